@@ -103,7 +103,6 @@ def doQuad(quad, cores, rtr, rtrPort, netAddr):
     bus = sst.Component("membus", "memHierarchy.Bus")
     bus.addParams({
         "bus_frequency" : clock,
-        "bus_latency_cycles" : 1,
         })
 
     for x in range(cores):
@@ -0,0 +1,171 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * File:   intervalTree.h
+ */
+
+#ifndef _SIEVE_INTERVALTREE_H_
+#define _SIEVE_INTERVALTREE_H_
+
+#include <stdint.h>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Address ranges indexed for point lookups, used to map a miss address to the allocation it falls in.
+ *
+ * A treap ordered by range start where each node also keeps the largest range end in its subtree,
+ * so a lookup only descends into subtrees that can contain the address. Ranges may overlap or nest
+ * (e.g., an allocation carved out of a larger mapping); lookup returns the innermost one, i.e., the
+ * containing range with the largest start. Insert, erase and lookup are O(log n) expected.
+ */
+template<typename V>
+class IntervalTree {
+public:
+    IntervalTree() : root_(nullptr), size_(0), seed_(0x9e3779b97f4a7c15ULL) { }
+    ~IntervalTree() { destroy(root_); }
+
+    size_t size() const { return size_; }
+
+    /** Insert [start, start + length). A range already starting at 'start' is replaced */
+    void insert(uint64_t start, uint64_t length, const V &value) {
+        erase(start);
+        Node * node = new Node(start, start + length, nextPriority(), value);
+        Node * less, * rest;
+        split(root_, start, less, rest);
+        root_ = merge(merge(less, node), rest);
+        size_++;
+    }
+
+    /** Remove the range starting at 'start'. Returns whether there was one */
+    bool erase(uint64_t start) {
+        Node * less, * rest, * match, * greater;
+        split(root_, start, less, rest);
+        splitAfter(rest, start, match, greater);
+        root_ = merge(less, greater);
+        if (!match) return false;
+        delete match;
+        size_--;
+        return true;
+    }
+
+    /** Value of the range starting at 'start', or nullptr */
+    V* find(uint64_t start) {
+        Node * node = root_;
+        while (node && node->start != start)
+            node = start < node->start ? node->left : node->right;
+        return node ? &node->value : nullptr;
+    }
+
+    /** Value of the innermost range containing 'addr', or nullptr */
+    V* lookup(uint64_t addr) {
+        Node * node = lookup(root_, addr);
+        return node ? &node->value : nullptr;
+    }
+
+private:
+    struct Node {
+        Node(uint64_t start, uint64_t end, uint64_t priority, const V &value) : start(start), end(end), maxEnd(end),
+            priority(priority), left(nullptr), right(nullptr), value(value) { }
+        uint64_t start;
+        uint64_t end;
+        uint64_t maxEnd;    // Largest end in this subtree
+        uint64_t priority;
+        Node * left;
+        Node * right;
+        V value;
+    };
+
+    static uint64_t maxEnd(Node * node) { return node ? node->maxEnd : 0; }
+
+    static Node * update(Node * node) {
+        node->maxEnd = node->end;
+        if (maxEnd(node->left) > node->maxEnd) node->maxEnd = maxEnd(node->left);
+        if (maxEnd(node->right) > node->maxEnd) node->maxEnd = maxEnd(node->right);
+        return node;
+    }
+
+    /* Split into ranges starting before 'key' and the rest */
+    static void split(Node * node, uint64_t key, Node * &less, Node * &rest) {
+        if (!node) {
+            less = rest = nullptr;
+        } else if (node->start < key) {
+            split(node->right, key, node->right, rest);
+            less = update(node);
+        } else {
+            split(node->left, key, less, node->left);
+            rest = update(node);
+        }
+    }
+
+    /* Split into ranges starting at or before 'key' and the rest */
+    static void splitAfter(Node * node, uint64_t key, Node * &lessEq, Node * &greater) {
+        if (!node) {
+            lessEq = greater = nullptr;
+        } else if (node->start <= key) {
+            splitAfter(node->right, key, node->right, greater);
+            lessEq = update(node);
+        } else {
+            splitAfter(node->left, key, lessEq, node->left);
+            greater = update(node);
+        }
+    }
+
+    /* Every start in 'left' is below every start in 'right' */
+    static Node * merge(Node * left, Node * right) {
+        if (!left) return right;
+        if (!right) return left;
+        if (left->priority > right->priority) {
+            left->right = merge(left->right, right);
+            return update(left);
+        }
+        right->left = merge(left, right->left);
+        return update(right);
+    }
+
+    static Node * lookup(Node * node, uint64_t addr) {
+        if (!node || node->maxEnd <= addr) return nullptr;
+        if (node->start > addr) return lookup(node->left, addr);
+        // Later starts are more deeply nested, so prefer a match on the right
+        Node * match = lookup(node->right, addr);
+        if (match) return match;
+        if (node->end > addr) return node;
+        return lookup(node->left, addr);
+    }
+
+    static void destroy(Node * node) {
+        if (!node) return;
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+
+    /* xorshift64, deterministic so runs are repeatable */
+    uint64_t nextPriority() {
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 7;
+        seed_ ^= seed_ << 17;
+        return seed_;
+    }
+
+    Node * root_;
+    size_t size_;
+    uint64_t seed_;
+};
+
+}}
+
+#endif
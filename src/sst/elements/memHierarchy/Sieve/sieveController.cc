@@ -25,38 +25,28 @@
 #include "sieveController.h"
 #include "../memEvent.h"
 
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
 using namespace SST;
 using namespace SST::MemHierarchy;
 
 void Sieve::recordMiss(Addr addr, bool isRead) {
-    allocMap_t::iterator allocI = activeAllocMap.lower_bound(addr);
+    mallocEntry * alloc = activeAllocs.lookup(addr);
     
-    // lower_bound returns iterator to address just above or equal to addr
-    if (allocI->first != addr) {
-        if (allocI == activeAllocMap.begin()) {
-            allocI = activeAllocMap.end(); // Not found
+    if (alloc) {
+        uint64_t allocID = alloc->id;
+        if (streaming) {
+            heavyHitters.record(allocID, isRead);
         } else {
-            allocI--; // Actually want the address just below the one we got
-        }
-    }
-    if (allocI != activeAllocMap.end()) {
-        // is it in range
-        if (addr < (allocI->first +  allocI->second.size)) {
-            uint64_t allocID = allocI->second.id;
-            allocCountMap_t::iterator evI = allocMap.find(allocID);
-            if (evI == allocMap.end()) {
-                allocMap[allocID] = rwCount_t();
-                evI = allocMap.find(allocID);
-            }
-            if (isRead) {
-                evI->second.first++;
-                statReadMisses->addData(1);
-            } else {
-                evI->second.second++;
-                statWriteMisses->addData(1);
-            }
-            return;
+            rwCount_t &counts = allocMap[allocID];
+            if (isRead) counts.first++;
+            else counts.second++;
         }
+        if (isRead) statReadMisses->addData(1);
+        else statWriteMisses->addData(1);
+        return;
     }
     
     if (isRead) {
@@ -74,24 +64,24 @@ void Sieve::processAllocEvent(SST::Event* event) {
     
     if (ev->getType() == ArielComponent::arielAllocTrackEvent::ALLOC) {
         // add to the list of active allocations (i.e. not FREEd)
-        mallocEntry entry = {ev->getInstructionPointer(), ev->getAllocateLength()};
-        activeAllocMap[ev->getVirtualAddress()] = entry;
-
 #ifdef __SST_DEBUG_OUTPUT__
-        if (activeAllocMap.find(ev->getVirtualAddress()) != activeAllocMap.end()) {
+        if (activeAllocs.find(ev->getVirtualAddress())) {
             // sometimes ariel replaces both malloc() and _malloc(), so we get two reports. Just ignore the first. 
-            output_->debug(_INFO_, "Trying to add allocation event at an address (%p %" PRIx64") with an active allocation. %" PRIu64 "\n", ev, ev->getVirtualAddress(), (uint64_t)activeAllocMap.size());
+            output_->debug(_INFO_, "Trying to add allocation event at an address (%p %" PRIx64") with an active allocation. %" PRIu64 "\n", ev, ev->getVirtualAddress(), (uint64_t)activeAllocs.size());
         }
 #endif
+        mallocEntry entry = {ev->getInstructionPointer(), ev->getAllocateLength()};
+        activeAllocs.insert(ev->getVirtualAddress(), entry.size, entry);
+
         delete ev;
     } else if (ev->getType() == ArielComponent::arielAllocTrackEvent::FREE) {
-        allocMap_t::iterator targ = activeAllocMap.find(ev->getVirtualAddress());
-        if (targ != activeAllocMap.end()) {
-            uint64_t allocID = targ->second.id;
+        mallocEntry * targ = activeAllocs.find(ev->getVirtualAddress());
+        if (targ) {
+            uint64_t allocID = targ->id;
             allocCountMap_t::iterator mapIt = allocMap.find(allocID);
             
             // In this case ALWAYS delete the entry from active alloc & delete the event
-            activeAllocMap.erase(targ);
+            activeAllocs.erase(ev->getVirtualAddress());
             
             // If the entry in the count map is 0, remove it as well
             if (mapIt != allocMap.end() && (mapIt->second.first == 0 && mapIt->second.second == 0)) {
@@ -117,6 +107,15 @@ void Sieve::processEvent(SST::Event* ev) {
     MemEvent* event = static_cast<MemEvent*>(ev);
     Command cmd     = event->getCmd();
     
+    // Dump the streaming profile if an interval has ended since the last access
+    if (profileInterval) {
+        SimTime_t interval = getCurrentSimTime(profileInterval);
+        if (interval != lastInterval) {
+            lastInterval = interval;
+            outputStats(-1);
+        }
+    }
+    
     event->setBaseAddr(toBaseAddr(event->getAddr()));
     Addr baseAddr   = event->getBaseAddr();
             
@@ -189,6 +188,11 @@ void Sieve::outputStats(int marker) {
     }
     fileName << ".txt";
 
+    if (streaming) {
+        outputProfile(fileName.str());
+        return;
+    }
+
     // create new file
     Output* output_file = new Output("",0,0,SST::Output::FILE, fileName.str());
 
@@ -219,6 +223,37 @@ void Sieve::outputStats(int marker) {
     delete output_file;
 }
 
+/* Write the heavy hitters, most misses first, then start a new profile */
+void Sieve::outputProfile(const string &fileName) {
+    vector<SpaceSaving<uint64_t>::Counter> counters = heavyHitters.sorted();
+
+    stringstream text;
+    text << "#Profile at " << getCurrentSimTimeNano() << "ns: " << heavyHitters.total() << " misses, "
+        << counters.size() << " of at most " << heavyHitters.capacity() << " allocations tracked\n";
+    text << "#Printing allocation memory accesses (mallocID, reads, writes, maxOvercount):\n";
+    for (vector<SpaceSaving<uint64_t>::Counter>::iterator it = counters.begin(); it != counters.end(); it++) {
+        text << it->key << " " << it->reads << " " << it->writes << " " << it->error << "\n";
+    }
+    string out = text.str();
+
+#ifdef HAVE_LIBZ
+    if (compressOutput) {
+        string name = fileName + ".gz";
+        gzFile file = gzopen(name.c_str(), "wb");
+        if (!file || gzwrite(file, out.data(), out.size()) != (int)out.size())
+            output_->fatal(CALL_INFO, -1, "%s, Error: unable to write profile to %s\n", getName().c_str(), name.c_str());
+        gzclose(file);
+        heavyHitters.clear();
+        return;
+    }
+#endif
+    FILE * file = fopen(fileName.c_str(), "w");
+    if (!file || fwrite(out.data(), 1, out.size(), file) != out.size())
+        output_->fatal(CALL_INFO, -1, "%s, Error: unable to write profile to %s\n", getName().c_str(), fileName.c_str());
+    fclose(file);
+    heavyHitters.clear();
+}
+
 void Sieve::finish(){
     outputStats(-1);
 }
@@ -33,6 +33,8 @@
 #include "../replacementManager.h"
 #include "../util.h"
 #include "../../ariel/arielalloctrackev.h"
+#include "intervalTree.h"
+#include "spaceSaving.h"
 
 
 namespace SST { namespace MemHierarchy {
@@ -54,7 +56,11 @@ public:
             {"debug",                   "(uint) Print debug information. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",             "(uint) Debugging/verbosity level. Between 0 and 10", "0"},
             {"output_file",             "(string) Name of file to output malloc information to. Will have sequence number (and optional marker number) and .txt appended to it. E.g. sieveMallocRank-3.txt", "sieveMallocRank"},
-            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"} )
+            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"},
+            {"profile_mode",            "(string) How misses are counted per allocation. 'exact' counts every allocation and dumps at buoys and at the end of simulation. 'streaming' keeps a fixed number of counters for the allocations with the most misses, dumps them every profile_interval too, and starts a fresh profile after each dump.", "exact"},
+            {"profile_entries",         "(uint) Streaming mode: number of allocations tracked. A count may be overestimated by at most (misses since last dump)/profile_entries; the overestimate is the last column of the dump.", "1024"},
+            {"profile_interval",        "(string) Streaming mode: simulated time between dumps, with units. A dump is written at the first access after each interval ends. '0ns' dumps only at buoys and at the end of simulation.", "0ns"},
+            {"profile_compress",        "(bool) Streaming mode: gzip the dump files (.txt.gz). Ignored if SST was built without zlib.", "true"} )
 
     SST_ELI_DOCUMENT_PORTS(
             {"cpu_link_%(port)d", "Ports connected to the CPUs", {"memHierarchy.MemEventBase"}},
@@ -92,7 +98,6 @@ private:
     };
     
         
-    typedef map<Addr, mallocEntry> allocMap_t;
     typedef pair<uint64_t, uint64_t> rwCount_t;
     typedef std::unordered_map<uint64_t, rwCount_t > allocCountMap_t;
     
@@ -103,10 +108,15 @@ private:
     uint64_t outCount;
     /** All Allocations */
     allocCountMap_t allocMap;
-     /** All allocations in list form */
-    /** Active Allocations */
-    allocMap_t activeAllocMap; 
-    /** misses not associated with an alloc'd region */
+    /** Active Allocations, by address range */
+    IntervalTree<mallocEntry> activeAllocs;
+
+    /** Streaming profile: heavy-hitter counts since the last dump */
+    bool streaming;
+    SpaceSaving<uint64_t> heavyHitters;
+    TimeConverter* profileInterval;
+    SimTime_t lastInterval;
+    bool compressOutput;
 
     void recordMiss(Addr addr, bool isRead);
     
@@ -123,6 +133,7 @@ private:
 
     /** output and clear stats to file  */
     void outputStats(int marker);
+    void outputProfile(const string &fileName);
     bool resetStatsOnOutput;
 
     CacheArray*         cacheArray_;
@@ -60,7 +60,8 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
     /* ---------------- Initialization ----------------- */
     HashFunction* ht = new PureIdHashFunction;
     ReplacementMgr* replManager = new LRUReplacementMgr(output_, numLines, associativity, true);
-    cacheArray_ = new SetAssociativeArray(output_, numLines, lineSize, associativity, replManager, ht, false);
+    /* Sieve only tracks tags, so the array is timing-only and holds no line data */
+    cacheArray_ = new SetAssociativeArray(output_, numLines, lineSize, associativity, replManager, ht, false, true);
     
     output_->debug(_INFO_,"--------------------------- Initializing [Sieve]: %s... \n", this->Component::getName().c_str());
 
@@ -73,6 +74,25 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
     
     resetStatsOnOutput = params.find<bool>("reset_stats_at_buoy", 0) != 0;
 
+    /* Streaming profile */
+    string profileMode = params.find<std::string>("profile_mode", "exact");
+    if (profileMode != "exact" && profileMode != "streaming")
+        output_->fatal(CALL_INFO, -1, "%s, Invalid param: profile_mode - must be 'exact' or 'streaming'. You specified '%s'\n", getName().c_str(), profileMode.c_str());
+    streaming = (profileMode == "streaming");
+    
+    uint64_t profileEntries = params.find<uint64_t>("profile_entries", 1024);
+    if (streaming && profileEntries == 0)
+        output_->fatal(CALL_INFO, -1, "%s, Invalid param: profile_entries - must be at least 1\n", getName().c_str());
+    heavyHitters.setCapacity(streaming ? profileEntries : 0);
+
+    string intervalStr = params.find<std::string>("profile_interval", "0ns");
+    UnitAlgebra intervalUA(intervalStr);
+    if (!intervalUA.hasUnits("s"))
+        output_->fatal(CALL_INFO, -1, "%s, Invalid param: profile_interval - must have units of time (s). Ex: '100us'. SI units are ok. You specified '%s'\n", getName().c_str(), intervalStr.c_str());
+    profileInterval = (streaming && intervalUA.getRoundedValue() != 0) ? getTimeConverter(intervalUA) : nullptr;
+    lastInterval = 0;
+    compressOutput = params.find<bool>("profile_compress", true);
+
     // optional link for allocation / free tracking
     configureLinks();
 
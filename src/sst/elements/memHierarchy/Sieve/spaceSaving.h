@@ -0,0 +1,136 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * File:   spaceSaving.h
+ */
+
+#ifndef _SIEVE_SPACESAVING_H_
+#define _SIEVE_SPACESAVING_H_
+
+#include <algorithm>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Fixed-size heavy-hitter counters (space-saving, Metwally et al., ICDT'05).
+ *
+ * Tracks read and write counts for at most 'capacity' keys. When a new key arrives and the table
+ * is full, it takes over the counter with the smallest count and inherits that count as its error,
+ * i.e., the most the key's count may be overestimated by. Any key seen more than total()/capacity
+ * times is guaranteed to be in the table. Counters are kept in a min-heap on count, so recording
+ * is O(log capacity) and memory does not grow with the number of distinct keys.
+ */
+template<typename K>
+class SpaceSaving {
+public:
+    struct Counter {
+        Counter(const K &key, uint64_t error) : key(key), reads(0), writes(0), error(error) { }
+        uint64_t count() const { return reads + writes + error; }
+        K key;
+        uint64_t reads;
+        uint64_t writes;
+        uint64_t error;     // Counts inherited from the evicted key
+    };
+
+    SpaceSaving(size_t capacity = 0) : capacity_(capacity), total_(0) { }
+
+    void setCapacity(size_t capacity) {
+        capacity_ = capacity;
+        clear();
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return heap_.size(); }
+
+    /** Number of events recorded since the last clear() */
+    uint64_t total() const { return total_; }
+
+    void record(const K &key, bool isRead) {
+        if (capacity_ == 0) return;
+        total_++;
+        size_t i;
+        typename std::unordered_map<K, size_t>::iterator it = index_.find(key);
+        if (it != index_.end()) {
+            i = it->second;
+        } else if (heap_.size() < capacity_) {
+            i = heap_.size();
+            heap_.push_back(Counter(key, 0));
+            index_[key] = i;
+            siftUp(i);
+            i = index_[key];
+        } else {
+            i = 0;
+            index_.erase(heap_[0].key);
+            heap_[0] = Counter(key, heap_[0].count());
+            index_[key] = 0;
+        }
+        if (isRead) heap_[i].reads++;
+        else heap_[i].writes++;
+        siftDown(i);
+    }
+
+    /** Tracked counters, highest count first */
+    std::vector<Counter> sorted() const {
+        std::vector<Counter> counters(heap_);
+        std::sort(counters.begin(), counters.end(), [](const Counter &a, const Counter &b) { return a.count() > b.count(); });
+        return counters;
+    }
+
+    void clear() {
+        heap_.clear();
+        index_.clear();
+        total_ = 0;
+    }
+
+private:
+    void swap(size_t a, size_t b) {
+        std::swap(heap_[a], heap_[b]);
+        index_[heap_[a].key] = a;
+        index_[heap_[b].key] = b;
+    }
+
+    void siftUp(size_t i) {
+        while (i > 0 && heap_[i].count() < heap_[(i - 1) / 2].count()) {
+            swap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void siftDown(size_t i) {
+        while (true) {
+            size_t least = i;
+            size_t left = 2 * i + 1;
+            size_t right = left + 1;
+            if (left < heap_.size() && heap_[left].count() < heap_[least].count()) least = left;
+            if (right < heap_.size() && heap_[right].count() < heap_[least].count()) least = right;
+            if (least == i) return;
+            swap(i, least);
+            i = least;
+        }
+    }
+
+    std::vector<Counter> heap_;
+    std::unordered_map<K, size_t> index_;   // key -> position in heap_
+    size_t capacity_;
+    uint64_t total_;
+};
+
+}}
+
+#endif
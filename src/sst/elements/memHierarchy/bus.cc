@@ -22,6 +22,7 @@
 #include <sst_config.h>
 
 #include <sstream>
+#include <algorithm>
 
 #include "bus.h"
 
@@ -52,8 +53,10 @@ Bus::Bus(ComponentId_t id, Params& params) : Component(id) {
 }
 
 
-void Bus::processIncomingEvent(SST::Event* ev) {
-    eventQueue_.push(ev);
+void Bus::processIncomingEvent(SST::Event* ev, int port) {
+    QueuedEvent entry = { static_cast<MemEventBase*>(ev), arrivalSeq_++ };
+    inQueues_[port].push_back(entry);
+    queuedEvents_++;
     if (!busOn_) {
         reregisterClock(defaultTimeBase_, clockHandler_);
         busOn_ = true;
@@ -63,13 +66,30 @@ void Bus::processIncomingEvent(SST::Event* ev) {
 
 bool Bus::clockTick(Cycle_t time) {
 
-    if (!eventQueue_.empty()) {
-        SST::Event* event = eventQueue_.front();
-        
-        if (broadcast_) broadcastEvent(event);
-        else sendSingleEvent(event);
-        
-        eventQueue_.pop();
+    if (queuedEvents_ != 0) {
+        /* Order the input ports with waiting events by priority */
+        int numPorts = ports_.size();
+        arbOrder_.clear();
+        for (int i = 0; i < numPorts; i++) {
+            int port = (arbitration_ == Arbitration::RoundRobin) ? (rrNext_ + i) % numPorts : i;
+            if (!inQueues_[port].empty()) arbOrder_.push_back(port);
+        }
+        if (arbitration_ == Arbitration::Age && arbOrder_.size() > 1) {
+            std::sort(arbOrder_.begin(), arbOrder_.end(), [this](int a, int b) { return inQueues_[a].front().seq < inQueues_[b].front().seq; });
+        }
+
+        unsigned int freeLanes = 0;
+        for (unsigned int i = 0; i < lanes_; i++) {
+            if (laneFreeCycle_[i] <= time) freeLanes++;
+        }
+
+        bool granted = false;
+        for (std::vector<int>::iterator it = arbOrder_.begin(); it != arbOrder_.end() && freeLanes != 0; it++) {
+            if (!trySend(*it, time)) continue;
+            freeLanes--;
+            if (!granted && arbitration_ == Arbitration::RoundRobin) rrNext_ = (*it + 1) % numPorts;
+            granted = true;
+        }
         idleCount_ = 0;
     } else if (busOn_) idleCount_++;
     
@@ -84,19 +104,60 @@ bool Bus::clockTick(Cycle_t time) {
 }
 
 
-void Bus::broadcastEvent(SST::Event* ev) {
-    MemEventBase* memEvent = dynamic_cast<MemEventBase*>(ev);
-    LinkId_t srcLinkId = lookupNode(memEvent->getSrc());
-    SST::Link* srcLink = linkIdMap_[srcLinkId];
+bool Bus::trySend(int port, Cycle_t cycle) {
+    MemEventBase* event = inQueues_[port].front().event;
 
-    for (int i = 0; i < numHighNetPorts_; i++) {
-        if (highNetPorts_[i] == srcLink) continue;
-        highNetPorts_[i]->send(memEvent->clone());
+    Cycle_t transferCycles = 1;
+    if (laneWidth_ != 0 && event->getPayloadSize() > laneWidth_) 
+        transferCycles = (event->getPayloadSize() + laneWidth_ - 1) / laneWidth_;
+    SimTime_t delay = transferCycles - 1 + latency_;
+
+    if (broadcast_) {
+        for (int i = 0; i < (int)ports_.size(); i++) {
+            if (i != port && !portAvailable(i, cycle)) return false;
+        }
+        for (int i = 0; i < (int)ports_.size(); i++) {
+            if (i != port) occupyPort(i, cycle, transferCycles);
+        }
+        broadcastEvent(event, port, delay);
+    } else {
+        int dstPort = lookupNode(event->getDstId());
+        if (!portAvailable(dstPort, cycle)) return false;
+        occupyPort(dstPort, cycle, transferCycles);
+        sendSingleEvent(event, dstPort, delay);
     }
-    
-    for (int i = 0; i < numLowNetPorts_; i++) {
-        if (lowNetPorts_[i] == srcLink) continue;
-        lowNetPorts_[i]->send(memEvent->clone());
+
+    for (unsigned int i = 0; i < lanes_; i++) {
+        if (laneFreeCycle_[i] <= cycle) {
+            laneFreeCycle_[i] = cycle + transferCycles;
+            break;
+        }
+    }
+    inQueues_[port].pop_front();
+    queuedEvents_--;
+    return true;
+}
+
+
+bool Bus::portAvailable(int port, Cycle_t cycle) {
+    if (portFreeCycle_[port] > cycle) return false;
+    if (credits_ == 0) return true;
+    std::deque<Cycle_t> &returns = creditReturns_[port];
+    while (!returns.empty() && returns.front() <= cycle) returns.pop_front();
+    return returns.size() < credits_;
+}
+
+
+void Bus::occupyPort(int port, Cycle_t cycle, Cycle_t transferCycles) {
+    portFreeCycle_[port] = cycle + transferCycles;
+    if (credits_ != 0) creditReturns_[port].push_back(cycle + transferCycles + latency_);
+}
+
+
+void Bus::broadcastEvent(MemEventBase* memEvent, int srcPort, SimTime_t delay) {
+    for (int i = 0; i < (int)ports_.size(); i++) {
+        if (i == srcPort) continue;
+        ports_[i]->send(delay, defaultTimeBase_, memEvent->clone());
     }
     
     delete memEvent;
@@ -104,51 +165,40 @@ void Bus::broadcastEvent(SST::Event* ev) {
 
 
 
-void Bus::sendSingleEvent(SST::Event* ev) {
-    MemEventBase *event = static_cast<MemEventBase*>(ev);
+void Bus::sendSingleEvent(MemEventBase* event, int dstPort, SimTime_t delay) {
 #ifdef __SST_DEBUG_OUTPUT__
     if (is_debug_event(event)) {
         dbg_.debug(_L3_,"\n\n");
         dbg_.debug(_L3_,"----------------------------------------------------------------------------------------\n");    //raise(SIGINT);
-        dbg_.debug(_L3_,"Incoming Event. Name: %s, LinkID: %d, Event: %s\n",
-                   this->getName().c_str(), event->getDeliveryLink()->getId(), event->getBriefString().c_str());
+        dbg_.debug(_L3_,"Incoming Event. Name: %s, Port: %d, Event: %s\n",
+                   this->getName().c_str(), dstPort, event->getBriefString().c_str());
+        dbg_.debug(_L3_,"BCmd = %s \n", CommandString[(int)event->getCmd()]);
+        dbg_.debug(_L3_,"BDst = %s \n", event->getDst().c_str());
+        dbg_.debug(_L3_,"BSrc = %s \n", event->getSrc().c_str());
     }
 #endif
-    LinkId_t dstLinkId = lookupNode(event->getDst());
-    SST::Link* dstLink = linkIdMap_[dstLinkId];
-    MemEventBase* forwardEvent = event->clone();
-#ifdef __SST_DEBUG_OUTPUT__
-    if (is_debug_event(forwardEvent)) {
-        dbg_.debug(_L3_,"BCmd = %s \n", CommandString[(int)forwardEvent->getCmd()]);
-        dbg_.debug(_L3_,"BDst = %s \n", forwardEvent->getDst().c_str());
-        dbg_.debug(_L3_,"BSrc = %s \n", forwardEvent->getSrc().c_str());
-    }
-#endif
-    dstLink->send(forwardEvent);
-    
-    delete event;
+    ports_[dstPort]->send(delay, defaultTimeBase_, event);
 }
 
 /*----------------------------------------
  * Helper functions
  *---------------------------------------*/
 
-void Bus::mapNodeEntry(const std::string& name, LinkId_t id) {
-	std::map<std::string, LinkId_t>::iterator it = nameMap_.find(name);
-	if (it != nameMap_.end() ) {
-            if (it->second != id)
-                dbg_.fatal(CALL_INFO, -1, "%s, Error: Bus attempting to map node that has already been mapped\n", getName().c_str());
-            return;
-        }
-    nameMap_[name] = id;
+void Bus::mapNodeEntry(EndpointId name, int port) {
+    if (name >= portOfEndpoint_.size()) portOfEndpoint_.resize(name + 1, -1);
+    if (portOfEndpoint_[name] != -1) {
+        if (portOfEndpoint_[name] != port)
+            dbg_.fatal(CALL_INFO, -1, "%s, Error: Bus attempting to map node that has already been mapped\n", getName().c_str());
+        return;
+    }
+    portOfEndpoint_[name] = port;
 }
 
-LinkId_t Bus::lookupNode(const std::string& name) {
-	std::map<std::string, LinkId_t>::iterator it = nameMap_.find(name);
-    if (nameMap_.end() == it) {
-        dbg_.fatal(CALL_INFO, -1, "%s, Error: Bus lookup of node %s returned no mapping\n", getName().c_str(), name.c_str());
+int Bus::lookupNode(EndpointId name) {
+    if (name >= portOfEndpoint_.size() || portOfEndpoint_[name] == -1) {
+        dbg_.fatal(CALL_INFO, -1, "%s, Error: Bus lookup of node %s returned no mapping\n", getName().c_str(), EndpointNames::name(name).c_str());
     }
-    return it->second;
+    return portOfEndpoint_[name];
 }
 
 void Bus::configureLinks() {
@@ -156,9 +206,9 @@ void Bus::configureLinks() {
     std::string linkprefix = "high_network_";
     std::string linkname = linkprefix + "0";
     while (isPortConnected(linkname)) {
-        link = configureLink(linkname, "50 ps", new Event::Handler<Bus>(this, &Bus::processIncomingEvent));
+        link = configureLink(linkname, "50 ps", new Event::Handler<Bus,int>(this, &Bus::processIncomingEvent, ports_.size()));
         highNetPorts_.push_back(link);
-        linkIdMap_[highNetPorts_[numHighNetPorts_]->getId()] = highNetPorts_[numHighNetPorts_];
+        ports_.push_back(link);
         dbg_.output(CALL_INFO, "Port %d = Link %d\n", numHighNetPorts_, highNetPorts_[numHighNetPorts_]->getId());
         numHighNetPorts_++;
         linkname = linkprefix + std::to_string(numHighNetPorts_);
@@ -167,9 +217,9 @@ void Bus::configureLinks() {
     linkprefix = "low_network_";
     linkname = linkprefix + "0";
     while (isPortConnected(linkname)) {
-        link = configureLink(linkname, "50 ps", new Event::Handler<Bus>(this, &Bus::processIncomingEvent));
+        link = configureLink(linkname, "50 ps", new Event::Handler<Bus,int>(this, &Bus::processIncomingEvent, ports_.size()));
         lowNetPorts_.push_back(link);
-        linkIdMap_[lowNetPorts_[numLowNetPorts_]->getId()] = lowNetPorts_[numLowNetPorts_];
+        ports_.push_back(link);
         dbg_.output(CALL_INFO, "Port %d = Link %d\n", numLowNetPorts_, lowNetPorts_[numLowNetPorts_]->getId());
         numLowNetPorts_++;
         linkname = linkprefix + std::to_string(numLowNetPorts_);
@@ -177,6 +227,11 @@ void Bus::configureLinks() {
     
     if (numLowNetPorts_ < 1 || numHighNetPorts_ < 1) dbg_.fatal(CALL_INFO, -1,"couldn't find number of Ports (numPorts)\n");
 
+    inQueues_.resize(ports_.size());
+    portFreeCycle_.resize(ports_.size(), 0);
+    creditReturns_.resize(ports_.size());
+    arbOrder_.reserve(ports_.size());
+
 }
 
 void Bus::configureParameters(SST::Params& params) {
@@ -193,13 +248,39 @@ void Bus::configureParameters(SST::Params& params) {
     numHighNetPorts_  = 0;
     numLowNetPorts_   = 0;
     
-    latency_      = params.find<int>("bus_latency_cycles", 1);
+    latency_      = params.find<int>("bus_latency_cycles", 0);
     idleMax_      = params.find<int>("idle_max", 6);
     busFrequency_ = params.find<std::string>("bus_frequency", "Invalid");
     broadcast_    = params.find<int>("broadcast", 0);
     fanout_       = params.find<int>("fanout", 0);  /* TODO:  Fanout: Only send messages to lower level caches */
 
     if (busFrequency_ == "Invalid") dbg_.fatal(CALL_INFO, -1, "Bus Frequency was not specified\n");
+    if (latency_ < 0) dbg_.fatal(CALL_INFO, -1, "Invalid param(%s): bus_latency_cycles - must be at least 0. You specified %d\n", getName().c_str(), latency_);
+
+    lanes_ = params.find<unsigned int>("lanes", 1);
+    if (lanes_ == 0) dbg_.fatal(CALL_INFO, -1, "Invalid param(%s): lanes - must be at least 1\n", getName().c_str());
+    laneFreeCycle_.resize(lanes_, 0);
+
+    std::string laneWidth = params.find<std::string>("lane_width", "0B");
+    fixByteUnits(laneWidth);
+    UnitAlgebra laneWidthUA(laneWidth);
+    if (!laneWidthUA.hasUnits("B")) 
+        dbg_.fatal(CALL_INFO, -1, "Invalid param(%s): lane_width - must have units of bytes (B). SI units OK. You specified '%s'\n", getName().c_str(), laneWidth.c_str());
+    laneWidth_ = laneWidthUA.getRoundedValue();
+
+    std::string arbitration = params.find<std::string>("arbitration", "age");
+    if (arbitration == "age") arbitration_ = Arbitration::Age;
+    else if (arbitration == "round_robin") arbitration_ = Arbitration::RoundRobin;
+    else dbg_.fatal(CALL_INFO, -1, "Invalid param(%s): arbitration - must be 'age' or 'round_robin'. You specified '%s'\n", getName().c_str(), arbitration.c_str());
+
+    credits_ = params.find<unsigned int>("credits", 0);
+    if (credits_ != 0 && latency_ == 0) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.output("%s, Warning: credits is set but bus_latency_cycles is 0. Events reach their port when its transfer ends, so the in-flight cap has no effect.\n", getName().c_str());
+    }
+    queuedEvents_ = 0;
+    arrivalSeq_ = 0;
+    rrNext_ = 0;
     
      /* Multiply Frequency times two.  This is because an SST Bus components has
         2 SST Links (highNEt & LowNet) and thus it takes a least 2 cycles for any
@@ -223,7 +304,7 @@ void Bus::init(unsigned int phase) {
 
             if (memEvent && memEvent->getCmd() == Command::NULLCMD) {
                 dbg_.debug(_L10_, "bus %s broadcasting upper event to lower ports (%d): %s\n", getName().c_str(), numLowNetPorts_, memEvent->getVerboseString().c_str());
-                mapNodeEntry(memEvent->getSrc(), highNetPorts_[i]->getId());
+                mapNodeEntry(memEvent->getSrcId(), i);
                 for (int k = 0; k < numLowNetPorts_; k++)
                     lowNetPorts_[k]->sendInitData(memEvent->clone());
             } else if (memEvent) {
@@ -241,7 +322,7 @@ void Bus::init(unsigned int phase) {
             if (!memEvent) delete memEvent;
             else if (memEvent->getCmd() == Command::NULLCMD) {
                 dbg_.debug(_L10_, "bus %s broadcasting lower event to upper ports (%d): %s\n", getName().c_str(), numHighNetPorts_, memEvent->getVerboseString().c_str());
-                mapNodeEntry(memEvent->getSrc(), lowNetPorts_[i]->getId());
+                mapNodeEntry(memEvent->getSrcId(), numHighNetPorts_ + i);
                 for (int i = 0; i < numHighNetPorts_; i++) {
                     highNetPorts_[i]->sendInitData(memEvent->clone());
                 }
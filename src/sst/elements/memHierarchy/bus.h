@@ -17,6 +17,7 @@
 #define SST_MEMHIERARCHY_BUS_H
 
 #include <queue>
+#include <deque>
 #include <map>
 
 #include <sst/core/event.h>
@@ -53,7 +54,11 @@ public:
             {"bus_frequency",       "(string) Bus clock frequency"},
             {"broadcast",           "(bool) If set, messages are broadcast to all other ports", "0"},
             {"fanout",              "(bool) If set, messages from the high network are replicated and sent to all low network ports", "0"},
-            {"bus_latency_cycles",  "(uint) Bus latency in cycles", "0"},
+            {"bus_latency_cycles",  "(uint) Bus latency in cycles, added between winning arbitration and delivery. Older versions of the bus ignored this param, so configs that set it now see slower deliveries.", "0"},
+            {"lanes",               "(uint) Number of events the bus can transfer in parallel each cycle. Each port still receives at most one event at a time.", "1"},
+            {"lane_width",          "(string) Bytes of payload a lane moves per cycle; larger events hold their lane and destination port for several cycles. 0B means every event takes one cycle.", "0B"},
+            {"arbitration",         "(string) How ports are chosen when more events are waiting than can be sent. Options: 'age' (oldest event first), 'round_robin' (rotate over input ports)", "age"},
+            {"credits",             "(uint) Cap on events in flight on the bus to any one port, counted from arbitration until delivery. This is not flow control with the receiver: the receiver's buffers are not tracked. Only has an effect when bus_latency_cycles is above 0. 0 is unlimited.", "0"},
             {"idle_max",            "(uint) Bus temporarily turns off clock after this number of idle cycles", "6"},
             {"debug",               "(uint) Output location for debug statements. Requires core configuration flag '--enable-debug'. --0[None], 1[STDOUT], 2[STDERR], 3[FILE]--", "0"},
             {"debug_level",         "(uint) Debugging level: 0 to 10", "0"},
@@ -65,6 +70,8 @@ public:
 
 /* Class definition */
 
+    enum class Arbitration { Age, RoundRobin };
+
     typedef MemEvent::id_type key_t;
     static const key_t ANY_KEY;
     static const char BUS_INFO_STR[];
@@ -74,14 +81,27 @@ public:
 
 private:
 
-    /** Adds event to the incoming event queue.  Reregisters clock if needed */
-	void processIncomingEvent(SST::Event *ev);
+    /* An event waiting at an input port */
+    struct QueuedEvent {
+        MemEventBase * event;
+        uint64_t seq;   // Arrival order across all ports, for age-based arbitration
+    };
+
+    /** Adds event to its input port's queue.  Reregisters clock if needed */
+	void processIncomingEvent(SST::Event *ev, int port);
+
+    /** Try to send the event at the head of a port's queue. Returns whether it was sent */
+    bool trySend(int port, Cycle_t cycle);
     
     /** Send event to a single destination */
-    void sendSingleEvent(SST::Event *ev);
+    void sendSingleEvent(MemEventBase *ev, int dstPort, SimTime_t delay);
     
-    /** Broadcast event to all ports */
-    void broadcastEvent(SST::Event *ev);
+    /** Broadcast event to all ports except srcPort */
+    void broadcastEvent(MemEventBase *ev, int srcPort, SimTime_t delay);
+
+    /** Whether port can accept a new event this cycle: not mid-transfer and under the in-flight cap */
+    bool portAvailable(int port, Cycle_t cycle);
+    void occupyPort(int port, Cycle_t cycle, Cycle_t transferCycles);
     
     /**  Clock Handler */
     bool clockTick(Cycle_t);
@@ -90,8 +110,8 @@ private:
     void configureParameters(SST::Params&);
     void configureLinks();
     
-    void mapNodeEntry(const std::string&, LinkId_t);
-    LinkId_t lookupNode(const std::string&);
+    void mapNodeEntry(EndpointId, int port);
+    int lookupNode(EndpointId);
 
 
     Output                          dbg_;
@@ -113,9 +133,24 @@ private:
     std::string                     bus_latency_cycles_;
 	std::vector<SST::Link*>         highNetPorts_;
 	std::vector<SST::Link*>         lowNetPorts_;
-	std::map<string, LinkId_t>      nameMap_;
-    std::map<LinkId_t, SST::Link*>  linkIdMap_;
-    std::queue<SST::Event*>         eventQueue_;
+
+    /* Ports are numbered high_network_0..N-1 then low_network_0..M-1 */
+    std::vector<SST::Link*>         ports_;
+    std::vector<int>                portOfEndpoint_;    // Port each endpoint is reached through, indexed by EndpointId. -1 if unknown
+
+    /* Split-transaction arbitration state */
+    unsigned int                    lanes_;
+    uint64_t                        laneWidth_;
+    Arbitration                     arbitration_;
+    unsigned int                    credits_;
+    std::vector<std::deque<QueuedEvent> > inQueues_;    // Waiting events, per input port
+    std::vector<Cycle_t>            laneFreeCycle_;     // Cycle each lane finishes its current transfer
+    std::vector<Cycle_t>            portFreeCycle_;     // Cycle each output port finishes its current transfer
+    std::vector<std::deque<Cycle_t> > creditReturns_;   // Delivery cycle of each event in flight to a port, used for the 'credits' cap
+    uint64_t                        queuedEvents_;
+    uint64_t                        arrivalSeq_;
+    int                             rrNext_;            // Round-robin: input port with the highest priority
+    std::vector<int>                arbOrder_;
     
 };
 
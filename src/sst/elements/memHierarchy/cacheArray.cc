@@ -26,34 +26,22 @@
 namespace SST { namespace MemHierarchy {
 
 /* Set Associative Array Class */
-SetAssociativeArray::SetAssociativeArray(Output* dbg, unsigned int numLines, unsigned int lineSize, unsigned int associativity, ReplacementMgr* rm, HashFunction* hf, bool sharersAware) :
-    CacheArray(dbg, numLines, associativity, lineSize, rm, hf, sharersAware, true) 
-    { 
-        setStates = new State[associativity];
-        setSharers = new unsigned int[associativity];
-        setOwned = new bool[associativity];
-    }
+SetAssociativeArray::SetAssociativeArray(Output* dbg, unsigned int numLines, unsigned int lineSize, unsigned int associativity, ReplacementMgr* rm, HashFunction* hf, bool sharersAware, bool timingOnly) :
+    CacheArray(dbg, numLines, associativity, lineSize, rm, hf, sharersAware, true, timingOnly) 
+    { }
 
 
-SetAssociativeArray::~SetAssociativeArray() {
-    delete [] setStates;
-    delete [] setSharers;
-    delete [] setOwned;
-}
+SetAssociativeArray::~SetAssociativeArray() { }
 
 CacheArray::CacheLine* SetAssociativeArray::lookup(const Addr baseAddr, bool update) {
     Addr lineAddr = toLineAddr(baseAddr);
     int set = hash_->hash(0, lineAddr) % numSets_;
     int setBegin = set * associativity_;
-    int setEnd = setBegin + associativity_;
    
-    for (int i = setBegin; i < setEnd; i++) {
-        if (lines_[i]->getBaseAddr() == baseAddr) {
-            if (update) replacementMgr_->update(i);
-            return lines_[i];
-        }
-    }
-    return nullptr;
+    int i = findTag(setBegin, baseAddr);
+    if (i < 0) return nullptr;
+    if (update) replacementMgr_->update(i);
+    return lines_[i];
 }
 
 CacheArray::CacheLine* SetAssociativeArray::findReplacementCandidate(const Addr baseAddr, bool cache) {
@@ -66,12 +54,7 @@ unsigned int SetAssociativeArray::preReplace(const Addr baseAddr) {
     int set         = hash_->hash(0, lineAddr) % numSets_;
     int setBegin    = set * associativity_;
     
-    for (unsigned int id = 0; id < associativity_; id++) {
-        setStates[id] = lines_[id+setBegin]->getState();
-        setSharers[id] = lines_[id+setBegin]->numSharers();
-        setOwned[id] = lines_[id+setBegin]->ownerExists();
-    }
-    return replacementMgr_->findBestCandidate(setBegin, setStates, setSharers, setOwned, sharersAware_? true: false);
+    return replacementMgr_->findBestCandidate(setBegin, &states_[setBegin], &coherence_[setBegin], sharersAware_);
 }
 
 void SetAssociativeArray::replace(const Addr baseAddr, CacheArray::CacheLine * candidate, CacheArray::DataLine * dataCandidate) {
@@ -79,6 +62,7 @@ void SetAssociativeArray::replace(const Addr baseAddr, CacheArray::CacheLine * c
     replacementMgr_->replaced(index);
     candidate->reset();
     candidate->setBaseAddr(baseAddr);
+    replacementMgr_->inserted(index, baseAddr);
     replacementMgr_->update(index);
 }
 
@@ -89,8 +73,8 @@ void SetAssociativeArray::deallocate(unsigned int index) {
 
 /* Dual Set Associative Array Class */
 DualSetAssociativeArray::DualSetAssociativeArray(Output* dbg, unsigned int lineSize, HashFunction * hf, bool sharersAware, unsigned int dirNumLines, 
-        unsigned int dirAssociativity, ReplacementMgr * dirRp, unsigned int cacheNumLines, unsigned int cacheAssociativity, ReplacementMgr * cacheRp) :
-        CacheArray(dbg, dirNumLines, dirAssociativity, lineSize, dirRp, hf, sharersAware, false)
+        unsigned int dirAssociativity, ReplacementMgr * dirRp, unsigned int cacheNumLines, unsigned int cacheAssociativity, ReplacementMgr * cacheRp, bool timingOnly) :
+        CacheArray(dbg, dirNumLines, dirAssociativity, lineSize, dirRp, hf, sharersAware, false, timingOnly)
     {
         // Set up data cache
         cacheNumLines_  = cacheNumLines;
@@ -99,15 +83,11 @@ DualSetAssociativeArray::DualSetAssociativeArray(Output* dbg, unsigned int lineS
         cacheNumSets_   = cacheNumLines_ / cacheAssociativity_;
         dataLines_.resize(cacheNumLines_);
         for (unsigned int i = 0; i < cacheNumLines_; i++) {
-            dataLines_[i] = new DataLine(lineSize_, i, dbg_);
+            dataLines_[i] = new DataLine(lineSize_, i, dbg_, zeroLine_, timingOnly_);
         }
 
-        dirSetStates    = new State[dirAssociativity];
-        dirSetSharers   = new unsigned int[dirAssociativity];
-        dirSetOwned     = new bool[dirAssociativity];
-        cacheSetStates  = new State[cacheAssociativity];
-        cacheSetSharers = new unsigned int[cacheAssociativity];
-        cacheSetOwned   = new bool[cacheAssociativity];
+        cacheSetStates      = new State[cacheAssociativity];
+        cacheSetCoherence   = new uint8_t[cacheAssociativity];
     }
 
 
@@ -115,20 +95,16 @@ CacheArray::CacheLine* DualSetAssociativeArray::lookup(const Addr baseAddr, bool
     Addr lineAddr = toLineAddr(baseAddr);
     int set = hash_->hash(0, lineAddr) % numSets_;
     int setBegin = set * associativity_;
-    int setEnd = setBegin + associativity_;
    
-    for (int i = setBegin; i < setEnd; i++) {
-        if (lines_[i]->getBaseAddr() == baseAddr) {
-            if (update) {
-                replacementMgr_->update(i);
-                if (lines_[i]->getDataLine() != NULL) {
-                    cacheReplacementMgr_->update(lines_[i]->getDataLine()->getIndex());
-                }
-            }
-            return lines_[i];
+    int i = findTag(setBegin, baseAddr);
+    if (i < 0) return nullptr;
+    if (update) {
+        replacementMgr_->update(i);
+        if (lines_[i]->getDataLine() != NULL) {
+            cacheReplacementMgr_->update(lines_[i]->getDataLine()->getIndex());
         }
     }
-    return nullptr;
+    return lines_[i];
 }
 
 CacheArray::CacheLine * DualSetAssociativeArray::findReplacementCandidate(const Addr baseAddr, bool cache) {
@@ -152,12 +128,7 @@ unsigned int DualSetAssociativeArray::preReplaceDir(const Addr baseAddr) {
     int set         = hash_->hash(0, lineAddr) % numSets_;
     int setBegin    = set * associativity_;
     
-    for (unsigned int id = 0; id < associativity_; id++) {
-        dirSetStates[id]    = lines_[id+setBegin]->getState();
-        dirSetSharers[id]   = lines_[id+setBegin]->numSharers();
-        dirSetOwned[id]     = lines_[id+setBegin]->ownerExists();
-    }
-    return replacementMgr_->findBestCandidate(setBegin, dirSetStates, dirSetSharers, dirSetOwned, sharersAware_);
+    return replacementMgr_->findBestCandidate(setBegin, &states_[setBegin], &coherence_[setBegin], sharersAware_);
 }
 
 void DualSetAssociativeArray::replace(const Addr baseAddr, CacheArray::CacheLine * candidate, CacheArray::DataLine * dataCandidate) {
@@ -169,6 +140,7 @@ void DualSetAssociativeArray::replace(const Addr baseAddr, CacheArray::CacheLine
         }
         candidate->reset();
         candidate->setBaseAddr(baseAddr);
+        replacementMgr_->inserted(index, baseAddr);
         replacementMgr_->update(index); 
     } else {
         unsigned int dIndex = dataCandidate->getIndex();
@@ -179,6 +151,7 @@ void DualSetAssociativeArray::replace(const Addr baseAddr, CacheArray::CacheLine
         }
         dataCandidate->setDirLine(candidate); // set new dir->data link
         candidate->setDataLine(dataCandidate);
+        cacheReplacementMgr_->inserted(dIndex, candidate->getBaseAddr());
         cacheReplacementMgr_->update(dIndex);
     }
 }
@@ -191,16 +164,14 @@ unsigned int DualSetAssociativeArray::preReplaceCache(const Addr baseAddr) {
     for (unsigned int id = 0; id < cacheAssociativity_; id++) {
         int dirIndex = dataLines_[id+setBegin]->getDirLine() ? dataLines_[id+setBegin]->getDirLine()->getIndex() : -1;
         if (dirIndex == -1) {
-            cacheSetStates[id] = I;
-            cacheSetSharers[id] = 0;
-            cacheSetOwned[id] = false;
+            cacheSetStates[id]      = I;
+            cacheSetCoherence[id]   = 0;
         } else {
-            cacheSetStates[id]  = lines_[dirIndex]->getState();
-            cacheSetSharers[id] = lines_[dirIndex]->numSharers();
-            cacheSetOwned[id]   = lines_[dirIndex]->ownerExists();
+            cacheSetStates[id]      = states_[dirIndex];
+            cacheSetCoherence[id]   = coherence_[dirIndex];
         }
     }
-    return cacheReplacementMgr_->findBestCandidate(setBegin, cacheSetStates, cacheSetSharers, cacheSetOwned, sharersAware_);
+    return cacheReplacementMgr_->findBestCandidate(setBegin, cacheSetStates, cacheSetCoherence, sharersAware_);
 }
 
 void DualSetAssociativeArray::deallocateCache(unsigned int index) {
@@ -209,7 +180,173 @@ void DualSetAssociativeArray::deallocateCache(unsigned int index) {
 }
 
 
+void SetAssociativeArray::saveData(SnapshotWriter &out) {
+    if (timingOnly_) return;
+    for (unsigned int i = 0; i < numLines_; i++) {
+        if (!lines_[i]->inTransition() && states_[i] != I) out.write(lines_[i]->getData()->data(), lineSize_);   // Same lines saveSnapshot keeps valid
+    }
+}
+
+void SetAssociativeArray::loadData(SnapshotCursor &in, bool hasData) {
+    for (unsigned int i = 0; i < numLines_ && hasData; i++) {
+        if (states_[i] == I) continue;
+        const uint8_t * data = in.skip(lineSize_);
+        if (!data || timingOnly_) continue;
+        SharedPayload payload;
+        payload.assign(data, lineSize_);
+        lines_[i]->setData(payload, 0);
+    }
+}
+
+void DualSetAssociativeArray::saveData(SnapshotWriter &out) {
+    out.write((uint32_t)cacheNumLines_);
+    for (unsigned int i = 0; i < cacheNumLines_; i++) {
+        CacheLine * dirLine = dataLines_[i]->getDirLine();
+        if (dirLine && (dirLine->inTransition() || !dirLine->valid())) dirLine = nullptr;   // Saved as invalid, so the data goes too
+        out.write((int32_t)(dirLine ? dirLine->getIndex() : -1));
+        if (dirLine && !timingOnly_) out.write(dataLines_[i]->getData()->data(), lineSize_);
+    }
+}
+
+void DualSetAssociativeArray::loadData(SnapshotCursor &in, bool hasData) {
+    if (in.read<uint32_t>() != cacheNumLines_)
+        dbg_->fatal(CALL_INFO, -1, "Error: snapshot data array size does not match this cache's. Lines: %u\n", cacheNumLines_);
+    for (unsigned int i = 0; i < cacheNumLines_ && in.good(); i++) {
+        int32_t dirIndex = in.read<int32_t>();
+        if (dirIndex < 0) continue;
+        if ((unsigned int)dirIndex >= numLines_ || states_[dirIndex] == I)
+            dbg_->fatal(CALL_INFO, -1, "Error: snapshot data line %u maps to invalid directory line %d\n", i, dirIndex);
+        dataLines_[i]->setDirLine(lines_[dirIndex]);
+        lines_[dirIndex]->setDataLine(dataLines_[i]);
+        if (!hasData) continue;
+        const uint8_t * data = in.skip(lineSize_);
+        if (!data || timingOnly_) continue;
+        SharedPayload payload;
+        payload.assign(data, lineSize_);
+        dataLines_[i]->setData(payload, 0);
+    }
+}
+
+void DualSetAssociativeArray::saveReplacement(SnapshotWriter &out, const std::string &name) {
+    CacheArray::saveReplacement(out, name);
+    out.beginSection(SnapshotSection::Replacement, name + ".data");
+    cacheReplacementMgr_->save(out);
+    out.endSection();
+}
+
+bool DualSetAssociativeArray::loadReplacement(const SnapshotReader &in, const std::string &name) {
+    SnapshotCursor cursor;
+    bool dirRestored = CacheArray::loadReplacement(in, name);
+    return in.find(SnapshotSection::Replacement, name + ".data", cursor) && cacheReplacementMgr_->load(cursor) && dirRestored;
+}
+
+
 /* Cache Array Class */
+
+/* 
+ * Snapshot layout: geometry, the sharer names the ids below refer to, every line's tag and state,
+ * then owner and sharers for each valid line, followed by the array type's data. Only stable states
+ * are saved: tags stay put so lookups behave the same, but lines in transition come back invalid.
+ * Locks, atomics and send timestamps are not saved.
+ */
+uint64_t CacheArray::saveSnapshot(SnapshotWriter &out, const std::string &name) {
+    uint64_t transient = 0;
+
+    out.beginSection(SnapshotSection::CacheArray, name);
+    out.write((uint32_t)numLines_);
+    out.write((uint32_t)associativity_);
+    out.write((uint32_t)lineSize_);
+    out.write((uint8_t)!timingOnly_);
+
+    out.write((uint32_t)sharerTable_.size());
+    for (unsigned int id = 0; id < sharerTable_.size(); id++)
+        out.writeString(sharerTable_.getName(id));
+
+    out.write(tags_.data(), numLines_ * sizeof(Addr));
+    for (unsigned int i = 0; i < numLines_; i++) {
+        uint8_t state = lines_[i]->inTransition() ? (uint8_t)I : (uint8_t)states_[i];
+        if (state != states_[i]) transient++;
+        out.write(state);
+    }
+
+    for (unsigned int i = 0; i < numLines_; i++) {
+        CacheLine * line = lines_[i];
+        if (line->inTransition() || !line->valid()) continue;
+        out.write((int32_t)(line->ownerExists() ? sharerTable_.findId(line->getOwner()) : -1));
+        out.write((uint32_t)line->numSharers());
+        for (CacheLine::SharerIterator it = line->sharersBegin(); it != line->sharersEnd(); ++it)
+            out.write((uint32_t)sharerTable_.findId(*it));
+    }
+
+    saveData(out);
+    out.endSection();
+
+    saveReplacement(out, name);
+    return transient;
+}
+
+bool CacheArray::loadSnapshot(const SnapshotReader &in, const std::string &name) {
+    SnapshotCursor cursor;
+    if (!in.find(SnapshotSection::CacheArray, name, cursor))
+        dbg_->fatal(CALL_INFO, -1, "Error: snapshot has no cache array for '%s'\n", name.c_str());
+
+    uint32_t numLines = cursor.read<uint32_t>();
+    uint32_t associativity = cursor.read<uint32_t>();
+    uint32_t lineSize = cursor.read<uint32_t>();
+    bool hasData = cursor.read<uint8_t>();
+    if (numLines != numLines_ || associativity != associativity_ || lineSize != lineSize_)
+        dbg_->fatal(CALL_INFO, -1, "Error: snapshot of '%s' was taken with a different geometry. Snapshot: %u lines, %u ways, %uB lines. This cache: %u lines, %u ways, %uB lines.\n",
+                name.c_str(), numLines, associativity, lineSize, numLines_, associativity_, lineSize_);
+    if (!hasData && !timingOnly_)
+        dbg_->fatal(CALL_INFO, -1, "Error: snapshot of '%s' was taken in timing-only mode and has no data to restore into a cache that holds data\n", name.c_str());
+
+    vector<EndpointId> names(cursor.read<uint32_t>());
+    for (unsigned int id = 0; id < names.size(); id++)
+        names[id] = EndpointNames::intern(cursor.readString());
+
+    const uint8_t * tags = cursor.skip(numLines_ * sizeof(Addr));
+    const uint8_t * states = cursor.skip(numLines_);
+    if (!cursor.good())
+        dbg_->fatal(CALL_INFO, -1, "Error: snapshot of '%s' is truncated\n", name.c_str());
+    memcpy(tags_.data(), tags, numLines_ * sizeof(Addr));
+
+    for (unsigned int i = 0; i < numLines_; i++) {
+        CacheLine * line = lines_[i];
+        line->reset();
+        line->setState((State)states[i]);
+        if (!line->valid()) continue;
+
+        int32_t owner = cursor.read<int32_t>();
+        uint32_t numSharers = cursor.read<uint32_t>();
+        if (owner >= (int32_t)names.size() || numSharers > names.size()) 
+            dbg_->fatal(CALL_INFO, -1, "Error: snapshot of '%s' is corrupt, line %u has an unknown owner or too many sharers\n", name.c_str(), i);
+        if (owner >= 0) line->setOwner(names[owner]);
+        for (uint32_t j = 0; j < numSharers; j++) {
+            uint32_t id = cursor.read<uint32_t>();
+            if (id >= names.size())
+                dbg_->fatal(CALL_INFO, -1, "Error: snapshot of '%s' is corrupt, line %u has an unknown sharer\n", name.c_str(), i);
+            line->addSharer(names[id]);
+        }
+    }
+
+    loadData(cursor, hasData);   // Timing-only arrays skip over the snapshot's data
+    if (!cursor.good() || !cursor.atEnd())
+        dbg_->fatal(CALL_INFO, -1, "Error: snapshot of '%s' is truncated or corrupt\n", name.c_str());
+
+    return loadReplacement(in, name);
+}
+
+void CacheArray::saveReplacement(SnapshotWriter &out, const std::string &name) {
+    out.beginSection(SnapshotSection::Replacement, name);
+    replacementMgr_->save(out);
+    out.endSection();
+}
+
+bool CacheArray::loadReplacement(const SnapshotReader &in, const std::string &name) {
+    SnapshotCursor cursor;
+    return in.find(SnapshotSection::Replacement, name, cursor) && replacementMgr_->load(cursor);
+}
+
 void CacheArray::printConfiguration() {
     dbg_->debug(_INFO_, "Sets: %d \n", numSets_);
     dbg_->debug(_INFO_, "Lines: %d \n", numLines_);
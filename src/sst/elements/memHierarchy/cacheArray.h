@@ -21,8 +21,15 @@
 #define CACHEARRAY_H
 
 #include <vector>
+#include <set>
+#include <unordered_map>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #include "memTypes.h"
+#include "sharedPayload.h"
+#include "snapshot.h"
 #include "hash.h"
 #include "sst/core/output.h"
 #include "util.h"
@@ -46,23 +53,25 @@ public:
         const int index_;
         Output * dbg_;
 
-        vector<uint8_t> data_;
+        SharedPayload data_;            // Starts out sharing the array's zero line
+        const bool timingOnly_;         // Timing-only: data_ is never written
         CacheArray::CacheLine * dirLine_;
     public:
-        DataLine(unsigned int size, int index, Output * dbg) : size_(size), index_(index), dbg_(dbg), dirLine_(nullptr) {
-            data_.resize(size_/sizeof(uint8_t));
-        }
+        DataLine(unsigned int size, int index, Output * dbg, const SharedPayload &zeroLine, bool timingOnly) : size_(size), index_(index), dbg_(dbg), 
+                data_(zeroLine), timingOnly_(timingOnly), dirLine_(nullptr) { }
 
 
         // Data getter/setter
-        vector<uint8_t>* getData() { return &data_; }
+        const SharedPayload* getData() { return &data_; }
 
-        void setData(vector<uint8_t> data, uint32_t offset) {
-            std::copy(data.begin(), data.end(), data_.begin() + offset);
+        void setData(const SharedPayload &data, uint32_t offset) {
+            if (timingOnly_) return;
             if (data.size() + offset > size_) { // TODO can we remove this check somehow?
                 dbg_->fatal(CALL_INFO, -1, "Error: Cacheline write exceeds line size. Size: %" PRIu32 ", Offset: %" PRIu32 ", Write size: %zu\n",
                         size_, offset, data.size());
             }
+            if (offset == 0 && data.size() == size_) data_ = data;  // Whole line: share the bytes
+            else data_.write(data.get(), offset);
         }
 
         // dirIndex getter/setter
@@ -74,17 +83,55 @@ public:
     };
 
 
+    /* 
+     * Sharer table - maps the endpoint IDs of upper level caches to dense per-array bit indices.
+     * Lines track sharers/owners by bit index so that each line only needs a bitmask instead of a set of names.
+     * Endpoint IDs are themselves small dense integers, so the lookup is a vector index rather than a hash.
+     * Names known at setup are registered in sorted order so that iterating over a line's sharers visits them
+     * in the same order as the name-ordered sets used previously.
+     */
+    class SharerTable {
+    private:
+        vector<int> bits_;              // Endpoint ID -> bit index, -1 if not registered
+        vector<EndpointId> endpoints_;  // Bit index -> endpoint ID
+    public:
+        /** Lookup an endpoint's bit index, assigning a new one if the endpoint has not been seen */
+        int getId(EndpointId endpoint) {
+            if (endpoint >= bits_.size()) bits_.resize(endpoint + 1, -1);
+            if (bits_[endpoint] < 0) {
+                bits_[endpoint] = endpoints_.size();
+                endpoints_.push_back(endpoint);
+            }
+            return bits_[endpoint];
+        }
+        /** Lookup an endpoint's bit index without assigning one. Returns -1 if the endpoint has not been seen */
+        int findId(EndpointId endpoint) const {
+            return (endpoint < bits_.size()) ? bits_[endpoint] : -1;
+        }
+        /** Lookup the endpoint for a bit index */
+        EndpointId getEndpoint(int id) const { return endpoints_[id]; }
+        /** Lookup the name for a bit index */
+        const std::string& getName(int id) const { return EndpointNames::name(endpoints_[id]); }
+        /** Number of endpoints registered */
+        unsigned int size() const { return endpoints_.size(); }
+    };
+
+
     /* Cache line type - didn't bother splitting into different types (L1/lower-level/dir) because space overhead is small */
     class CacheLine {
     protected:
         const uint32_t      size_;
         const int           index_;
         Output *            dbg_;
+        SharerTable *       sharerTable_;
         
-        Addr                baseAddr_;
-        State               state_;
-        set<std::string>    sharers_;
-        std::string         owner_;
+        Addr &              baseAddr_;      // Lives in CacheArray::tags_ so lookups scan a contiguous array
+        State &             state_;         // Lives in CacheArray::states_
+        uint8_t &           coherence_;     // Lives in CacheArray::coherence_, mirrors numSharers_ != 0 and owner_ >= 0
+        uint64_t            sharers_;       // Bitmask of sharer ids < 64
+        vector<uint64_t>    sharersExt_;    // Bitmask of sharer ids >= 64, only allocated if there are that many sharers
+        unsigned int        numSharers_;
+        int                 owner_;         // Owner id, -1 if no owner
         
         uint64_t            lastSendTimestamp_; // Use to force sequential timing for subsequent accesses to the line
 
@@ -97,20 +144,72 @@ public:
         DataLine * dataLine_;
 
         /* Cache specific */
-        vector<uint8_t> data_;
+        SharedPayload data_;            // Starts out sharing the array's zero line
+        const bool timingOnly_;         // Timing-only: data_ is never written
+
+        /** Return the first sharer id >= id, or -1 if there is none */
+        int nextSharer(int id) const {
+            unsigned int word = id >> 6;
+            uint64_t bits;
+            while (true) {
+                if (word == 0) bits = sharers_;
+                else if (word - 1 < sharersExt_.size()) bits = sharersExt_[word - 1];
+                else return -1;
+                bits &= ~(uint64_t)0 << (id & 63);
+                if (bits) return (word << 6) + __builtin_ctzll(bits);
+                word++;
+                id = word << 6;
+            }
+        }
+
+        bool testSharer(int id) const {
+            if (id < 64) return (sharers_ >> id) & 1;
+            unsigned int word = (id >> 6) - 1;
+            return word < sharersExt_.size() && ((sharersExt_[word] >> (id & 63)) & 1);
+        }
+
+        void clearSharers() {
+            sharers_ = 0;
+            sharersExt_.clear();
+            numSharers_ = 0;
+            coherence_ &= ~ReplacementMgr::HAS_SHARERS;
+        }
+
+        void setOwnerId(int id) {
+            owner_ = id;
+            if (id < 0) coherence_ &= ~ReplacementMgr::OWNED;
+            else coherence_ |= ReplacementMgr::OWNED;
+        }
 
     public:
-        CacheLine (unsigned int size, int index, Output * dbg, bool cache) : size_(size), index_(index), dbg_(dbg), baseAddr_(0), state_(I) {
+        /** Iterate over the endpoint IDs of a line's sharers, in bit index order */
+        class SharerIterator {
+        private:
+            const CacheLine * line_;
+            int id_;
+        public:
+            SharerIterator(const CacheLine * line, int id) : line_(line), id_(id) { }
+            EndpointId operator*() const { return line_->sharerTable_->getEndpoint(id_); }
+            SharerIterator& operator++() { id_ = line_->nextSharer(id_ + 1); return *this; }
+            bool operator==(const SharerIterator &other) const { return id_ == other.id_; }
+            bool operator!=(const SharerIterator &other) const { return id_ != other.id_; }
+        };
+
+        CacheLine (unsigned int size, int index, Output * dbg, SharerTable * sharerTable, Addr &tag, State &state, uint8_t &coherence, bool cache, 
+                const SharedPayload &zeroLine, bool timingOnly) : size_(size), index_(index), dbg_(dbg), sharerTable_(sharerTable), baseAddr_(tag), state_(state), 
+                coherence_(coherence), timingOnly_(timingOnly) {
+            baseAddr_ = 0;
+            coherence_ = 0;
             reset();
-            if (cache) data_.resize(size_/sizeof(uint8_t));
+            if (cache) data_ = zeroLine;
         }
         
         virtual ~CacheLine() {}
 
         void reset() {
             state_ = I;
-            sharers_.clear();
-            owner_.clear();
+            clearSharers();
+            setOwnerId(-1);
             
             lastSendTimestamp_      = 0;
 
@@ -139,8 +238,8 @@ public:
             state_ = state; 
             if (state == I) {
                 clearAtomics();
-                sharers_.clear();
-                owner_.clear();
+                clearSharers();
+                setOwnerId(-1);
             }
         }
 
@@ -152,40 +251,57 @@ public:
         bool valid() { return state_ != I; }
 
         /** Getter for sharer field - return whether sharer field is empty */
-        bool isShareless() { return sharers_.empty(); }
-        /** Getter for sharer field */
-        set<std::string>* getSharers() { return &sharers_; }
+        bool isShareless() { return numSharers_ == 0; }
+        /** Getter for sharer field - iterator to first sharer */
+        SharerIterator sharersBegin() const { return SharerIterator(this, nextSharer(0)); }
+        /** Getter for sharer field - iterator past last sharer */
+        SharerIterator sharersEnd() const { return SharerIterator(this, -1); }
         /** Getter for sharer field - return number of sharers in set*/
-        unsigned int numSharers() { return sharers_.size(); }
+        unsigned int numSharers() { return numSharers_; }
         
         /** Getter for sharer field - return whether a particular sharer exists in the set*/
-        bool isSharer(std::string name) { 
-            if (name.empty()) return false; 
-            return sharers_.find(name) != sharers_.end(); 
+        bool isSharer(EndpointId sharer) { 
+            if (sharer == NO_ENDPOINT || numSharers_ == 0) return false; 
+            int id = sharerTable_->findId(sharer);
+            return id >= 0 && testSharer(id);
         }
         
         /** Setter for sharer field - remove a specific sharer */
-        void removeSharer(std::string name) {
-            if(name.empty()) return;
-            if (sharers_.find(name) == sharers_.end()) 
-                dbg_->fatal(CALL_INFO, -1, "Error: cannot remove sharer '%s', not a current sharer. Addr = 0x%" PRIx64 "\n", name.c_str(), baseAddr_);
-            sharers_.erase(name);        
+        void removeSharer(EndpointId sharer) {
+            if (sharer == NO_ENDPOINT) return;
+            int id = sharerTable_->findId(sharer);
+            if (id < 0 || !testSharer(id)) 
+                dbg_->fatal(CALL_INFO, -1, "Error: cannot remove sharer '%s', not a current sharer. Addr = 0x%" PRIx64 "\n", 
+                        EndpointNames::name(sharer).c_str(), baseAddr_);
+            if (id < 64) sharers_ &= ~((uint64_t)1 << id);
+            else sharersExt_[(id >> 6) - 1] &= ~((uint64_t)1 << (id & 63));
+            if (--numSharers_ == 0) coherence_ &= ~ReplacementMgr::HAS_SHARERS;
         }
     
         /** Setter for sharer field - add a specific sharer */
-        void addSharer(std::string name) {
-            if (name.empty()) return;
-            sharers_.insert(name);
+        void addSharer(EndpointId sharer) {
+            if (sharer == NO_ENDPOINT) return;
+            int id = sharerTable_->getId(sharer);
+            if (testSharer(id)) return;
+            if (id < 64) {
+                sharers_ |= (uint64_t)1 << id;
+            } else {
+                unsigned int word = (id >> 6) - 1;
+                if (word >= sharersExt_.size()) sharersExt_.resize(word + 1, 0);
+                sharersExt_[word] |= (uint64_t)1 << (id & 63);
+            }
+            numSharers_++;
+            coherence_ |= ReplacementMgr::HAS_SHARERS;
         }
 
         /** Setter for owner field */
-        void setOwner(std::string owner) { owner_ = owner; }
-        /** Getter for owner field */
-        std::string getOwner() { return owner_; }
+        void setOwner(EndpointId owner) { setOwnerId(owner == NO_ENDPOINT ? -1 : sharerTable_->getId(owner)); }
+        /** Getter for owner field - NO_ENDPOINT if there is no owner */
+        EndpointId getOwner() { return (owner_ < 0) ? NO_ENDPOINT : sharerTable_->getEndpoint(owner_); }
         /** Setter for owner field - clear field */
-        void clearOwner() { owner_.clear(); }
+        void clearOwner() { setOwnerId(-1); }
         /** Getter for owner field - return whether field is set */
-        bool ownerExists() { return !owner_.empty(); }
+        bool ownerExists() { return owner_ >= 0; }
 
         /** Setter for timestamp field */
         void setTimestamp(uint64_t timestamp) { lastSendTimestamp_ = timestamp; }
@@ -224,15 +340,17 @@ public:
         
         /***** Cache specific fields *****/
         /** Getter for cache line data */
-        vector<uint8_t>* getData() { return &data_; }
+        const SharedPayload* getData() { return &data_; }
 
-        /** Setter for cache line data - write only specified bits*/
-        void setData(vector<uint8_t> data, uint32_t offset) {
-            std::copy(data.begin(), data.end(), data_.begin() + offset);
+        /** Setter for cache line data - write only specified bits. No-op in timing-only arrays */
+        void setData(const SharedPayload &data, uint32_t offset) {
+            if (timingOnly_) return;
             if (data.size() + offset > size_) { // TODO can we remove this check somehow?
                 dbg_->fatal(CALL_INFO, -1, "Error: Cacheline write exceeds line size. Size: %" PRIu32 ", Offset: %" PRIu32 ", Write size: %zu\n",
                         size_, offset, data.size());
             }
+            if (offset == 0 && data.size() == size_) data_ = data;  // Whole line: share the bytes
+            else data_.write(data.get(), offset);
         }
 
         /***** Dir specific fields *****/
@@ -245,6 +363,7 @@ public:
 
     typedef CacheArray::CacheLine CacheLine;
     typedef CacheArray::DataLine DataLine;
+    typedef CacheArray::SharerTable SharerTable;
 
     /** Function returns the cacheline tag's ID if its valid (-1 if unvalid).
         If updateReplacement is set, the replacement stats are updated */
@@ -258,6 +377,9 @@ public:
 
     /** Get line size.  Should not change at runtime */
     Addr getLineSize() { return lineSize_; }
+
+    /** Get number of lines */
+    unsigned int getNumLines() { return numLines_; }
     
     /** Drop block offset bits (ie. log2(lineSize) */
     Addr toLineAddr(Addr addr) { return (Addr) ((addr >> lineOffset_) / slices_); }
@@ -274,6 +396,12 @@ public:
     }
 
     vector<CacheLine *> lines_;
+    vector<Addr>        tags_;      // Base address of each line, indexed like lines_ so each set is contiguous
+    vector<State>       states_;    // State of each line, indexed like lines_
+    vector<uint8_t>     coherence_; // ReplacementMgr::HAS_SHARERS | OWNED for each line, indexed like lines_
+
+    /** Whether lines store data or only timing state */
+    bool isTimingOnly() const { return timingOnly_; }
     void setSliceAware(unsigned int numSlices) {
         slices_ = numSlices;
     }
@@ -282,6 +410,21 @@ public:
         banks_ = numBanks;
     }
 
+    /** Register the names of the endpoints that may become sharers/owners of lines in this array */
+    void registerSharers(const std::set<std::string> &names) {
+        for (std::set<std::string>::const_iterator it = names.begin(); it != names.end(); it++)
+            sharerTable_.getId(EndpointNames::intern(*it));
+    }
+
+    /** Snapshot tags, stable states, sharers/owners, data and replacement state under 'name'. 
+     *  Lines in transition are saved as invalid; returns how many there were */
+    uint64_t saveSnapshot(SnapshotWriter &out, const std::string &name);
+
+    /** Restore a snapshot saved by an array of the same geometry. Sharer names must already be registered.
+     *  Returns false if replacement state was not restored (e.g., the policy differs), in which case 
+     *  replacement starts from its initial state */
+    bool loadSnapshot(const SnapshotReader &in, const std::string &name);
+
 private:
     void printConfiguration();
     void errorChecking();
@@ -299,20 +442,53 @@ protected:
     bool            sharersAware_;
     unsigned int    slices_;    // Both slices are banks_ are banks; slices_ are external to this cache array, banks_ are internal
     unsigned int    banks_;
+    SharerTable     sharerTable_;
+    bool            timingOnly_;
+    SharedPayload   zeroLine_;  // Every line's initial data. In timing-only arrays it is the only data storage
+
+    /* Snapshot hooks for the parts that differ between array types */
+    virtual void saveData(SnapshotWriter &out) = 0;
+    virtual void loadData(SnapshotCursor &in, bool hasData) = 0;
+    virtual void saveReplacement(SnapshotWriter &out, const std::string &name);
+    virtual bool loadReplacement(const SnapshotReader &in, const std::string &name);
+
+    /** Return the index of the line in the set starting at setBegin whose tag is baseAddr, or -1 */
+    int findTag(unsigned int setBegin, Addr baseAddr) const {
+        const Addr * tags = &tags_[setBegin];
+#ifdef __AVX2__
+        if ((associativity_ & 3) == 0) {
+            __m256i key = _mm256_set1_epi64x((long long)baseAddr);
+            for (unsigned int i = 0; i < associativity_; i += 4) {
+                __m256i cmp = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + i)), key);
+                int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+                if (mask) return setBegin + i + __builtin_ctz(mask);
+            }
+            return -1;
+        }
+#endif
+        for (unsigned int i = 0; i < associativity_; i++) {
+            if (tags[i] == baseAddr) return setBegin + i;
+        }
+        return -1;
+    }
 
     CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, unsigned int lineSize,
-               ReplacementMgr* replacementMgr, HashFunction* hash, bool sharersAware, bool cache) : dbg_(dbg), 
+               ReplacementMgr* replacementMgr, HashFunction* hash, bool sharersAware, bool cache, bool timingOnly) : dbg_(dbg), 
                numLines_(numLines), associativity_(associativity), lineSize_(lineSize),
-               replacementMgr_(replacementMgr), hash_(hash) {
+               replacementMgr_(replacementMgr), hash_(hash), timingOnly_(timingOnly) {
         dbg_->debug(_INFO_,"--------------------------- Initializing [Set Associative Cache Array]... \n");
         numSets_    = numLines_ / associativity_;
         lineOffset_ = log2Of(lineSize_);
         lines_.resize(numLines_);
+        tags_.resize(numLines_, 0);     // Lines hold references into these, they must not be resized after this
+        states_.resize(numLines_, I);
+        coherence_.resize(numLines_, 0);
         slices_ = 1;
         banks_ = 1;
+        zeroLine_.assign(lineSize_, 0);
 
         for (unsigned int i = 0; i < numLines_; i++) {
-            lines_[i] = new CacheLine(lineSize_, i, dbg_, cache);
+            lines_[i] = new CacheLine(lineSize_, i, dbg_, &sharerTable_, tags_[i], states_[i], coherence_[i], cache, zeroLine_, timingOnly_);
         }
 
         printConfiguration();
@@ -329,7 +505,7 @@ class SetAssociativeArray : public CacheArray {
 public:
 
     SetAssociativeArray(Output* dbg, unsigned int numLines, unsigned int lineSize, unsigned int associativity,
-                        ReplacementMgr* rp, HashFunction* hf, bool sharersAware);
+                        ReplacementMgr* rp, HashFunction* hf, bool sharersAware, bool timingOnly);
     
 
     ~SetAssociativeArray();
@@ -339,9 +515,10 @@ public:
     void replace(Addr baseAddr, CacheLine * candidate_id, DataLine * dataCandidate);
     unsigned int preReplace(Addr baseAddr);
     void deallocate(unsigned int index);
-    State * setStates;
-    unsigned int * setSharers;
-    bool * setOwned;
+
+protected:
+    void saveData(SnapshotWriter &out);
+    void loadData(SnapshotCursor &in, bool hasData);
 };
 
 /*
@@ -354,7 +531,7 @@ public:
 class DualSetAssociativeArray : public CacheArray {
 public:
     DualSetAssociativeArray(Output * dbg, unsigned int lineSize, HashFunction * hf, bool sharersAware, unsigned int dirNumLines, unsigned int dirAssociativity, ReplacementMgr* dirRp, 
-            unsigned int cacheNumLines, unsigned int cacheAssociativity, ReplacementMgr * cacheRp);
+            unsigned int cacheNumLines, unsigned int cacheAssociativity, ReplacementMgr * cacheRp, bool timingOnly);
 
     CacheLine * lookup(Addr baseAddr, bool updateReplacement);
     CacheLine * findReplacementCandidate(Addr baseAddr, bool cache);
@@ -364,12 +541,14 @@ public:
     void deallocateCache(unsigned int index);
     
     vector<DataLine*> dataLines_;
-    State * dirSetStates;
-    unsigned int * dirSetSharers;
-    bool * dirSetOwned;
-    State * cacheSetStates;
-    unsigned int * cacheSetSharers;
-    bool * cacheSetOwned;
+    State * cacheSetStates;         // Data lines map to arbitrary directory lines, so their set's metadata is gathered here
+    uint8_t * cacheSetCoherence;
+
+protected:
+    void saveData(SnapshotWriter &out);
+    void loadData(SnapshotCursor &in, bool hasData);
+    void saveReplacement(SnapshotWriter &out, const std::string &name);
+    bool loadReplacement(const SnapshotReader &in, const std::string &name);
 
 private:
     /* For our separate data cache */
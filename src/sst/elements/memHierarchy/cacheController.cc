@@ -110,7 +110,7 @@ void Cache::processCacheRequest(MemEvent* event, Command cmd, Addr baseAddr, boo
         }
 
         // Forward instead of allocating for non-inclusive caches
-        vector<uint8_t> * data = &event->getPayload();
+        const SharedPayload * data = &event->getSharedPayload();
         coherenceMgr_->forwardMessage(event, baseAddr, event->getSize(), 0, data); // Event to forward, address, requested size, data (if any)
         event->setInProgress(true);
         return;
@@ -119,7 +119,7 @@ void Cache::processCacheRequest(MemEvent* event, Command cmd, Addr baseAddr, boo
     line = cacheArray_->lookup(baseAddr, false);
 
     // Special case -> allocate line for prefetches to non-inclusive caches
-    bool localPrefetch = event->isPrefetch() && event->getRqstr() == getName();
+    bool localPrefetch = event->isPrefetch() && event->getRqstrId() == nameId_;
     if (type_ == "noninclusive_with_directory" && localPrefetch && line->getDataLine() == NULL && line->getState() == I) {
         if (!allocateDirCacheLine(event, baseAddr, line, false)) {
             if (is_debug_addr(baseAddr)) d_->debug(_L3_, "-- Data Cache Miss --\n");
@@ -356,11 +356,12 @@ bool Cache::allocateLine(MemEvent * event, Addr baseAddr) {
             return false;
         }
         
-        CacheAction action = coherenceMgr_->handleEviction(replacementLine, this->getName(), false);
+        CacheAction action = coherenceMgr_->handleEviction(replacementLine, nameId_, false);
         if (action == STALL) {
             mshr_->insertPointer(replacementLine->getBaseAddr(), event->getBaseAddr());
             return false;
         }
+        prefetchLineEvicted(replacementLine->getBaseAddr());
     }
 
     /* OK to replace line */
@@ -383,11 +384,12 @@ bool Cache::allocateCacheLine(MemEvent* event, Addr baseAddr) {
             return false;
         }
         
-        CacheAction action = coherenceMgr_->handleEviction(replacementLine, this->getName(), false);
+        CacheAction action = coherenceMgr_->handleEviction(replacementLine, nameId_, false);
         if (action == STALL) {
             mshr_->insertPointer(replacementLine->getBaseAddr(), event->getBaseAddr());
             return false;
         }
+        prefetchLineEvicted(replacementLine->getBaseAddr());
     }
     
     /* OK to replace line  */
@@ -415,7 +417,8 @@ bool Cache::allocateDirCacheLine(MemEvent * event, Addr baseAddr, CacheLine * di
             mshr_->insertPointer(replacementDirLine->getBaseAddr(), baseAddr);
             return false;
         }
-        coherenceMgr_->handleEviction(replacementDirLine, this->getName(), true);
+        coherenceMgr_->handleEviction(replacementDirLine, nameId_, true);
+        prefetchLineEvicted(replacementDirLine->getBaseAddr());
     }
 
     cacheArray_->replace(baseAddr, dirLine, replacementDataLine);
@@ -613,7 +616,7 @@ void Cache::postRequestProcessing(MemEvent* event, CacheLine* cacheLine, bool re
     Addr addr   = event->getBaseAddr();
 
     /* Clean up */
-    if (event->isPrefetch() && event->getRqstr() == this->getName() && !replay) {
+    if (event->isPrefetch() && event->getRqstrId() == nameId_ && !replay) {
         statPrefetchHit->addData(1);
     }
     recordLatency(event);
@@ -710,9 +713,9 @@ void Cache::printLine(Addr addr) {
         State state = (line == nullptr) ? NP : line->getState();
         bool isCached = (line == nullptr) ? false : (line->getDataLine() != NULL);
         unsigned int sharers = (line == nullptr) ? 0 : line->numSharers();
-        string owner = (line == nullptr) ? "" : line->getOwner();
+        EndpointId owner = (line == nullptr) ? NO_ENDPOINT : line->getOwner();
         d_->debug(_L8_, "0x%" PRIx64 ": %s, %u, \"%s\" %d\n", 
-                addr, StateString[state], sharers, owner.c_str(), isCached); 
+                addr, StateString[state], sharers, EndpointNames::name(owner).c_str(), isCached); 
     } else if (L1_) {
         CacheLine * line = cacheArray_->lookup(addr, false);
         State state = (line == nullptr) ? NP : line->getState();
@@ -721,8 +724,8 @@ void Cache::printLine(Addr addr) {
         CacheLine * line = cacheArray_->lookup(addr, false);
         State state = (line == nullptr) ? NP : line->getState();
         unsigned int sharers = (line == NULL) ? 0 : line->numSharers();
-        string owner = (line == NULL) ? "" : line->getOwner();
-        d_->debug(_L8_, "0x%" PRIx64 ": %s, %u, \"%s\"\n", addr, StateString[state], sharers, owner.c_str());
+        EndpointId owner = (line == NULL) ? NO_ENDPOINT : line->getOwner();
+        d_->debug(_L8_, "0x%" PRIx64 ": %s, %u, \"%s\"\n", addr, StateString[state], sharers, EndpointNames::name(owner).c_str());
     }
 }
 
@@ -38,6 +38,7 @@
 #include "coherencemgr/coherenceController.h"
 #include "util.h"
 #include "cacheListener.h"
+#include "prefetchIssueQueue.h"
 #include "memLinkBase.h"
 #include <string>
 #include <sstream>
@@ -68,12 +69,12 @@ public:
             {"cache_line_size",         "(uint) Size of a cache line (aka cache block) in bytes.", "64"},
             {"hash_function",           "(int) 0 - none (default), 1 - linear, 2 - XOR", "0"},
             {"coherence_protocol",      "(string) Coherence protocol. Options: MESI, MSI, NONE", "MESI"},
-            {"replacement_policy",      "(string) Replacement policy of the cache array. Options:  LRU[least-recently-used], LFU[least-frequently-used], Random, MRU[most-recently-used], or NMRU[not-most-recently-used]. ", "lru"},
+            {"replacement_policy",      "(string) Replacement policy of the cache array. Options:  LRU[least-recently-used], LFU[least-frequently-used], Random, MRU[most-recently-used], NMRU[not-most-recently-used], SRRIP[static re-reference interval prediction], BRRIP[bimodal RRIP], DRRIP[set-dueling SRRIP/BRRIP], or SHiP[signature-based hit prediction, by memory region]. ", "lru"},
             {"cache_type",              "(string) - Cache type. Options: inclusive cache ('inclusive', required for L1s), non-inclusive cache ('noninclusive') or non-inclusive cache with a directory ('noninclusive_with_directory', required for non-inclusive caches with multiple upper level caches directly above them),", "inclusive"},
             {"max_requests_per_cycle",  "(int) Maximum number of requests to accept per cycle. 0 or negative is unlimited.", "-1"},
-            {"request_link_width",      "(string) Limits number of request bytes sent per cycle. Use 'B' units. '0B' is unlimited.", "0B"},
-            {"response_link_width",     "(string) Limits number of response bytes sent per cycle. Use 'B' units. '0B' is unlimited.", "0B"},
-            {"noninclusive_directory_repl",    "(string) If non-inclusive directory exists, its replacement policy. LRU, LFU, MRU, NMRU, or RANDOM. (not case-sensitive).", "LRU"},
+            {"request_link_width",      "(string) Limits number of request bytes sent per cycle in each direction (e.g., GetS down, Inv up). Use 'B' units. '0B' is unlimited.", "0B"},
+            {"response_link_width",     "(string) Limits number of response bytes sent per cycle in each direction (e.g., GetSResp up, AckInv down). Use 'B' units. '0B' is unlimited.", "0B"},
+            {"noninclusive_directory_repl",    "(string) If non-inclusive directory exists, its replacement policy. LRU, LFU, MRU, NMRU, RANDOM, SRRIP, BRRIP, DRRIP, or SHiP. (not case-sensitive).", "LRU"},
             {"noninclusive_directory_entries", "(uint) Number of entries in the directory. Must be at least 1 if the non-inclusive directory exists.", "0"},
             {"noninclusive_directory_associativity", "(uint) For a set-associative directory, number of ways.", "1"},
             {"mshr_num_entries",        "(int) Number of MSHR entries. Not valid for L1s because L1 MSHRs assumed to be sized for the CPU's load/store queue. Setting this to -1 will create a very large MSHR.", "-1"},
@@ -85,6 +86,10 @@ public:
             {"prefetch_delay_cycles",   "(uint) Delay prefetches from prefetcher by this number of cycles.", "1"},
             {"max_outstanding_prefetch","(uint) Maximum number of prefetch misses that can be outstanding, additional prefetches will be dropped/NACKed. Default is 1/2 of MSHR entries.", "0.5*mshr_num_entries"},
             {"drop_prefetch_mshr_level","(uint) Drop/NACK prefetches if the number of in-use mshrs is greater than or equal to this number. Default is mshr_num_entries - 2.", "mshr_num_entries-2"},
+            {"prefetch_queue_depth",    "(uint) Queue up to this many prefetches while the cache is busy instead of dropping them; duplicates and prefetches to lines already present or in the MSHR are filtered. When full, the oldest prefetch is dropped. 0 issues or drops each prefetch on arrival.", "0"},
+            {"prefetch_issue_rate",     "(uint) Maximum prefetches issued from the prefetch queue per cycle. Demand requests take priority within max_requests_per_cycle.", "1"},
+            {"prefetch_throttle",       "(bool) Throttle prefetching using accuracy and lateness feedback (FDP). Scales max_outstanding_prefetch by a level between 1/5 and 5/5.", "false"},
+            {"prefetch_throttle_interval", "(uint) Number of issued prefetches per throttling interval.", "512"},
             {"num_cache_slices",        "(uint) For a distributed, shared cache, total number of cache slices", "1"},
             {"slice_id",                "(uint) For distributed, shared caches, unique ID for this cache slice", "0"},
             {"slice_allocation_policy", "(string) Policy for allocating addresses among distributed shared cache. Options: rr[round-robin]", "rr"},
@@ -96,6 +101,13 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"timing_only",             "(bool) Model timing only: cache lines hold no data and events carry payload sizes but no payload bytes. Data seen by the CPU is meaningless.", "false"},
+            {"event_pool_stats",        "(bool) Record the process-wide MemEvent/MemEventInit pool statistics (EventPool_*) at finish. If several caches set this, only the first one constructed in each process registers them.", "false"},
+            {"warmup_requests",         "(uint) L1 only. Handle this many CPU requests in functional warmup mode, then switch to detailed timing. During warmup, requests are answered at once and only update tag, coherence and replacement state at the last cache level (and the directory, if any). Data returned during warmup is meaningless. 0 disables unless warmup_end_addr is set.", "0"},
+            {"warmup_end_addr",         "(uint) L1 only. End functional warmup when a CPU request to this address's line arrives (e.g., a marker the application or generator touches at the region of interest). The marker request is handled in detailed mode.", ""},
+            {"snapshot_save",           "(string) Write this cache's tags, coherence state, data and replacement state to this file. Use a separate file for each component.", ""},
+            {"snapshot_save_time",      "(string) Simulated time at which to write the snapshot, e.g., '1ms'. The memory system should be quiescent then: lines in transition are saved as invalid. If not set, the snapshot is written at the end of simulation.", ""},
+            {"snapshot_load",           "(string) Restore this cache's state from a snapshot file at setup. The cache must have the geometry the snapshot was taken with.", ""},
             /* Old parameters - deprecated or moved */
             {"LL",                          "DEPRECATED - Now auto-detected during init."}, // Remove 8.0
             {"LLC",                         "DEPRECATED - Now auto-detected by configure."}, // Remove 8.0
@@ -138,9 +150,17 @@ public:
             {"TotalNoncacheableEventsReceived", "Total number of non-cache or noncacheable cache events that were received by this cache and forward", "events", 1},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle", "events", 1},
             {"Bank_conflicts",          "Total number of bank conflicts detected", "count", 1},
+            {"Warmup_requests",         "Number of functional warmup requests handled or forwarded by this cache", "events", 1},
+            {"Warmup_installs",         "Number of lines installed by functional warmup", "events", 1},
+            {"Warmup_drops",            "Number of functional warmup requests that could not install a line (victim busy or shared, or directory refused)", "events", 1},
             {"Prefetch_requests",       "Number of prefetches received from prefetcher at this cache", "events", 1},
             {"Prefetch_hits",           "Number of prefetches that were cancelled due to cache or MSHR hit", "events", 1},
             {"Prefetch_drops",          "Number of prefetches that were cancelled because the cache was too busy or too many prefetches were outstanding", "events", 1},
+            {"Prefetch_issued",         "Number of prefetches that missed and were issued by this cache", "events", 1},
+            {"Prefetch_useful",         "Number of issued prefetches later accessed by a demand request (accuracy = useful/issued, coverage = useful/(useful + demand misses))", "events", 1},
+            {"Prefetch_late",           "Number of useful prefetches whose miss was still outstanding at the demand access", "events", 1},
+            {"Prefetch_unused",         "Number of issued prefetches evicted before any demand access", "events", 1},
+            {"Prefetch_throttle_level", "Prefetch throttle level (1-5) at the end of each cycle with queued prefetches", "level", 2},
             /* Coherence events - break down GetS between S/E */
             {"SharedReadResponse",      "Coherence: Received shared response to a GetS request", "count", 2},
             {"ExclusiveReadResponse",   "Coherence: Received exclusive response to a GetS request", "count", 2},
@@ -156,12 +176,15 @@ public:
             {"FetchInv_recv",           "Event received: FetchInv", "count", 2},
             {"FetchInvX_recv",          "Event received: FetchInvX", "count", 2},
             {"Inv_recv",                "Event received: Inv", "count", 2},
-            {"NACK_recv",               "Event: NACK received", "count", 2})
+            {"NACK_recv",               "Event: NACK received", "count", 2},
+            /* MemEvent pools - process-wide, only registered if 'event_pool_stats' is set, at one cache per process */
+            {"EventPool_blocks",        "Event pools: number of MemEvent and MemEventInit blocks carved from slabs", "count", 5},
+            {"EventPool_allocs",        "Event pools: number of MemEvent and MemEventInit allocations served by the pools", "count", 5},
+            {"EventPool_outstanding",   "Event pools: number of MemEvents and MemEventInits still allocated at finish", "count", 5})
 
 /* Class definition */ 
     typedef CacheArray::CacheLine           CacheLine;
     typedef CacheArray::DataLine            DataLine;
-    typedef map<Addr, mshrEntry>            mshrTable;
     typedef unsigned int                    uint;
     typedef uint64_t                        uint64;
 
@@ -207,6 +230,30 @@ private:
     
     /** Self-Event prefetch handler for this component */
     void processPrefetchEvent(SST::Event *event);
+
+    /** Functional warmup: answer a CPU request immediately and warm the levels below */
+    void processWarmupAccess(MemEvent *event);
+
+    /** Functional warmup: install a line at the last cache level or pass the request down */
+    void processWarmRequest(MemEvent *event);
+
+    /** Functional warmup: directory's answer to a warm request */
+    void processWarmResponse(MemEvent *event);
+
+    /** Write the cache's state to 'snapshot_save' */
+    void saveSnapshot();
+
+    /** Self-event handler for 'snapshot_save_time' */
+    void handleSnapshotEvent(SST::Event *event);
+
+    /** Issue queued prefetches while request slots and MSHR room allow */
+    void issuePrefetches();
+
+    /** Whether a prefetch to this line would be redundant: present in the cache or outstanding in the MSHR */
+    bool prefetchRedundant(Addr baseAddr);
+
+    /** Record prefetch feedback for a line leaving the cache */
+    void prefetchLineEvicted(Addr baseAddr);
     
     /** Function processes incomming access requests from HiLv$ or the CPU
         It appropriately redirects requests to Top and/or Bottom controllers.  */
@@ -233,7 +280,7 @@ private:
 
     /** Function attempts to send all responses for previous events that 'blocked' due to an outstanding request.
         If response blocks cache line the remaining responses go to MSHR till new outstanding request finishes  */
-    inline void activatePrevEvents(Addr baseAddr);
+    void activatePrevEvents(Addr baseAddr);
 
     /** This function re-processes a signle previous request.  In hardware, the MSHR would be looked up,
         the MSHR entry would be modified and the response would be sent directly without reading the cache
@@ -328,6 +375,16 @@ private:
     std::string             type_;
     CoherenceProtocol       protocol_;
     bool                    L1_;
+    bool                    eventPoolStats_;        // Whether to register/record MemEvent pool statistics
+    bool                    timingOnly_;            // Whether events are made dataless on arrival
+    bool                    warmup_;                // Whether CPU requests are being handled in functional warmup mode
+    uint64_t                warmupRemaining_;       // Warmup requests left, 0 if warmup only ends at warmupEndAddr_
+    bool                    warmupEndAddrSet_;
+    Addr                    warmupEndAddr_;         // Line address whose access ends warmup
+    std::string             snapshotSave_;          // Snapshot file to write, empty if none
+    std::string             snapshotLoad_;          // Snapshot file to restore at setup, empty if none
+    Link*                   snapshotLink_;          // Self link that fires at snapshot_save_time
+    bool                    snapshotSaved_;
     bool                    allNoncacheableRequests_;
     SimTime_t               maxWaitTime_;
     unsigned int            maxBytesUpPerCycle_;
@@ -338,6 +395,7 @@ private:
     int                     dropPrefetchLevel_;
     int                     maxOutstandingPrefetch_;
     SimTime_t               prefetchDelay_;
+    int                     prefetchIssueRate_;
     int                     maxRequestsPerCycle_;
 
     /* Cache structures */
@@ -346,6 +404,7 @@ private:
     MemLinkBase*            linkUp_;
     MemLinkBase*            linkDown_;
     Link*                   prefetchLink_;
+    PrefetchIssueQueue      prefetchQueue_;
     Link*                   maxWaitSelfLink_;
     MSHR*                   mshr_;
     CoherenceController*    coherenceMgr_;
@@ -362,7 +421,8 @@ private:
     vector<string>          upperLevelCacheNames_;
     uint64_t                timestamp_;
     int                     requestsThisCycle_;
-    std::map<SST::Event::id_type, std::string> responseDst_; 
+    EndpointId              nameId_;        // Interned getName(), compared against event sources/requestors
+    std::map<SST::Event::id_type, EndpointId> responseDst_; 
     std::queue<MemEventBase*>       requestBuffer_;                 // Buffer requests that can't be processed due to port limits
     std::vector< std::queue<MemEventBase*> > bankConflictBuffer_;   // Buffer requests that have bank conflicts
     std::map<MemEvent*,uint64>      startTimeList_;
@@ -373,6 +433,7 @@ private:
     bool                    isLL;
     bool                    lowerIsNoninclusive;
     bool                    expectWritebackAcks;
+    bool                    lowerIsCache;           // Whether warm requests pass through to another cache level
 
     /* Performance enhancement: turn clocks off when idle */
     bool                    clockIsOn_;                 // Tell us whether clock is on or off
@@ -422,10 +483,25 @@ private:
     Statistic<uint64_t>* statMSHROccupancy;
     Statistic<uint64_t>* statBankConflicts;
 
+    // MemEvent pool statistics
+    Statistic<uint64_t>* statEventPoolBlocks;
+    Statistic<uint64_t>* statEventPoolAllocs;
+    Statistic<uint64_t>* statEventPoolOutstanding;
+
+    // Functional warmup statistics
+    Statistic<uint64_t>* statWarmupRequests;
+    Statistic<uint64_t>* statWarmupInstalls;
+    Statistic<uint64_t>* statWarmupDrops;
+
     // Prefetch statistics
     Statistic<uint64_t>* statPrefetchRequest;
     Statistic<uint64_t>* statPrefetchHit;
     Statistic<uint64_t>* statPrefetchDrop;
+    Statistic<uint64_t>* statPrefetchIssued;
+    Statistic<uint64_t>* statPrefetchUseful;
+    Statistic<uint64_t>* statPrefetchLate;
+    Statistic<uint64_t>* statPrefetchUnused;
+    Statistic<uint64_t>* statPrefetchThrottleLevel;
 };
 
 
@@ -454,7 +530,7 @@ private:
         - MSHR:  Class that represents a hardware Miss Status Handling Register (or Miss Status Holding
         Register).  Noncacheable requests use a separate MSHR for simplicity.
 
-        The MSHR is a map of <addr, vector<UNION(event, addr pointer)> >. 
+        The MSHR is a hash table of <addr, vector<UNION(event, addr pointer)> >. 
         Why a UNION(event, addr pointer)?  Upon receiving a miss request, all cache line replacement candidates 
         might be in transition, regardless of the replacement policy and associativity used.  
         In this case the MSHR stores a pointer in the MSHR entry.  When a replacement candidate is NO longer in
@@ -488,6 +564,19 @@ private:
     (closer to the CPU) has a block and thus may prefetch blocks that are already present in their hierarchy. The lower-level caches are not designed
     to deal with this. Prefetch also does not currently work alongside shared, sliced caches as prefetches generated at one cache are not neccessarily
     for blocks mapped to that cache.
+    Prefetches a prefetcher emits wait in a bounded issue queue when 'prefetch_queue_depth' is set and are issued as
+    request slots and MSHR room allow, behind demand requests. Issued prefetches are tracked for accuracy and lateness
+    statistics, which optionally throttle how many prefetch misses may be outstanding ('prefetch_throttle').
+
+    Functional warmup ('warmup_requests', 'warmup_end_addr' on L1s) fast-forwards to a region of interest. The L1 answers CPU
+    requests immediately and sends them down flagged F_WARMUP. Caches with another cache below pass these through; the last
+    cache level installs the line without fetching data (E/M above memory). Above a directory, the line is reserved in IS and
+    the directory either records the cache as a sharer and grants S, or refuses. Only the last level keeps warmed lines, so
+    upper levels start cold and no sharer/owner state has to be reconciled when detailed timing begins.
+
+    Snapshots ('snapshot_save', 'snapshot_load') let many runs start from one warmed state. Caches, directories and memory
+    controllers each write their state to their own file at 'snapshot_save_time' or at the end of simulation and restore it
+    at setup. Save all components of a hierarchy at the same, quiescent point so that sharer and owner state stays consistent.
  
     Key notes:
         - The cache supports hardware "locking" (GetSX command), and atomics-based requests (LLSC, GetS with 
@@ -221,6 +221,10 @@ bool Cache::processEvent(MemEventBase* ev, bool replay) {
     }
     bool noncacheable = ev->queryFlag(MemEvent::F_NONCACHEABLE);
 
+    // Drop any payload bytes on arrival, only their size matters in timing-only mode
+    if (timingOnly_ && MemEventTypeArr[(int)ev->getCmd()] == MemEventType::Cache) {
+        static_cast<MemEvent*>(ev)->setDataless();
+    }
 
     if (MemEventTypeArr[(int)ev->getCmd()] != MemEventType::Cache || noncacheable) {
         statNoncacheableEventsReceived->addData(1);
@@ -238,6 +242,25 @@ bool Cache::processEvent(MemEventBase* ev, bool replay) {
         d_->fatal(CALL_INFO, -1, "%s, Base address is not a multiple of line size! Line size: %" PRIu64 ". Event: %s\n", getName().c_str(), cacheArray_->getLineSize(), ev->getVerboseString().c_str());
     }
     
+    // Functional warmup events bypass banks, ports and MSHRs
+    if (event->queryFlag(MemEvent::F_WARMUP)) {
+        if (BasicCommandClassArr[(int)cmd] == BasicCommandClass::Request) processWarmRequest(event);
+        else processWarmResponse(event);
+        return true;
+    }
+
+    if (warmup_ && !replay && (cmd == Command::GetS || cmd == Command::GetX || cmd == Command::GetSX) 
+            && !(event->isPrefetch() && event->getRqstrId() == nameId_)) {
+        bool marker = warmupEndAddrSet_ && baseAddr == warmupEndAddr_;
+        if (!marker) {
+            processWarmupAccess(event);
+            if (warmupRemaining_ == 0 || --warmupRemaining_ > 0) return true;
+        }
+        warmup_ = false;
+        d_->verbose(CALL_INFO, 1, 0, "%s: Functional warmup done at %" PRIu64 "ns. Switching to detailed timing.\n", getName().c_str(), getCurrentSimTimeNano());
+        if (!marker) return true;  // The marker request itself is handled in detailed mode
+    }
+    
     // Check bank free before we do anything
     if (bankStatus_.size() > 0) {
         Addr bank = cacheArray_->getBank(event->getBaseAddr());
@@ -285,9 +308,18 @@ bool Cache::processEvent(MemEventBase* ev, bool replay) {
             
             profileEvent(event, cmd, replay, canStall);
             
+            // Prefetch feedback: first demand access to a prefetched line
+            if (!replay && !(event->isPrefetch() && event->getRqstrId() == nameId_)) {
+                bool outstanding = mshr_->isHit(baseAddr);
+                if (prefetchQueue_.demand(baseAddr, outstanding)) {
+                    statPrefetchUseful->addData(1);
+                    if (outstanding) statPrefetchLate->addData(1);
+                }
+            }
+
             if (mshr_->isHit(baseAddr) && canStall) {
                 // Drop local prefetches if there are outstanding requests for the same address NOTE this includes replacements/inv/etc.
-                if (event->isPrefetch() && event->getRqstr() == this->getName()) {
+                if (event->isPrefetch() && event->getRqstrId() == nameId_) {
                     statPrefetchDrop->addData(1);
                     delete event;
                     break;
@@ -361,11 +393,11 @@ bool Cache::processEvent(MemEventBase* ev, bool replay) {
 void Cache::processNoncacheable(MemEventBase* event) {
     if (CommandCPUSide[(int)event->getCmd()]) {
         if (!(event->queryFlag(MemEvent::F_NORESPONSE))) {
-            responseDst_.insert(std::make_pair(event->getID(), event->getSrc()));
+            responseDst_.insert(std::make_pair(event->getID(), event->getSrcId()));
         }
         coherenceMgr_->forwardTowardsMem(event);
     } else {
-        std::map<SST::Event::id_type,std::string>::iterator it = responseDst_.find(event->getResponseToID());
+        std::map<SST::Event::id_type,EndpointId>::iterator it = responseDst_.find(event->getResponseToID());
         if (it == responseDst_.end()) {
             d_->fatal(CALL_INFO, 01, "%s, Error: noncacheable response received does not match a request. Event: (%s). Time: %" PRIu64 "\n",
                     getName().c_str(), event->getVerboseString().c_str(), getCurrentSimTimeNano());
@@ -384,7 +416,7 @@ void Cache::handlePrefetchEvent(SST::Event* ev) {
 void Cache::processPrefetchEvent(SST::Event* ev) {
     MemEvent* event = static_cast<MemEvent*>(ev);
     event->setBaseAddr(toBaseAddr(event->getAddr()));
-    event->setRqstr(this->getName());
+    event->setRqstr(nameId_);
 
     if (!clockIsOn_) {
         Cycle_t time = reregisterClock(defaultTimeBase_, clockHandler_); 
@@ -401,10 +433,33 @@ void Cache::processPrefetchEvent(SST::Event* ev) {
     // Record received prefetch
     statPrefetchRequest->addData(1);
 
+    // Queue prefetch to issue as resources allow, filtering ones that would be cancelled anyway
+    if (prefetchQueue_.enabled()) {
+        Addr baseAddr = event->getBaseAddr();
+        if (event->getCmd() == Command::NULLCMD) {
+            statPrefetchDrop->addData(1);
+            delete event;
+        } else if (prefetchQueue_.queued(baseAddr) || prefetchRedundant(baseAddr)) {
+            statPrefetchHit->addData(1);
+            delete event;
+        } else {
+            MemEvent* dropped = prefetchQueue_.push(event);
+            if (dropped) {
+                statPrefetchDrop->addData(1);
+                delete dropped;
+            }
+        }
+        return;
+    }
+
     // Drop prefetch if we can't handle it immediately or handling it would violate maxOustandingPrefetch or dropPrefetchLevel
     if (requestsThisCycle_ != maxRequestsPerCycle_) {
-        if (event->getCmd() != Command::NULLCMD && mshr_->getSize() < dropPrefetchLevel_ && mshr_->getPrefetchCount() < maxOutstandingPrefetch_) { 
+        if (event->getCmd() != Command::NULLCMD && mshr_->getSize() < dropPrefetchLevel_ && mshr_->getPrefetchCount() < prefetchQueue_.scaleOutstanding(maxOutstandingPrefetch_)) { 
             requestsThisCycle_++;
+            if (!prefetchRedundant(event->getBaseAddr())) {
+                statPrefetchIssued->addData(1);
+                prefetchQueue_.issued(event->getBaseAddr());
+            }
             processEvent(event, false);
         } else {
             statPrefetchDrop->addData(1);
@@ -417,6 +472,141 @@ void Cache::processPrefetchEvent(SST::Event* ev) {
 }
 
 
+/* Functional warmup at the L1: the CPU gets an immediate response and the request continues down as a warm request */
+void Cache::processWarmupAccess(MemEvent * event) {
+    MemEvent * responseEvent = event->makeResponse();
+    if (event->getCmd() == Command::GetX) {
+        if (event->isStoreConditional()) responseEvent->setSuccess(true);
+        responseEvent->setSize(event->getSize());
+    } else {
+        responseEvent->setZeroPayload(event->getSize());
+    }
+    coherenceMgr_->forwardTowardsCPU(responseEvent, event->getSrcId());
+
+    event->setFlag(MemEvent::F_WARMUP);
+    event->setPayload(0, nullptr);
+    processWarmRequest(event);
+}
+
+
+/* 
+ * Functional warmup request. Only the last cache level keeps warmed lines, so nothing above it needs to be tracked
+ * as a sharer or owner. Lines are installed without data. If the victim is busy or has sharers, the request is dropped.
+ */
+void Cache::processWarmRequest(MemEvent * event) {
+    statWarmupRequests->addData(1);
+    if (lowerIsCache) {
+        coherenceMgr_->forwardTowardsMem(event);
+        return;
+    }
+
+    Addr baseAddr = event->getBaseAddr();
+    bool write = event->getCmd() != Command::GetS;
+    
+    // Cache+directory arrays allocate data lines separately and are not warmed; incoherent caches cannot take a grant from a directory
+    if (type_ == "noninclusive_with_directory" || (!isLL && protocol_ == CoherenceProtocol::NONE) || mshr_->isHit(baseAddr)) {
+        statWarmupDrops->addData(1);
+        delete event;
+        return;
+    }
+    
+    CacheLine * line = cacheArray_->lookup(baseAddr, true);
+    if (line != nullptr && line->valid()) {
+        if (write && line->getState() == E) line->setState(M);
+        delete event;
+        return;
+    }
+
+    if (line == nullptr) {
+        CacheLine * victim = cacheArray_->findReplacementCandidate(baseAddr, true);
+        if (victim->valid()) {
+            Addr victimAddr = victim->getBaseAddr();
+            if (victim->inTransition() || victim->isLocked() || victim->numSharers() > 0 || victim->ownerExists() || mshr_->isHit(victimAddr)
+                    || coherenceMgr_->handleEviction(victim, nameId_, false) != DONE) {
+                statWarmupDrops->addData(1);
+                delete event;
+                return;
+            }
+            prefetchLineEvicted(victimAddr);
+        }
+        cacheArray_->replace(baseAddr, victim);
+        line = victim;
+    }
+
+    if (isLL) {
+        line->setState(write ? M : (protocol_ == CoherenceProtocol::MSI ? S : E));
+        statWarmupInstalls->addData(1);
+        delete event;
+    } else {
+        // Directory below: hold the line until the directory records us as a sharer
+        line->setState(IS);
+        event->setCmd(Command::GetS);
+        coherenceMgr_->forwardTowardsMem(event);
+    }
+}
+
+
+void Cache::processWarmResponse(MemEvent * event) {
+    Addr baseAddr = event->getBaseAddr();
+    CacheLine * line = cacheArray_->lookup(baseAddr, false);
+    if (line != nullptr && line->getState() == IS) {
+        if (event->success()) {
+            line->setState(S);
+            statWarmupInstalls->addData(1);
+        } else {
+            line->setState(I);
+            statWarmupDrops->addData(1);
+        }
+    }
+    delete event;
+    activatePrevEvents(baseAddr);   // Requests that arrived while the line was reserved
+}
+
+
+bool Cache::prefetchRedundant(Addr baseAddr) {
+    if (mshr_->isHit(baseAddr)) return true;
+    CacheLine * line = cacheArray_->lookup(baseAddr, false);
+    if (line == nullptr || line->getState() == I) return false;
+    return type_ != "noninclusive_with_directory" || line->getDataLine() != nullptr;
+}
+
+
+void Cache::issuePrefetches() {
+    int maxOutstanding = prefetchQueue_.scaleOutstanding(maxOutstandingPrefetch_);
+    int issued = 0;
+    while (!prefetchQueue_.empty() && issued < prefetchIssueRate_ && requestsThisCycle_ < maxRequestsPerCycle_) {
+        MemEvent * event = prefetchQueue_.front();
+        Addr baseAddr = event->getBaseAddr();
+        
+        // Line may have arrived or been requested while the prefetch waited
+        if (prefetchRedundant(baseAddr)) {
+            prefetchQueue_.pop();
+            statPrefetchHit->addData(1);
+            delete event;
+            continue;
+        }
+        
+        if (mshr_->getSize() >= dropPrefetchLevel_ || (int)mshr_->getPrefetchCount() >= maxOutstanding)
+            break;
+
+        prefetchQueue_.pop();
+        statPrefetchIssued->addData(1);
+        prefetchQueue_.issued(baseAddr);
+        requestsThisCycle_++;
+        issued++;
+        if (!processEvent(event, false))
+            requestBuffer_.push(event);
+    }
+    statPrefetchThrottleLevel->addData(prefetchQueue_.level());
+}
+
+
+void Cache::prefetchLineEvicted(Addr baseAddr) {
+    if (prefetchQueue_.evicted(baseAddr))
+        statPrefetchUnused->addData(1);
+}
+
+
 
 void Cache::init(unsigned int phase) {
     if (linkUp_ == linkDown_) {
@@ -437,6 +627,9 @@ void Cache::init(unsigned int phase) {
                 if (eventC->getType() != Endpoint::Memory) { // All other types do coherence
                     isLL = false;
                 }
+                if (eventC->getType() == Endpoint::Cache) {
+                    lowerIsCache = true;
+                }
                 if (!eventC->getInclusive()) {
                     lowerIsNoninclusive = true; // TODO better checking if multiple caches below us
                 }
@@ -481,6 +674,9 @@ void Cache::init(unsigned int phase) {
                 if (eventC->getType() != Endpoint::Memory) { // All other types to coherence
                     isLL = false;
                 }
+                if (eventC->getType() == Endpoint::Cache) {
+                    lowerIsCache = true;
+                }
                 if (!eventC->getInclusive()) {
                     lowerIsNoninclusive = true; // TODO better checking if multiple caches below us
                 }
@@ -518,6 +714,13 @@ void Cache::setup() {
     if (names->empty()) 
         d_->fatal(CALL_INFO, -1,"%s did not find any sources\n", getName().c_str());
 
+    // Give each source a dense id so that cache lines can track sharers/owners as bitmasks
+    std::set<std::string> sharerNames;
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = names->begin(); it != names->end(); it++) {
+        if (!it->name.empty()) sharerNames.insert(it->name);
+    }
+    cacheArray_->registerSharers(sharerNames);
+
     names = linkDown_->getDests();
     if (names->empty()) {
         std::set<MemLinkBase::EndpointInfo> dstNames;
@@ -549,11 +752,55 @@ void Cache::setup() {
     if (linkUp_ != linkDown_) linkDown_->setup();
 
     coherenceMgr_->setupLowerStatus(isLL, expectWritebackAcks, lowerIsNoninclusive);
+
+    // Restore a snapshot now that sharer names are registered
+    if (!snapshotLoad_.empty()) {
+        SnapshotReader snapshot;
+        if (!snapshot.open(snapshotLoad_))
+            d_->fatal(CALL_INFO, -1, "%s, Error: unable to load snapshot '%s': %s\n", getName().c_str(), snapshotLoad_.c_str(), snapshot.error().c_str());
+        if (!cacheArray_->loadSnapshot(snapshot, getName())) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.output("%s, Warning: snapshot '%s' has no replacement state for this cache's replacement policy. Replacement state starts cold.\n", 
+                    getName().c_str(), snapshotLoad_.c_str());
+        }
+    }
+    if (snapshotLink_) snapshotLink_->send(1, NULL);
+}
+
+
+void Cache::handleSnapshotEvent(SST::Event * event) {
+    saveSnapshot();
+}
+
+
+void Cache::saveSnapshot() {
+    SnapshotWriter snapshot;
+    if (!snapshot.open(snapshotSave_))
+        d_->fatal(CALL_INFO, -1, "%s, Error: unable to open snapshot file '%s' for writing\n", getName().c_str(), snapshotSave_.c_str());
+    uint64_t transient = cacheArray_->saveSnapshot(snapshot, getName());
+    if (!snapshot.close())
+        d_->fatal(CALL_INFO, -1, "%s, Error: failed writing snapshot file '%s'\n", getName().c_str(), snapshotSave_.c_str());
+    snapshotSaved_ = true;
+
+    if (transient != 0) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.output("%s, Warning: %" PRIu64 " lines were in transition when the snapshot was written at %" PRIu64 "ns and were saved as invalid.\n",
+                getName().c_str(), transient, getCurrentSimTimeNano());
+    }
 }
 
 
 void Cache::finish() {
+    if (eventPoolStats_) {
+        MemEventPool<MemEvent>::Stats poolStats = MemEventPool<MemEvent>::getStats();
+        MemEventPool<MemEventInit>::Stats initPoolStats = MemEventPool<MemEventInit>::getStats();
+        statEventPoolBlocks->addData(poolStats.blocks + initPoolStats.blocks);
+        statEventPoolAllocs->addData(poolStats.allocs + initPoolStats.allocs);
+        statEventPoolOutstanding->addData(poolStats.outstanding + initPoolStats.outstanding);
+    }
+
     listener_->printStats(*d_);
+    if (!snapshotSave_.empty() && !snapshotSaved_) saveSnapshot();
     delete cacheArray_;
     delete d_;
 }
@@ -639,6 +886,13 @@ bool Cache::clockTick(Cycle_t time) {
         }
         requestBuffer_.swap(tmpBuffer);
     }
+    
+    // Issue queued prefetches with any request slots demand requests left over
+    if (!prefetchQueue_.empty()) {
+        issuePrefetches();
+        if (!prefetchQueue_.empty()) queuesEmpty = false;
+    }
+    
     // Disable lower-level cache clocks if they're idle
     if (queuesEmpty && nicIdle && clockIsOn_ && !conflicts) {
         clockIsOn_ = false;
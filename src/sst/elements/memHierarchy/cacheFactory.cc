@@ -46,6 +46,8 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
     
     d2_ = new Output();
     d2_->init("", params.find<int>("debug_level", 1), 0,(Output::output_location_t)params.find<int>("debug", SST::Output::NONE));
+
+    nameId_ = EndpointNames::intern(getName());
     
     /* Debug filtering */
     std::vector<Addr> addrArr;
@@ -115,6 +117,8 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
     
     allNoncacheableRequests_    = params.find<bool>("force_noncacheable_reqs", false);
     maxRequestsPerCycle_        = params.find<int>("max_requests_per_cycle",-1);
+    eventPoolStats_             = params.find<bool>("event_pool_stats", false);
+    timingOnly_                 = params.find<bool>("timing_only", false);
     string packetSize           = params.find<std::string>("min_packet_size", "8B");
 
     UnitAlgebra packetSize_ua(packetSize);
@@ -127,6 +131,29 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
     }
     requestsThisCycle_ = 0;
 
+    /* Functional warmup */
+    warmupRemaining_            = params.find<uint64_t>("warmup_requests", 0);
+    warmupEndAddr_              = params.find<Addr>("warmup_end_addr", 0, warmupEndAddrSet_);
+    warmupEndAddr_              = toBaseAddr(warmupEndAddr_);
+    warmup_                     = warmupRemaining_ > 0 || warmupEndAddrSet_;
+    if (warmup_ && !L1_)
+        d_->fatal(CALL_INFO, -1, "%s, Invalid param: warmup_requests/warmup_end_addr - functional warmup is controlled by L1 caches only. Set these on the L1s.\n", getName().c_str());
+
+    /* Snapshots */
+    snapshotSave_               = params.find<std::string>("snapshot_save", "");
+    snapshotLoad_               = params.find<std::string>("snapshot_load", "");
+    std::string snapshotTime    = params.find<std::string>("snapshot_save_time", "");
+    snapshotLink_ = nullptr;
+    if (!snapshotTime.empty()) {
+        UnitAlgebra snapshotTime_ua(snapshotTime);
+        if (!snapshotTime_ua.hasUnits("s"))
+            d_->fatal(CALL_INFO, -1, "%s, Invalid param: snapshot_save_time - must have units of time (s). Ex: '1ms'. SI units are ok. You specified '%s'\n", getName().c_str(), snapshotTime.c_str());
+        if (snapshotSave_.empty())
+            d_->fatal(CALL_INFO, -1, "%s, Invalid param: snapshot_save_time - snapshot_save must also be set to the file to write the snapshot to\n", getName().c_str());
+        snapshotLink_ = configureSelfLink("Snapshot", snapshotTime, new Event::Handler<Cache>(this, &Cache::handleSnapshotEvent));
+    }
+    snapshotSaved_ = false;
+
     /* Configure links */
     configureLinks(params);
 
@@ -144,6 +171,7 @@ void Cache::createCoherenceManager(Params &params) {
     isLL = true;
     lowerIsNoninclusive = false;
     expectWritebackAcks = false;
+    lowerIsCache = false;
     Params coherenceParams;
     coherenceParams.insert("debug_level", params.find<std::string>("debug_level", "1"));
     coherenceParams.insert("debug", params.find<std::string>("debug", "0"));
@@ -157,6 +185,7 @@ void Cache::createCoherenceManager(Params &params) {
     coherenceParams.insert("request_link_width", params.find<std::string>("request_link_width", "0B"));
     coherenceParams.insert("response_link_width", params.find<std::string>("response_link_width", "0B"));
     coherenceParams.insert("min_packet_size", params.find<std::string>("min_packet_size", "8B"));
+    coherenceParams.insert("timing_only", params.find<std::string>("timing_only", "false"));
 
     if (!L1_) {
         if (protocol_ != CoherenceProtocol::NONE) {
@@ -364,6 +393,24 @@ void Cache::createPrefetcher(Params &params, int mshrSize) {
         statPrefetchRequest         = registerStatistic<uint64_t>("Prefetch_requests");
         statPrefetchHit             = registerStatistic<uint64_t>("Prefetch_hits");
         statPrefetchDrop            = registerStatistic<uint64_t>("Prefetch_drops");
+        statPrefetchIssued          = registerStatistic<uint64_t>("Prefetch_issued");
+        statPrefetchUseful          = registerStatistic<uint64_t>("Prefetch_useful");
+        statPrefetchLate            = registerStatistic<uint64_t>("Prefetch_late");
+        statPrefetchUnused          = registerStatistic<uint64_t>("Prefetch_unused");
+        statPrefetchThrottleLevel   = registerStatistic<uint64_t>("Prefetch_throttle_level");
+
+        // Configure the prefetch issue queue and feedback tracking
+        int queueDepth              = params.find<int>("prefetch_queue_depth", 0);
+        prefetchIssueRate_          = params.find<int>("prefetch_issue_rate", 1);
+        bool throttle               = params.find<bool>("prefetch_throttle", false);
+        uint64_t throttleInterval   = params.find<uint64_t>("prefetch_throttle_interval", 512);
+        if (queueDepth < 0)
+            d_->fatal(CALL_INFO, -1, "%s, Invalid param: prefetch_queue_depth - must be at least 0. You specified %d\n", getName().c_str(), queueDepth);
+        if (prefetchIssueRate_ < 1)
+            d_->fatal(CALL_INFO, -1, "%s, Invalid param: prefetch_issue_rate - must be at least 1. You specified %d\n", getName().c_str(), prefetchIssueRate_);
+        if (throttle && throttleInterval == 0)
+            d_->fatal(CALL_INFO, -1, "%s, Invalid param: prefetch_throttle_interval - must be at least 1 when prefetch_throttle is enabled\n", getName().c_str());
+        prefetchQueue_.configure(queueDepth, cacheArray_->getNumLines(), throttle ? throttleInterval : 0);
     }
 
     listener_->registerResponseCallback(new Event::Handler<Cache>(this, &Cache::handlePrefetchEvent));
@@ -431,6 +478,7 @@ CacheArray* Cache::createCacheArray(Params &params) {
     if (!found) d_->fatal(CALL_INFO, -1, "%s, Param not specified: cache_size\n", getName().c_str());
     
     unsigned int lineSize = params.find<uint64_t>("cache_line_size", 64);
+    bool timingOnly = params.find<bool>("timing_only", false);
     
     uint64_t assoc = params.find<uint64_t>("associativity", -1, found); // uint64_t to match cache size in case we have a fully associative cache
     if (!found) d_->fatal(CALL_INFO, -1, "%s, Param not specified: associativity\n", getName().c_str());
@@ -482,11 +530,11 @@ CacheArray* Cache::createCacheArray(Params &params) {
     else                    ht = new PureIdHashFunction;
 
     if (type_ == "inclusive" || type_ == "noninclusive") {
-        return new SetAssociativeArray(d_, lines, lineSize, assoc, rmgr, ht, !L1_);
+        return new SetAssociativeArray(d_, lines, lineSize, assoc, rmgr, ht, !L1_, timingOnly);
     } else if (type_ == "noninclusive_with_directory") {
         /* Construct */
         ReplacementMgr* drmgr = constructReplacementManager(dReplacement, dEntries, dAssoc);
-        return new DualSetAssociativeArray(d_, lineSize, ht, true, dEntries, dAssoc, drmgr, lines, assoc, rmgr);
+        return new DualSetAssociativeArray(d_, lineSize, ht, true, dEntries, dAssoc, drmgr, lines, assoc, rmgr, timingOnly);
     }
 }
 
@@ -506,8 +554,20 @@ ReplacementMgr* Cache::constructReplacementManager(std::string policy, uint64_t
 
     if (SST::strcasecmp(policy, "nmru"))   
         return new NMRUReplacementMgr(d_, lines, associativity);
+
+    if (SST::strcasecmp(policy, "srrip"))
+        return new RRIPReplacementMgr(d_, lines, associativity, RRIPReplacementMgr::Policy::SRRIP);
+
+    if (SST::strcasecmp(policy, "brrip"))
+        return new RRIPReplacementMgr(d_, lines, associativity, RRIPReplacementMgr::Policy::BRRIP);
+
+    if (SST::strcasecmp(policy, "drrip"))
+        return new RRIPReplacementMgr(d_, lines, associativity, RRIPReplacementMgr::Policy::DRRIP);
+
+    if (SST::strcasecmp(policy, "ship"))
+        return new SHiPReplacementMgr(d_, lines, associativity);
     
-    d_->fatal(CALL_INFO, -1, "%s, Invalid param: (directory_)replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', and 'nmru'. You specified '%s'.\n",
+    d_->fatal(CALL_INFO, -1, "%s, Invalid param: (directory_)replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', 'nmru', 'srrip', 'brrip', 'drrip', and 'ship'. You specified '%s'.\n",
             getName().c_str(), policy.c_str());
     
     return nullptr;
@@ -605,4 +665,13 @@ void Cache::registerStatistics() {
     statNACK_recv                   = registerStatistic<uint64_t>("NACK_recv");
     statMSHROccupancy               = registerStatistic<uint64_t>("MSHR_occupancy");
     statBankConflicts               = registerStatistic<uint64_t>("Bank_conflicts");
+    statWarmupRequests              = registerStatistic<uint64_t>("Warmup_requests");
+    statWarmupInstalls              = registerStatistic<uint64_t>("Warmup_installs");
+    statWarmupDrops                 = registerStatistic<uint64_t>("Warmup_drops");
+    if (eventPoolStats_) eventPoolStats_ = MemEventPool<MemEvent>::claimStats();
+    if (eventPoolStats_) {
+        statEventPoolBlocks         = registerStatistic<uint64_t>("EventPool_blocks");
+        statEventPoolAllocs         = registerStatistic<uint64_t>("EventPool_allocs");
+        statEventPoolOutstanding    = registerStatistic<uint64_t>("EventPool_outstanding");
+    }
 }
@@ -45,7 +45,7 @@ using namespace SST::MemHierarchy;
 /**
  *  Handle eviction. Stall if eviction candidate is in transition.
  */
-CacheAction IncoherentController::handleEviction(CacheLine* wbCacheLine, string origRqstr, bool ignoredParam) {
+CacheAction IncoherentController::handleEviction(CacheLine* wbCacheLine, EndpointId origRqstr, bool ignoredParam) {
     State state = wbCacheLine->getState();
     recordEvictionState(state);
     
@@ -203,10 +203,10 @@ int IncoherentController::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine)
  */
 CacheAction IncoherentController::handleGetSRequest(MemEvent* event, CacheLine* cacheLine, bool replay) {
     State state = cacheLine->getState();
-    vector<uint8_t>* data = cacheLine->getData();
+    const SharedPayload* data = cacheLine->getData();
     if (is_debug_event(event)) printData(cacheLine->getData(), false);
 
-    bool shouldRespond = !(event->isPrefetch() && (event->getRqstr() == parent->getName()));
+    bool shouldRespond = !(event->isPrefetch() && (event->getRqstrId() == parentId_));
     recordStateEventCount(event->getCmd(), state);
 
     uint64_t sendTime = 0;
@@ -284,7 +284,7 @@ CacheAction IncoherentController::handlePutMRequest(MemEvent* event, CacheLine*
     
     switch (state) {
         case I:
-            cacheLine->setData(event->getPayload(), 0);
+            cacheLine->setData(event->getSharedPayload(), 0);
             if (event->getDirty()) cacheLine->setState(M);
             else cacheLine->setState(E);
             break;
@@ -298,7 +298,7 @@ CacheAction IncoherentController::handlePutMRequest(MemEvent* event, CacheLine*
             if (event->getDirty()) cacheLine->setState(M);
         case M:
             if (event->getDirty()) {
-                cacheLine->setData(event->getPayload(), 0);
+                cacheLine->setData(event->getSharedPayload(), 0);
                 
                 if (is_debug_event(event)) printData(cacheLine->getData(), true);
             }
@@ -317,7 +317,7 @@ CacheAction IncoherentController::handleFlushLineRequest(MemEvent * event, Cache
     
      if (reqEvent != NULL) return STALL;
     
-    forwardFlushLine(event->getBaseAddr(), event->getRqstr(), cacheLine, Command::FlushLine);
+    forwardFlushLine(event->getBaseAddr(), event->getRqstrId(), cacheLine, Command::FlushLine);
     if (cacheLine && state != I) cacheLine->setState(S_B);
     else if (cacheLine) cacheLine->setState(I_B);
     event->setInProgress(true);
@@ -332,7 +332,7 @@ CacheAction IncoherentController::handleFlushLineInvRequest(MemEvent * event, Ca
 
     if (reqEvent != NULL) return STALL;
 
-    forwardFlushLine(event->getBaseAddr(), event->getRqstr(), cacheLine, Command::FlushLineInv);
+    forwardFlushLine(event->getBaseAddr(), event->getRqstrId(), cacheLine, Command::FlushLineInv);
     if (cacheLine) cacheLine->setState(I_B);
     event->setInProgress(true);
     return STALL;   // wait for response
@@ -345,17 +345,17 @@ CacheAction IncoherentController::handleFlushLineInvRequest(MemEvent * event, Ca
 CacheAction IncoherentController::handleDataResponse(MemEvent* responseEvent, CacheLine* cacheLine, MemEvent* origRequest){
     
     if (!inclusive_ && (cacheLine == NULL || cacheLine->getState() == I)) {
-        sendResponseUp(origRequest, &responseEvent->getPayload(), true, 0);
+        sendResponseUp(origRequest, &responseEvent->getSharedPayload(), true, 0);
         return DONE;
     }
 
-    cacheLine->setData(responseEvent->getPayload(), 0);
+    cacheLine->setData(responseEvent->getSharedPayload(), 0);
     if (is_debug_event(responseEvent)) printData(cacheLine->getData(), true);
 
     State state = cacheLine->getState();
     recordStateEventCount(responseEvent->getCmd(), state);
     
-    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstr() == parent->getName()));
+    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstrId() == parentId_));
     uint64_t sendTime = 0;
     switch (state) {
         case IS:
@@ -390,8 +390,9 @@ CacheAction IncoherentController::handleDataResponse(MemEvent* responseEvent, Ca
  *  Send writeback to lower level cache
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
-void IncoherentController::sendWriteback(Command cmd, CacheLine* cacheLine, string origRqstr){
-    MemEvent* newCommandEvent = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+void IncoherentController::sendWriteback(Command cmd, CacheLine* cacheLine, EndpointId origRqstr){
+    MemEvent* newCommandEvent = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+    if (timingOnly_) newCommandEvent->setDataless();
     newCommandEvent->setDst(getDestination(cacheLine->getBaseAddr()));
     newCommandEvent->setSize(cacheLine->getSize());
     if (cmd == Command::PutM || writebackCleanBlocks_) {
@@ -413,8 +414,9 @@ void IncoherentController::sendWriteback(Command cmd, CacheLine* cacheLine, stri
 /**
  *  Forward a flush line request, with or without data
  */
-void IncoherentController::forwardFlushLine(Addr baseAddr, string origRqstr, CacheLine * cacheLine, Command cmd) {
-    MemEvent * flush = new MemEvent(parent, baseAddr, baseAddr, cmd);
+void IncoherentController::forwardFlushLine(Addr baseAddr, EndpointId origRqstr, CacheLine * cacheLine, Command cmd) {
+    MemEvent * flush = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), baseAddr, baseAddr, cmd);
+    if (timingOnly_) flush->setDataless();
     flush->setDst(getDestination(baseAddr));
     flush->setRqstr(origRqstr);
     flush->setSize(lineSize_);
@@ -444,7 +446,7 @@ void IncoherentController::forwardFlushLine(Addr baseAddr, string origRqstr, Cac
 void IncoherentController::sendFlushResponse(MemEvent * requestEvent, bool success) {
     MemEvent * flushResponse = requestEvent->makeResponse();
     flushResponse->setSuccess(success);
-    flushResponse->setDst(requestEvent->getSrc());
+    flushResponse->setDst(requestEvent->getSrcId());
 
     uint64_t deliveryTime = timestamp_ + mshrLatency_;
     Response resp = {flushResponse, deliveryTime, packetHeaderBytes};
@@ -478,7 +480,7 @@ void IncoherentController::addToOutgoingQueueUp(Response& resp) {
 /*
  *  Print data values for debugging
  */
-void IncoherentController::printData(vector<uint8_t> * data, bool set) {
+void IncoherentController::printData(const SharedPayload* data, bool set) {
     /*if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
     
@@ -180,7 +180,7 @@ public:
 /* Event handlers */
     /* Public event handlers called by cache controller */
     /** Send cache line data to the lower level caches */
-    CacheAction handleEviction(CacheLine* _wbCacheLine, string _origRqstr, bool ignoredParameter=false);
+    CacheAction handleEviction(CacheLine* _wbCacheLine, EndpointId _origRqstr, bool ignoredParameter=false);
 
     /** Process cache request:  GetX, GetS, GetSX */
     CacheAction handleRequest(MemEvent* event, CacheLine* cacheLine, bool replay);
@@ -288,17 +288,17 @@ private:
     
 /* Private methods for sending events */
     /** Send writeback request to lower level caches */
-    void sendWriteback(Command cmd, CacheLine* cacheLine, string origRqstr);
+    void sendWriteback(Command cmd, CacheLine* cacheLine, EndpointId origRqstr);
     
     /** Send a flush response */
     void sendFlushResponse(MemEvent * reqEent, bool success);
     
     /** Forward a FlushLine request with or without data */
-    void forwardFlushLine(Addr baseAddr, string origRqstr, CacheLine * cacheLine, Command cmd);
+    void forwardFlushLine(Addr baseAddr, EndpointId origRqstr, CacheLine * cacheLine, Command cmd);
 
 /* Helper methods */
    
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(const SharedPayload* data, bool set);
 
 /* Statistics */
     void recordStateEventCount(Command cmd, State state);
@@ -43,7 +43,7 @@ using namespace SST::MemHierarchy;
  *      isRetryNeeded
  */
   
-CacheAction L1CoherenceController::handleEviction(CacheLine* wbCacheLine, string origRqstr, bool ignoredParam) {
+CacheAction L1CoherenceController::handleEviction(CacheLine* wbCacheLine, EndpointId origRqstr, bool ignoredParam) {
     State state = wbCacheLine->getState();
    
     /* L1 specific code */
@@ -145,7 +145,7 @@ CacheAction L1CoherenceController::handleInvalidationRequest(MemEvent * event, C
 
     /* L1 specific code for gem5 integration */
     if (snoopL1Invs_) {
-        MemEvent* snoop = new MemEvent(parent, event->getAddr(), event->getBaseAddr(), Command::Inv);
+        MemEvent* snoop = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), event->getAddr(), event->getBaseAddr(), Command::Inv);
         uint64_t baseTime = timestamp_ > cacheLine->getTimestamp() ? timestamp_ : cacheLine->getTimestamp();
         uint64_t deliveryTime = (replay) ? baseTime + mshrLatency_ : baseTime + tagLatency_;
         Response resp = {snoop, deliveryTime, packetHeaderBytes};
@@ -250,9 +250,9 @@ bool L1CoherenceController::isRetryNeeded(MemEvent * event, CacheLine * cacheLin
 
 CacheAction L1CoherenceController::handleGetSRequest(MemEvent* event, CacheLine* cacheLine, bool replay){
     State state = cacheLine->getState();
-    vector<uint8_t>* data = cacheLine->getData();
+    const SharedPayload* data = cacheLine->getData();
     
-    bool shouldRespond = !(event->isPrefetch() && (event->getRqstr() == parent->getName()));
+    bool shouldRespond = !(event->isPrefetch() && (event->getRqstrId() == parentId_));
     recordStateEventCount(event->getCmd(), state);
     uint64_t sendTime = 0;
     switch (state) {
@@ -285,7 +285,7 @@ CacheAction L1CoherenceController::handleGetSRequest(MemEvent* event, CacheLine*
 CacheAction L1CoherenceController::handleGetXRequest(MemEvent* event, CacheLine* cacheLine, bool replay) {
     State state = cacheLine->getState();
     Command cmd = event->getCmd();
-    vector<uint8_t>* data = cacheLine->getData();
+    const SharedPayload* data = cacheLine->getData();
     uint64_t sendTime = 0;
 
     recordStateEventCount(event->getCmd(), state);
@@ -316,7 +316,7 @@ CacheAction L1CoherenceController::handleGetXRequest(MemEvent* event, CacheLine*
             if (cmd == Command::GetX) {
                 /* L1s write back immediately */
                 if (!event->isStoreConditional() || cacheLine->isAtomic()) {
-                    cacheLine->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
+                    cacheLine->setData(event->getSharedPayload(), event->getAddr() - event->getBaseAddr());
                     
                     if (is_debug_addr(cacheLine->getBaseAddr())) {
                         printData(cacheLine->getData(), true);
@@ -367,7 +367,7 @@ CacheAction L1CoherenceController::handleFlushLineRequest(MemEvent * event, Cach
         return DONE;
     }
     
-    forwardFlushLine(event->getBaseAddr(), Command::FlushLine, event->getRqstr(), cacheLine);
+    forwardFlushLine(event->getBaseAddr(), Command::FlushLine, event->getRqstrId(), cacheLine);
     
     if (cacheLine != NULL && state != I) cacheLine->setState(S_B);
     else if (cacheLine != NULL) cacheLine->setState(I_B);
@@ -392,7 +392,7 @@ CacheAction L1CoherenceController::handleFlushLineInvRequest(MemEvent * event, C
         return DONE;
     }
 
-    forwardFlushLine(event->getBaseAddr(), Command::FlushLineInv, event->getRqstr(), cacheLine);
+    forwardFlushLine(event->getBaseAddr(), Command::FlushLineInv, event->getRqstrId(), cacheLine);
     if (cacheLine != NULL) cacheLine->setState(I_B);
     return STALL;   // wait for response
 }
@@ -403,7 +403,7 @@ CacheAction L1CoherenceController::handleFlushLineInvRequest(MemEvent * event, C
  */
 void L1CoherenceController::handleDataResponse(MemEvent* responseEvent, CacheLine* cacheLine, MemEvent* origRequest){
     
-    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstr() == parent->getName()));
+    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstrId() == parentId_));
     
     State state = cacheLine->getState();
     recordStateEventCount(responseEvent->getCmd(), state);
@@ -414,7 +414,7 @@ void L1CoherenceController::handleDataResponse(MemEvent* responseEvent, CacheLin
     uint64_t sendTime = 0;
     switch (state) {
         case IS:
-            cacheLine->setData(responseEvent->getPayload(), 0);
+            cacheLine->setData(responseEvent->getSharedPayload(), 0);
             
             if (is_debug_addr(cacheLine->getBaseAddr())) {
                 printData(cacheLine->getData(), true);
@@ -430,7 +430,7 @@ void L1CoherenceController::handleDataResponse(MemEvent* responseEvent, CacheLin
             cacheLine->setTimestamp(sendTime-1);
             break;
         case IM:
-            cacheLine->setData(responseEvent->getPayload(), 0);
+            cacheLine->setData(responseEvent->getSharedPayload(), 0);
             
             if (is_debug_addr(cacheLine->getBaseAddr())) {
                 printData(cacheLine->getData(), true);
@@ -440,7 +440,7 @@ void L1CoherenceController::handleDataResponse(MemEvent* responseEvent, CacheLin
             cacheLine->setState(M);
             if (origRequest->getCmd() == Command::GetX) {
                 if (!origRequest->isStoreConditional() || cacheLine->isAtomic()) {
-                    cacheLine->setData(origRequest->getPayload(), origRequest->getAddr() - origRequest->getBaseAddr());
+                    cacheLine->setData(origRequest->getSharedPayload(), origRequest->getAddr() - origRequest->getBaseAddr());
                     
                     if (is_debug_addr(cacheLine->getBaseAddr())) {
                         printData(cacheLine->getData(), true);
@@ -632,7 +632,7 @@ int L1CoherenceController::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine
     if (cmd == Command::GetSX) cmd = Command::GetX;  // for our purposes these are equal
 
     if (state == I) return 1;
-    if (event->isPrefetch() && event->getRqstr() == parent->getName()) return 0;
+    if (event->isPrefetch() && event->getRqstrId() == parentId_) return 0;
     
     switch (state) {
         case S:
@@ -683,10 +683,10 @@ void L1CoherenceController::sendResponseDown(MemEvent* event, CacheLine* cacheLi
 }
 
 
-uint64_t L1CoherenceController::sendResponseUp(MemEvent * event, std::vector<uint8_t>* data, bool replay, uint64_t baseTime, bool finishedAtomically) {
+uint64_t L1CoherenceController::sendResponseUp(MemEvent * event, const SharedPayload* data, bool replay, uint64_t baseTime, bool finishedAtomically) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
-    responseEvent->setDst(event->getSrc());
+    responseEvent->setDst(event->getSrcId());
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
      
     if (!noncacheable) {
@@ -726,8 +726,9 @@ uint64_t L1CoherenceController::sendResponseUp(MemEvent * event, std::vector<uin
  *  Handles: sending writebacks
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
-void L1CoherenceController::sendWriteback(Command cmd, CacheLine* cacheLine, bool dirty, string origRqstr) {
-    MemEvent* writeback = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+void L1CoherenceController::sendWriteback(Command cmd, CacheLine* cacheLine, bool dirty, EndpointId origRqstr) {
+    MemEvent* writeback = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+    if (timingOnly_) writeback->setDataless();
     writeback->setDst(getDestination(cacheLine->getBaseAddr()));
     writeback->setSize(cacheLine->getSize());
     uint64_t latency = tagLatency_;
@@ -778,8 +779,9 @@ void L1CoherenceController::sendAckInv(MemEvent * request, CacheLine * cacheLine
 }
 
 
-void L1CoherenceController::forwardFlushLine(Addr baseAddr, Command cmd, string origRqstr, CacheLine * cacheLine) {
-    MemEvent * flush = new MemEvent(parent, baseAddr, baseAddr, cmd);
+void L1CoherenceController::forwardFlushLine(Addr baseAddr, Command cmd, EndpointId origRqstr, CacheLine * cacheLine) {
+    MemEvent * flush = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), baseAddr, baseAddr, cmd);
+    if (timingOnly_) flush->setDataless();
     flush->setDst(getDestination(baseAddr));
     flush->setRqstr(origRqstr);
     flush->setSize(lineSize_);
@@ -808,8 +810,8 @@ void L1CoherenceController::forwardFlushLine(Addr baseAddr, Command cmd, string
 void L1CoherenceController::sendFlushResponse(MemEvent * requestEvent, bool success, uint64_t baseTime, bool replay) {
     MemEvent * flushResponse = requestEvent->makeResponse();
     flushResponse->setSuccess(success);
-    flushResponse->setDst(requestEvent->getSrc());
-    flushResponse->setRqstr(requestEvent->getRqstr());
+    flushResponse->setDst(requestEvent->getSrcId());
+    flushResponse->setRqstr(requestEvent->getRqstrId());
     
     uint64_t deliveryTime = baseTime + (replay ? mshrLatency_ : tagLatency_);
     Response resp = {flushResponse, deliveryTime, packetHeaderBytes};
@@ -838,7 +840,7 @@ void L1CoherenceController::addToOutgoingQueueUp(Response& resp) {
  * Helper functions
  ********************/
 
-void L1CoherenceController::printData(vector<uint8_t> * data, bool set) {
+void L1CoherenceController::printData(const SharedPayload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
     
@@ -47,7 +47,7 @@ using namespace SST::MemHierarchy;
  *      isRetryNeeded 
  */
   
-CacheAction L1IncoherentController::handleEviction(CacheLine* wbCacheLine, string origRqstr, bool ignoredParam) {
+CacheAction L1IncoherentController::handleEviction(CacheLine* wbCacheLine, EndpointId origRqstr, bool ignoredParam) {
     State state = wbCacheLine->getState();
    
     /* L1 specific code */
@@ -175,9 +175,9 @@ bool L1IncoherentController::isRetryNeeded(MemEvent * event, CacheLine * cacheLi
 
 CacheAction L1IncoherentController::handleGetSRequest(MemEvent* event, CacheLine* cacheLine, bool replay){
     State state = cacheLine->getState();
-    vector<uint8_t>* data = cacheLine->getData();
+    const SharedPayload* data = cacheLine->getData();
     
-    bool shouldRespond = !(event->isPrefetch() && (event->getRqstr() == parent->getName()));
+    bool shouldRespond = !(event->isPrefetch() && (event->getRqstrId() == parentId_));
     recordStateEventCount(event->getCmd(), state);
     
     uint64_t sendTime = 0;
@@ -212,7 +212,7 @@ CacheAction L1IncoherentController::handleGetSRequest(MemEvent* event, CacheLine
 CacheAction L1IncoherentController::handleGetXRequest(MemEvent* event, CacheLine* cacheLine, bool replay) {
     State state = cacheLine->getState();
     Command cmd = event->getCmd();
-    vector<uint8_t>* data = cacheLine->getData();
+    const SharedPayload* data = cacheLine->getData();
     
     uint64_t sendTime = 0;
 
@@ -229,7 +229,7 @@ CacheAction L1IncoherentController::handleGetXRequest(MemEvent* event, CacheLine
             if (cmd == Command::GetX) {
                 /* L1s write back immediately */
                 if (!event->isStoreConditional() || cacheLine->isAtomic()) {
-                    cacheLine->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
+                    cacheLine->setData(event->getSharedPayload(), event->getAddr() - event->getBaseAddr());
                 }
                 /* Handle GetX as unlock (store-unlock) */
                 if (event->queryFlag(MemEvent::F_LOCKED)) {
@@ -276,7 +276,7 @@ CacheAction L1IncoherentController::handleFlushLineRequest(MemEvent * event, Cac
         return DONE;
     }
     
-    forwardFlushLine(event->getBaseAddr(), Command::FlushLine, event->getRqstr(), cacheLine);
+    forwardFlushLine(event->getBaseAddr(), Command::FlushLine, event->getRqstrId(), cacheLine);
     
     if (cacheLine != NULL && state != I) cacheLine->setState(S_B);
     else if (cacheLine != NULL) cacheLine->setState(I_B);
@@ -301,7 +301,7 @@ CacheAction L1IncoherentController::handleFlushLineInvRequest(MemEvent * event,
         return DONE;
     }
 
-    forwardFlushLine(event->getBaseAddr(), Command::FlushLineInv, event->getRqstr(), cacheLine);
+    forwardFlushLine(event->getBaseAddr(), Command::FlushLineInv, event->getRqstrId(), cacheLine);
     if (cacheLine != NULL) cacheLine->setState(I_B);
     return STALL;   // wait for response
 }
@@ -309,8 +309,8 @@ CacheAction L1IncoherentController::handleFlushLineInvRequest(MemEvent * event,
 
 void L1IncoherentController::handleDataResponse(MemEvent* responseEvent, CacheLine* cacheLine, MemEvent* origRequest){
     
-    cacheLine->setData(responseEvent->getPayload(), 0);
-    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstr() == parent->getName()));
+    cacheLine->setData(responseEvent->getSharedPayload(), 0);
+    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstrId() == parentId_));
     
     State state = cacheLine->getState();
     recordStateEventCount(responseEvent->getCmd(), state);
@@ -331,7 +331,7 @@ void L1IncoherentController::handleDataResponse(MemEvent* responseEvent, CacheLi
             cacheLine->setState(M);
             if (origRequest->getCmd() == Command::GetX) {
                 if (!origRequest->isStoreConditional() || cacheLine->isAtomic()) {
-                    cacheLine->setData(origRequest->getPayload(), origRequest->getAddr() - origRequest->getBaseAddr());
+                    cacheLine->setData(origRequest->getSharedPayload(), origRequest->getAddr() - origRequest->getBaseAddr());
 
                 }
                 /* Handle GetX as unlock (store-unlock) */
@@ -379,10 +379,10 @@ int L1IncoherentController::isCoherenceMiss(MemEvent* event, CacheLine* cacheLin
  *  Methods for sending & receiving messages
  *********************************************/
 
-uint64_t L1IncoherentController::sendResponseUp(MemEvent * event, std::vector<uint8_t>* data, bool replay, uint64_t baseTime, bool finishedAtomically) {
+uint64_t L1IncoherentController::sendResponseUp(MemEvent * event, const SharedPayload* data, bool replay, uint64_t baseTime, bool finishedAtomically) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
-    responseEvent->setDst(event->getSrc());
+    responseEvent->setDst(event->getSrcId());
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
     
     if (!noncacheable) {
@@ -417,8 +417,9 @@ uint64_t L1IncoherentController::sendResponseUp(MemEvent * event, std::vector<ui
  *  Handles: sending writebacks
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
-void L1IncoherentController::sendWriteback(Command cmd, CacheLine* cacheLine, string origRqstr){
-    MemEvent* writeback = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+void L1IncoherentController::sendWriteback(Command cmd, CacheLine* cacheLine, EndpointId origRqstr){
+    MemEvent* writeback = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+    if (timingOnly_) writeback->setDataless();
     writeback->setDst(getDestination(cacheLine->getBaseAddr()));
     writeback->setSize(cacheLine->getSize());
     if (cmd == Command::PutM || writebackCleanBlocks_) {
@@ -436,8 +437,9 @@ void L1IncoherentController::sendWriteback(Command cmd, CacheLine* cacheLine, st
 }
 
 
-void L1IncoherentController::forwardFlushLine(Addr baseAddr, Command cmd, string origRqstr, CacheLine * cacheLine) {
-    MemEvent * flush = new MemEvent(parent, baseAddr, baseAddr, cmd);
+void L1IncoherentController::forwardFlushLine(Addr baseAddr, Command cmd, EndpointId origRqstr, CacheLine * cacheLine) {
+    MemEvent * flush = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), baseAddr, baseAddr, cmd);
+    if (timingOnly_) flush->setDataless();
     flush->setDst(getDestination(baseAddr));
     flush->setRqstr(origRqstr);
     flush->setSize(lineSize_);
@@ -466,8 +468,8 @@ void L1IncoherentController::forwardFlushLine(Addr baseAddr, Command cmd, string
 void L1IncoherentController::sendFlushResponse(MemEvent * requestEvent, bool success, uint64_t baseTime, bool replay) {
     MemEvent * flushResponse = requestEvent->makeResponse();
     flushResponse->setSuccess(success);
-    flushResponse->setDst(requestEvent->getSrc());
-    flushResponse->setRqstr(requestEvent->getRqstr());
+    flushResponse->setDst(requestEvent->getSrcId());
+    flushResponse->setRqstr(requestEvent->getRqstrId());
     
     uint64_t deliveryTime = baseTime + (replay ? mshrLatency_ : tagLatency_);
     Response resp = {flushResponse, deliveryTime, packetHeaderBytes};
@@ -496,7 +498,7 @@ void L1IncoherentController::addToOutgoingQueueUp(Response& resp) {
  * Helper functions
  ********************/
 
-void L1IncoherentController::printData(vector<uint8_t> * data, bool set) {
+void L1IncoherentController::printData(const SharedPayload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
     
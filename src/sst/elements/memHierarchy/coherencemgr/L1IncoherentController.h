@@ -155,7 +155,7 @@ public:
     
     /* Event handlers called by cache controller */
     /** Send cache line data to the lower level caches */
-    CacheAction handleEviction(CacheLine* wbCacheLine, string origRqstr, bool ignoredParam=false);
+    CacheAction handleEviction(CacheLine* wbCacheLine, EndpointId origRqstr, bool ignoredParam=false);
 
     /** Process new cache request:  GetX, GetS, GetSX */
     CacheAction handleRequest(MemEvent* event, CacheLine* cacheLine, bool replay);
@@ -171,7 +171,7 @@ public:
 
     /* Methods for sending events, called by cache controller */
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic = false);
+    uint64_t sendResponseUp(MemEvent * event, const SharedPayload* data, bool replay, uint64_t baseTime, bool atomic = false);
     
     /** Call through to coherenceController with statistic recording */
     void addToOutgoingQueue(Response& resp);
@@ -182,7 +182,7 @@ public:
     bool isRetryNeeded(MemEvent * event, CacheLine * cacheLine);
 
 
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(const SharedPayload* data, bool set);
 
 private:
     /* Statistics */
@@ -246,10 +246,10 @@ private:
     
     /* Methods for sending events */
     /** Send writeback request to lower level caches */
-    void sendWriteback(Command cmd, CacheLine* cacheLine, string origRqstr);
+    void sendWriteback(Command cmd, CacheLine* cacheLine, EndpointId origRqstr);
 
     /** Forward a flush line request, with or without data */
-    void forwardFlushLine(Addr baseAddr, Command cmd, string origRqstr, CacheLine * cacheLine);
+    void forwardFlushLine(Addr baseAddr, Command cmd, EndpointId origRqstr, CacheLine * cacheLine);
     
     /** Send response to a flush request */
     void sendFlushResponse(MemEvent * requestEvent, bool success, uint64_t baseTime, bool replay);
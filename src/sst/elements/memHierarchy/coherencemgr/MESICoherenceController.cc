@@ -48,7 +48,7 @@ using namespace SST::MemHierarchy;
  *  LLCs and caches writing back to non-inclusive caches wait for AckPuts before sending further events for the evicted address
  *  This prevents races if the writeback is NACKed.
  */
-CacheAction MESIController::handleEviction(CacheLine* wbCacheLine, string rqstr, bool ignoredParam) {
+CacheAction MESIController::handleEviction(CacheLine* wbCacheLine, EndpointId rqstr, bool ignoredParam) {
     State state = wbCacheLine->getState();
     recordEvictionState(state);
 
@@ -75,7 +75,7 @@ CacheAction MESIController::handleEviction(CacheLine* wbCacheLine, string rqstr,
                 return DONE;
             }
             if (wbCacheLine->numSharers() > 0) {
-                invalidateAllSharers(wbCacheLine, parent->getName(), false); 
+                invalidateAllSharers(wbCacheLine, parentId_, false); 
                 wbCacheLine->setState(SI);
                 
                 if (is_debug_addr(wbBaseAddr)) debug->debug(_L7_, "Eviction requires invalidating sharers\n");
@@ -92,7 +92,7 @@ CacheAction MESIController::handleEviction(CacheLine* wbCacheLine, string rqstr,
                 return DONE;
             }
             if (wbCacheLine->numSharers() > 0) {
-                invalidateAllSharers(wbCacheLine, parent->getName(), false); 
+                invalidateAllSharers(wbCacheLine, parentId_, false); 
                 wbCacheLine->setState(EI);
                 
                 if (is_debug_addr(wbBaseAddr)) debug->debug(_L7_, "Eviction requires invalidating sharers\n");
@@ -100,7 +100,7 @@ CacheAction MESIController::handleEviction(CacheLine* wbCacheLine, string rqstr,
                 return STALL;
             }
             if (wbCacheLine->ownerExists()) {
-                sendFetchInv(wbCacheLine, parent->getName(), false);
+                sendFetchInv(wbCacheLine, parentId_, false);
                 mshr_->incrementAcksNeeded(wbBaseAddr);
                 wbCacheLine->setState(EI);
                 
@@ -118,7 +118,7 @@ CacheAction MESIController::handleEviction(CacheLine* wbCacheLine, string rqstr,
                 return DONE;
             }
             if (wbCacheLine->numSharers() > 0) {
-                invalidateAllSharers(wbCacheLine, parent->getName(), false); 
+                invalidateAllSharers(wbCacheLine, parentId_, false); 
                 wbCacheLine->setState(MI);
                 
                 if (is_debug_addr(wbBaseAddr)) debug->debug(_L7_, "Eviction requires invalidating sharers\n");
@@ -126,7 +126,7 @@ CacheAction MESIController::handleEviction(CacheLine* wbCacheLine, string rqstr,
                 return STALL;
             }
             if (wbCacheLine->ownerExists()) {
-                sendFetchInv(wbCacheLine, parent->getName(), false);
+                sendFetchInv(wbCacheLine, parentId_, false);
     /* Event/State combinations - Count how many times an event was seen in particular state */
                 mshr_->incrementAcksNeeded(wbBaseAddr);
                 wbCacheLine->setState(MI);
@@ -300,12 +300,12 @@ bool MESIController::isRetryNeeded(MemEvent* event, CacheLine* cacheLine) {
         case Command::FetchInv:
         case Command::FetchInvX:
             if (state == I) return false;   // Already resolved the request, don't resend
-            if (cacheLine->getOwner() != event->getDst()) {
-                if (cacheLine->isSharer(event->getDst()) && cmd == Command::FetchInv) { // Got a downgrade from the owner but still need to invalidate
+            if (cacheLine->getOwner() != event->getDstId()) {
+                if (cacheLine->isSharer(event->getDstId()) && cmd == Command::FetchInv) { // Got a downgrade from the owner but still need to invalidate
                     uint64_t deliveryTime = 0;
-                    MemEvent * inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
-                    inv->setDst(event->getDst());
-                    inv->setRqstr(event->getRqstr());
+                    MemEvent * inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
+                    inv->setDst(event->getDstId());
+                    inv->setRqstr(event->getRqstrId());
                     inv->setSize(cacheLine->getSize());
                     deliveryTime = timestamp_  + mshrLatency_;
                     Response resp = {inv, deliveryTime, packetHeaderBytes};
@@ -321,7 +321,7 @@ bool MESIController::isRetryNeeded(MemEvent* event, CacheLine* cacheLine) {
             return true;
         case Command::Inv:
             if (state == I) return false;   // Already resolved the request, don't resend
-            if (!cacheLine->isSharer(event->getDst())) return false;    // Must have gotten a replacement from this sharer
+            if (!cacheLine->isSharer(event->getDstId())) return false;    // Must have gotten a replacement from this sharer
             return true;
         default:
             debug->fatal(CALL_INFO,-1,"%s, Error: NACKed event is unrecognized. Event = %s. Time = %" PRIu64 "ns\n",
@@ -343,7 +343,7 @@ int MESIController::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine) {
     if (cmd == Command::GetSX) cmd = Command::GetX;  // for our purposes these are equal
 
     if (state == I) return 1;
-    if (event->isPrefetch() && event->getRqstr() == parent->getName()) return 0;
+    if (event->isPrefetch() && event->getRqstrId() == parentId_) return 0;
     if (state == S && lastLevel_) state = M;
     switch (state) {
         case S:
@@ -354,7 +354,7 @@ int MESIController::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine) {
             if (cacheLine->ownerExists()) return 3;
             if (cmd == Command::GetS) return 0;  // hit
             if (cmd == Command::GetX) {
-                if (cacheLine->isShareless() || (cacheLine->isSharer(event->getSrc()) && cacheLine->numSharers() == 1)) return 0; // Hit
+                if (cacheLine->isShareless() || (cacheLine->isSharer(event->getSrcId()) && cacheLine->numSharers() == 1)) return 0; // Hit
             }
             return 3;
         case IS:
@@ -382,12 +382,12 @@ int MESIController::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine) {
 /** Handle GetS request */
 CacheAction MESIController::handleGetSRequest(MemEvent* event, CacheLine* cacheLine, bool replay) {
     State state = cacheLine->getState();
-    vector<uint8_t>* data = cacheLine->getData();
+    const SharedPayload* data = cacheLine->getData();
     
     if (is_debug_event(event)) printData(cacheLine->getData(), false);
     
     uint64_t sendTime = 0;
-    bool shouldRespond = !(event->isPrefetch() && (event->getRqstr() == parent->getName()));
+    bool shouldRespond = !(event->isPrefetch() && (event->getRqstrId() == parentId_));
     recordStateEventCount(event->getCmd(), state);
     switch (state) {
         case I:
@@ -399,7 +399,7 @@ CacheAction MESIController::handleGetSRequest(MemEvent* event, CacheLine* cacheL
         case S:
             notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
             if (!shouldRespond) return DONE;
-            cacheLine->addSharer(event->getSrc());
+            cacheLine->addSharer(event->getSrcId());
             sendTime = sendResponseUp(event, data, replay, cacheLine->getTimestamp());
             cacheLine->setTimestamp(sendTime);
             return DONE;
@@ -413,14 +413,14 @@ CacheAction MESIController::handleGetSRequest(MemEvent* event, CacheLine* cacheL
             if (!inclusive_) {
                 sendTime = sendResponseUp(event, Command::GetXResp, data, state == M, replay, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
-                cacheLine->setOwner(event->getSrc());
+                cacheLine->setOwner(event->getSrcId());
                 return DONE;
             }
 
             if (cacheLine->isShareless() && !cacheLine->ownerExists() && protocol_) {
                 if (is_debug_addr(cacheLine->getBaseAddr())) debug->debug(_L7_, "New owner: %s\n", event->getSrc().c_str());
                 
-                cacheLine->setOwner(event->getSrc());
+                cacheLine->setOwner(event->getSrcId());
                 sendTime = sendResponseUp(event, Command::GetXResp, data, replay, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
                 return DONE;
@@ -428,13 +428,13 @@ CacheAction MESIController::handleGetSRequest(MemEvent* event, CacheLine* cacheL
             if (cacheLine->ownerExists()) {
                 if (is_debug_addr(cacheLine->getBaseAddr())) debug->debug(_L7_,"GetS request but exclusive owner exists \n");
                 
-                sendFetchInvX(cacheLine, event->getRqstr(), replay);
+                sendFetchInvX(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 if (state == E) cacheLine->setState(E_InvX);
                 else cacheLine->setState(M_InvX);
                 return STALL;
             }
-            cacheLine->addSharer(event->getSrc());
+            cacheLine->addSharer(event->getSrcId());
             sendTime = sendResponseUp(event, data, replay, cacheLine->getTimestamp());
             cacheLine->setTimestamp(sendTime);
             return DONE;
@@ -472,7 +472,7 @@ CacheAction MESIController::handleGetXRequest(MemEvent* event, CacheLine* cacheL
         case S:
             notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
             sendTime = forwardMessage(event, cacheLine->getBaseAddr(), cacheLine->getSize(), cacheLine->getTimestamp(), NULL);
-            if (invalidateSharersExceptRequestor(cacheLine, event->getSrc(), event->getRqstr(), replay)) {
+            if (invalidateSharersExceptRequestor(cacheLine, event->getSrcId(), event->getRqstrId(), replay)) {
                 cacheLine->setState(SM_Inv);
             } else {
                 cacheLine->setState(SM);
@@ -485,19 +485,19 @@ CacheAction MESIController::handleGetXRequest(MemEvent* event, CacheLine* cacheL
             notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::HIT);
 
             if (!cacheLine->isShareless()) {
-                if (invalidateSharersExceptRequestor(cacheLine, event->getSrc(), event->getRqstr(), replay)) {
+                if (invalidateSharersExceptRequestor(cacheLine, event->getSrcId(), event->getRqstrId(), replay)) {
                     cacheLine->setState(M_Inv);
                     return STALL;
                 }
             }
             if (cacheLine->ownerExists()) {
-                sendFetchInv(cacheLine, event->getRqstr(), replay);
+                sendFetchInv(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(M_Inv);
                 return STALL;
             }
-            cacheLine->setOwner(event->getSrc());
-            if (cacheLine->isSharer(event->getSrc())) cacheLine->removeSharer(event->getSrc());
+            cacheLine->setOwner(event->getSrcId());
+            if (cacheLine->isSharer(event->getSrcId())) cacheLine->removeSharer(event->getSrcId());
             sendTime = sendResponseUp(event, cacheLine->getData(), replay, cacheLine->getTimestamp());
             cacheLine->setTimestamp(sendTime);
             
@@ -536,16 +536,16 @@ CacheAction MESIController::handleFlushLineRequest(MemEvent * event, CacheLine*
             break;
         case E:
         case M:
-            if (cacheLine->getOwner() == event->getSrc()) {
+            if (cacheLine->getOwner() == event->getSrcId()) {
                 cacheLine->clearOwner();
-                cacheLine->addSharer(event->getSrc());
+                cacheLine->addSharer(event->getSrcId());
                 if (event->getDirty()) {
-                    cacheLine->setData(event->getPayload(), 0);
+                    cacheLine->setData(event->getSharedPayload(), 0);
                     cacheLine->setState(M);
                 }
             }
             if (cacheLine->ownerExists()) {
-                sendFetchInvX(cacheLine, event->getRqstr(), replay);
+                sendFetchInvX(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 state == M ? cacheLine->setState(M_InvX) : cacheLine->setState(E_InvX);
                 return STALL;
@@ -560,34 +560,34 @@ CacheAction MESIController::handleFlushLineRequest(MemEvent * event, CacheLine*
             return STALL; // Wait for the Get* request to finish
         case EI:
         case MI:
-            if (cacheLine->getOwner() == event->getSrc()) {
+            if (cacheLine->getOwner() == event->getSrcId()) {
                 cacheLine->clearOwner();
-                cacheLine->addSharer(event->getSrc());
+                cacheLine->addSharer(event->getSrcId());
                 if (event->getDirty()) {
-                    cacheLine->setData(event->getPayload(), 0);
+                    cacheLine->setData(event->getSharedPayload(), 0);
                     cacheLine->setState(MI);
                 }
             }
             return STALL;
         case M_Inv:
         case E_Inv:
-            if (cacheLine->getOwner() == event->getSrc()) {
+            if (cacheLine->getOwner() == event->getSrcId()) {
                 cacheLine->clearOwner();
-                cacheLine->addSharer(event->getSrc());
+                cacheLine->addSharer(event->getSrcId());
                 if (event->getDirty()) {
-                    cacheLine->setData(event->getPayload(), 0);
+                    cacheLine->setData(event->getSharedPayload(), 0);
                     cacheLine->setState(M_Inv);
                 }
             }
             return STALL;
         case M_InvX:
         case E_InvX:
-            if (cacheLine->getOwner() == event->getSrc()) {
+            if (cacheLine->getOwner() == event->getSrcId()) {
                 cacheLine->clearOwner();
-                cacheLine->addSharer(event->getSrc());
+                cacheLine->addSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
                 if (event->getDirty()) {
-                    cacheLine->setData(event->getPayload(), 0);
+                    cacheLine->setData(event->getSharedPayload(), 0);
                     cacheLine->setState(M_InvX);
                 }
             }
@@ -606,7 +606,7 @@ CacheAction MESIController::handleFlushLineRequest(MemEvent * event, CacheLine*
                     debug->fatal(CALL_INFO, -1, "%s, Error: Handling not implemented because state not expected: noninclusive cache, state = %s, request = %s. Time = %" PRIu64 " ns\n",
                             parent->getName().c_str(), StateString[state], event->getVerboseString().c_str(), getCurrentSimTimeNano());
                 } else {
-                    cacheLine->addSharer(reqEvent->getSrc());
+                    cacheLine->addSharer(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, cacheLine->getData(), (event->getDirty()), cacheLine->getTimestamp());
                     cacheLine->setTimestamp(sendTime);
                     (state == M_InvX || event->getDirty()) ? cacheLine->setState(M) : cacheLine->setState(E);
@@ -618,7 +618,7 @@ CacheAction MESIController::handleFlushLineRequest(MemEvent * event, CacheLine*
                     parent->getName().c_str(), StateString[state], event->getVerboseString().c_str(), getCurrentSimTimeNano());
     }
 
-    forwardFlushLine(event->getBaseAddr(), event->getRqstr(), cacheLine, Command::FlushLine);
+    forwardFlushLine(event->getBaseAddr(), event->getRqstrId(), cacheLine, Command::FlushLine);
     if (cacheLine && state != I) cacheLine->setState(S_B);
     else if (cacheLine) cacheLine->setState(I_B);
     event->setInProgress(true);
@@ -638,11 +638,11 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
     // Apply incoming flush -> remove if sharer/owner & update data if dirty
     
     if (cacheLine) {
-        if (cacheLine->isSharer(event->getSrc())) {
-            cacheLine->removeSharer(event->getSrc());
+        if (cacheLine->isSharer(event->getSrcId())) {
+            cacheLine->removeSharer(event->getSrcId());
             if (mshr_->getAcksNeeded(event->getBaseAddr()) > 0) mshr_->decrementAcksNeeded(event->getBaseAddr());
         }
-        if (cacheLine->getOwner() == event->getSrc()) {
+        if (cacheLine->getOwner() == event->getSrcId()) {
             cacheLine->clearOwner();
             if (mshr_->getAcksNeeded(event->getBaseAddr()) > 0) mshr_->decrementAcksNeeded(event->getBaseAddr());
         }
@@ -651,7 +651,7 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
                 cacheLine->setState(M);
                 state = M;
             }
-            cacheLine->setData(event->getPayload(), 0);
+            cacheLine->setData(event->getSharedPayload(), 0);
         }
     }
     
@@ -665,33 +665,33 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
             break;
         case S:
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(S_Inv);
                 return STALL;
             }
             break;
         case E:
             if (cacheLine->ownerExists()) {
-                sendFetchInv(cacheLine, event->getRqstr(), replay);
+                sendFetchInv(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(E_Inv);
                 return STALL;
             }
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(E_Inv);
                 return STALL;
             }
             break;
         case M:
             if (cacheLine->ownerExists()) {
-                sendFetchInv(cacheLine, event->getRqstr(), replay);
+                sendFetchInv(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(M_Inv);
                 return STALL;
             }
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(M_Inv);
                 return STALL;
             }
@@ -708,7 +708,7 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
                 if (reqEvent->getCmd() == Command::Inv) sendAckInv(reqEvent);
                 else if (reqEvent->getCmd() == Command::FetchInv) sendResponseDown(reqEvent, cacheLine, false, true);
                 else if (reqEvent->getCmd() == Command::FlushLineInv) {
-                    forwardFlushLine(reqEvent->getBaseAddr(), reqEvent->getRqstr(), cacheLine, Command::FlushLineInv);
+                    forwardFlushLine(reqEvent->getBaseAddr(), reqEvent->getRqstrId(), cacheLine, Command::FlushLineInv);
                     cacheLine->setState(I_B);
                     return STALL;
                 }
@@ -719,7 +719,7 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
                 if (reqEvent->getCmd() == Command::Inv) {
                     if (cacheLine->numSharers() > 0) {  // May not have invalidated GetX requestor -> cannot also be the FlushLine requestor since that one is in I and blocked on flush
-                        invalidateAllSharers(cacheLine, reqEvent->getRqstr(), true);
+                        invalidateAllSharers(cacheLine, reqEvent->getRqstrId(), true);
                         return STALL;
                     } else {
                         sendAckInv(reqEvent);
@@ -737,16 +737,16 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
         case EI:
         case MI:
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
-                if (state == MI || event->getDirty()) sendWriteback(Command::PutM, cacheLine, true, parent->getName());
+                if (state == MI || event->getDirty()) sendWriteback(Command::PutM, cacheLine, true, parentId_);
     /* Event/State combinations - Count how many times an event was seen in particular state */
-                else sendWriteback(Command::PutE, cacheLine, false, parent->getName());
+                else sendWriteback(Command::PutE, cacheLine, false, parentId_);
                 if (expectWritebackAck_) mshr_->insertWriteback(cacheLine->getBaseAddr());
                 cacheLine->setState(I);
                 return DONE;
             } else return STALL;
         case SI:
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
-                sendWriteback(Command::PutS, cacheLine, false, parent->getName());
+                sendWriteback(Command::PutS, cacheLine, false, parentId_);
                 if (expectWritebackAck_) mshr_->insertWriteback(cacheLine->getBaseAddr());
                 cacheLine->setState(I);
                 return DONE;
@@ -759,14 +759,14 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
                     cacheLine->setState(I);
                     return DONE;
                 } else if (reqEvent->getCmd() == Command::GetX || reqEvent->getCmd() == Command::GetSX) {
-                    cacheLine->setOwner(reqEvent->getSrc());
-                    if (cacheLine->isSharer(reqEvent->getSrc())) cacheLine->removeSharer(reqEvent->getSrc());
+                    cacheLine->setOwner(reqEvent->getSrcId());
+                    if (cacheLine->isSharer(reqEvent->getSrcId())) cacheLine->removeSharer(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, cacheLine->getData(), true, cacheLine->getTimestamp());
                     cacheLine->setTimestamp(sendTime);
                     cacheLine->setState(M);
                     return DONE;
                 } else if (reqEvent->getCmd() == Command::FlushLineInv) {
-                    forwardFlushLine(event->getBaseAddr(), event->getRqstr(), cacheLine, Command::FlushLineInv);
+                    forwardFlushLine(event->getBaseAddr(), event->getRqstrId(), cacheLine, Command::FlushLineInv);
                     cacheLine->setState(I_B);
                     return STALL;
                 }
@@ -778,7 +778,7 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
                     cacheLine->setState(I);
                     return DONE;
                 } else if (reqEvent->getCmd() == Command::FlushLineInv) {
-                    forwardFlushLine(reqEvent->getBaseAddr(), reqEvent->getRqstr(), cacheLine, Command::FlushLineInv);
+                    forwardFlushLine(reqEvent->getBaseAddr(), reqEvent->getRqstrId(), cacheLine, Command::FlushLineInv);
                     cacheLine->setState(I_B);
                     return STALL;
                 }
@@ -795,17 +795,17 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
                     else cacheLine->setState(E);
                     return handleFlushLineRequest(reqEvent, cacheLine, NULL, true);
                 } else if (!inclusive_) { // cmd = GetS; need to forward dirty/M so we don't lose that info
-                    cacheLine->setOwner(reqEvent->getSrc());
+                    cacheLine->setOwner(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, Command::GetXResp, cacheLine->getData(), (state == M_InvX || event->getDirty()), true, cacheLine->getTimestamp());
                     cacheLine->setTimestamp(sendTime);
                     (state == M_InvX || event->getDirty()) ? cacheLine->setState(M) : cacheLine->setState(E);
                 } else if (protocol_) { // MESI, fwd exclusive since now no other owner
-                    cacheLine->setOwner(reqEvent->getSrc());
+                    cacheLine->setOwner(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, Command::GetXResp, cacheLine->getData(), true, cacheLine->getTimestamp());
                     cacheLine->setTimestamp(sendTime);
                     (state == M_InvX || event->getDirty()) ? cacheLine->setState(M) : cacheLine->setState(E);
                 } else {
-                    cacheLine->addSharer(reqEvent->getSrc());
+                    cacheLine->addSharer(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, cacheLine->getData(), true, cacheLine->getTimestamp());
                     cacheLine->setTimestamp(sendTime);
                     (state == M_InvX || event->getDirty()) ? cacheLine->setState(M) : cacheLine->setState(E);
@@ -817,7 +817,7 @@ CacheAction MESIController::handleFlushLineInvRequest(MemEvent * event, CacheLin
                     parent->getName().c_str(), StateString[state], event->getVerboseString().c_str(), getCurrentSimTimeNano());
     }
 
-    forwardFlushLine(event->getBaseAddr(), event->getRqstr(), cacheLine, Command::FlushLineInv);
+    forwardFlushLine(event->getBaseAddr(), event->getRqstrId(), cacheLine, Command::FlushLineInv);
     if (cacheLine) cacheLine->setState(I_B);
     return STALL;   // wait for response
 }
@@ -853,7 +853,7 @@ CacheAction MESIController::handlePutSRequest(MemEvent* event, CacheLine* line,
                         parent->getName().c_str(), event->getVerboseString().c_str(), reqEvent->getVerboseString().c_str(), getCurrentSimTimeNano());
             }
         }
-        line->setData(event->getPayload(), 0);
+        line->setData(event->getSharedPayload(), 0);
         
         if (is_debug_event(event)) printData(line->getData(), true);
         
@@ -869,8 +869,8 @@ CacheAction MESIController::handlePutSRequest(MemEvent* event, CacheLine* line,
     } 
     if (mshr_->getAcksNeeded(event->getBaseAddr()) > 0) mshr_->decrementAcksNeeded(event->getBaseAddr());
 
-    if (line->isSharer(event->getSrc())) {
-        line->removeSharer(event->getSrc());
+    if (line->isSharer(event->getSrcId())) {
+        line->removeSharer(event->getSrcId());
     }
     
     bool retry = (mshr_->getAcksNeeded(event->getBaseAddr()) == 0);
@@ -889,17 +889,17 @@ CacheAction MESIController::handlePutSRequest(MemEvent* event, CacheLine* line,
             return DONE;
         /* Races with evictions */
         case SI:
-            sendWriteback(Command::PutS, line, false, parent->getName());
+            sendWriteback(Command::PutS, line, false, parentId_);
             if (expectWritebackAck_) mshr_->insertWriteback(line->getBaseAddr());
             line->setState(I);
             return DONE;
         case EI:
-            sendWriteback(Command::PutE, line, false, parent->getName());
+            sendWriteback(Command::PutE, line, false, parentId_);
             if (expectWritebackAck_) mshr_->insertWriteback(line->getBaseAddr());
             line->setState(I);
             return DONE;
         case MI:
-            sendWriteback(Command::PutM, line, true, parent->getName());
+            sendWriteback(Command::PutM, line, true, parentId_);
             if (expectWritebackAck_) mshr_->insertWriteback(line->getBaseAddr());
             line->setState(I);
             return DONE;
@@ -945,8 +945,8 @@ CacheAction MESIController::handlePutSRequest(MemEvent* event, CacheLine* line,
                 sendResponseDown(reqEvent, line, true, true);
                 line->setState(I);
             } else if (reqEvent->getCmd() == Command::GetX || reqEvent->getCmd() == Command::GetSX) {
-                line->setOwner(reqEvent->getSrc());
-                if (line->isSharer(reqEvent->getSrc())) line->removeSharer(reqEvent->getSrc());
+                line->setOwner(reqEvent->getSrcId());
+                if (line->isSharer(reqEvent->getSrcId())) line->removeSharer(reqEvent->getSrcId());
                 sendTime = sendResponseUp(reqEvent, line->getData(), true, line->getTimestamp());
                 line->setTimestamp(sendTime);
                 line->setState(M);
@@ -964,7 +964,7 @@ CacheAction MESIController::handlePutSRequest(MemEvent* event, CacheLine* line,
         case SM_Inv:
             if (reqEvent->getCmd() == Command::Inv) {
                 if (line->numSharers() > 0) { // Possible that GetX requestor was never invalidated
-                    invalidateAllSharers(line, reqEvent->getRqstr(), true);
+                    invalidateAllSharers(line, reqEvent->getRqstrId(), true);
                     return IGNORE;
                 } else {
                     sendAckInv(reqEvent);
@@ -1020,7 +1020,7 @@ CacheAction MESIController::handlePutMRequest(MemEvent* event, CacheLine* cacheL
         }
     } 
     if (event->getDirty() || !inclusive_) {
-        cacheLine->setData(event->getPayload(), 0);
+        cacheLine->setData(event->getSharedPayload(), 0);
     }
     cacheLine->clearOwner();
             
@@ -1037,15 +1037,15 @@ CacheAction MESIController::handlePutMRequest(MemEvent* event, CacheLine* cacheL
         /* Races with evictions */
         case EI:
             if (event->getCmd() == Command::PutM) {
-                sendWriteback(Command::PutM, cacheLine, true, parent->getName());
+                sendWriteback(Command::PutM, cacheLine, true, parentId_);
             } else {
-                sendWriteback(Command::PutE, cacheLine, false, parent->getName());
+                sendWriteback(Command::PutE, cacheLine, false, parentId_);
             }
 	    cacheLine->setState(I);    // wait for ack
             if (expectWritebackAck_) mshr_->insertWriteback(cacheLine->getBaseAddr());
             break;
         case MI:
-            sendWriteback(Command::PutM, cacheLine, true, parent->getName());
+            sendWriteback(Command::PutM, cacheLine, true, parentId_);
 	    cacheLine->setState(I);    // wait for ack
             if (expectWritebackAck_) mshr_->insertWriteback(cacheLine->getBaseAddr());
             break;
@@ -1071,7 +1071,7 @@ CacheAction MESIController::handlePutMRequest(MemEvent* event, CacheLine* cacheL
             } else {
                 cacheLine->setState(M);
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::WRITE, NotifyResultType::HIT);
-                cacheLine->setOwner(reqEvent->getSrc());
+                cacheLine->setOwner(reqEvent->getSrcId());
                 sendTime = sendResponseUp(reqEvent, cacheLine->getData(), true, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
             
@@ -1092,15 +1092,15 @@ CacheAction MESIController::handlePutMRequest(MemEvent* event, CacheLine* cacheL
             } else if (!inclusive_) { // Race with GetS
                 sendTime = sendResponseUp(reqEvent, Command::GetXResp, cacheLine->getData(), (cacheLine->getState() == M), true, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
-                cacheLine->setOwner(reqEvent->getSrc());
+                cacheLine->setOwner(reqEvent->getSrcId());
             } else if (protocol_) {
                 if (is_debug_addr(cacheLine->getBaseAddr())) debug->debug(_L7_, "New owner: %s\n", reqEvent->getSrc().c_str());
                 
-                cacheLine->setOwner(reqEvent->getSrc());
+                cacheLine->setOwner(reqEvent->getSrcId());
                 sendTime = sendResponseUp(reqEvent, Command::GetXResp, cacheLine->getData(), true, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
             } else {
-                cacheLine->addSharer(reqEvent->getSrc());
+                cacheLine->addSharer(reqEvent->getSrcId());
                 sendTime = sendResponseUp(reqEvent, cacheLine->getData(), true, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
             }
@@ -1134,7 +1134,7 @@ CacheAction MESIController::handleInv(MemEvent* event, CacheLine* cacheLine, boo
         case S_B:
         case S:
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 if (state == S) cacheLine->setState(S_Inv);
                 else cacheLine->setState(SB_Inv);
                 return STALL;
@@ -1145,7 +1145,7 @@ CacheAction MESIController::handleInv(MemEvent* event, CacheLine* cacheLine, boo
             return DONE;
         case SM:
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(SM_Inv);
                 return STALL;
             }
@@ -1184,7 +1184,7 @@ CacheAction MESIController::handleForceInv(MemEvent * event, CacheLine * cacheLi
         case S_B:
         case S:
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 if (state == S) cacheLine->setState(S_Inv);
                 else cacheLine->setState(SB_Inv);
                 return STALL;
@@ -1195,7 +1195,7 @@ CacheAction MESIController::handleForceInv(MemEvent * event, CacheLine * cacheLi
             return DONE;
         case SM:
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(SM_Inv);
                 return STALL;
             }
@@ -1212,13 +1212,13 @@ CacheAction MESIController::handleForceInv(MemEvent * event, CacheLine * cacheLi
         case E:
         case M:
             if (cacheLine->ownerExists()) {
-                sendForceInv(cacheLine, event->getRqstr(), replay);
+                sendForceInv(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(M_Inv);
                 return STALL;
             }
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(M_Inv);
                 return STALL;
             }
@@ -1263,14 +1263,14 @@ CacheAction MESIController::handleFetchInv(MemEvent * event, CacheLine * cacheLi
             return IGNORE;
         case S: // Happens when there is a non-inclusive cache below us
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(S_Inv);
                 return STALL;
             }
             break;
         case S_B:
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(SB_Inv);
                 return STALL;
             }
@@ -1279,7 +1279,7 @@ CacheAction MESIController::handleFetchInv(MemEvent * event, CacheLine * cacheLi
             return DONE;
         case SM:
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(SM_Inv);
                 return STALL;
             }
@@ -1288,26 +1288,26 @@ CacheAction MESIController::handleFetchInv(MemEvent * event, CacheLine * cacheLi
             return DONE;
         case E:
             if (cacheLine->ownerExists()) {
-                sendFetchInv(cacheLine, event->getRqstr(), replay);
+                sendFetchInv(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(E_Inv);
                 return STALL;
             }
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(E_Inv);
                 return STALL;
             }
             break;
         case M:
             if (cacheLine->ownerExists()) {
-                sendFetchInv(cacheLine, event->getRqstr(), replay);
+                sendFetchInv(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(M_Inv);
                 return STALL;
             }
             if (cacheLine->numSharers() > 0) {
-                invalidateAllSharers(cacheLine, event->getRqstr(), replay);
+                invalidateAllSharers(cacheLine, event->getRqstrId(), replay);
                 cacheLine->setState(M_Inv);
                 return STALL;
             }
@@ -1357,7 +1357,7 @@ CacheAction MESIController::handleFetchInvX(MemEvent * event, CacheLine * cacheL
             return IGNORE;
         case E:
             if (cacheLine->ownerExists()) {
-                sendFetchInvX(cacheLine, event->getRqstr(), replay);
+                sendFetchInvX(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(E_InvX);
                 return STALL;
@@ -1365,7 +1365,7 @@ CacheAction MESIController::handleFetchInvX(MemEvent * event, CacheLine * cacheL
             break;
         case M:
             if (cacheLine->ownerExists()) {
-                sendFetchInvX(cacheLine, event->getRqstr(), replay);
+                sendFetchInvX(cacheLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 cacheLine->setState(M_InvX);
                 return STALL;
@@ -1432,7 +1432,7 @@ CacheAction MESIController::handleDataResponse(MemEvent* responseEvent, CacheLin
     origRequest->setMemFlags(responseEvent->getMemFlags());
 
     if (!inclusive_ && (cacheLine == NULL || cacheLine->getState() == I)) {
-        uint64_t sendTime = sendResponseUp(origRequest, responseEvent->getCmd(), &responseEvent->getPayload(), responseEvent->getDirty(), true, 0);
+        uint64_t sendTime = sendResponseUp(origRequest, responseEvent->getCmd(), &responseEvent->getSharedPayload(), responseEvent->getDirty(), true, 0);
         if (cacheLine != NULL) cacheLine->setTimestamp(sendTime);
         return DONE;
     }
@@ -1440,13 +1440,13 @@ CacheAction MESIController::handleDataResponse(MemEvent* responseEvent, CacheLin
     State state = cacheLine->getState();
     recordStateEventCount(responseEvent->getCmd(), state);
     
-    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstr() == parent->getName()));
+    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstrId() == parentId_));
     
     uint64_t sendTime = 0;
     
     switch (state) {
         case IS:
-            cacheLine->setData(responseEvent->getPayload(), 0);
+            cacheLine->setData(responseEvent->getSharedPayload(), 0);
             
             if (is_debug_event(responseEvent)) printData(cacheLine->getData(), true);
             
@@ -1457,14 +1457,14 @@ CacheAction MESIController::handleDataResponse(MemEvent* responseEvent, CacheLin
             if (!shouldRespond) return DONE;
             
             if (!inclusive_ && cacheLine->getState() != S) { // Transfer E/M permission
-                cacheLine->setOwner(origRequest->getSrc());
-                sendTime = sendResponseUp(origRequest, Command::GetXResp, &responseEvent->getPayload(), state == M, true, cacheLine->getTimestamp());
+                cacheLine->setOwner(origRequest->getSrcId());
+                sendTime = sendResponseUp(origRequest, Command::GetXResp, &responseEvent->getSharedPayload(), state == M, true, cacheLine->getTimestamp());
             } else if (protocol_ && cacheLine->getState() != S) { // Send exclusive response
-                cacheLine->setOwner(origRequest->getSrc());
-                sendTime = sendResponseUp(origRequest, Command::GetXResp, &responseEvent->getPayload(), true, cacheLine->getTimestamp());
+                cacheLine->setOwner(origRequest->getSrcId());
+                sendTime = sendResponseUp(origRequest, Command::GetXResp, &responseEvent->getSharedPayload(), true, cacheLine->getTimestamp());
             } else { // Default shared response
-                cacheLine->addSharer(origRequest->getSrc());
-                sendTime = sendResponseUp(origRequest, &responseEvent->getPayload(), true, cacheLine->getTimestamp());
+                cacheLine->addSharer(origRequest->getSrcId());
+                sendTime = sendResponseUp(origRequest, &responseEvent->getSharedPayload(), true, cacheLine->getTimestamp());
             }
 
             cacheLine->setTimestamp(sendTime);
@@ -1473,13 +1473,13 @@ CacheAction MESIController::handleDataResponse(MemEvent* responseEvent, CacheLin
             
             return DONE;
         case IM:
-            cacheLine->setData(responseEvent->getPayload(), 0);
+            cacheLine->setData(responseEvent->getSharedPayload(), 0);
             
             if (is_debug_event(responseEvent)) printData(cacheLine->getData(), true);
         case SM:
             cacheLine->setState(M);
-            cacheLine->setOwner(origRequest->getSrc());
-            if (cacheLine->isSharer(origRequest->getSrc())) cacheLine->removeSharer(origRequest->getSrc());
+            cacheLine->setOwner(origRequest->getSrcId());
+            if (cacheLine->isSharer(origRequest->getSrcId())) cacheLine->removeSharer(origRequest->getSrcId());
             notifyListenerOfAccess(origRequest, NotifyAccessType::WRITE, NotifyResultType::HIT);
             sendTime = sendResponseUp(origRequest, cacheLine->getData(), true, cacheLine->getTimestamp());
             cacheLine->setTimestamp(sendTime);
@@ -1509,7 +1509,7 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
     CacheAction action = (mshr_->getAcksNeeded(responseEvent->getBaseAddr()) == 0) ? DONE : IGNORE;
 
     // Update data
-    if (state != I) cacheLine->setData(responseEvent->getPayload(), 0);
+    if (state != I) cacheLine->setData(responseEvent->getSharedPayload(), 0);
     
     if (state != I && (is_debug_event(responseEvent))) printData(cacheLine->getData(), true);
 
@@ -1530,25 +1530,25 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
             sendResponseDownFromMSHR(responseEvent, reqEvent, responseEvent->getDirty());
             break;
         case EI:
-            sendWriteback(responseEvent->getDirty() ? Command::PutM : Command::PutE, cacheLine, responseEvent->getDirty(), parent->getName());
+            sendWriteback(responseEvent->getDirty() ? Command::PutM : Command::PutE, cacheLine, responseEvent->getDirty(), parentId_);
 	    cacheLine->setState(I);    // wait for ack
             if (expectWritebackAck_) mshr_->insertWriteback(cacheLine->getBaseAddr());
             break;
         case MI:
-            sendWriteback(Command::PutM, cacheLine, true, parent->getName());
+            sendWriteback(Command::PutM, cacheLine, true, parentId_);
 	    cacheLine->setState(I);    // wait for ack
             if (expectWritebackAck_) mshr_->insertWriteback(cacheLine->getBaseAddr());
             break;
         case E_InvX:
             cacheLine->clearOwner();
-            cacheLine->addSharer(responseEvent->getSrc());
+            cacheLine->addSharer(responseEvent->getSrcId());
             if (reqEvent->getCmd() == Command::FetchInvX) {
                 sendResponseDownFromMSHR(responseEvent, reqEvent, responseEvent->getDirty());
                 cacheLine->setState(S);
             } else if (reqEvent->getCmd() == Command::FlushLine) {
                 if (responseEvent->getDirty()) {
                     cacheLine->setState(M);
-                    cacheLine->setData(responseEvent->getPayload(), 0);
+                    cacheLine->setData(responseEvent->getSharedPayload(), 0);
                 } else {
                     cacheLine->setState(E);
                 }
@@ -1556,10 +1556,10 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
                 break;
             } else if (reqEvent->getCmd() == Command::FetchInv) {    // Raced with FlushLine
                 if (responseEvent->getDirty()) {
-                    cacheLine->setData(responseEvent->getPayload(), 0);
+                    cacheLine->setData(responseEvent->getSharedPayload(), 0);
                 }
                 if (cacheLine->numSharers() > 0) {
-                    invalidateAllSharers(cacheLine, reqEvent->getRqstr(), true);
+                    invalidateAllSharers(cacheLine, reqEvent->getRqstrId(), true);
                     responseEvent->getDirty() ? cacheLine->setState(M_Inv) : cacheLine->setState(E_Inv);
                     return STALL;
                 }
@@ -1568,10 +1568,10 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
                 break;
             } else {
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
-                cacheLine->addSharer(reqEvent->getSrc());
+                cacheLine->addSharer(reqEvent->getSrcId());
                 if (responseEvent->getDirty()) {
                     cacheLine->setState(M);
-                    cacheLine->setData(responseEvent->getPayload(), 0);
+                    cacheLine->setData(responseEvent->getSharedPayload(), 0);
                 } else cacheLine->setState(E);
                 sendTime = sendResponseUp(reqEvent, cacheLine->getData(), true, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
@@ -1580,11 +1580,11 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
         case E_Inv:
             if (reqEvent->getCmd() == Command::FlushLineInv) {
                 
-                if (cacheLine->isSharer(responseEvent->getSrc())) cacheLine->removeSharer(responseEvent->getSrc());
-                if (cacheLine->getOwner() == responseEvent->getSrc()) cacheLine->clearOwner();
+                if (cacheLine->isSharer(responseEvent->getSrcId())) cacheLine->removeSharer(responseEvent->getSrcId());
+                if (cacheLine->getOwner() == responseEvent->getSrcId()) cacheLine->clearOwner();
                 if (responseEvent->getDirty()) {
                     cacheLine->setState(M);
-                    cacheLine->setData(responseEvent->getPayload(), 0);
+                    cacheLine->setData(responseEvent->getSharedPayload(), 0);
                 } else cacheLine->setState(E);
                 if (action != DONE) { // Sanity check...
                     debug->fatal(CALL_INFO, -1, "%s, Error: Received a FetchResp to a FlushLineInv but still waiting on more acks. Event = %s. Time = %" PRIu64 "ns\n",
@@ -1593,21 +1593,21 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
                 action = handleFlushLineInvRequest(reqEvent, cacheLine, NULL, true);
                 break;
             }
-            if (cacheLine->isSharer(responseEvent->getSrc())) cacheLine->removeSharer(responseEvent->getSrc());
-            if (cacheLine->getOwner() == responseEvent->getSrc()) cacheLine->clearOwner();
+            if (cacheLine->isSharer(responseEvent->getSrcId())) cacheLine->removeSharer(responseEvent->getSrcId());
+            if (cacheLine->getOwner() == responseEvent->getSrcId()) cacheLine->clearOwner();
             sendResponseDown(reqEvent, cacheLine, responseEvent->getDirty(), true);
             cacheLine->setState(I);
             break;
         case M_InvX:
             cacheLine->clearOwner();
-            cacheLine->addSharer(responseEvent->getSrc());
+            cacheLine->addSharer(responseEvent->getSrcId());
             if (reqEvent->getCmd() == Command::FetchInvX) {
                 sendResponseDown(reqEvent, cacheLine, true, true);
                 cacheLine->setState(S);
             } else if (reqEvent->getCmd() == Command::FlushLine) {
                 if (responseEvent->getDirty()) {
                     cacheLine->setState(M);
-                    cacheLine->setData(responseEvent->getPayload(), 0);
+                    cacheLine->setData(responseEvent->getSharedPayload(), 0);
                 } else {
                     cacheLine->setState(E);
                 }
@@ -1615,10 +1615,10 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
                 break;
             } else if (reqEvent->getCmd() == Command::FetchInv) {
                 if (responseEvent->getDirty()) {
-                    cacheLine->setData(responseEvent->getPayload(), 0);
+                    cacheLine->setData(responseEvent->getSharedPayload(), 0);
                 }
                 if (cacheLine->numSharers() > 0) {
-                    invalidateAllSharers(cacheLine, reqEvent->getRqstr(), true);
+                    invalidateAllSharers(cacheLine, reqEvent->getRqstrId(), true);
                     cacheLine->setState(M_Inv);
                     return STALL;
                 }
@@ -1627,7 +1627,7 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
                 break;
             } else {    // reqEvent->getCmd() == GetS
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
-                cacheLine->addSharer(reqEvent->getSrc());
+                cacheLine->addSharer(reqEvent->getSrcId());
                 sendTime = sendResponseUp(reqEvent, cacheLine->getData(), true, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
                 cacheLine->setState(M);
@@ -1636,8 +1636,8 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
         case M_Inv:
             cacheLine->clearOwner();
             if (reqEvent->getCmd() == Command::FlushLineInv) {
-                if (cacheLine->getOwner() == responseEvent->getSrc()) cacheLine->clearOwner();
-                if (responseEvent->getDirty()) cacheLine->setData(responseEvent->getPayload(), 0);
+                if (cacheLine->getOwner() == responseEvent->getSrcId()) cacheLine->clearOwner();
+                if (responseEvent->getDirty()) cacheLine->setData(responseEvent->getSharedPayload(), 0);
                 cacheLine->setState(M);
                 if (action != DONE) { // Sanity check...
                     debug->fatal(CALL_INFO, -1, "%s, Error: Received a FetchResp to a FlushLineInv but still waiting on more acks. Event = %s. Time = %" PRIu64 "ns\n",
@@ -1650,8 +1650,8 @@ CacheAction MESIController::handleFetchResp(MemEvent * responseEvent, CacheLine*
                 cacheLine->setState(I);
             } else {    // reqEvent->getCmd() == GetX
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::WRITE, NotifyResultType::HIT);
-                cacheLine->setOwner(reqEvent->getSrc());
-                if (cacheLine->isSharer(reqEvent->getSrc())) cacheLine->removeSharer(reqEvent->getSrc());
+                cacheLine->setOwner(reqEvent->getSrcId());
+                if (cacheLine->isSharer(reqEvent->getSrcId())) cacheLine->removeSharer(reqEvent->getSrcId());
                 sendTime = sendResponseUp(reqEvent, cacheLine->getData(), true, cacheLine->getTimestamp());
                 cacheLine->setTimestamp(sendTime);
                 
@@ -1676,10 +1676,10 @@ CacheAction MESIController::handleAckInv(MemEvent * ack, CacheLine * line, MemEv
     
     recordStateEventCount(ack->getCmd(), state);
 
-    if (line && line->isSharer(ack->getSrc())) {
-        line->removeSharer(ack->getSrc());
+    if (line && line->isSharer(ack->getSrcId())) {
+        line->removeSharer(ack->getSrcId());
     }
-    if (line && line->getOwner() == ack->getSrc()) {
+    if (line && line->getOwner() == ack->getSrcId()) {
         line->clearOwner();
     }
     
@@ -1717,7 +1717,7 @@ CacheAction MESIController::handleAckInv(MemEvent * ack, CacheLine * line, MemEv
             if (action == DONE) {
                 if (reqEvent->getCmd() == Command::Inv || reqEvent->getCmd() == Command::ForceInv) {
                     if (line->numSharers() > 0) { // May not have invalidated GetX requestor
-                        invalidateAllSharers(line, reqEvent->getRqstr(), true);
+                        invalidateAllSharers(line, reqEvent->getRqstrId(), true);
                         return IGNORE;
                     } else {
                         sendAckInv(reqEvent);
@@ -1735,7 +1735,7 @@ CacheAction MESIController::handleAckInv(MemEvent * ack, CacheLine * line, MemEv
         case SB_Inv:
             if (action == DONE) {
                 if (line->numSharers() > 0) {
-                    invalidateAllSharers(line, reqEvent->getRqstr(), true);
+                    invalidateAllSharers(line, reqEvent->getRqstrId(), true);
                     return IGNORE;
                 }
                 sendAckInv(ack);
@@ -1744,21 +1744,21 @@ CacheAction MESIController::handleAckInv(MemEvent * ack, CacheLine * line, MemEv
             return action;
         case SI:
             if (action == DONE) {
-                sendWriteback(Command::PutS, line, false, parent->getName());
+                sendWriteback(Command::PutS, line, false, parentId_);
                 if (expectWritebackAck_) mshr_->insertWriteback(line->getBaseAddr());
                 line->setState(I);
             }
             return action;
         case EI:
             if (action == DONE) {
-                sendWriteback(Command::PutE, line, false, parent->getName());
+                sendWriteback(Command::PutE, line, false, parentId_);
                 if (expectWritebackAck_) mshr_->insertWriteback(line->getBaseAddr());
                 line->setState(I);
             }
             return action;
         case MI:
             if (action == DONE) {
-                sendWriteback(Command::PutM, line, true, parent->getName());
+                sendWriteback(Command::PutM, line, true, parentId_);
                 if (expectWritebackAck_) mshr_->insertWriteback(line->getBaseAddr());
                 line->setState(I);
             }
@@ -1790,8 +1790,8 @@ CacheAction MESIController::handleAckInv(MemEvent * ack, CacheLine * line, MemEv
                     line->setState(I);  
                 } else { // reqEvent->getCmd() == GetX/GetSX
                     notifyListenerOfAccess(reqEvent, NotifyAccessType::WRITE, NotifyResultType::HIT);
-                    line->setOwner(reqEvent->getSrc());
-                    if (line->isSharer(reqEvent->getSrc())) line->removeSharer(reqEvent->getSrc());
+                    line->setOwner(reqEvent->getSrcId());
+                    if (line->isSharer(reqEvent->getSrcId())) line->removeSharer(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, line->getData(), true, line->getTimestamp());
                     line->setTimestamp(sendTime);
                     
@@ -1828,11 +1828,10 @@ CacheAction MESIController::handleAckInv(MemEvent * ack, CacheLine * line, MemEv
 /**
  *  Send an Inv to all sharers of the block. Used for evictions or Inv/FetchInv requests from lower level caches
  */
-void MESIController::invalidateAllSharers(CacheLine * cacheLine, string rqstr, bool replay) {
-    set<std::string> * sharers = cacheLine->getSharers();
+void MESIController::invalidateAllSharers(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
     uint64_t deliveryTime = 0;
-    for (set<std::string>::iterator it = sharers->begin(); it != sharers->end(); it++) {
-        MemEvent * inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
+    for (CacheLine::SharerIterator it = cacheLine->sharersBegin(); it != cacheLine->sharersEnd(); ++it) {
+        MemEvent * inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
         inv->setDst(*it);
         inv->setRqstr(rqstr);
         inv->setSize(cacheLine->getSize());
@@ -1846,7 +1845,7 @@ void MESIController::invalidateAllSharers(CacheLine * cacheLine, string rqstr, b
 
         if (is_debug_addr(cacheLine->getBaseAddr())) {
             debug->debug(_L7_,"Sending inv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                    cacheLine->getBaseAddr(), (*it).c_str(), deliveryTime);
+                    cacheLine->getBaseAddr(), EndpointNames::name(*it).c_str(), deliveryTime);
         }
     }
     if (deliveryTime != 0) cacheLine->setTimestamp(deliveryTime);
@@ -1857,14 +1856,13 @@ void MESIController::invalidateAllSharers(CacheLine * cacheLine, string rqstr, b
  *  Send an Inv to all sharers unless the cache requesting exclusive permission is a sharer; then send Inv to all sharers except requestor. 
  *  Used for GetX/GetSX requests.
  */
-bool MESIController::invalidateSharersExceptRequestor(CacheLine * cacheLine, string rqstr, string origRqstr, bool replay) {
+bool MESIController::invalidateSharersExceptRequestor(CacheLine * cacheLine, EndpointId rqstr, EndpointId origRqstr, bool replay) {
     bool sentInv = false;
-    set<std::string> * sharers = cacheLine->getSharers();
     uint64_t deliveryTime = 0;
-    for (set<std::string>::iterator it = sharers->begin(); it != sharers->end(); it++) {
+    for (CacheLine::SharerIterator it = cacheLine->sharersBegin(); it != cacheLine->sharersEnd(); ++it) {
         if (*it == rqstr) continue;
 
-        MemEvent * inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
+        MemEvent * inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
         inv->setDst(*it);
         inv->setRqstr(origRqstr);
         inv->setSize(cacheLine->getSize());
@@ -1879,7 +1877,7 @@ bool MESIController::invalidateSharersExceptRequestor(CacheLine * cacheLine, str
         
         if (is_debug_addr(cacheLine->getBaseAddr())) {
             debug->debug(_L7_,"Sending inv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                    cacheLine->getBaseAddr(), (*it).c_str(), deliveryTime);
+                    cacheLine->getBaseAddr(), EndpointNames::name(*it).c_str(), deliveryTime);
         }
     }
     if (deliveryTime != 0) cacheLine->setTimestamp(deliveryTime);
@@ -1890,8 +1888,8 @@ bool MESIController::invalidateSharersExceptRequestor(CacheLine * cacheLine, str
 /**
  *  Send FetchInv to owner of a block
  */
-void MESIController::sendFetchInv(CacheLine * cacheLine, string rqstr, bool replay) {
-    MemEvent * fetch = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
+void MESIController::sendFetchInv(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
+    MemEvent * fetch = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
     fetch->setDst(cacheLine->getOwner());
     fetch->setRqstr(rqstr);
     fetch->setSize(cacheLine->getSize());
@@ -1904,7 +1902,7 @@ void MESIController::sendFetchInv(CacheLine * cacheLine, string rqstr, bool repl
    
     if (is_debug_addr(cacheLine->getBaseAddr())) {
         debug->debug(_L7_, "Sending FetchInv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                cacheLine->getBaseAddr(), cacheLine->getOwner().c_str(), deliveryTime);
+                cacheLine->getBaseAddr(), EndpointNames::name(cacheLine->getOwner()).c_str(), deliveryTime);
     }
 }
 
@@ -1912,8 +1910,8 @@ void MESIController::sendFetchInv(CacheLine * cacheLine, string rqstr, bool repl
 /** 
  *  Send FetchInv to owner of a block
  */
-void MESIController::sendFetchInvX(CacheLine * cacheLine, string rqstr, bool replay) {
-    MemEvent * fetch = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInvX);
+void MESIController::sendFetchInvX(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
+    MemEvent * fetch = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInvX);
     fetch->setDst(cacheLine->getOwner());
     fetch->setRqstr(rqstr);
     fetch->setSize(cacheLine->getSize());
@@ -1926,7 +1924,7 @@ void MESIController::sendFetchInvX(CacheLine * cacheLine, string rqstr, bool rep
     
     if (is_debug_addr(cacheLine->getBaseAddr())) {
         debug->debug(_L7_, "Sending FetchInvX: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                cacheLine->getBaseAddr(), cacheLine->getOwner().c_str(), deliveryTime);
+                cacheLine->getBaseAddr(), EndpointNames::name(cacheLine->getOwner()).c_str(), deliveryTime);
     }
 }
 
@@ -1934,8 +1932,8 @@ void MESIController::sendFetchInvX(CacheLine * cacheLine, string rqstr, bool rep
 /**
  *  Send ForceInv to block owner
  */
-void MESIController::sendForceInv(CacheLine * cacheLine, string rqstr, bool replay) {
-    MemEvent * inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::ForceInv);
+void MESIController::sendForceInv(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
+    MemEvent * inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::ForceInv);
     inv->setDst(cacheLine->getOwner());
     inv->setRqstr(rqstr);
     inv->setSize(cacheLine->getSize());
@@ -1948,7 +1946,7 @@ void MESIController::sendForceInv(CacheLine * cacheLine, string rqstr, bool repl
     
     if (is_debug_addr(cacheLine->getBaseAddr())) {
         debug->debug(_L7_, "Sending ForceInv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                cacheLine->getBaseAddr(), cacheLine->getOwner().c_str(), deliveryTime);
+                cacheLine->getBaseAddr(), EndpointNames::name(cacheLine->getOwner()).c_str(), deliveryTime);
     }
 }
 
@@ -1959,7 +1957,7 @@ void MESIController::sendForceInv(CacheLine * cacheLine, string rqstr, bool repl
  */
 void MESIController::forwardMessageUp(MemEvent* event) {
     MemEvent * forwardEvent = new MemEvent(*event);
-    forwardEvent->setSrc(parent->getName());
+    forwardEvent->setSrc(parentId_);
     forwardEvent->setDst(getSrc());
     
     uint64_t deliveryTime = timestamp_ + tagLatency_;
@@ -2001,7 +1999,7 @@ void MESIController::sendResponseDown(MemEvent* event, CacheLine* cacheLine, boo
  */
 void MESIController::sendResponseDownFromMSHR(MemEvent * respEvent, MemEvent * reqEvent, bool dirty) {
     MemEvent * newResponseEvent = reqEvent->makeResponse();
-    newResponseEvent->setPayload(respEvent->getPayload());
+    newResponseEvent->copyPayload(respEvent);
     newResponseEvent->setSize(respEvent->getSize());
     newResponseEvent->setDirty(dirty);
 
@@ -2019,8 +2017,9 @@ void MESIController::sendResponseDownFromMSHR(MemEvent * respEvent, MemEvent * r
  *  Handles: sending writebacks
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
-void MESIController::sendWriteback(Command cmd, CacheLine* cacheLine, bool dirty, string rqstr) {
-    MemEvent* newCommandEvent = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+void MESIController::sendWriteback(Command cmd, CacheLine* cacheLine, bool dirty, EndpointId rqstr) {
+    MemEvent* newCommandEvent = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), cmd);
+    if (timingOnly_) newCommandEvent->setDataless();
     newCommandEvent->setDst(getDestination(cacheLine->getBaseAddr()));
     newCommandEvent->setSize(cacheLine->getSize());
     bool hasData = false;
@@ -2049,9 +2048,9 @@ void MESIController::sendWriteback(Command cmd, CacheLine* cacheLine, bool dirty
  *  Send a writeback ack. Mostly used by non-inclusive caches.
  */
 void MESIController::sendWritebackAck(MemEvent * event) {
-    MemEvent * ack = new MemEvent(parent, event->getBaseAddr(), event->getBaseAddr(), Command::AckPut);
-    ack->setDst(event->getSrc());
-    ack->setRqstr(event->getSrc());
+    MemEvent * ack = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), event->getBaseAddr(), event->getBaseAddr(), Command::AckPut);
+    ack->setDst(event->getSrcId());
+    ack->setRqstr(event->getSrcId());
     ack->setSize(event->getSize());
 
     uint64_t deliveryTime = timestamp_ + tagLatency_;
@@ -2083,8 +2082,9 @@ void MESIController::sendAckInv(MemEvent * inv) {
 /**
  *  Forward a flush line request, with or without data
  */
-void MESIController::forwardFlushLine(Addr baseAddr, string origRqstr, CacheLine * cacheLine, Command cmd) {
-    MemEvent * flush = new MemEvent(parent, baseAddr, baseAddr, cmd);
+void MESIController::forwardFlushLine(Addr baseAddr, EndpointId origRqstr, CacheLine * cacheLine, Command cmd) {
+    MemEvent * flush = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), baseAddr, baseAddr, cmd);
+    if (timingOnly_) flush->setDataless();
     flush->setDst(getDestination(baseAddr));
     flush->setRqstr(origRqstr);
     flush->setSize(lineSize_);
@@ -2114,7 +2114,7 @@ void MESIController::forwardFlushLine(Addr baseAddr, string origRqstr, CacheLine
 void MESIController::sendFlushResponse(MemEvent * requestEvent, bool success) {
     MemEvent * flushResponse = requestEvent->makeResponse();
     flushResponse->setSuccess(success);
-    flushResponse->setDst(requestEvent->getSrc());
+    flushResponse->setDst(requestEvent->getSrcId());
 
     uint64_t deliveryTime = timestamp_ + mshrLatency_;
     Response resp = {flushResponse, deliveryTime, packetHeaderBytes};
@@ -2145,7 +2145,7 @@ void MESIController::addToOutgoingQueueUp(Response& resp) {
 
 
 /** Print value of data blocks for debugging */
-void MESIController::printData(vector<uint8_t> * data, bool set) {
+void MESIController::printData(const SharedPayload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
     
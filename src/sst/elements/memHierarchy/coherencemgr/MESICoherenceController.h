@@ -463,7 +463,7 @@ public:
 
 /* Event handlers */
     /** Send cacheline data to the lower level caches */
-    CacheAction handleEviction(CacheLine* wbCacheLine, string origRqstr, bool ignoredParam=false);
+    CacheAction handleEviction(CacheLine* wbCacheLine, EndpointId origRqstr, bool ignoredParam=false);
 
     /** Process cache request:  GetX, GetS, GetSX */
     CacheAction handleRequest(MemEvent* event, CacheLine* cacheLine, bool replay);
@@ -742,7 +742,7 @@ private:
     void sendResponseDownFromMSHR(MemEvent* response, MemEvent * request, bool dirty);
 
     /** Send writeback request to lower level caches */
-    void sendWriteback(Command cmd, CacheLine* cacheLine, bool dirty, string origRqstr);
+    void sendWriteback(Command cmd, CacheLine* cacheLine, bool dirty, EndpointId origRqstr);
     
     /** Send AckPut to upper level cache */
     void sendWritebackAck(MemEvent * event);
@@ -751,28 +751,28 @@ private:
     void sendAckInv(MemEvent * event);
 
     /** Fetch data from owner and invalidate their copy of the line */
-    void sendFetchInv(CacheLine * cacheLine, string rqstr, bool replay);
+    void sendFetchInv(CacheLine * cacheLine, EndpointId rqstr, bool replay);
     
     /** Fetch data from owner and downgrade owner to sharer */
-    void sendFetchInvX(CacheLine * cacheLine, string rqstr, bool replay);
+    void sendFetchInvX(CacheLine * cacheLine, EndpointId rqstr, bool replay);
 
     /** Force invalidation of line from owner, do not request data */
-    void sendForceInv(CacheLine * cacheLine, string rqstr, bool replay);
+    void sendForceInv(CacheLine * cacheLine, EndpointId rqstr, bool replay);
     /** Invalidate all sharers of a block. Used for invalidations and evictions */
-    void invalidateAllSharers(CacheLine * cacheLine, string rqstr, bool replay);
+    void invalidateAllSharers(CacheLine * cacheLine, EndpointId rqstr, bool replay);
     
     /** Invalidate all sharers of a block except the requestor (rqstr). Used for upgrade requests. */
-    bool invalidateSharersExceptRequestor(CacheLine * cacheLine, string rqstr, string origRqstr, bool replay);
+    bool invalidateSharersExceptRequestor(CacheLine * cacheLine, EndpointId rqstr, EndpointId origRqstr, bool replay);
     
     /** Send a flush response */
     void sendFlushResponse(MemEvent * reqEent, bool success);
     
     /** Forward a FlushLine request with or without data */
-    void forwardFlushLine(Addr baseAddr, string origRqstr, CacheLine * cacheLine, Command cmd);
+    void forwardFlushLine(Addr baseAddr, EndpointId origRqstr, CacheLine * cacheLine, Command cmd);
 
 /* Helper methods */
    
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(const SharedPayload* data, bool set);
 
 /* Statistics */
     void recordStateEventCount(Command cmd, State state);
@@ -45,7 +45,7 @@ using namespace SST::MemHierarchy;
  *  Directory evictions will also trigger a cache eviction if the block is locally cached
  *  Return whether the eviction is complete (DONE) or not (STALL)
  */
-CacheAction MESIInternalDirectory::handleEviction(CacheLine* replacementLine, string origRqstr, bool fromDataCache) {
+CacheAction MESIInternalDirectory::handleEviction(CacheLine* replacementLine, EndpointId origRqstr, bool fromDataCache) {
     State state = replacementLine->getState();
     
     recordEvictionState(state);
@@ -60,9 +60,9 @@ CacheAction MESIInternalDirectory::handleEviction(CacheLine* replacementLine, st
     bool collision = (waitingEvent != NULL && (waitingEvent->getCmd() == Command::PutS || waitingEvent->getCmd() == Command::PutE || waitingEvent->getCmd() == Command::PutM));
     if (collision) {    // Note that 'collision' and 'fromDataCache' cannot both be true, don't need to handle that case
         if (state == E && waitingEvent->getDirty()) replacementLine->setState(M);
-        if (replacementLine->isSharer(waitingEvent->getSrc())) replacementLine->removeSharer(waitingEvent->getSrc());
+        if (replacementLine->isSharer(waitingEvent->getSrcId())) replacementLine->removeSharer(waitingEvent->getSrcId());
         else if (replacementLine->ownerExists()) replacementLine->clearOwner();
-        mshr_->setDataBuffer(waitingEvent->getBaseAddr(), waitingEvent->getPayload());
+        mshr_->setDataBuffer(waitingEvent->getBaseAddr(), waitingEvent);
         mshr_->removeFront(waitingEvent->getBaseAddr());
         delete waitingEvent;
     }
@@ -71,8 +71,8 @@ CacheAction MESIInternalDirectory::handleEviction(CacheLine* replacementLine, st
             return DONE;
         case S:
             if (replacementLine->numSharers() > 0 && !fromDataCache) {
-                if (isCached || collision) invalidateAllSharers(replacementLine, parent->getName(), false);
-                else invalidateAllSharersAndFetch(replacementLine, parent->getName(), false);    // Fetch needed for PutS
+                if (isCached || collision) invalidateAllSharers(replacementLine, parentId_, false);
+                else invalidateAllSharersAndFetch(replacementLine, parentId_, false);    // Fetch needed for PutS
                 replacementLine->setState(SI);
                 return STALL;
             }
@@ -85,12 +85,12 @@ CacheAction MESIInternalDirectory::handleEviction(CacheLine* replacementLine, st
             return DONE;
         case E:
             if (replacementLine->numSharers() > 0 && !fromDataCache) { // May or may not be cached
-                if (isCached || collision) invalidateAllSharers(replacementLine, parent->getName(), false);
-                else invalidateAllSharersAndFetch(replacementLine, parent->getName(), false);
+                if (isCached || collision) invalidateAllSharers(replacementLine, parentId_, false);
+                else invalidateAllSharersAndFetch(replacementLine, parentId_, false);
                 replacementLine->setState(EI);
                 return STALL;
             } else if (replacementLine->ownerExists() && !fromDataCache) { // Not cached
-                sendFetchInv(replacementLine, parent->getName(), false);
+                sendFetchInv(replacementLine, parentId_, false);
                 mshr_->incrementAcksNeeded(wbBaseAddr);
                 replacementLine->setState(EI);
                 return STALL;
@@ -106,12 +106,12 @@ CacheAction MESIInternalDirectory::handleEviction(CacheLine* replacementLine, st
             }
         case M:
             if (replacementLine->numSharers() > 0 && !fromDataCache) {
-                if (isCached || collision) invalidateAllSharers(replacementLine, parent->getName(), false);
-                else invalidateAllSharersAndFetch(replacementLine, parent->getName(), false);
+                if (isCached || collision) invalidateAllSharers(replacementLine, parentId_, false);
+                else invalidateAllSharersAndFetch(replacementLine, parentId_, false);
                 replacementLine->setState(MI);
                 return STALL;
             } else if (replacementLine->ownerExists() && !fromDataCache) {
-                sendFetchInv(replacementLine, parent->getName(), false);
+                sendFetchInv(replacementLine, parentId_, false);
                 mshr_->incrementAcksNeeded(wbBaseAddr);
                 replacementLine->setState(MI);
                 return STALL;
@@ -277,16 +277,16 @@ bool MESIInternalDirectory::isRetryNeeded(MemEvent * event, CacheLine * dirLine)
             return true;
         case Command::FetchInvX:
             if (state == I) return false;
-            if (dirLine->getOwner() != event->getDst()) return false;
+            if (dirLine->getOwner() != event->getDstId()) return false;
             return true;
         case Command::FetchInv:
             if (state == I) return false;
-            if ((dirLine->getOwner() != event->getDst()) && !dirLine->isSharer(event->getDst())) return false;
+            if ((dirLine->getOwner() != event->getDstId()) && !dirLine->isSharer(event->getDstId())) return false;
             return true;
         case Command::Fetch:
         case Command::Inv:
             if (state == I) return false;
-            if (!dirLine->isSharer(event->getDst())) return false;
+            if (!dirLine->isSharer(event->getDstId())) return false;
             return true;
         default:
             debug->fatal(CALL_INFO, -1, "%s (dir), Error: Received NACK for unrecognized event: %s. Addr = 0x%" PRIx64 ", Src = %s. Time = %" PRIu64 "ns\n",
@@ -309,7 +309,7 @@ int MESIInternalDirectory::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine
     if (cmd == Command::GetSX) cmd = Command::GetX;  // for our purposes these are equal
 
     if (state == I) return 1;
-    if (event->isPrefetch() && event->getRqstr() == parent->getName()) return 0;
+    if (event->isPrefetch() && event->getRqstrId() == parentId_) return 0;
     if (state == S && lastLevel_) state = M;
     switch (state) {
         case S:
@@ -320,7 +320,7 @@ int MESIInternalDirectory::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine
             if (cacheLine->ownerExists()) return 3;
             if (cmd == Command::GetS) return 0; 
             if (cmd == Command::GetX) {
-                if (cacheLine->isShareless() || (cacheLine->isSharer(event->getSrc()) && cacheLine->numSharers() == 1)) return 0; // Hit
+                if (cacheLine->isShareless() || (cacheLine->isSharer(event->getSrcId()) && cacheLine->numSharers() == 1)) return 0; // Hit
             }
             return 3;
         case IS:
@@ -351,7 +351,7 @@ int MESIInternalDirectory::isCoherenceMiss(MemEvent* event, CacheLine* cacheLine
 CacheAction MESIInternalDirectory::handleGetSRequest(MemEvent* event, CacheLine* dirLine, bool replay) {
     State state = dirLine->getState();
     
-    bool shouldRespond = !(event->isPrefetch() && (event->getRqstr() == parent->getName()));
+    bool shouldRespond = !(event->isPrefetch() && (event->getRqstrId() == parentId_));
     recordStateEventCount(event->getCmd(), state);    
     bool isCached = dirLine->getDataLine() != NULL;
     uint64_t sendTime = 0;
@@ -366,12 +366,12 @@ CacheAction MESIInternalDirectory::handleGetSRequest(MemEvent* event, CacheLine*
             notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
             if (!shouldRespond) return DONE;
             if (isCached) {
-                dirLine->addSharer(event->getSrc());
+                dirLine->addSharer(event->getSrcId());
                 sendTime = sendResponseUp(event, dirLine->getDataLine()->getData(), replay, dirLine->getTimestamp());
                 dirLine->setTimestamp(sendTime);
                 return DONE;
             } 
-            sendFetch(dirLine, event->getRqstr(), replay);
+            sendFetch(dirLine, event->getRqstrId(), replay);
             mshr_->incrementAcksNeeded(event->getBaseAddr());
             dirLine->setState(S_D);     // Fetch in progress, block incoming invalidates/fetches/etc.
             return STALL;
@@ -380,7 +380,7 @@ CacheAction MESIInternalDirectory::handleGetSRequest(MemEvent* event, CacheLine*
             notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
             if (!shouldRespond) return DONE;
             if (dirLine->ownerExists()) {
-                sendFetchInvX(dirLine, event->getRqstr(), replay);
+                sendFetchInvX(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 if (state == E) dirLine->setState(E_InvX);
                 else dirLine->setState(M_InvX);
@@ -388,16 +388,16 @@ CacheAction MESIInternalDirectory::handleGetSRequest(MemEvent* event, CacheLine*
             } else if (isCached) {
                 if (protocol_ && dirLine->numSharers() == 0) {
                     sendTime = sendResponseUp(event, Command::GetXResp, dirLine->getDataLine()->getData(), replay, dirLine->getTimestamp());
-                    dirLine->setOwner(event->getSrc());
+                    dirLine->setOwner(event->getSrcId());
                     dirLine->setTimestamp(sendTime);
                 } else {
                     sendTime = sendResponseUp(event, dirLine->getDataLine()->getData(), replay, dirLine->getTimestamp());
-                    dirLine->addSharer(event->getSrc());
+                    dirLine->addSharer(event->getSrcId());
                     dirLine->setTimestamp(sendTime);
                 }
                 return DONE;
             } else {
-                sendFetch(dirLine, event->getRqstr(), replay);
+                sendFetch(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 if (state == E) dirLine->setState(E_D);
                 else dirLine->setState(M_D);
@@ -436,14 +436,14 @@ CacheAction MESIInternalDirectory::handleGetXRequest(MemEvent* event, CacheLine*
     switch (state) {
         case I:
             notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
-            sendTime = forwardMessage(event, dirLine->getBaseAddr(), lineSize_, 0, &event->getPayload());
+            sendTime = forwardMessage(event, dirLine->getBaseAddr(), lineSize_, 0, &event->getSharedPayload());
             dirLine->setState(IM);
             dirLine->setTimestamp(sendTime);
             return STALL;
         case S:
             notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
-            sendTime = forwardMessage(event, dirLine->getBaseAddr(), lineSize_, dirLine->getTimestamp(), &event->getPayload());
-            if (invalidateSharersExceptRequestor(dirLine, event->getSrc(), event->getRqstr(), replay, false)) {
+            sendTime = forwardMessage(event, dirLine->getBaseAddr(), lineSize_, dirLine->getTimestamp(), &event->getSharedPayload());
+            if (invalidateSharersExceptRequestor(dirLine, event->getSrcId(), event->getRqstrId(), replay, false)) {
                 dirLine->setState(SM_Inv);
             } else {
                 dirLine->setState(SM);
@@ -455,18 +455,18 @@ CacheAction MESIInternalDirectory::handleGetXRequest(MemEvent* event, CacheLine*
         case M:
             notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::HIT);
 
-            if (invalidateSharersExceptRequestor(dirLine, event->getSrc(), event->getRqstr(), replay, !isCached)) {
+            if (invalidateSharersExceptRequestor(dirLine, event->getSrcId(), event->getRqstrId(), replay, !isCached)) {
                 dirLine->setState(M_Inv);
                 return STALL;
             }
             if (dirLine->ownerExists()) {
-                sendFetchInv(dirLine, event->getRqstr(), replay);
+                sendFetchInv(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 dirLine->setState(M_Inv);
                 return STALL;
             }
-            dirLine->setOwner(event->getSrc());
-            if (dirLine->isSharer(event->getSrc())) dirLine->removeSharer(event->getSrc());
+            dirLine->setOwner(event->getSrcId());
+            if (dirLine->isSharer(event->getSrcId())) dirLine->removeSharer(event->getSrcId());
             if (isCached) sendTime = sendResponseUp(event, dirLine->getDataLine()->getData(), replay, dirLine->getTimestamp());  // is an upgrade request, requestor has data already
             else sendTime = sendResponseUp(event, NULL, replay, dirLine->getTimestamp());
             dirLine->setTimestamp(sendTime);
@@ -490,19 +490,19 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
     recordStateEventCount(event->getCmd(), state);
 
     if (state == S_D || state == E_D || state == SM_D || state == M_D) {
-        if (*(dirLine->getSharers()->begin()) == event->getSrc()) {    // Put raced with Fetch
+        if (*(dirLine->sharersBegin()) == event->getSrcId()) {    // Put raced with Fetch
             mshr_->decrementAcksNeeded(event->getBaseAddr());
         }
     } else if (mshr_->getAcksNeeded(event->getBaseAddr()) > 0) mshr_->decrementAcksNeeded(event->getBaseAddr());
 
-    if (dirLine->isSharer(event->getSrc())) {
-        dirLine->removeSharer(event->getSrc());
+    if (dirLine->isSharer(event->getSrcId())) {
+        dirLine->removeSharer(event->getSrcId());
     }
     // Set data, either to cache or to MSHR
     if (dirLine->getDataLine() != NULL) {
-        dirLine->getDataLine()->setData(event->getPayload(), 0);
+        dirLine->getDataLine()->setData(event->getSharedPayload(), 0);
         printData(dirLine->getDataLine()->getData(), true);
-    } else if (mshr_->isHit(dirLine->getBaseAddr())) mshr_->setDataBuffer(dirLine->getBaseAddr(), event->getPayload());
+    } else if (mshr_->isHit(dirLine->getBaseAddr())) mshr_->setDataBuffer(dirLine->getBaseAddr(), event);
     
     uint64_t sendTime = 0;
 
@@ -517,17 +517,17 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             sendWritebackAck(event);
             return DONE;
         case SI:
-            sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstr(), &event->getPayload());
+            sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
             if (expectWritebackAck_) mshr_->insertWriteback(event->getBaseAddr());
             dirLine->setState(I);
             return DONE;
         case EI:
-            sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstr(), &event->getPayload());
+            sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
             if (expectWritebackAck_) mshr_->insertWriteback(event->getBaseAddr());
             dirLine->setState(I);
             return DONE;
         case MI:
-            sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstr(), &event->getPayload());
+            sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
             if (expectWritebackAck_) mshr_->insertWriteback(event->getBaseAddr());
             dirLine->setState(I);
             return DONE;
@@ -547,17 +547,17 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             dirLine->setState(S);
             if (reqEvent->getCmd() == Command::Fetch) {
                 if (dirLine->getDataLine() == NULL && dirLine->numSharers() == 0) {
-                    sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstr(), &event->getPayload());
+                    sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
                     dirLine->setState(I);
                 } else {
                     sendResponseDownFromMSHR(event, false);
                 }
             } else if (reqEvent->getCmd() == Command::GetS) {    // GetS
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
-                dirLine->addSharer(reqEvent->getSrc());
-                sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                dirLine->addSharer(reqEvent->getSrcId());
+                sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                 dirLine->setTimestamp(sendTime);
-                if (is_debug_event(event)) printData(&event->getPayload(), false);
+                if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
             } else {
                 debug->fatal(CALL_INFO, -1, "%s (dir), Error: Received PutS in state %s but stalled request has command %s. Addr = 0x%" PRIx64 ". Time = %" PRIu64 "ns\n",
                         parent->getName().c_str(), StateString[state], CommandString[(int)reqEvent->getCmd()], event->getBaseAddr(), getCurrentSimTimeNano());
@@ -565,7 +565,7 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             return DONE;
         case E_Inv:
             if (reqEvent->getCmd() == Command::FetchInv) {
-                sendResponseDown(reqEvent, dirLine, &event->getPayload(), event->getDirty(), true);
+                sendResponseDown(reqEvent, dirLine, &event->getSharedPayload(), event->getDirty(), true);
                 dirLine->setState(I);
             }
             return DONE;
@@ -573,7 +573,7 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             dirLine->setState(E);
             if (reqEvent->getCmd() == Command::Fetch) {
                 if (dirLine->getDataLine() == NULL && dirLine->numSharers() == 0) {
-                    sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstr(), &event->getPayload());
+                    sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
                     dirLine->setState(I);
                 } else {
                     sendResponseDownFromMSHR(event, false);
@@ -581,15 +581,15 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             } else if (reqEvent->getCmd() == Command::GetS) {
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
                 if (dirLine->numSharers() == 0) {
-                    dirLine->setOwner(reqEvent->getSrc());
-                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getPayload(), true, dirLine->getTimestamp());
+                    dirLine->setOwner(reqEvent->getSrcId());
+                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                 } else {
-                    dirLine->addSharer(reqEvent->getSrc());
-                    sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                    dirLine->addSharer(reqEvent->getSrcId());
+                    sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                 }
-                if (is_debug_event(event)) printData(&event->getPayload(), false);
+                if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
             } else {
                 debug->fatal(CALL_INFO, -1, "%s (dir), Error: Received PutS in state %s but stalled request has command %s. Addr = 0x%" PRIx64 ". Time = %" PRIu64 "ns\n",
                         parent->getName().c_str(), StateString[state], CommandString[(int)reqEvent->getCmd()], event->getBaseAddr(), getCurrentSimTimeNano());
@@ -599,7 +599,7 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             dirLine->setState(S);
             if (reqEvent->getCmd() == Command::FetchInvX) {
                 if (dirLine->getDataLine() == NULL && dirLine->numSharers() == 0) {
-                    sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstr(), &event->getPayload());
+                    sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
                     dirLine->setState(I);
                 } else {
                     sendResponseDownFromMSHR(event, false);
@@ -611,15 +611,15 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             return DONE;
         case M_Inv: // PutS raced with AckInv from GetX, PutS raced with AckInv from FetchInv
             if (reqEvent->getCmd() == Command::FetchInv) {
-                sendResponseDown(reqEvent, dirLine, &event->getPayload(), true, true);
+                sendResponseDown(reqEvent, dirLine, &event->getSharedPayload(), true, true);
                 dirLine->setState(I);
             } else {
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::WRITE, NotifyResultType::HIT);
-                dirLine->setOwner(reqEvent->getSrc());
-                if (dirLine->isSharer(reqEvent->getSrc())) dirLine->removeSharer(reqEvent->getSrc());
-                sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                dirLine->setOwner(reqEvent->getSrcId());
+                if (dirLine->isSharer(reqEvent->getSrcId())) dirLine->removeSharer(reqEvent->getSrcId());
+                sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                 dirLine->setTimestamp(sendTime);
-                if (is_debug_event(reqEvent)) printData(&event->getPayload(), false);
+                if (is_debug_event(reqEvent)) printData(&event->getSharedPayload(), false);
                 dirLine->setState(M);
             }
             return DONE;
@@ -627,7 +627,7 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             dirLine->setState(M);
             if (reqEvent->getCmd() == Command::Fetch) {
                 if (dirLine->getDataLine() == NULL && dirLine->numSharers() == 0) {
-                    sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstr(), &event->getPayload());
+                    sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
                     dirLine->setState(I);
                 } else {
                     sendResponseDownFromMSHR(event, false);
@@ -635,15 +635,15 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
             } else if (reqEvent->getCmd() == Command::GetS) {
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
                 if (dirLine->numSharers() == 0) {
-                    dirLine->setOwner(reqEvent->getSrc());
-                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getPayload(), true, dirLine->getTimestamp());
+                    dirLine->setOwner(reqEvent->getSrcId());
+                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                 } else {
-                    dirLine->addSharer(reqEvent->getSrc());
-                    sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                    dirLine->addSharer(reqEvent->getSrcId());
+                    sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                 }
-                if (is_debug_event(event)) printData(&event->getPayload(), false);
+                if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
             } else {
                 debug->fatal(CALL_INFO, -1, "%s (dir), Error: Received PutS in state %s but stalled request has command %s. Addr = 0x%" PRIx64 ". Time = %" PRIu64 "ns\n",
                         parent->getName().c_str(), StateString[state], CommandString[(int)reqEvent->getCmd()], event->getBaseAddr(), getCurrentSimTimeNano());
@@ -652,14 +652,14 @@ CacheAction MESIInternalDirectory::handlePutSRequest(MemEvent * event, CacheLine
         case SM_Inv:
             if (reqEvent->getCmd() == Command::Inv) {    // Completed Inv so handle
                 if (dirLine->numSharers() > 0) {
-                    invalidateAllSharers(dirLine, event->getRqstr(), true);
+                    invalidateAllSharers(dirLine, event->getRqstrId(), true);
                     return IGNORE;
                 }
                 sendAckInv(reqEvent);
                 dirLine->setState(IM);
             } else if (reqEvent->getCmd() == Command::FetchInv) {
                 if (dirLine->numSharers() > 0) {
-                    invalidateAllSharers(dirLine, event->getRqstr(), true);
+                    invalidateAllSharers(dirLine, event->getRqstrId(), true);
                     return IGNORE;
                 }
                 sendResponseDownFromMSHR(event, false);
@@ -690,8 +690,8 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
     recordStateEventCount(event->getCmd(), state);
 
     bool isCached = dirLine->getDataLine() != NULL;
-    if (isCached) dirLine->getDataLine()->setData(event->getPayload(), 0);
-    else if (mshr_->isHit(dirLine->getBaseAddr())) mshr_->setDataBuffer(dirLine->getBaseAddr(), event->getPayload());
+    if (isCached) dirLine->getDataLine()->setData(event->getSharedPayload(), 0);
+    else if (mshr_->isHit(dirLine->getBaseAddr())) mshr_->setDataBuffer(dirLine->getBaseAddr(), event);
 
     if (mshr_->getAcksNeeded(event->getBaseAddr()) > 0) mshr_->decrementAcksNeeded(event->getBaseAddr());
 
@@ -704,7 +704,7 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
             dirLine->clearOwner();
             sendWritebackAck(event);
             if (!isCached) {
-                sendWritebackFromMSHR(((dirLine->getState() == E) ? Command::PutE : Command::PutM), dirLine, event->getRqstr(), &event->getPayload());
+                sendWritebackFromMSHR(((dirLine->getState() == E) ? Command::PutE : Command::PutM), dirLine, event->getRqstrId(), &event->getSharedPayload());
                 if (expectWritebackAck_) mshr_->insertWriteback(dirLine->getBaseAddr());
                 dirLine->setState(I);
             }
@@ -713,7 +713,7 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
             if (event->getDirty()) dirLine->setState(MI);
         case MI:
             dirLine->clearOwner();
-            sendWritebackFromMSHR(((dirLine->getState() == EI) ? Command::PutE : Command::PutM), dirLine, parent->getName(), &event->getPayload());
+            sendWritebackFromMSHR(((dirLine->getState() == EI) ? Command::PutE : Command::PutM), dirLine, parentId_, &event->getSharedPayload());
             if (expectWritebackAck_) mshr_->insertWriteback(dirLine->getBaseAddr());
             dirLine->setState(I);
             break;
@@ -721,7 +721,7 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
             dirLine->clearOwner();
             if (reqEvent->getCmd() == Command::FetchInvX) {
                 if (!isCached) {
-                    sendWritebackFromMSHR(event->getDirty() ? Command::PutM : Command::PutE, dirLine, event->getRqstr(), &event->getPayload());
+                    sendWritebackFromMSHR(event->getDirty() ? Command::PutM : Command::PutE, dirLine, event->getRqstrId(), &event->getSharedPayload());
                     dirLine->setState(I);
                     if (expectWritebackAck_) mshr_->insertWriteback(event->getBaseAddr());
                 } else {
@@ -731,15 +731,15 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
             } else {
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
                 if (protocol_) {
-                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getPayload(), true, dirLine->getTimestamp());
+                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
-                    dirLine->setOwner(reqEvent->getSrc());
+                    dirLine->setOwner(reqEvent->getSrcId());
                 } else {
-                    sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                    sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
-                    dirLine->addSharer(reqEvent->getSrc());
+                    dirLine->addSharer(reqEvent->getSrcId());
                 }
-                if (is_debug_event(event)) printData(&event->getPayload(), false);
+                if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
                 if (event->getDirty()) dirLine->setState(M);
                 else dirLine->setState(E);
             }
@@ -748,7 +748,7 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
             dirLine->clearOwner();
             if (reqEvent->getCmd() == Command::FetchInvX) {
                 if (!isCached) {
-                    sendWritebackFromMSHR(Command::PutM, dirLine, event->getRqstr(), &event->getPayload());
+                    sendWritebackFromMSHR(Command::PutM, dirLine, event->getRqstrId(), &event->getSharedPayload());
                     dirLine->setState(I);
                     if (expectWritebackAck_) mshr_->insertWriteback(event->getBaseAddr());
                 } else {
@@ -759,15 +759,15 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
                 dirLine->setState(M);
                 if (protocol_) {
-                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getPayload(), true, dirLine->getTimestamp());
+                    sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
-                    dirLine->setOwner(reqEvent->getSrc());
+                    dirLine->setOwner(reqEvent->getSrcId());
                 } else {
-                    sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                    sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
-                    dirLine->addSharer(reqEvent->getSrc());
+                    dirLine->addSharer(reqEvent->getSrcId());
                 }
-                if (is_debug_event(event)) printData(&event->getPayload(), false);
+                if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
             }
             return DONE;
         case E_Inv:
@@ -777,10 +777,10 @@ CacheAction MESIInternalDirectory::handlePutMRequest(MemEvent * event, CacheLine
             if (reqEvent->getCmd() == Command::GetX || reqEvent->getCmd() == Command::GetSX) {
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::WRITE, NotifyResultType::HIT);
                 dirLine->setState(M);
-                sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                 dirLine->setTimestamp(sendTime);
-                dirLine->setOwner(reqEvent->getSrc());
-                if (is_debug_event(event)) printData(&event->getPayload(), false);
+                dirLine->setOwner(reqEvent->getSrcId());
+                if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
             } else { /* Cmd == Fetch */
                 sendResponseDownFromMSHR(event, (dirLine->getState() == M_Inv));
                 dirLine->setState(I);
@@ -801,8 +801,8 @@ CacheAction MESIInternalDirectory::handleFlushLineRequest(MemEvent * event, Cach
 
     bool isCached = dirLine && dirLine->getDataLine() != NULL;
     if (event->getPayloadSize() != 0) {
-        if (isCached) dirLine->getDataLine()->setData(event->getPayload(), 0);
-        else if (mshr_->isHit(event->getBaseAddr())) mshr_->setDataBuffer(event->getBaseAddr(), event->getPayload());
+        if (isCached) dirLine->getDataLine()->setData(event->getSharedPayload(), 0);
+        else if (mshr_->isHit(event->getBaseAddr())) mshr_->setDataBuffer(event->getBaseAddr(), event);
     }
 
     CacheAction reqEventAction; // What to do with the reqEvent
@@ -817,15 +817,15 @@ CacheAction MESIInternalDirectory::handleFlushLineRequest(MemEvent * event, Cach
             break;
         case E:
         case M:
-            if (dirLine->getOwner() == event->getSrc()) {
+            if (dirLine->getOwner() == event->getSrcId()) {
                 dirLine->clearOwner();
-                dirLine->addSharer(event->getSrc());
+                dirLine->addSharer(event->getSrcId());
                 if (event->getDirty()) {
                     dirLine->setState(M);
                 }
             }
             if (dirLine->ownerExists()) {
-                sendFetchInvX(dirLine, event->getRqstr(), replay);
+                sendFetchInvX(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 state == E ? dirLine->setState(E_InvX) : dirLine->setState(M_InvX);
                 return STALL;
@@ -849,9 +849,9 @@ CacheAction MESIInternalDirectory::handleFlushLineRequest(MemEvent * event, Cach
         case EI:
         case M_Inv:
         case E_Inv:
-            if (dirLine->getOwner() == event->getSrc()) {
+            if (dirLine->getOwner() == event->getSrcId()) {
                 dirLine->clearOwner();
-                dirLine->addSharer(event->getSrc()); // Other cache will treat FetchInv as Inv
+                dirLine->addSharer(event->getSrcId()); // Other cache will treat FetchInv as Inv
             }
             if (event->getDirty()) {
                 if (state == EI) dirLine->setState(MI);
@@ -860,9 +860,9 @@ CacheAction MESIInternalDirectory::handleFlushLineRequest(MemEvent * event, Cach
             return STALL;
         case M_InvX:
         case E_InvX:
-            if (dirLine->getOwner() == event->getSrc()) {
+            if (dirLine->getOwner() == event->getSrcId()) {
                 dirLine->clearOwner();
-                dirLine->addSharer(event->getSrc());
+                dirLine->addSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
                 if (event->getDirty()) {
                     dirLine->setState(M_InvX);
@@ -881,7 +881,7 @@ CacheAction MESIInternalDirectory::handleFlushLineRequest(MemEvent * event, Cach
                     return handleFetchInv(reqEvent, dirLine, true, NULL);
                 } else {
                     notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
-                    dirLine->addSharer(reqEvent->getSrc());
+                    dirLine->addSharer(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, (isCached ? dirLine->getDataLine()->getData() : mshr_->getDataBuffer(event->getBaseAddr())), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                     dirLine->setState(NextState[state]);
@@ -914,13 +914,13 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
 
     bool isCached = dirLine && dirLine->getDataLine() != NULL;
     if (event->getPayloadSize() != 0) {
-        if (isCached) dirLine->getDataLine()->setData(event->getPayload(), 0);
-        else if (mshr_->isHit(event->getBaseAddr())) mshr_->setDataBuffer(event->getBaseAddr(), event->getPayload());
+        if (isCached) dirLine->getDataLine()->setData(event->getSharedPayload(), 0);
+        else if (mshr_->isHit(event->getBaseAddr())) mshr_->setDataBuffer(event->getBaseAddr(), event);
     }
 
     // Apply incoming flush -> remove if owner
     if (state == M || state == E) {
-        if (dirLine->getOwner() == event->getSrc()) {
+        if (dirLine->getOwner() == event->getSrcId()) {
             dirLine->clearOwner();
             if (event->getDirty()) {
                 dirLine->setState(M);
@@ -936,24 +936,24 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
             if (reqEvent != NULL) return STALL;
             break;
         case S:
-            if (dirLine->isSharer(event->getSrc())) dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) dirLine->removeSharer(event->getSrcId());
             if (dirLine->numSharers() > 0) {
-                invalidateAllSharers(dirLine, event->getRqstr(), replay);
+                invalidateAllSharers(dirLine, event->getRqstrId(), replay);
                 dirLine->setState(S_Inv);
                 return STALL;
             }
             break;
         case E:
         case M:
-            if (dirLine->isSharer(event->getSrc())) dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) dirLine->removeSharer(event->getSrcId());
             if (dirLine->ownerExists()) {
-                sendFetchInv(dirLine, event->getRqstr(), replay);
+                sendFetchInv(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 state == E ? dirLine->setState(E_Inv) : dirLine->setState(M_Inv);
                 return STALL;
             }
             if (dirLine->numSharers() > 0) {
-                invalidateAllSharers(dirLine, event->getRqstr(), replay);
+                invalidateAllSharers(dirLine, event->getRqstrId(), replay);
                 state == E ? dirLine->setState(E_Inv) : dirLine->setState(M_Inv);
                 return STALL;
             }
@@ -963,7 +963,7 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
         case SM:
             return STALL; // Wait for the Get* request to finish
         case SM_D:
-            if (*(dirLine->getSharers()->begin()) == event->getSrc()) { // Flush raced with Fetch
+            if (*(dirLine->sharersBegin()) == event->getSrcId()) { // Flush raced with Fetch
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
@@ -978,19 +978,19 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
         case S_D:
         case E_D:
         case M_D:
-            if (*(dirLine->getSharers()->begin()) == event->getSrc()) {
+            if (*(dirLine->sharersBegin()) == event->getSrcId()) {
                 mshr_->decrementAcksNeeded(event->getBaseAddr()); 
             }
-            if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
                 dirLine->setState(NextState[state]);
                 if (reqEvent->getCmd() == Command::Fetch) {
                     if (dirLine->getDataLine() == NULL && dirLine->numSharers() == 0) {
-                        if (state == M_D || event->getDirty()) sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstr(), &event->getPayload());
-                        else if (state == E_D) sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstr(), &event->getPayload());
-                        else if (state == S_D) sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstr(), &event->getPayload());
+                        if (state == M_D || event->getDirty()) sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
+                        else if (state == E_D) sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
+                        else if (state == S_D) sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstrId(), &event->getSharedPayload());
                         dirLine->setState(I);
                     } else {
                         sendResponseDownFromMSHR(event, (state == M_D || event->getDirty()) ? true : false);
@@ -998,15 +998,15 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
                 } else if (reqEvent->getCmd() == Command::GetS) {
                     notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
                     if (dirLine->numSharers() > 0 || state == S_D) {
-                        dirLine->addSharer(reqEvent->getSrc());
-                        sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                        dirLine->addSharer(reqEvent->getSrcId());
+                        sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                         dirLine->setTimestamp(sendTime);
                     } else {
-                        dirLine->setOwner(reqEvent->getSrc());
-                        sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getPayload(), true, dirLine->getTimestamp());
+                        dirLine->setOwner(reqEvent->getSrcId());
+                        sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getSharedPayload(), true, dirLine->getTimestamp());
                         dirLine->setTimestamp(sendTime);
                     }
-                    if (is_debug_event(event)) printData(&event->getPayload(), false);
+                    if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
                 } else {
                     debug->fatal(CALL_INFO, -1, "%s (dir), Error: Received FlushLineInv in state %s but stalled request has command %s. Addr = 0x%" PRIx64 ". Time = %" PRIu64 "ns\n",
                             parent->getName().c_str(), StateString[state], CommandString[(int)reqEvent->getCmd()], event->getBaseAddr(), getCurrentSimTimeNano());
@@ -1015,8 +1015,8 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
             }
             return STALL;
         case S_Inv:
-            if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             reqEventAction = (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) ? DONE : STALL;
@@ -1035,14 +1035,14 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
             }
             return reqEventAction;
         case SM_Inv:
-            if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
                 if (reqEvent->getCmd() == Command::Inv) {
                     if (dirLine->numSharers() > 0) {  // May not have invalidated GetX requestor -> cannot also be the FlushLine requestor since that one is in I and blocked on flush
-                        invalidateAllSharers(dirLine, reqEvent->getRqstr(), true);
+                        invalidateAllSharers(dirLine, reqEvent->getRqstrId(), true);
                         return STALL;
                     } else {
                         sendAckInv(reqEvent);
@@ -1058,66 +1058,66 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
             }
             return STALL;
         case MI:
-            if (dirLine->getOwner() == event->getSrc()) {
+            if (dirLine->getOwner() == event->getSrcId()) {
                 dirLine->clearOwner();
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
-            } else if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            } else if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
-                if (isCached) sendWritebackFromCache(Command::PutM, dirLine, parent->getName());
-                else sendWritebackFromMSHR(Command::PutM, dirLine, parent->getName(), mshr_->getDataBuffer(event->getBaseAddr()));
+                if (isCached) sendWritebackFromCache(Command::PutM, dirLine, parentId_);
+                else sendWritebackFromMSHR(Command::PutM, dirLine, parentId_, mshr_->getDataBuffer(event->getBaseAddr()));
                 if (expectWritebackAck_) mshr_->insertWriteback(dirLine->getBaseAddr());
                 dirLine->setState(NextState[state]);
                 return DONE;
             } else return STALL;
         case EI:
-            if (dirLine->getOwner() == event->getSrc()) {
+            if (dirLine->getOwner() == event->getSrcId()) {
                 dirLine->clearOwner();
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
-            } else if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            } else if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             if (event->getDirty()) dirLine->setState(MI);
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
-                if (isCached && event->getDirty()) sendWritebackFromCache(Command::PutM, dirLine, parent->getName());
-                else if (isCached) sendWritebackFromCache(Command::PutE, dirLine, parent->getName());
-                else if (event->getDirty()) sendWritebackFromMSHR(Command::PutM, dirLine, parent->getName(), mshr_->getDataBuffer(event->getBaseAddr()));
-                else sendWritebackFromMSHR(Command::PutE, dirLine, parent->getName(), mshr_->getDataBuffer(event->getBaseAddr()));
+                if (isCached && event->getDirty()) sendWritebackFromCache(Command::PutM, dirLine, parentId_);
+                else if (isCached) sendWritebackFromCache(Command::PutE, dirLine, parentId_);
+                else if (event->getDirty()) sendWritebackFromMSHR(Command::PutM, dirLine, parentId_, mshr_->getDataBuffer(event->getBaseAddr()));
+                else sendWritebackFromMSHR(Command::PutE, dirLine, parentId_, mshr_->getDataBuffer(event->getBaseAddr()));
                 if (expectWritebackAck_) mshr_->insertWriteback(dirLine->getBaseAddr());
                 dirLine->setState(NextState[state]);
                 return DONE;
             } else return STALL;
         case SI:
-            if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
-                if (isCached) sendWritebackFromCache(Command::PutS, dirLine, parent->getName());
-                else sendWritebackFromMSHR(Command::PutS, dirLine, parent->getName(), mshr_->getDataBuffer(event->getBaseAddr()));
+                if (isCached) sendWritebackFromCache(Command::PutS, dirLine, parentId_);
+                else sendWritebackFromMSHR(Command::PutS, dirLine, parentId_, mshr_->getDataBuffer(event->getBaseAddr()));
                 if (expectWritebackAck_) mshr_->insertWriteback(dirLine->getBaseAddr());
                 dirLine->setState(I);
                 return DONE;
             } else return STALL;
         case M_Inv:
-            if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
-            } else if (dirLine->getOwner() == event->getSrc()) {
+            } else if (dirLine->getOwner() == event->getSrcId()) {
                 dirLine->clearOwner();
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
                 if (reqEvent->getCmd() == Command::FetchInv) {
-                    sendResponseDown(reqEvent, dirLine, &event->getPayload(), true, true);
+                    sendResponseDown(reqEvent, dirLine, &event->getSharedPayload(), true, true);
                     dirLine->setState(I);
                     return DONE;
                 } else if (reqEvent->getCmd() == Command::GetX || reqEvent->getCmd() == Command::GetSX) {
-                    dirLine->setOwner(reqEvent->getSrc());
-                    if (dirLine->isSharer(reqEvent->getSrc())) dirLine->removeSharer(reqEvent->getSrc());
+                    dirLine->setOwner(reqEvent->getSrcId());
+                    if (dirLine->isSharer(reqEvent->getSrcId())) dirLine->removeSharer(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, (isCached ? dirLine->getDataLine()->getData() : mshr_->getDataBuffer(event->getBaseAddr())), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                     dirLine->setState(M);
@@ -1129,16 +1129,16 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
                 }
             } else return STALL;
         case E_Inv:
-            if (dirLine->isSharer(event->getSrc())) {
-                dirLine->removeSharer(event->getSrc());
+            if (dirLine->isSharer(event->getSrcId())) {
+                dirLine->removeSharer(event->getSrcId());
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
-            } else if (dirLine->getOwner() == event->getSrc()) {
+            } else if (dirLine->getOwner() == event->getSrcId()) {
                 dirLine->clearOwner();
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
                 if (reqEvent->getCmd() == Command::FetchInv) {
-                    sendResponseDown(reqEvent, dirLine, &event->getPayload(), event->getDirty(), true);
+                    sendResponseDown(reqEvent, dirLine, &event->getSharedPayload(), event->getDirty(), true);
                     dirLine->setState(I);
                     return DONE;
                 } else if (reqEvent->getCmd() == Command::FlushLineInv) {
@@ -1150,14 +1150,14 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
             } else return STALL;
         case M_InvX:
         case E_InvX:
-            if (dirLine->getOwner() == event->getSrc()) {
+            if (dirLine->getOwner() == event->getSrcId()) {
                 mshr_->decrementAcksNeeded(event->getBaseAddr());
                 dirLine->clearOwner();
             }
             if (mshr_->getAcksNeeded(event->getBaseAddr()) == 0) {
                 if (reqEvent->getCmd() == Command::FetchInvX) {
                     if (!isCached) {
-                        sendWritebackFromMSHR((event->getDirty() || state == M_InvX) ? Command::PutM : Command::PutE, dirLine, event->getRqstr(), &event->getPayload());
+                        sendWritebackFromMSHR((event->getDirty() || state == M_InvX) ? Command::PutM : Command::PutE, dirLine, event->getRqstrId(), &event->getSharedPayload());
                         dirLine->setState(I);
                         if (expectWritebackAck_) mshr_->insertWriteback(event->getBaseAddr());
                     } else {
@@ -1167,15 +1167,15 @@ CacheAction MESIInternalDirectory::handleFlushLineInvRequest(MemEvent * event, C
                 } else {
                     notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
                     if (protocol_) {
-                        sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getPayload(), true, dirLine->getTimestamp());
+                        sendTime = sendResponseUp(reqEvent, Command::GetXResp, &event->getSharedPayload(), true, dirLine->getTimestamp());
                         dirLine->setTimestamp(sendTime);
-                        dirLine->addSharer(reqEvent->getSrc());
+                        dirLine->addSharer(reqEvent->getSrcId());
                     } else {
-                        sendTime = sendResponseUp(reqEvent, &event->getPayload(), true, dirLine->getTimestamp());
+                        sendTime = sendResponseUp(reqEvent, &event->getSharedPayload(), true, dirLine->getTimestamp());
                         dirLine->setTimestamp(sendTime);
-                        dirLine->addSharer(reqEvent->getSrc());
+                        dirLine->addSharer(reqEvent->getSrcId());
                     }
-                    if (is_debug_event(event)) printData(&event->getPayload(), false);
+                    if (is_debug_event(event)) printData(&event->getSharedPayload(), false);
                 }
 
                 (state == M_InvX || event->getDirty()) ? dirLine->setState(M) : dirLine->setState(E);
@@ -1208,12 +1208,12 @@ CacheAction MESIInternalDirectory::handleInv(MemEvent* event, CacheLine* dirLine
         case S_B:
         case S:
             if (dirLine->numSharers() > 0) {
-                invalidateAllSharers(dirLine, event->getRqstr(), replay);
+                invalidateAllSharers(dirLine, event->getRqstrId(), replay);
                 state == S_B ? dirLine->setState(SB_Inv) : dirLine->setState(S_Inv);
                 // Resolve races with waiting PutS requests
                 while (collisionEvent != NULL) {
                     if (collisionEvent->getCmd() == Command::PutS) {
-                        dirLine->removeSharer(collisionEvent->getSrc());
+                        dirLine->removeSharer(collisionEvent->getSrcId());
                         mshr_->decrementAcksNeeded(event->getBaseAddr());
                         mshr_->removeElement(event->getBaseAddr(), collisionEvent);   
                         delete collisionEvent;
@@ -1228,11 +1228,11 @@ CacheAction MESIInternalDirectory::handleInv(MemEvent* event, CacheLine* dirLine
             return DONE;
         case SM:
             if (dirLine->numSharers() > 0) {
-                invalidateAllSharers(dirLine, event->getRqstr(), replay);
+                invalidateAllSharers(dirLine, event->getRqstrId(), replay);
                 dirLine->setState(SM_Inv);
                 while (collisionEvent != NULL) {
                     if (collisionEvent->getCmd() == Command::PutS) {
-                        dirLine->removeSharer(collisionEvent->getSrc());
+                        dirLine->removeSharer(collisionEvent->getSrcId());
                         mshr_->decrementAcksNeeded(event->getBaseAddr());
                         mshr_->removeFront(event->getBaseAddr());   // We've sent an inv to them so no need for AckPut
                         delete collisionEvent;
@@ -1272,7 +1272,7 @@ CacheAction MESIInternalDirectory::handleForceInv(MemEvent * event, CacheLine *
     
     /* Handle mshr collisions with replacements - treat as having already occured, however AckPut needs to get returned */
     while (collisionEvent && collisionEvent->isWriteback()) {
-        if (dirLine->isSharer(collisionEvent->getSrc())) dirLine->removeSharer(collisionEvent->getSrc());
+        if (dirLine->isSharer(collisionEvent->getSrcId())) dirLine->removeSharer(collisionEvent->getSrcId());
         if (dirLine->ownerExists()) dirLine->clearOwner();
         sendWritebackAck(collisionEvent);
         mshr_->removeFront(dirLine->getBaseAddr());
@@ -1292,7 +1292,7 @@ CacheAction MESIInternalDirectory::handleForceInv(MemEvent * event, CacheLine *
         case S_B:
         case SM:
             if (dirLine->numSharers() > 0) {
-                invalidateAllSharers(dirLine, event->getRqstr(), replay);
+                invalidateAllSharers(dirLine, event->getRqstrId(), replay);
                 if (state == S) dirLine->setState(S_Inv);
                 else if (state == S_B) dirLine->setState(SB_Inv);
                 else dirLine->setState(SM_Inv);
@@ -1306,13 +1306,13 @@ CacheAction MESIInternalDirectory::handleForceInv(MemEvent * event, CacheLine *
         case E:
         case M:
             if (dirLine->ownerExists()) {
-                sendForceInv(dirLine, event->getRqstr(), replay);
+                sendForceInv(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 state == E ? dirLine->setState(E_Inv) : dirLine->setState(M_Inv);
                 return STALL;
             }
             if (dirLine->numSharers() > 0) {
-                invalidateAllSharers(dirLine, event->getRqstr(), replay);
+                invalidateAllSharers(dirLine, event->getRqstrId(), replay);
                 state == E ? dirLine->setState(E_Inv) : dirLine->setState(M_Inv);
                 return STALL;
             }
@@ -1370,10 +1370,10 @@ CacheAction MESIInternalDirectory::handleFetch(MemEvent * event, CacheLine * dir
                 return DONE;
             }
             if (collisionEvent != NULL) {
-                sendResponseDown(event, dirLine, &collisionEvent->getPayload(), false, replay);
+                sendResponseDown(event, dirLine, &collisionEvent->getSharedPayload(), false, replay);
                 return DONE;
             }
-            sendFetch(dirLine, event->getRqstr(), replay);
+            sendFetch(dirLine, event->getRqstrId(), replay);
             mshr_->incrementAcksNeeded(event->getBaseAddr());
             if (state == S) dirLine->setState(S_D);
             else dirLine->setState(SM_D);
@@ -1405,9 +1405,9 @@ CacheAction MESIInternalDirectory::handleFetchInv(MemEvent * event, CacheLine *
     // If colliding event is a replacement, treat the replacement as if it had aleady occured/raced with an earlier FetchInv
     if (collisionEvent && collisionEvent->isWriteback()) {
         collision = true;
-        if (dirLine->isSharer(collisionEvent->getSrc())) dirLine->removeSharer(collisionEvent->getSrc());
+        if (dirLine->isSharer(collisionEvent->getSrcId())) dirLine->removeSharer(collisionEvent->getSrcId());
         if (dirLine->ownerExists()) dirLine->clearOwner();
-        mshr_->setDataBuffer(collisionEvent->getBaseAddr(), collisionEvent->getPayload());
+        mshr_->setDataBuffer(collisionEvent->getBaseAddr(), collisionEvent);
         if (state == E && collisionEvent->getDirty()) dirLine->setState(M);
         state = M;
         sendWritebackAck(collisionEvent);
@@ -1423,8 +1423,8 @@ CacheAction MESIInternalDirectory::handleFetchInv(MemEvent * event, CacheLine *
             return IGNORE;
         case S:
             if (dirLine->numSharers() > 0) {
-                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstr(), replay);
-                else invalidateAllSharersAndFetch(dirLine, event->getRqstr(), replay);
+                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstrId(), replay);
+                else invalidateAllSharersAndFetch(dirLine, event->getRqstrId(), replay);
                 dirLine->setState(S_Inv);
                 return STALL;
             }
@@ -1435,8 +1435,8 @@ CacheAction MESIInternalDirectory::handleFetchInv(MemEvent * event, CacheLine *
             return DONE;
         case SM:
             if (dirLine->numSharers() > 0) {
-                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstr(), replay);
-                else invalidateAllSharersAndFetch(dirLine, event->getRqstr(), replay);
+                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstrId(), replay);
+                else invalidateAllSharersAndFetch(dirLine, event->getRqstrId(), replay);
                 dirLine->setState(SM_Inv);
                 return STALL;
             }
@@ -1447,7 +1447,7 @@ CacheAction MESIInternalDirectory::handleFetchInv(MemEvent * event, CacheLine *
             return DONE;
         case S_B:
             if (dirLine->numSharers() > 0) {
-                invalidateAllSharers(dirLine, event->getRqstr(), replay);
+                invalidateAllSharers(dirLine, event->getRqstrId(), replay);
                 dirLine->setState(SB_Inv);
                 return STALL;
             }
@@ -1456,14 +1456,14 @@ CacheAction MESIInternalDirectory::handleFetchInv(MemEvent * event, CacheLine *
             return DONE;
         case E:
             if (dirLine->ownerExists()) {
-                sendFetchInv(dirLine, event->getRqstr(), replay);
+                sendFetchInv(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 dirLine->setState(E_Inv);
                 return STALL;
             }
             if (dirLine->numSharers() > 0) {
-                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstr(), replay);
-                else invalidateAllSharersAndFetch(dirLine, event->getRqstr(), replay);
+                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstrId(), replay);
+                else invalidateAllSharersAndFetch(dirLine, event->getRqstrId(), replay);
                 dirLine->setState(E_Inv);
                 return STALL;
             }
@@ -1474,14 +1474,14 @@ CacheAction MESIInternalDirectory::handleFetchInv(MemEvent * event, CacheLine *
             return DONE;
         case M:
             if (dirLine->ownerExists()) {
-                sendFetchInv(dirLine, event->getRqstr(), replay);
+                sendFetchInv(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 dirLine->setState(M_Inv);
                 return STALL;
             }
             if (dirLine->numSharers() > 0) {
-                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstr(), replay);
-                else invalidateAllSharersAndFetch(dirLine, event->getRqstr(), replay);
+                if (isCached || collision) invalidateAllSharers(dirLine, event->getRqstrId(), replay);
+                else invalidateAllSharersAndFetch(dirLine, event->getRqstrId(), replay);
                 dirLine->setState(M_Inv);
                 return STALL;
             }
@@ -1541,15 +1541,15 @@ CacheAction MESIInternalDirectory::handleFetchInvX(MemEvent * event, CacheLine *
             if (collision) {
                 if (dirLine->ownerExists()) {
                     dirLine->clearOwner();
-                    dirLine->addSharer(collisionEvent->getSrc());
+                    dirLine->addSharer(collisionEvent->getSrcId());
                     collisionEvent->setCmd(Command::PutS);   // TODO there's probably a cleaner way to do this...and a safer/better way!
                 }
                 dirLine->setState(S);
-                sendResponseDown(event, dirLine, &collisionEvent->getPayload(), collisionEvent->getDirty(), replay);
+                sendResponseDown(event, dirLine, &collisionEvent->getSharedPayload(), collisionEvent->getDirty(), replay);
                 return DONE;
             }
             if (dirLine->ownerExists()) {
-                sendFetchInvX(dirLine, event->getRqstr(), replay);
+                sendFetchInvX(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 dirLine->setState(E_InvX);
                 return STALL;
@@ -1560,7 +1560,7 @@ CacheAction MESIInternalDirectory::handleFetchInvX(MemEvent * event, CacheLine *
                 return DONE;
             }
             // Otherwise shared and not cached
-            sendFetch(dirLine, event->getRqstr(), replay);
+            sendFetch(dirLine, event->getRqstrId(), replay);
             mshr_->incrementAcksNeeded(event->getBaseAddr());
             dirLine->setState(E_InvX);
             return STALL;
@@ -1568,15 +1568,15 @@ CacheAction MESIInternalDirectory::handleFetchInvX(MemEvent * event, CacheLine *
            if (collision) {
                 if (dirLine->ownerExists()) {
                     dirLine->clearOwner();
-                    dirLine->addSharer(collisionEvent->getSrc());
+                    dirLine->addSharer(collisionEvent->getSrcId());
                     collisionEvent->setCmd(Command::PutS);   // TODO there's probably a cleaner way to do this...and a safer/better way!
                 }
                 dirLine->setState(S);
-                sendResponseDown(event, dirLine, &collisionEvent->getPayload(), true, replay);
+                sendResponseDown(event, dirLine, &collisionEvent->getSharedPayload(), true, replay);
                 return DONE;
             }
             if (dirLine->ownerExists()) {
-                sendFetchInvX(dirLine, event->getRqstr(), replay);
+                sendFetchInvX(dirLine, event->getRqstrId(), replay);
                 mshr_->incrementAcksNeeded(event->getBaseAddr());
                 dirLine->setState(M_InvX);
                 return STALL;
@@ -1587,7 +1587,7 @@ CacheAction MESIInternalDirectory::handleFetchInvX(MemEvent * event, CacheLine *
                 return DONE;
             }
             // Otherwise shared and not cached
-            sendFetch(dirLine, event->getRqstr(), replay);
+            sendFetch(dirLine, event->getRqstrId(), replay);
             mshr_->incrementAcksNeeded(event->getBaseAddr());
             dirLine->setState(M_InvX);
             return STALL;
@@ -1622,7 +1622,7 @@ CacheAction MESIInternalDirectory::handleDataResponse(MemEvent* responseEvent, C
     
     origRequest->setMemFlags(responseEvent->getMemFlags());
 
-    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstr() == parent->getName()));
+    bool shouldRespond = !(origRequest->isPrefetch() && (origRequest->getRqstrId() == parentId_));
     bool isCached = dirLine->getDataLine() != NULL;
     uint64_t sendTime = 0;
     switch (state) {
@@ -1630,31 +1630,31 @@ CacheAction MESIInternalDirectory::handleDataResponse(MemEvent* responseEvent, C
             if (responseEvent->getCmd() == Command::GetXResp && protocol_) dirLine->setState(E);
             else dirLine->setState(S);
             notifyListenerOfAccess(origRequest, NotifyAccessType::READ, NotifyResultType::HIT);
-            if (isCached) dirLine->getDataLine()->setData(responseEvent->getPayload(), 0);
+            if (isCached) dirLine->getDataLine()->setData(responseEvent->getSharedPayload(), 0);
             if (!shouldRespond) return DONE;
             if (dirLine->getState() == E) {
-                dirLine->setOwner(origRequest->getSrc());
-                sendTime = sendResponseUp(origRequest, Command::GetXResp, &responseEvent->getPayload(), true, dirLine->getTimestamp());
+                dirLine->setOwner(origRequest->getSrcId());
+                sendTime = sendResponseUp(origRequest, Command::GetXResp, &responseEvent->getSharedPayload(), true, dirLine->getTimestamp());
             } else {
-                dirLine->addSharer(origRequest->getSrc());
-                sendTime = sendResponseUp(origRequest, &responseEvent->getPayload(), true, dirLine->getTimestamp());
+                dirLine->addSharer(origRequest->getSrcId());
+                sendTime = sendResponseUp(origRequest, &responseEvent->getSharedPayload(), true, dirLine->getTimestamp());
             }
             dirLine->setTimestamp(sendTime);
-            if (is_debug_event(responseEvent)) printData(&responseEvent->getPayload(), false);
+            if (is_debug_event(responseEvent)) printData(&responseEvent->getSharedPayload(), false);
             return DONE;
         case IM:
-            if (isCached) dirLine->getDataLine()->setData(responseEvent->getPayload(), 0);
+            if (isCached) dirLine->getDataLine()->setData(responseEvent->getSharedPayload(), 0);
         case SM:
             dirLine->setState(M);
-            dirLine->setOwner(origRequest->getSrc());
-            if (dirLine->isSharer(origRequest->getSrc())) dirLine->removeSharer(origRequest->getSrc());
+            dirLine->setOwner(origRequest->getSrcId());
+            if (dirLine->isSharer(origRequest->getSrcId())) dirLine->removeSharer(origRequest->getSrcId());
             notifyListenerOfAccess(origRequest, NotifyAccessType::WRITE, NotifyResultType::HIT);
-            sendTime = sendResponseUp(origRequest, (isCached ? dirLine->getDataLine()->getData() : &responseEvent->getPayload()), true, dirLine->getTimestamp());
+            sendTime = sendResponseUp(origRequest, (isCached ? dirLine->getDataLine()->getData() : &responseEvent->getSharedPayload()), true, dirLine->getTimestamp());
             dirLine->setTimestamp(sendTime);
-            if (is_debug_event(responseEvent)) printData(&responseEvent->getPayload(), false);
+            if (is_debug_event(responseEvent)) printData(&responseEvent->getSharedPayload(), false);
             return DONE;
         case SM_Inv:
-            mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent->getPayload());  // TODO this might be a problem if we try to use it
+            mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent);  // TODO this might be a problem if we try to use it
             dirLine->setState(M_Inv);
             return STALL;
         default:
@@ -1674,7 +1674,7 @@ CacheAction MESIInternalDirectory::handleFetchResp(MemEvent * responseEvent, Cac
     CacheAction action = (mshr_->getAcksNeeded(responseEvent->getBaseAddr()) == 0) ? DONE : IGNORE;
     
     bool isCached = dirLine->getDataLine() != NULL;
-    if (isCached) dirLine->getDataLine()->setData(responseEvent->getPayload(), 0);    // Update local data if needed
+    if (isCached) dirLine->getDataLine()->setData(responseEvent->getSharedPayload(), 0);    // Update local data if needed
     recordStateEventCount(responseEvent->getCmd(), state);
     
     uint64_t sendTime = 0; 
@@ -1691,20 +1691,20 @@ CacheAction MESIInternalDirectory::handleFetchResp(MemEvent * responseEvent, Cac
                 sendResponseDownFromMSHR(responseEvent, (state == M));
             } else if (reqEvent->getCmd() == Command::GetS) {    // GetS
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
-                dirLine->addSharer(reqEvent->getSrc());
-                sendTime = sendResponseUp(reqEvent, &responseEvent->getPayload(), true, dirLine->getTimestamp());
+                dirLine->addSharer(reqEvent->getSrcId());
+                sendTime = sendResponseUp(reqEvent, &responseEvent->getSharedPayload(), true, dirLine->getTimestamp());
                 dirLine->setTimestamp(sendTime);
-                if (is_debug_event(responseEvent)) printData(&responseEvent->getPayload(), false);
+                if (is_debug_event(responseEvent)) printData(&responseEvent->getSharedPayload(), false);
             } else {
                 debug->fatal(CALL_INFO, -1, "%s (dir), Error: Received FetchResp in state %s but stalled request has command %s. Addr = 0x%" PRIx64 ". Time = %" PRIu64 "ns\n",
                         parent->getName().c_str(), StateString[state], CommandString[(int)reqEvent->getCmd()], responseEvent->getBaseAddr(), getCurrentSimTimeNano());
             }
             break;
         case SI:
-            dirLine->removeSharer(responseEvent->getSrc());
-            mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent->getPayload());
+            dirLine->removeSharer(responseEvent->getSrcId());
+            mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent);
             if (action == DONE) {
-                sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstr(), &responseEvent->getPayload());
+                sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstrId(), &responseEvent->getSharedPayload());
                 if (expectWritebackAck_) mshr_->insertWriteback(dirLine->getBaseAddr());
                 dirLine->setState(I);
             }
@@ -1712,27 +1712,27 @@ CacheAction MESIInternalDirectory::handleFetchResp(MemEvent * responseEvent, Cac
         case EI:
             if (responseEvent->getDirty()) dirLine->setState(MI);
         case MI:
-            if (dirLine->getOwner() == responseEvent->getSrc()) dirLine->clearOwner();
-            if (dirLine->isSharer(responseEvent->getSrc())) dirLine->removeSharer(responseEvent->getSrc());
+            if (dirLine->getOwner() == responseEvent->getSrcId()) dirLine->clearOwner();
+            if (dirLine->isSharer(responseEvent->getSrcId())) dirLine->removeSharer(responseEvent->getSrcId());
             if (action == DONE) {
-                sendWritebackFromMSHR(((dirLine->getState() == EI) ? Command::PutE : Command::PutM), dirLine, parent->getName(), &responseEvent->getPayload());
+                sendWritebackFromMSHR(((dirLine->getState() == EI) ? Command::PutE : Command::PutM), dirLine, parentId_, &responseEvent->getSharedPayload());
                 if (expectWritebackAck_) mshr_->insertWriteback(dirLine->getBaseAddr());
                 dirLine->setState(I);
             }
             break;
         case E_InvX:    // FetchXResp for a GetS, FetchInvX, or FlushLine
         case M_InvX:    // FetchXResp for a GetS, FetchInvX, or FlushLine
-            if (dirLine->getOwner() == responseEvent->getSrc()) {
+            if (dirLine->getOwner() == responseEvent->getSrcId()) {
                 dirLine->clearOwner();
-                dirLine->addSharer(responseEvent->getSrc());
+                dirLine->addSharer(responseEvent->getSrcId());
             }
-            if (!isCached) mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent->getPayload());
+            if (!isCached) mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent);
             if (reqEvent->getCmd() == Command::FetchInvX) {
                 sendResponseDownFromMSHR(responseEvent, (state == M_InvX || responseEvent->getDirty()));
                 dirLine->setState(S);
             } else if (reqEvent->getCmd() == Command::FetchInv) {    // External FetchInv raced with our FlushLine, handle it first
                 if (dirLine->numSharers() > 0) {
-                    invalidateAllSharers(dirLine, reqEvent->getRqstr(), true);
+                    invalidateAllSharers(dirLine, reqEvent->getRqstrId(), true);
                     (state == M_InvX || responseEvent->getDirty())?  dirLine->setState(M_Inv) : dirLine->setState(E_Inv);
                     return STALL;
                 }
@@ -1743,33 +1743,33 @@ CacheAction MESIInternalDirectory::handleFetchResp(MemEvent * responseEvent, Cac
                 action = handleFlushLineRequest(reqEvent, dirLine, NULL, true);
             } else {
                 notifyListenerOfAccess(reqEvent, NotifyAccessType::READ, NotifyResultType::HIT);
-                dirLine->addSharer(reqEvent->getSrc());
-                sendTime = sendResponseUp(reqEvent, &responseEvent->getPayload(), true, dirLine->getTimestamp());
+                dirLine->addSharer(reqEvent->getSrcId());
+                sendTime = sendResponseUp(reqEvent, &responseEvent->getSharedPayload(), true, dirLine->getTimestamp());
                 dirLine->setTimestamp(sendTime);
-                if (is_debug_event(responseEvent)) printData(&responseEvent->getPayload(), false);
+                if (is_debug_event(responseEvent)) printData(&responseEvent->getSharedPayload(), false);
                 if (responseEvent->getDirty() || state == M_InvX) dirLine->setState(M);
                 else dirLine->setState(E);
             }
             break;
         case E_Inv: // FetchResp for FetchInv/flush, may also be waiting for acks
         case M_Inv: // FetchResp for FetchInv/flush or GetX, may also be waiting for acks
-            if (dirLine->isSharer(responseEvent->getSrc())) dirLine->removeSharer(responseEvent->getSrc());
-            if (dirLine->getOwner() == responseEvent->getSrc()) dirLine->clearOwner();
+            if (dirLine->isSharer(responseEvent->getSrcId())) dirLine->removeSharer(responseEvent->getSrcId());
+            if (dirLine->getOwner() == responseEvent->getSrcId()) dirLine->clearOwner();
             if (action != DONE) {
                 if (responseEvent->getDirty()) dirLine->setState(M_Inv);
-                mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent->getPayload());
+                mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent);
             } else {
                 if (reqEvent->getCmd() == Command::GetX || reqEvent->getCmd() == Command::GetSX) {
                     notifyListenerOfAccess(reqEvent, NotifyAccessType::WRITE, NotifyResultType::HIT);
-                    if (dirLine->isSharer(reqEvent->getSrc())) dirLine->removeSharer(reqEvent->getSrc());
-                    dirLine->setOwner(reqEvent->getSrc());
-                    sendTime = sendResponseUp(reqEvent, &responseEvent->getPayload(), true, dirLine->getTimestamp());
+                    if (dirLine->isSharer(reqEvent->getSrcId())) dirLine->removeSharer(reqEvent->getSrcId());
+                    dirLine->setOwner(reqEvent->getSrcId());
+                    sendTime = sendResponseUp(reqEvent, &responseEvent->getSharedPayload(), true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                     dirLine->setState(M);
                 } else if (reqEvent->getCmd() == Command::FlushLineInv) {
                     if (responseEvent->getDirty()) {
-                        if (dirLine->getDataLine() != NULL) dirLine->getDataLine()->setData(responseEvent->getPayload(), 0);
-                        else mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent->getPayload());
+                        if (dirLine->getDataLine() != NULL) dirLine->getDataLine()->setData(responseEvent->getSharedPayload(), 0);
+                        else mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent);
                     }
                     if (responseEvent->getDirty() || state == M_Inv) dirLine->setState(M);
                     else dirLine->setState(E);
@@ -1786,9 +1786,9 @@ CacheAction MESIInternalDirectory::handleFetchResp(MemEvent * responseEvent, Cac
             break;
         case S_Inv:     // Received a FetchInv in S state
         case SM_Inv:    // Received a FetchInv in SM state
-            if (dirLine->isSharer(responseEvent->getSrc())) dirLine->removeSharer(responseEvent->getSrc());
+            if (dirLine->isSharer(responseEvent->getSrcId())) dirLine->removeSharer(responseEvent->getSrcId());
             if (action != DONE) {
-                mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent->getPayload());
+                mshr_->setDataBuffer(responseEvent->getBaseAddr(), responseEvent);
             } else {
                 sendResponseDownFromMSHR(responseEvent, false);
                 (state == S_Inv) ? dirLine->setState(I) : dirLine->setState(IM);
@@ -1808,14 +1808,14 @@ CacheAction MESIInternalDirectory::handleAckInv(MemEvent * ack, CacheLine * dirL
     State state = dirLine->getState();
     recordStateEventCount(ack->getCmd(), state);
 
-    if (dirLine->isSharer(ack->getSrc())) {
-        dirLine->removeSharer(ack->getSrc());
+    if (dirLine->isSharer(ack->getSrcId())) {
+        dirLine->removeSharer(ack->getSrcId());
     }
     if (is_debug_event(ack)) debug->debug(_L6_, "Received AckInv for 0x%" PRIx64 ", acks needed: %d\n", ack->getBaseAddr(), mshr_->getAcksNeeded(ack->getBaseAddr()));
     if (mshr_->getAcksNeeded(ack->getBaseAddr()) > 0) mshr_->decrementAcksNeeded(ack->getBaseAddr());
     CacheAction action = (mshr_->getAcksNeeded(ack->getBaseAddr()) == 0) ? DONE : IGNORE;
     bool isCached = dirLine->getDataLine() != NULL;
-    vector<uint8_t> * data = isCached ? dirLine->getDataLine()->getData() : mshr_->getDataBuffer(reqEvent->getBaseAddr());
+    const SharedPayload* data = isCached ? dirLine->getDataLine()->getData() : mshr_->getDataBuffer(reqEvent->getBaseAddr());
     uint64_t sendTime = 0; 
     switch (state) {
         case S_Inv: // AckInv for Inv
@@ -1839,8 +1839,8 @@ CacheAction MESIInternalDirectory::handleAckInv(MemEvent * ack, CacheLine * dirL
                     dirLine->setState(I);
                 } else {
                     notifyListenerOfAccess(reqEvent, NotifyAccessType::WRITE, NotifyResultType::HIT);
-                    dirLine->setOwner(reqEvent->getSrc());
-                    if (dirLine->isSharer(reqEvent->getSrc())) dirLine->removeSharer(reqEvent->getSrc());
+                    dirLine->setOwner(reqEvent->getSrcId());
+                    if (dirLine->isSharer(reqEvent->getSrcId())) dirLine->removeSharer(reqEvent->getSrcId());
                     sendTime = sendResponseUp(reqEvent, data, true, dirLine->getTimestamp());
                     dirLine->setTimestamp(sendTime);
                     if (is_debug_event(reqEvent)) printData(data, false);
@@ -1853,7 +1853,7 @@ CacheAction MESIInternalDirectory::handleAckInv(MemEvent * ack, CacheLine * dirL
             if (action == DONE) {
                 if (reqEvent->getCmd() == Command::Inv || reqEvent->getCmd() == Command::ForceInv) {    // Completed Inv so handle
                     if (dirLine->numSharers() > 0) {
-                        invalidateAllSharers(dirLine, reqEvent->getRqstr(), true);
+                        invalidateAllSharers(dirLine, reqEvent->getRqstrId(), true);
                         return STALL;
                     }
                     sendAckInv(reqEvent);
@@ -1870,7 +1870,7 @@ CacheAction MESIInternalDirectory::handleAckInv(MemEvent * ack, CacheLine * dirL
         case SB_Inv:
             if (action == DONE) {
                 if (dirLine->numSharers() > 0) {
-                    invalidateAllSharers(dirLine, reqEvent->getRqstr(), true);
+                    invalidateAllSharers(dirLine, reqEvent->getRqstrId(), true);
                     return IGNORE;
                 }
                 sendAckInv(reqEvent);
@@ -1879,19 +1879,19 @@ CacheAction MESIInternalDirectory::handleAckInv(MemEvent * ack, CacheLine * dirL
             return action;
         case SI:
             if (action == DONE) {
-                sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstr(), data);
+                sendWritebackFromMSHR(Command::PutS, dirLine, reqEvent->getRqstrId(), data);
                 if (expectWritebackAck_) mshr_->insertWriteback(ack->getBaseAddr());
                 dirLine->setState(I);
             }
         case EI:
             if (action == DONE) {
-                sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstr(), data);
+                sendWritebackFromMSHR(Command::PutE, dirLine, reqEvent->getRqstrId(), data);
                 if (expectWritebackAck_) mshr_->insertWriteback(ack->getBaseAddr());
                 dirLine->setState(I);
             }
         case MI:
             if (action == DONE) {
-                sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstr(), data);
+                sendWritebackFromMSHR(Command::PutM, dirLine, reqEvent->getRqstrId(), data);
                 if (expectWritebackAck_) mshr_->insertWriteback(ack->getBaseAddr());
                 dirLine->setState(I);
             }
@@ -1910,14 +1910,12 @@ CacheAction MESIInternalDirectory::handleAckInv(MemEvent * ack, CacheLine * dirL
  *---------------------------------------------------------------------------------------------------------------------*/
 
 
-void MESIInternalDirectory::invalidateAllSharers(CacheLine * dirLine, string rqstr, bool replay) {
-    set<std::string> * sharers = dirLine->getSharers();
-    
+void MESIInternalDirectory::invalidateAllSharers(CacheLine * dirLine, EndpointId rqstr, bool replay) {
     uint64_t baseTime = (timestamp_ > dirLine->getTimestamp()) ? timestamp_ : dirLine->getTimestamp();
     uint64_t deliveryTime = (replay) ? baseTime + mshrLatency_ : baseTime + tagLatency_;
     bool invSent = false;
-    for (set<std::string>::iterator it = sharers->begin(); it != sharers->end(); it++) {
-        MemEvent * inv = new MemEvent(parent, dirLine->getBaseAddr(), dirLine->getBaseAddr(), Command::Inv);
+    for (CacheLine::SharerIterator it = dirLine->sharersBegin(); it != dirLine->sharersEnd(); ++it) {
+        MemEvent * inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), dirLine->getBaseAddr(), dirLine->getBaseAddr(), Command::Inv);
         inv->setDst(*it);
         inv->setRqstr(rqstr);
     
@@ -1928,26 +1926,25 @@ void MESIInternalDirectory::invalidateAllSharers(CacheLine * dirLine, string rqs
         invSent = true;
         if (is_debug_addr(dirLine->getBaseAddr())) {
             debug->debug(_L7_,"Sending inv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                dirLine->getBaseAddr(), (*it).c_str(), deliveryTime);
+                dirLine->getBaseAddr(), EndpointNames::name(*it).c_str(), deliveryTime);
         }
     }
     if (invSent) dirLine->setTimestamp(deliveryTime);
 }
 
 
-void MESIInternalDirectory::invalidateAllSharersAndFetch(CacheLine * cacheLine, string rqstr, bool replay) {
-    set<std::string> * sharers = cacheLine->getSharers();
+void MESIInternalDirectory::invalidateAllSharersAndFetch(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
     bool fetched = false;
     
     uint64_t baseTime = (timestamp_ > cacheLine->getTimestamp()) ? timestamp_ : cacheLine->getTimestamp();
     uint64_t deliveryTime = (replay) ? timestamp_ + mshrLatency_ : timestamp_ + tagLatency_;
     bool invSent = false;
 
-    for (set<std::string>::iterator it = sharers->begin(); it != sharers->end(); it++) {
+    for (CacheLine::SharerIterator it = cacheLine->sharersBegin(); it != cacheLine->sharersEnd(); ++it) {
         MemEvent * inv;
-        if (fetched) inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
+        if (fetched) inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
         else {
-            inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
+            inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
             fetched = true;
         }
         inv->setDst(*it);
@@ -1962,7 +1959,7 @@ void MESIInternalDirectory::invalidateAllSharersAndFetch(CacheLine * cacheLine,
 
         if (is_debug_addr(cacheLine->getBaseAddr())) {
             debug->debug(_L7_,"Sending inv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                cacheLine->getBaseAddr(), (*it).c_str(), deliveryTime);
+                cacheLine->getBaseAddr(), EndpointNames::name(*it).c_str(), deliveryTime);
         }
     }
     
@@ -1974,22 +1971,21 @@ void MESIInternalDirectory::invalidateAllSharersAndFetch(CacheLine * cacheLine,
  * If checkFetch is true -> block is not cached
  * Then, if requestor is not already a sharer, we need data!
  */
-bool MESIInternalDirectory::invalidateSharersExceptRequestor(CacheLine * cacheLine, string rqstr, string origRqstr, bool replay, bool uncached) {
+bool MESIInternalDirectory::invalidateSharersExceptRequestor(CacheLine * cacheLine, EndpointId rqstr, EndpointId origRqstr, bool replay, bool uncached) {
     bool sentInv = false;
-    set<std::string> * sharers = cacheLine->getSharers();
-    bool needFetch = uncached && (sharers->find(rqstr) == sharers->end());
+    bool needFetch = uncached && !cacheLine->isSharer(rqstr);
     
     uint64_t baseTime = (timestamp_ > cacheLine->getTimestamp()) ? timestamp_ : cacheLine->getTimestamp();
     uint64_t deliveryTime = (replay) ? baseTime + mshrLatency_ : baseTime + tagLatency_;
     
-    for (set<std::string>::iterator it = sharers->begin(); it != sharers->end(); it++) {
+    for (CacheLine::SharerIterator it = cacheLine->sharersBegin(); it != cacheLine->sharersEnd(); ++it) {
         if (*it == rqstr) continue;
         MemEvent * inv;
         if (needFetch) {
-            inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
+            inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
             needFetch = false;
         } else {
-            inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
+            inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Inv);
         }
         inv->setDst(*it);
         inv->setRqstr(origRqstr);
@@ -2004,7 +2000,7 @@ bool MESIInternalDirectory::invalidateSharersExceptRequestor(CacheLine * cacheLi
         
         if (is_debug_addr(cacheLine->getBaseAddr())) {
             debug->debug(_L7_,"Sending inv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-                cacheLine->getBaseAddr(), (*it).c_str(), deliveryTime);
+                cacheLine->getBaseAddr(), EndpointNames::name(*it).c_str(), deliveryTime);
         }
     }
     if (sentInv) cacheLine->setTimestamp(deliveryTime);
@@ -2012,10 +2008,10 @@ bool MESIInternalDirectory::invalidateSharersExceptRequestor(CacheLine * cacheLi
 }
 
 
-void MESIInternalDirectory::sendFetchInv(CacheLine * cacheLine, string rqstr, bool replay) {
-    MemEvent * fetch = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
-    if (!(cacheLine->getOwner()).empty()) fetch->setDst(cacheLine->getOwner());
-    else fetch->setDst(*(cacheLine->getSharers()->begin()));
+void MESIInternalDirectory::sendFetchInv(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
+    MemEvent * fetch = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInv);
+    if (cacheLine->getOwner() != NO_ENDPOINT) fetch->setDst(cacheLine->getOwner());
+    else fetch->setDst(*(cacheLine->sharersBegin()));
     fetch->setRqstr(rqstr);
     fetch->setSize(cacheLine->getSize());
     
@@ -2027,13 +2023,13 @@ void MESIInternalDirectory::sendFetchInv(CacheLine * cacheLine, string rqstr, bo
    
     if (is_debug_addr(cacheLine->getBaseAddr())) {
         debug->debug(_L7_, "Sending FetchInv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-            cacheLine->getBaseAddr(), cacheLine->getOwner().c_str(), deliveryTime);
+            cacheLine->getBaseAddr(), EndpointNames::name(cacheLine->getOwner()).c_str(), deliveryTime);
     }
 }
 
 
-void MESIInternalDirectory::sendFetchInvX(CacheLine * cacheLine, string rqstr, bool replay) {
-    MemEvent * fetch = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInvX);
+void MESIInternalDirectory::sendFetchInvX(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
+    MemEvent * fetch = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::FetchInvX);
     fetch->setDst(cacheLine->getOwner());
     fetch->setRqstr(rqstr);
     fetch->setSize(cacheLine->getSize());
@@ -2046,14 +2042,14 @@ void MESIInternalDirectory::sendFetchInvX(CacheLine * cacheLine, string rqstr, b
     
     if (is_debug_addr(cacheLine->getBaseAddr())) {
         debug->debug(_L7_, "Sending FetchInvX: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-            cacheLine->getBaseAddr(), cacheLine->getOwner().c_str(), deliveryTime);
+            cacheLine->getBaseAddr(), EndpointNames::name(cacheLine->getOwner()).c_str(), deliveryTime);
     }
 }
 
 
-void MESIInternalDirectory::sendFetch(CacheLine * cacheLine, string rqstr, bool replay) {
-    MemEvent * fetch = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Fetch);
-    fetch->setDst(*((cacheLine->getSharers())->begin()));
+void MESIInternalDirectory::sendFetch(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
+    MemEvent * fetch = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::Fetch);
+    fetch->setDst(*(cacheLine->sharersBegin()));
     fetch->setRqstr(rqstr);
     
     uint64_t baseTime = (timestamp_ > cacheLine->getTimestamp()) ? timestamp_ : cacheLine->getTimestamp();
@@ -2064,13 +2060,13 @@ void MESIInternalDirectory::sendFetch(CacheLine * cacheLine, string rqstr, bool
     
     if (is_debug_addr(cacheLine->getBaseAddr())) {
         debug->debug(_L7_, "Sending Fetch: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-            cacheLine->getBaseAddr(), cacheLine->getOwner().c_str(), deliveryTime);
+            cacheLine->getBaseAddr(), EndpointNames::name(cacheLine->getOwner()).c_str(), deliveryTime);
     }
 }
 
 
-void MESIInternalDirectory::sendForceInv(CacheLine * cacheLine, string rqstr, bool replay) {
-    MemEvent * inv = new MemEvent(parent, cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::ForceInv);
+void MESIInternalDirectory::sendForceInv(CacheLine * cacheLine, EndpointId rqstr, bool replay) {
+    MemEvent * inv = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), cacheLine->getBaseAddr(), cacheLine->getBaseAddr(), Command::ForceInv);
     inv->setDst(cacheLine->getOwner());
     inv->setRqstr(rqstr);
     inv->setSize(cacheLine->getSize());
@@ -2083,7 +2079,7 @@ void MESIInternalDirectory::sendForceInv(CacheLine * cacheLine, string rqstr, bo
     
     if (is_debug_addr(cacheLine->getBaseAddr())) {
         debug->debug(_L7_, "Sending ForceInv: Addr = 0x%" PRIx64 ", Dst = %s @ cycles = %" PRIu64 ".\n", 
-            cacheLine->getBaseAddr(), cacheLine->getOwner().c_str(), deliveryTime);
+            cacheLine->getBaseAddr(), EndpointNames::name(cacheLine->getOwner()).c_str(), deliveryTime);
     }
 }
 
@@ -2092,7 +2088,7 @@ void MESIInternalDirectory::sendForceInv(CacheLine * cacheLine, string rqstr, bo
  *  Handles: responses to fetch invalidates
  *  Latency: cache access to read data for payload  
  */
-void MESIInternalDirectory::sendResponseDown(MemEvent* event, CacheLine * cacheLine, std::vector<uint8_t>* data, bool dirty, bool replay){
+void MESIInternalDirectory::sendResponseDown(MemEvent* event, CacheLine * cacheLine, const SharedPayload* data, bool dirty, bool replay){
     MemEvent *responseEvent = event->makeResponse();
     responseEvent->setPayload(*data);
     if (is_debug_event(event)) printData(data, false);
@@ -2115,7 +2111,7 @@ void MESIInternalDirectory::sendResponseDown(MemEvent* event, CacheLine * cacheL
 void MESIInternalDirectory::sendResponseDownFromMSHR(MemEvent * event, bool dirty) {
     MemEvent * requestEvent = mshr_->lookupFront(event->getBaseAddr());
     MemEvent * responseEvent = requestEvent->makeResponse();
-    responseEvent->setPayload(event->getPayload());
+    responseEvent->copyPayload(event);
     responseEvent->setSize(event->getSize());
     responseEvent->setDirty(dirty);
 
@@ -2142,9 +2138,9 @@ void MESIInternalDirectory::sendAckInv(MemEvent * event) {
 
 
 void MESIInternalDirectory::sendWritebackAck(MemEvent * event) {
-    MemEvent * ack = new MemEvent(parent, event->getBaseAddr(), event->getBaseAddr(), Command::AckPut);
-    ack->setDst(event->getSrc());
-    ack->setRqstr(event->getSrc());
+    MemEvent * ack = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), event->getBaseAddr(), event->getBaseAddr(), Command::AckPut);
+    ack->setDst(event->getSrcId());
+    ack->setRqstr(event->getSrcId());
     ack->setSize(event->getSize());
 
     uint64_t deliveryTime = timestamp_ + tagLatency_;
@@ -2154,8 +2150,9 @@ void MESIInternalDirectory::sendWritebackAck(MemEvent * event) {
     if (is_debug_event(event)) debug->debug(_L3_, "Sending AckPut at cycle = %" PRIu64 "\n", deliveryTime);
 }
 
-void MESIInternalDirectory::sendWritebackFromCache(Command cmd, CacheLine * dirLine, string rqstr) {
-    MemEvent * writeback = new MemEvent(parent, dirLine->getBaseAddr(), dirLine->getBaseAddr(), cmd);
+void MESIInternalDirectory::sendWritebackFromCache(Command cmd, CacheLine * dirLine, EndpointId rqstr) {
+    MemEvent * writeback = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), dirLine->getBaseAddr(), dirLine->getBaseAddr(), cmd);
+    if (timingOnly_) writeback->setDataless();
     writeback->setDst(getDestination(dirLine->getBaseAddr()));
     writeback->setSize(dirLine->getSize());
     if (cmd == Command::PutM || writebackCleanBlocks_) {
@@ -2172,8 +2169,9 @@ void MESIInternalDirectory::sendWritebackFromCache(Command cmd, CacheLine * dirL
     if (is_debug_addr(dirLine->getBaseAddr())) debug->debug(_L3_, "Sending writeback at cycle = %" PRIu64 ", Cmd = %s. From cache\n", deliveryTime, CommandString[(int)cmd]);
 }
 
-void MESIInternalDirectory::sendWritebackFromMSHR(Command cmd, CacheLine * dirLine, string rqstr, vector<uint8_t> * data) {
-    MemEvent * writeback = new MemEvent(parent, dirLine->getBaseAddr(), dirLine->getBaseAddr(), cmd);
+void MESIInternalDirectory::sendWritebackFromMSHR(Command cmd, CacheLine * dirLine, EndpointId rqstr, const SharedPayload* data) {
+    MemEvent * writeback = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), dirLine->getBaseAddr(), dirLine->getBaseAddr(), cmd);
+    if (timingOnly_) writeback->setDataless();
     writeback->setDst(getDestination(dirLine->getBaseAddr()));
     writeback->setSize(dirLine->getSize());
     if (cmd == Command::PutM || writebackCleanBlocks_) {
@@ -2191,7 +2189,7 @@ void MESIInternalDirectory::sendWritebackFromMSHR(Command cmd, CacheLine * dirLi
 void MESIInternalDirectory::sendFlushResponse(MemEvent * requestEvent, bool success) {
     MemEvent * flushResponse = requestEvent->makeResponse();
     flushResponse->setSuccess(success);
-    flushResponse->setDst(requestEvent->getSrc());
+    flushResponse->setDst(requestEvent->getSrcId());
 
     uint64_t deliveryTime = timestamp_ + mshrLatency_;
     Response resp = {flushResponse, deliveryTime, packetHeaderBytes};
@@ -2206,9 +2204,10 @@ void MESIInternalDirectory::sendFlushResponse(MemEvent * requestEvent, bool succ
  *  Forward a flush line request, with or without data
  */
 void MESIInternalDirectory::forwardFlushLine(MemEvent * origFlush, CacheLine * dirLine, bool dirty, Command cmd) {
-    MemEvent * flush = new MemEvent(parent, origFlush->getBaseAddr(), origFlush->getBaseAddr(), cmd);
+    MemEvent * flush = new MemEvent(parentId_, parent->getCurrentSimTimeNano(), origFlush->getBaseAddr(), origFlush->getBaseAddr(), cmd);
+    if (timingOnly_) flush->setDataless();
     flush->setDst(getDestination(origFlush->getBaseAddr()));
-    flush->setRqstr(origFlush->getRqstr());
+    flush->setRqstr(origFlush->getRqstrId());
     flush->setSize(lineSize_);
     uint64_t latency = tagLatency_;
     if (dirty) flush->setDirty(true);
@@ -2216,7 +2215,7 @@ void MESIInternalDirectory::forwardFlushLine(MemEvent * origFlush, CacheLine * d
     if (dirLine) {
         if (dirLine->getDataLine() != NULL) flush->setPayload(*dirLine->getDataLine()->getData());
         else if (mshr_->isHit(origFlush->getBaseAddr())) flush->setPayload(*mshr_->getDataBuffer(origFlush->getBaseAddr()));
-        else if (origFlush->getPayloadSize() != 0) flush->setPayload(origFlush->getPayload());
+        else if (origFlush->getPayloadSize() != 0) flush->copyPayload(origFlush);
     }
     uint64_t baseTime = timestamp_;
     if (dirLine && dirLine->getTimestamp() > baseTime) baseTime = dirLine->getTimestamp();
@@ -2249,7 +2248,7 @@ void MESIInternalDirectory::addToOutgoingQueueUp(Response& resp) {
  *--------------------------------------------------------------------------------------------------*/
 
 
-void MESIInternalDirectory::printData(vector<uint8_t> * data, bool set) {
+void MESIInternalDirectory::printData(const SharedPayload* data, bool set) {
 /*    if (set)    printf("Setting data (%zu): 0x", data->size());
     else        printf("Getting data (%zu): 0x", data->size());
     
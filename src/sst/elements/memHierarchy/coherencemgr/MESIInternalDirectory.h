@@ -499,7 +499,7 @@ public:
 
 /* Event handlers */
     /** Send cache line data to the lower level caches */
-    CacheAction handleEviction(CacheLine* replacementLine, string origRqstr, bool fromDataCache);
+    CacheAction handleEviction(CacheLine* replacementLine, EndpointId origRqstr, bool fromDataCache);
 
     /** Process cache request:  GetX, GetS, GetSX */
     CacheAction handleRequest(MemEvent* event, CacheLine* dirLine, bool replay);
@@ -788,19 +788,19 @@ private:
     CacheAction handleAckInv(MemEvent * responseEvent, CacheLine* dirLine, MemEvent * reqEvent);
 
 /* Private methods for sending events */
-    void sendResponseDown(MemEvent* event, CacheLine* dirLine, std::vector<uint8_t>* data, bool dirty, bool replay);
+    void sendResponseDown(MemEvent* event, CacheLine* dirLine, const SharedPayload* data, bool dirty, bool replay);
    
     /** Send response to lower level cache using 'event' instead of dirLine */
     void sendResponseDownFromMSHR(MemEvent* event, bool dirty);
 
     /** Send writeback request to lower level caches */
-    void sendWriteback(Command cmd, CacheLine* dirLine, string origRqstr);
+    void sendWriteback(Command cmd, CacheLine* dirLine, EndpointId origRqstr);
     
     /** Send writeback request to lower level cache using data from cache */
-    void sendWritebackFromCache(Command cmd, CacheLine* dirLine, string origRqstr);
+    void sendWritebackFromCache(Command cmd, CacheLine* dirLine, EndpointId origRqstr);
 
     /** Send writeback request to lower level cache using data from MSHR */
-    void sendWritebackFromMSHR(Command cmd, CacheLine* dirLine, string origRqstr, std::vector<uint8_t>* data);
+    void sendWritebackFromMSHR(Command cmd, CacheLine* dirLine, EndpointId origRqstr, const SharedPayload* data);
     
     /** Send writeback ack */
     void sendWritebackAck(MemEvent * event);
@@ -809,16 +809,16 @@ private:
     void sendAckInv(MemEvent * event);
 
     /** Fetch data from owner and invalidate their copy of the line */
-    void sendFetchInv(CacheLine * dirLine, string rqstr, bool replay);
+    void sendFetchInv(CacheLine * dirLine, EndpointId rqstr, bool replay);
     
     /** Fetch data from owner and downgrade owner to sharer */
-    void sendFetchInvX(CacheLine * dirLine, string rqstr, bool replay);
+    void sendFetchInvX(CacheLine * dirLine, EndpointId rqstr, bool replay);
 
     /** Fetch data from sharer */
-    void sendFetch(CacheLine * dirLine, string rqstr, bool replay);
+    void sendFetch(CacheLine * dirLine, EndpointId rqstr, bool replay);
 
     /** Send ForceInv to owner */
-    void sendForceInv(CacheLine * dirLine, string rqstr, bool replay);
+    void sendForceInv(CacheLine * dirLine, EndpointId rqstr, bool replay);
 
     /** Send a flush response */
     void sendFlushResponse(MemEvent * reqEvent, bool success);
@@ -827,18 +827,18 @@ private:
     void forwardFlushLine(MemEvent * origFlush, CacheLine * dirLine, bool dirty, Command cmd);
 
     /** Invalidate all sharers of a block. Used for invalidations and evictions */
-    void invalidateAllSharers(CacheLine * dirLine, string rqstr, bool replay);
+    void invalidateAllSharers(CacheLine * dirLine, EndpointId rqstr, bool replay);
     
     /** Invalidate all sharers of a block and fetch block from one of them. Used for invalidations and evictions */
-    void invalidateAllSharersAndFetch(CacheLine * dirLine, string rqstr, bool replay);
+    void invalidateAllSharersAndFetch(CacheLine * dirLine, EndpointId rqstr, bool replay);
     
     /** Invalidate all sharers of a block except the requestor (rqstr). If requestor is not a sharer, may fetch data from a sharer. Used for upgrade requests. */
-    bool invalidateSharersExceptRequestor(CacheLine * dirLine, string rqstr, string origRqstr, bool replay, bool checkFetch);
+    bool invalidateSharersExceptRequestor(CacheLine * dirLine, EndpointId rqstr, EndpointId origRqstr, bool replay, bool checkFetch);
 
 
 /* Miscellaneous */
    
-    void printData(vector<uint8_t> * data, bool set);
+    void printData(const SharedPayload* data, bool set);
 
 /* Statistics */
     //void recordStateEventCount(Command cmd, State state);
@@ -0,0 +1,191 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_CALENDARQUEUE_H
+#define MEMHIERARCHY_CALENDARQUEUE_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "util.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ *  Outgoing event queue keyed by delivery cycle (calendar queue / timing wheel)
+ *
+ *  Entries go in a ring of per-cycle buckets covering the next 'slots' cycles, so insert and
+ *  drain are O(1) however many events are waiting. Entries due further out wait in an overflow
+ *  map and move into the ring as it turns. Within a cycle entries leave in insertion order.
+ *
+ *  Events to the same address are never reordered: an entry is delivered no earlier than the
+ *  last entry still queued for its address. Each queue also does its own per-cycle byte
+ *  accounting, with a separate budget for each traffic class (e.g., requests and responses).
+ *  An entry is charged to its class; if it does not fit in what is left of that class's budget
+ *  it sends part of its bytes and finishes in a later cycle. Entries leave in order, so it
+ *  holds back everything behind it, but other classes' budgets are untouched.
+ *
+ *  T must have a 'size' member giving the bytes left to send for that entry.
+ */
+template<typename T>
+class CalendarQueue {
+public:
+    static const unsigned CLASSES = 2;
+
+    CalendarQueue(size_t slots = 64) : cursor_(0), count_(0), ringCount_(0) {
+        size_t size = 1;
+        while (size < slots) size <<= 1;
+        ring_.resize(size);
+        mask_ = size - 1;
+        for (unsigned cls = 0; cls < CLASSES; cls++) {
+            bytesPerCycle_[cls] = 0;
+            bytesLeft_[cls] = 0;
+        }
+    }
+
+    /* Bytes of class 'cls' that may be sent per cycle, 0 for unlimited */
+    void setBandwidth(unsigned cls, uint64_t bytesPerCycle) { bytesPerCycle_[cls] = bytesPerCycle; }
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+
+    /** Queue 'item' for delivery at 'deliveryTime' but not before earlier entries to 'addr'.
+     *  'now' is the current cycle; entries due in the past go out on the next drain */
+    void push(const T &item, uint64_t deliveryTime, Addr addr, uint64_t now) {
+        if (count_ == 0) cursor_ = now;
+        uint64_t time = deliveryTime < cursor_ ? cursor_ : deliveryTime;
+
+        typename std::unordered_map<Addr, Pending>::iterator last = pending_.find(addr);
+        if (last != pending_.end()) {
+            if (last->second.time > time) time = last->second.time;
+            last->second.time = time;
+            last->second.count++;
+        } else {
+            pending_.insert(std::make_pair(addr, Pending(time)));
+        }
+
+        if (time - cursor_ <= mask_) {
+            ring_[time & mask_].push(Entry(item, addr));
+            ringCount_++;
+        } else {
+            overflow_.insert(std::make_pair(time, Entry(item, addr)));
+        }
+        count_++;
+    }
+
+    /* Reset the byte budgets at the start of a cycle */
+    void startCycle() {
+        for (unsigned cls = 0; cls < CLASSES; cls++) bytesLeft_[cls] = bytesPerCycle_[cls];
+    }
+
+    /** Whether an entry is due by cycle 'now'. Turns the ring past cycles with nothing left to send */
+    bool ready(uint64_t now) {
+        while (count_ > 0 && cursor_ <= now) {
+            if (!ring_[cursor_ & mask_].empty()) return true;
+            if (ringCount_ == 0) {
+                // Nothing in the ring, jump ahead to the first overflow entry
+                uint64_t next = overflow_.begin()->first;
+                cursor_ = next < now + 1 ? next : now + 1;
+            } else {
+                cursor_++;
+            }
+            refill();
+        }
+        if (count_ == 0) cursor_ = now + 1;
+        return false;
+    }
+
+    /* Entry at the head of the current cycle, only valid after ready() */
+    T& front() { return ring_[cursor_ & mask_].front().item; }
+
+    /** Charge the front entry against this cycle's budget for its class 'cls'. Returns whether it may be
+     *  sent now; if not, whatever fit was sent and the entry waits for the next cycle with the rest */
+    bool charge(unsigned cls) {
+        if (bytesPerCycle_[cls] == 0) return true;
+        if (bytesLeft_[cls] == 0) return false;
+        T &item = front();
+        if (bytesLeft_[cls] >= item.size) {
+            bytesLeft_[cls] -= item.size;
+            return true;
+        }
+        item.size -= bytesLeft_[cls];
+        bytesLeft_[cls] = 0;
+        return false;
+    }
+
+    void pop() {
+        Bucket &bucket = ring_[cursor_ & mask_];
+        typename std::unordered_map<Addr, Pending>::iterator last = pending_.find(bucket.front().addr);
+        if (--last->second.count == 0) pending_.erase(last);
+        bucket.pop();
+        ringCount_--;
+        count_--;
+    }
+
+private:
+    struct Entry {
+        Entry(const T &item, Addr addr) : item(item), addr(addr) { }
+        T item;
+        Addr addr;
+    };
+
+    /* Vector with a moving head so an idle bucket holds no allocation and a busy one reuses its storage */
+    struct Bucket {
+        Bucket() : head(0) { }
+        bool empty() const { return head == entries.size(); }
+        Entry& front() { return entries[head]; }
+        void push(const Entry &entry) { entries.push_back(entry); }
+        void pop() {
+            if (++head == entries.size()) {
+                entries.clear();
+                head = 0;
+            }
+        }
+        std::vector<Entry> entries;
+        size_t head;
+    };
+
+    /* Latest delivery cycle and number of entries still queued for an address */
+    struct Pending {
+        Pending(uint64_t time) : time(time), count(1) { }
+        uint64_t time;
+        uint64_t count;
+    };
+
+    /* Move overflow entries that now fall inside the ring */
+    void refill() {
+        while (!overflow_.empty() && overflow_.begin()->first - cursor_ <= mask_) {
+            ring_[overflow_.begin()->first & mask_].push(overflow_.begin()->second);
+            overflow_.erase(overflow_.begin());
+            ringCount_++;
+        }
+    }
+
+    std::vector<Bucket> ring_;                      // ring_[t & mask_] holds entries for cycle t, cursor_ <= t <= cursor_ + mask_
+    std::multimap<uint64_t, Entry> overflow_;       // Entries past the ring, equal times kept in insertion order
+    std::unordered_map<Addr, Pending> pending_;
+    uint64_t cursor_;                               // Earliest cycle that may still have entries
+    uint64_t mask_;
+    size_t count_;
+    size_t ringCount_;
+
+    uint64_t bytesPerCycle_[CLASSES];
+    uint64_t bytesLeft_[CLASSES];
+};
+
+}}
+
+#endif /* MEMHIERARCHY_CALENDARQUEUE_H */
@@ -50,23 +50,31 @@ CoherenceController::CoherenceController(Component * comp, Params &params) : Sub
     tagLatency_ = params.find<uint64_t>("tag_access_latency_cycles", accessLatency_);
     mshrLatency_ = params.find<uint64_t>("mshr_latency_cycles", 1); /* cacheFactory is currently checking/setting this for us */
 
+    parentId_ = EndpointNames::intern(comp->getName());
+
     /* Get line size - already error checked by cacheFactory */
     lineSize_ = params.find<unsigned int>("cache_line_size", 64, found);
 
+    timingOnly_ = params.find<bool>("timing_only", false);
+
     /* Get throughput parameters */
     UnitAlgebra packetSize = UnitAlgebra(params.find<std::string>("min_packet_size", "8B"));
-    UnitAlgebra downLinkBW = UnitAlgebra(params.find<std::string>("request_link_width", "0B"));
-    UnitAlgebra upLinkBW = UnitAlgebra(params.find<std::string>("response_link_width", "0B"));
+    UnitAlgebra requestBW = UnitAlgebra(params.find<std::string>("request_link_width", "0B"));
+    UnitAlgebra responseBW = UnitAlgebra(params.find<std::string>("response_link_width", "0B"));
 
     if (!packetSize.hasUnits("B")) 
         output->fatal(CALL_INFO, -1, "%s, Invalid param: min_packet_size - must have units of bytes (B), SI units OK. Ex: '8B'. You specified '%s'\n", parent->getName().c_str(), packetSize.toString().c_str());
-    if (!downLinkBW.hasUnits("B")) 
-        output->fatal(CALL_INFO, -1, "%s, Invalid param: request_link_width - must have units of bytes (B), SI units OK. Ex: '64B'. You specified '%s'\n", parent->getName().c_str(), downLinkBW.toString().c_str());
-    if (!upLinkBW.hasUnits("B")) 
-        output->fatal(CALL_INFO, -1, "%s, Invalid param: response_link_width - must have units of bytes (B), SI units OK. Ex: '64B'. You specified '%s'\n", parent->getName().c_str(), upLinkBW.toString().c_str());
+    if (!requestBW.hasUnits("B")) 
+        output->fatal(CALL_INFO, -1, "%s, Invalid param: request_link_width - must have units of bytes (B), SI units OK. Ex: '64B'. You specified '%s'\n", parent->getName().c_str(), requestBW.toString().c_str());
+    if (!responseBW.hasUnits("B")) 
+        output->fatal(CALL_INFO, -1, "%s, Invalid param: response_link_width - must have units of bytes (B), SI units OK. Ex: '64B'. You specified '%s'\n", parent->getName().c_str(), responseBW.toString().c_str());
     
-    maxBytesUp = upLinkBW.getRoundedValue();
-    maxBytesDown = downLinkBW.getRoundedValue();
+    maxRequestBytes = requestBW.getRoundedValue();
+    maxResponseBytes = responseBW.getRoundedValue();
+    outgoingEventQueue_.setBandwidth((unsigned)BasicCommandClass::Request, maxRequestBytes);
+    outgoingEventQueue_.setBandwidth((unsigned)BasicCommandClass::Response, maxResponseBytes);
+    outgoingEventQueueUp_.setBandwidth((unsigned)BasicCommandClass::Request, maxRequestBytes);
+    outgoingEventQueueUp_.setBandwidth((unsigned)BasicCommandClass::Response, maxResponseBytes);
     packetHeaderBytes = packetSize.getRoundedValue();
     
     /* Initialize variables */
@@ -115,15 +123,15 @@ void CoherenceController::sendNACK(MemEvent * event, bool up, SimTime_t timeInNa
 
     
 /* Send response towards the CPU. L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, const SharedPayload* data, bool replay, uint64_t baseTime, bool atomic) {
     return sendResponseUp(event, CommandResponse[(int)event->getCmd()], data, false, replay, baseTime, atomic);
 }
    
 
 /* Send response towards the CPU. L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool atomic) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, const SharedPayload* data, bool dirty, bool replay, uint64_t baseTime, bool atomic) {
     MemEvent * responseEvent = event->makeResponse(cmd);
-    responseEvent->setDst(event->getSrc());
+    responseEvent->setDst(event->getSrcId());
     responseEvent->setSize(event->getSize());
     if (data != NULL) responseEvent->setPayload(*data);
     responseEvent->setDirty(dirty);
@@ -140,7 +148,7 @@ uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vect
 }
     
 /* Send response towards the CPU. L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, const SharedPayload* data, bool replay, uint64_t baseTime, bool atomic) {
     return sendResponseUp(event, cmd, data, false, replay, baseTime, atomic);
 }
     
@@ -165,14 +173,14 @@ void CoherenceController::resendEvent(MemEvent * event, bool up) {
   
 
 /* Forward a message to a lower level (towards memory) in the hierarchy */
-uint64_t CoherenceController::forwardMessage(MemEvent * event, Addr baseAddr, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data) {
+uint64_t CoherenceController::forwardMessage(MemEvent * event, Addr baseAddr, unsigned int requestSize, uint64_t baseTime, const SharedPayload* data) {
     /* Create event to be forwarded */
     MemEvent* forwardEvent;
     forwardEvent = new MemEvent(*event);
     
     if (data == NULL) forwardEvent->setPayload(0, NULL);
     
-    forwardEvent->setSrc(parent->getName());
+    forwardEvent->setSrc(parentId_);
     forwardEvent->setDst(linkDown_->findTargetDestination(baseAddr));
     forwardEvent->setSize(requestSize);
 
@@ -195,7 +203,7 @@ uint64_t CoherenceController::forwardMessage(MemEvent * event, Addr baseAddr, un
 }
 
 uint64_t CoherenceController::forwardTowardsMem(MemEventBase * event) {
-    event->setSrc(parent->getName());
+    event->setSrc(parentId_);
     event->setDst(linkDown_->findTargetDestination(event->getRoutingAddress()));
 
     Response fwdReq = {event, timestamp_ + 1, packetHeaderBytes + event->getPayloadSize()};
@@ -203,8 +211,8 @@ uint64_t CoherenceController::forwardTowardsMem(MemEventBase * event) {
     return timestamp_ + 1;
 }
 
-uint64_t CoherenceController::forwardTowardsCPU(MemEventBase * event, std::string dst) {
-    event->setSrc(parent->getName());
+uint64_t CoherenceController::forwardTowardsCPU(MemEventBase * event, EndpointId dst) {
+    event->setSrc(parentId_);
     event->setDst(dst);
 
     Response fwdReq = {event, timestamp_ + 1, packetHeaderBytes + event->getPayloadSize()};
@@ -212,8 +220,8 @@ uint64_t CoherenceController::forwardTowardsCPU(MemEventBase * event, std::strin
     return timestamp_ + 1;
 }
     
-std::string CoherenceController::getSrc() {
-    return linkUp_->getSources()->begin()->name;
+EndpointId CoherenceController::getSrc() {
+    return linkUp_->getSources()->begin()->nameId;
 }
 
 /**************************************/
@@ -227,19 +235,11 @@ bool CoherenceController::sendOutgoingCommands(SimTime_t curTime) {
     timestamp_++;
 
     // Check for ready events in outgoing 'down' queue
-    uint64_t bytesLeft = maxBytesDown;
-    while (!outgoingEventQueue_.empty() && outgoingEventQueue_.front().deliveryTime <= timestamp_) {
+    outgoingEventQueue_.startCycle();
+    while (outgoingEventQueue_.ready(timestamp_)) {
+        if (!outgoingEventQueue_.charge(commandClass(outgoingEventQueue_.front()))) break;
         MemEventBase *outgoingEvent = outgoingEventQueue_.front().event;
-        if (maxBytesDown != 0) {
-            if (bytesLeft == 0) break;
-            if (bytesLeft >= outgoingEventQueue_.front().size) {
-                bytesLeft -= outgoingEventQueue_.front().size;  // Send this many bytes
-            } else {
-                outgoingEventQueue_.front().size -= bytesLeft;
-                break;
-            }
-        }
-        
+
         outgoingEvent->setDst(linkDown_->findTargetDestination(outgoingEvent->getRoutingAddress()));
 
         if (is_debug_event(outgoingEvent)) {
@@ -248,23 +248,15 @@ bool CoherenceController::sendOutgoingCommands(SimTime_t curTime) {
         }
         
         linkDown_->send(outgoingEvent);
-        outgoingEventQueue_.pop_front();
+        outgoingEventQueue_.pop();
 
     }
 
     // Check for ready events in outgoing 'up' queue
-    bytesLeft = maxBytesUp;
-    while (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime <= timestamp_) {
+    outgoingEventQueueUp_.startCycle();
+    while (outgoingEventQueueUp_.ready(timestamp_)) {
+        if (!outgoingEventQueueUp_.charge(commandClass(outgoingEventQueueUp_.front()))) break;
         MemEventBase * outgoingEvent = outgoingEventQueueUp_.front().event;
-        if (maxBytesUp != 0) {
-            if (bytesLeft == 0) break;
-            if (bytesLeft >= outgoingEventQueueUp_.front().size) {
-                bytesLeft -= outgoingEventQueueUp_.front().size;
-            } else {
-                outgoingEventQueueUp_.front().size -= bytesLeft;
-                break;
-            }
-        }
 
         if (is_debug_event(outgoingEvent)) {
             debug->debug(_L4_,"SEND (%s). time: (%" PRIu64 ", %" PRIu64 ") event: (%s)\n",
@@ -272,7 +264,7 @@ bool CoherenceController::sendOutgoingCommands(SimTime_t curTime) {
         }
         
         linkUp_->send(outgoingEvent);
-        outgoingEventQueueUp_.pop_front();
+        outgoingEventQueueUp_.pop();
     }
 
     // Return whether it's ok for the cache to turn off the clock - we need it on to be able to send waiting events
@@ -286,24 +278,14 @@ bool CoherenceController::sendOutgoingCommands(SimTime_t curTime) {
  * a block and then re-request it, the requests can get inverted.
  */
 void CoherenceController::addToOutgoingQueue(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueue_.rbegin(); rit!= outgoingEventQueue_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueue_.insert(rit.base(), resp);
+    outgoingEventQueue_.push(resp, resp.deliveryTime, resp.event->getRoutingAddress(), timestamp_);
 }
 
-/* Add a new event to the outgoing queue up (towards memory)
+/* Add a new event to the outgoing queue up (towards the CPU)
  * Again, to do not reorder events to the same address
  */
 void CoherenceController::addToOutgoingQueueUp(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueueUp_.rbegin(); rit != outgoingEventQueueUp_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueueUp_.insert(rit.base(), resp);
+    outgoingEventQueueUp_.push(resp, resp.deliveryTime, resp.event->getRoutingAddress(), timestamp_);
 }
 
 
@@ -29,6 +29,7 @@
 #include "cacheArray.h"
 #include "mshr.h"
 #include "memLinkBase.h"
+#include "coherencemgr/calendarQueue.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -55,7 +56,7 @@ public:
     virtual CacheAction handleInvalidationRequest(MemEvent * event, CacheLine * line, MemEvent * collisionEvent, bool replay) =0;
 
     /* Handle an eviction */
-    virtual CacheAction handleEviction(CacheLine * line, string rqstr, bool fromDataCache=false) =0;
+    virtual CacheAction handleEviction(CacheLine * line, EndpointId rqstr, bool fromDataCache=false) =0;
     
     /* Handle a response - AckInv, GetSResp, etc. */
     virtual CacheAction handleResponse(MemEvent * event, CacheLine * line, MemEvent * request) =0;
@@ -76,29 +77,29 @@ public:
     void resendEvent(MemEvent * event, bool towardsCPU);
 
     /* Send a response event up (towards CPU). L1s need to implement their own to split out requested bytes. */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic=false);
+    uint64_t sendResponseUp(MemEvent * event, const SharedPayload* data, bool replay, uint64_t baseTime, bool atomic=false);
 
     /* Send a response event up (towards CPU). L1s need to implement their own to split out requested bytes. */
-    uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool atomic=false);
+    uint64_t sendResponseUp(MemEvent * event, Command cmd, const SharedPayload* data, bool replay, uint64_t baseTime, bool atomic=false);
     
     /* Send a response event up (towards CPU). L1s need to implement their own to split out requested bytes. */
-    uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool atomic=false);
+    uint64_t sendResponseUp(MemEvent * event, Command cmd, const SharedPayload* data, bool dirty, bool replay, uint64_t baseTime, bool atomic=false);
 
 
     /* Forward a message to a lower memory level (towards memory) */
-    uint64_t forwardMessage(MemEvent * event, Addr baseAddr, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data);
+    uint64_t forwardMessage(MemEvent * event, Addr baseAddr, unsigned int requestSize, uint64_t baseTime, const SharedPayload* data);
 
     /* Forward a generic message towards memory */
     uint64_t forwardTowardsMem(MemEventBase * event);
 
     /* Forward a generic message towards CPU */
-    uint64_t forwardTowardsCPU(MemEventBase * event, std::string dst);
+    uint64_t forwardTowardsCPU(MemEventBase * event, EndpointId dst);
 
     /* Return the name of the source for this cache */
-    std::string getSrc();
+    EndpointId getSrc();
     
     /* Return the destination for a given address - for sliced/distributed caches */
-    std::string getDestination(Addr addr) { return linkDown_->findTargetDestination(addr); }
+    EndpointId getDestination(Addr addr) { return linkDown_->findTargetDestination(addr); }
     
 
     /***** Manage outgoing event queuest *****/
@@ -147,9 +148,11 @@ protected:
     uint64_t        tagLatency_;        // Cache tag access latency
     uint64_t        mshrLatency_;       // MSHR lookup latency
 
-    /* Outgoing event queues - events are stalled here to account for access latencies */
-    list<Response> outgoingEventQueue_;
-    list<Response> outgoingEventQueueUp_;
+    /* Outgoing event queues - events are stalled here to account for access latencies
+     * Each queue has separate per-cycle byte budgets for requests and responses, since both
+     * classes travel in each direction (e.g., GetS and AckInv down, GetSResp and Inv up) */
+    CalendarQueue<Response> outgoingEventQueue_;
+    CalendarQueue<Response> outgoingEventQueueUp_;
     
     /* Debug control */
     std::set<Addr>  DEBUG_ADDR;
@@ -166,10 +169,12 @@ protected:
 
     /* General parameters and structures */
     unsigned int lineSize_;
+    EndpointId  parentId_;          // Interned name of the cache this controller belongs to
+    bool timingOnly_;               // Cache array holds no data, so events created here are dataless
 
     /* Throughput control TODO move these to a port manager */
-    uint64_t maxBytesUp;
-    uint64_t maxBytesDown;
+    uint64_t maxRequestBytes;       // Per cycle and direction, 0 for unlimited
+    uint64_t maxResponseBytes;
     uint64_t packetHeaderBytes;
 
     /***** Functions used by child classes *****/
@@ -180,6 +185,9 @@ protected:
     /* Add a new event to the outgoing command queue towards the CPU */
     virtual void addToOutgoingQueueUp(Response& resp);
 
+    /* Byte budget an outgoing event is charged to */
+    unsigned commandClass(const Response& resp) { return (unsigned)BasicCommandClassArr[(int)resp.event->getCmd()]; }
+
     /* Statistics */
     virtual void recordStateEventCount(Command cmd, State state);
     virtual void recordEvictionState(State state);
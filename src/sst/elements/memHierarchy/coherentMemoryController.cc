@@ -209,7 +209,7 @@ void CoherentMemController::handleReplacement(MemEvent * ev) {
     if (!directory_ && mshr_.find(ev->getBaseAddr()) != mshr_.end()) {
         MSHREntry * entry = &(mshr_.find(ev->getBaseAddr())->second.front());
         if (entry->cmd == Command::CustomReq && entry->shootdown) {
-            ev->getPayload().empty() ? handleAckInv(ev) : handleFetchResp(ev);
+            (ev->isDataless() ? ev->getPayloadSize() == 0 : ev->getSharedPayload().empty()) ? handleAckInv(ev) : handleFetchResp(ev);
             return;
         }
     }
@@ -264,7 +264,7 @@ void CoherentMemController::handleFlush(MemEvent * ev) {
 
     MemEvent* put = NULL;
     if (ev->getPayloadSize() != 0) {
-        put = new MemEvent(this, ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload());
+        put = new MemEvent(this, ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM, ev->getSharedPayload());
         put->setFlag(MemEvent::F_NORESPONSE);
         outstandingEventList_.insert(std::make_pair(put->getID(), OutstandingEvent(put, put->getBaseAddr())));
         notifyListeners(ev);
@@ -339,7 +339,7 @@ void CoherentMemController::handleFetchResp(MemEvent * ev) {
 
     // Write dirty data if needed
     if (ev->getDirty()) {
-        MemEvent * write = new MemEvent(this, ev->getAddr(), baseAddr, Command::PutM, ev->getPayload());
+        MemEvent * write = new MemEvent(this, ev->getAddr(), baseAddr, Command::PutM, ev->getSharedPayload());
         write->setRqstr(ev->getRqstr());
         ev->setFlag(MemEvent::F_NORESPONSE);
 
@@ -479,7 +479,7 @@ void CoherentMemController::finishMemReq(SST::Event::id_type id, uint32_t flags)
 
     /* Update backing store */
     bool noncacheable = ev->queryFlag(MemEventBase::F_NONCACHEABLE);
-    if (backing_ && (ev->getCmd() == Command::PutM || (ev->getCmd() == Command::GetX && noncacheable)) )
+    if (backing_ && !ev->isDataless() && (ev->getCmd() == Command::PutM || (ev->getCmd() == Command::GetX && noncacheable)) )
         MemController::writeData(ev);
 
     /* Special case - response was for a writeback needed for a shootdown */
@@ -617,8 +617,7 @@ void CoherentMemController::replayMemEvent(MemEvent * ev) {
 void CoherentMemController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++)
-        backing_->set(addr + i, data->at(i));
+    backing_->set(addr, data->size(), *data);
 }
 
 
@@ -627,7 +626,6 @@ void CoherentMemController::readData(Addr addr, size_t bytes, std::vector<uint8_
     
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
+    backing_->get(addr, bytes, data);
 }
 
@@ -59,6 +59,9 @@ public:
     /* Event handling */
     void handleMemResponse(SST::Event::id_type id, uint32_t flags);
 
+    /* Responses can queue shootdowns and replays in msgQueue_, which drains on clock */
+    bool responseNeedsClock() override { return true; }
+
 protected:
     virtual void processInitEvent(MemEventInit* ev);
     virtual void setup();
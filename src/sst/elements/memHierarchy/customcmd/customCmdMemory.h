@@ -16,6 +16,7 @@
 #ifndef _MEMHIERARCHY_CUSTOMCMDMEMHANDLER_H_
 #define _MEMHIERARCHY_CUSTOMCMDMEMHANDLER_H_
 
+#include <functional>
 #include <string>
 
 #include <sst/core/event.h>
@@ -26,15 +27,17 @@
 namespace SST {
 namespace MemHierarchy {
 
+namespace Backend { class Backing; }
+
 /* Class defining the information sent to the MemBackendConvertor */
 class CustomCmdInfo {
 public:
 
     /* Constructors */
-    CustomCmdInfo() { }
+    CustomCmdInfo() : footprintAddr_(0), readBytes_(0), writeBytes_(0) { }
     
     CustomCmdInfo(SST::Event::id_type id, std::string rqstr, uint32_t flags = 0 ) :
-      id_(id), rqstr_(rqstr), flags_(flags) { }
+      id_(id), flags_(flags), rqstr_(rqstr), footprintAddr_(0), readBytes_(0), writeBytes_(0) { }
     
     /* String-ify info for debug */
     virtual std::string getString() { 
@@ -62,10 +65,26 @@ public:
     std::string getRqstr() { return rqstr_; }
     void setRqstr(std::string rq) { rqstr_ = rq; }
 
+    /* Memory footprint. If set, the backend convertor times this command as 'readBytes' of reads
+     * followed by 'writeBytes' of writes starting at local address 'addr', issued as ordinary
+     * backend requests, instead of handing it to a backend that implements custom requests. */
+    void setFootprint(Addr addr, uint64_t readBytes, uint64_t writeBytes) {
+        footprintAddr_ = addr;
+        readBytes_ = readBytes;
+        writeBytes_ = writeBytes;
+    }
+    bool hasFootprint() const { return readBytes_ + writeBytes_ > 0; }
+    Addr getFootprintAddr() const { return footprintAddr_; }
+    uint64_t getReadBytes() const { return readBytes_; }
+    uint64_t getWriteBytes() const { return writeBytes_; }
+
 protected:
     SST::Event::id_type id_;    /* ID of matching MemEventBase */
     uint32_t flags_;            /* Flags to be sent */
     std::string rqstr_;         /* Requestor */
+    Addr footprintAddr_;        /* Footprint start (local address) */
+    uint64_t readBytes_;        /* Footprint bytes read */
+    uint64_t writeBytes_;       /* Footprint bytes written */
 };
 
 /*
@@ -90,7 +109,7 @@ public:
 
 
     /* Constructor */
-    CustomCmdMemHandler(Component * comp, Params &params) : SubComponent(comp) {
+    CustomCmdMemHandler(Component * comp, Params &params) : SubComponent(comp), backing_(nullptr), memSize_(0) {
         /* Create debug output */
         int debugLevel = params.find<int>("debug_level", 0);
         int debugLoc = params.find<int>("debug", 0);
@@ -132,11 +151,27 @@ public:
      *  parent->writeData(): Update the backing store if this custom command wrote data
      *  parent->readData(): Read the backing store if the response needs data
      *  parent->translateLocalT
+     * Handlers that operate on memory contents in bulk can use the backing store directly instead (see setBacking()).
      */
     virtual MemEventBase* finish(MemEventBase *ev, uint32_t flags) =0;
 
+    /* The memController passes its backing store (nullptr if it has none), its size, its global-to-local
+     * address translation and a test for whether a global address maps to it after loading the handler */
+    void setBacking(Backend::Backing * backing, size_t memSize, std::function<Addr(Addr)> toLocal, std::function<bool(Addr)> isLocal) {
+        backing_ = backing;
+        memSize_ = memSize;
+        toLocal_ = toLocal;
+        isLocal_ = isLocal;
+    }
+
 protected:
 
+    // Memory contents, indexed by local address
+    Backend::Backing * backing_;
+    size_t memSize_;
+    std::function<Addr(Addr)> toLocal_;
+    std::function<bool(Addr)> isLocal_;
+
     // Debug
     Output dbg;
     std::set<Addr> DEBUG_ADDR;
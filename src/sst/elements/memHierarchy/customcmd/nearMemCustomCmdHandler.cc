@@ -0,0 +1,262 @@
+// Copyright 2013-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <cstring>
+#include <type_traits>
+
+#include "customcmd/nearMemCustomCmdHandler.h"
+#include "customcmd/customOpCodeCmd.h"
+#include "membackend/backing.h"
+
+using namespace std;
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+/* Debug macros */
+#ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
+#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
+#else
+#define is_debug_event(ev) false
+#endif
+
+/* Reductions read the backing store in chunks of this many bytes */
+#define REDUCE_CHUNK_BYTES 65536
+
+NearMemCustomCmdMemHandler::NearMemCustomCmdMemHandler(Component * comp, Params &params) : CustomCmdMemHandler(comp, params) {
+    shootdown_ = params.find<bool>("shootdown", false);
+    lineSize_ = params.find<uint64_t>("cache_line_size", 64);
+    if (lineSize_ == 0)
+        dbg.fatal(CALL_INFO, -1, "%s, Invalid param: cache_line_size - must be greater than 0\n", parent->getName().c_str());
+
+    buffer_.resize(REDUCE_CHUNK_BYTES / sizeof(uint64_t));
+
+    statAtomicOps = registerStatistic<uint64_t>("atomic_ops");
+    statReduceOps = registerStatistic<uint64_t>("reduce_ops");
+    statReduceBytes = registerStatistic<uint64_t>("reduce_bytes");
+}
+
+CustomCmdMemHandler::MemEventInfo NearMemCustomCmdMemHandler::receive(MemEventBase* ev){
+    CustomCmdEvent * cme = static_cast<CustomCmdEvent*>(ev);
+    Operation op = decode(cme);
+
+    if (!shootdown_) {
+        CustomCmdMemHandler::MemEventInfo MEI(ev->getRoutingAddress(), false);
+        return MEI;
+    }
+
+    std::set<Addr> lines;
+    Addr last = cme->getAddr() + op.bytes - 1;
+    for (Addr line = cme->getAddr() - (cme->getAddr() % lineSize_); line <= last; line += lineSize_)
+        lines.insert(line);
+    CustomCmdMemHandler::MemEventInfo MEI(lines, true);
+    return MEI;
+}
+
+CustomCmdInfo* NearMemCustomCmdMemHandler::ready(MemEventBase* ev){
+    CustomCmdEvent * cme = static_cast<CustomCmdEvent*>(ev);
+    Operation op = decode(cme);
+
+    CustomOpCodeCmdInfo *CI = new CustomOpCodeCmdInfo(cme->getID(),
+                                        cme->getRqstr(),
+                                        cme->getRoutingAddress(),
+                                        cme->getOpCode(),
+                                        MemEventBase::F_SUCCESS);
+    // Atomics read and write back one element, reductions only read
+    CI->setFootprint(op.local, op.bytes, op.reduce ? 0 : op.width);
+    return CI;
+}
+
+MemEventBase* NearMemCustomCmdMemHandler::finish(MemEventBase *ev, uint32_t flags){
+    CustomCmdEvent * cme = static_cast<CustomCmdEvent*>(ev);
+    Operation op = decode(cme);
+    Addr addr = op.local;
+
+    std::vector<uint8_t> result(op.width, 0);
+    bool success = true;
+    switch (op.type) {
+        case Type::U32: execute<uint32_t>(op, addr, cme, result, success); break;
+        case Type::U64: execute<uint64_t>(op, addr, cme, result, success); break;
+        case Type::I32: execute<int32_t>(op, addr, cme, result, success); break;
+        case Type::I64: execute<int64_t>(op, addr, cme, result, success); break;
+        case Type::F32: execute<float>(op, addr, cme, result, success); break;
+        case Type::F64: execute<double>(op, addr, cme, result, success); break;
+    }
+
+    if (op.reduce) {
+        statReduceOps->addData(1);
+        statReduceBytes->addData(op.bytes);
+    } else {
+        statAtomicOps->addData(1);
+    }
+
+    if (is_debug_event(cme)) {
+        dbg.debug(_L4_, "%s, Executed near-memory op 0x%" PRIx32 " on 0x%" PRIx64 " (local 0x%" PRIx64 "), %" PRIu64 " bytes%s\n",
+                parent->getName().c_str(), cme->getOpCode(), cme->getAddr(), addr, op.bytes, success ? "" : ", compare failed");
+    }
+
+    if(ev->queryFlag(MemEventBase::F_NORESPONSE)||
+         ((flags & MemEventBase::F_NORESPONSE)>0)){
+        // posted request
+        return nullptr;
+    }
+
+    CustomCmdEvent *resp = cme->makeResponse();
+    resp->setPayload(result);
+    resp->setFlags(flags);
+    if (success) resp->setFlag(MemEventBase::F_SUCCESS);
+    else resp->clearFlag(MemEventBase::F_SUCCESS);
+    return resp;
+}
+
+NearMemCustomCmdMemHandler::Operation NearMemCustomCmdMemHandler::decode(CustomCmdEvent * ev) {
+    uint32_t opc = ev->getOpCode();
+    Operation op;
+    op.op = (Op)(opc & 0xF);
+    op.type = (Type)((opc >> 4) & 0xF);
+
+    if ((opc >> 8) != 0 || op.op > Op::ReduceMax || op.type > Type::F64) {
+        dbg.fatal(CALL_INFO, -1, "%s, Error: Unrecognized near-memory op code 0x%" PRIx32 ". Ev = %s\n",
+                parent->getName().c_str(), opc, ev->getVerboseString().c_str());
+    }
+
+    op.width = (op.type == Type::U32 || op.type == Type::I32 || op.type == Type::F32) ? 4 : 8;
+    op.reduce = op.op >= Op::ReduceSum;
+
+    if (op.reduce) {
+        op.bytes = ev->getSize();
+        if (op.bytes == 0 || op.bytes % op.width != 0)
+            dbg.fatal(CALL_INFO, -1, "%s, Error: Near-memory reduction size must be a non-zero multiple of the element size (%" PRIu32 "B). Ev = %s\n",
+                    parent->getName().c_str(), op.width, ev->getVerboseString().c_str());
+    } else {
+        op.bytes = op.width;
+        size_t operands = (op.op == Op::CompareSwap) ? 2 : 1;
+        if (ev->getPayloadSize() < operands * op.width)
+            dbg.fatal(CALL_INFO, -1, "%s, Error: Near-memory atomic needs %zu operand bytes in its payload. Ev = %s\n",
+                    parent->getName().c_str(), operands * op.width, ev->getVerboseString().c_str());
+    }
+    op.local = localRange(ev, op.bytes);
+    return op;
+}
+
+/* Translate the operation's range to local addresses, checking that all of it is in this memory.
+ * Both ends must belong to this controller and be exactly 'bytes' apart locally; with interleaving,
+ * a range that crosses into another controller's chunk fails one test or the other */
+Addr NearMemCustomCmdMemHandler::localRange(CustomCmdEvent * ev, uint64_t bytes) {
+    Addr first = ev->getAddr();
+    Addr last = first + bytes - 1;
+    Addr local = first;
+    bool valid = last >= first;
+    if (valid && ev->isAddrGlobal() && toLocal_) {
+        valid = isLocal_(first) && isLocal_(last);
+        if (valid) {
+            local = toLocal_(first);
+            valid = toLocal_(last) - local == bytes - 1;
+        }
+    }
+    if (valid && memSize_ != 0)
+        valid = local < memSize_ && bytes <= memSize_ - local;
+
+    if (!valid) {
+        dbg.fatal(CALL_INFO, -1, "%s, Error: Near-memory op on [0x%" PRIx64 ", 0x%" PRIx64 "] is not contiguous in this memory (%zu bytes). "
+                "Split operations at interleave boundaries. Ev = %s\n",
+                parent->getName().c_str(), first, last, memSize_, ev->getVerboseString().c_str());
+    }
+    return local;
+}
+
+/* Integer adds wrap rather than overflow */
+template<typename T>
+static typename std::enable_if<std::is_integral<T>::value, T>::type add(T a, T b) {
+    typedef typename std::make_unsigned<T>::type U;
+    return (T)((U)a + (U)b);
+}
+
+template<typename T>
+static typename std::enable_if<std::is_floating_point<T>::value, T>::type add(T a, T b) {
+    return a + b;
+}
+
+template<typename T>
+void NearMemCustomCmdMemHandler::execute(const Operation &op, Addr addr, CustomCmdEvent * ev, std::vector<uint8_t> &result, bool &success) {
+    if (op.reduce) {
+        T value = reduce<T>(op.op, addr, op.bytes / sizeof(T));
+        memcpy(result.data(), &value, sizeof(T));
+        return;
+    }
+
+    const uint8_t * operands = ev->getPayload().data();
+    T old = 0;
+    T arg;
+    memcpy(&arg, operands, sizeof(T));
+    if (backing_) backing_->get(addr, sizeof(T), (uint8_t*)&old);
+
+    T value = old;
+    switch (op.op) {
+        case Op::FetchAdd:
+            value = add<T>(old, arg);
+            break;
+        case Op::CompareSwap:
+            success = memcmp(&old, &arg, sizeof(T)) == 0;
+            if (success) memcpy(&value, operands + sizeof(T), sizeof(T));
+            break;
+        case Op::FetchMin:
+            if (arg < old) value = arg;
+            break;
+        case Op::FetchMax:
+            if (arg > old) value = arg;
+            break;
+        default:
+            break;
+    }
+
+    if (backing_ && memcmp(&value, &old, sizeof(T)) != 0)
+        backing_->set(addr, sizeof(T), (const uint8_t*)&value);
+    memcpy(result.data(), &old, sizeof(T));
+}
+
+/* Read the range a chunk at a time and fold each chunk in a tight loop */
+template<typename T>
+T NearMemCustomCmdMemHandler::reduce(Op op, Addr addr, uint64_t count) {
+    if (!backing_) return 0;
+
+    const uint64_t chunk = (buffer_.size() * sizeof(uint64_t)) / sizeof(T);
+    const T * data = (const T*)buffer_.data();
+    T acc = 0;
+    for (uint64_t done = 0; done < count; ) {
+        uint64_t n = (count - done < chunk) ? count - done : chunk;
+        backing_->get(addr + done * sizeof(T), n * sizeof(T), (uint8_t*)buffer_.data());
+        uint64_t i = 0;
+        if (done == 0 && op != Op::ReduceSum) acc = data[i++];
+        switch (op) {
+            case Op::ReduceSum:
+                for (; i < n; i++) acc = add<T>(acc, data[i]);
+                break;
+            case Op::ReduceMin:
+                for (; i < n; i++) if (data[i] < acc) acc = data[i];
+                break;
+            case Op::ReduceMax:
+                for (; i < n; i++) if (data[i] > acc) acc = data[i];
+                break;
+            default:
+                break;
+        }
+        done += n;
+    }
+    return acc;
+}
+
+// EOF
@@ -0,0 +1,114 @@
+// Copyright 2013-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_NEARMEMCUSTOMCMDHANDLER_H_
+#define _MEMHIERARCHY_NEARMEMCUSTOMCMDHANDLER_H_
+
+#include <string>
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/output.h>
+#include <sst/core/subcomponent.h>
+#include <sst/core/elementinfo.h>
+
+#include "memEventBase.h"
+#include "memEvent.h"
+#include "customcmd/customCmdMemory.h"
+#include "customcmd/customCmdEvent.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Near-memory atomics and reductions
+ * Custom Command Handler
+ *
+ * Executes at the memory controller against its backing store:
+ *  - Atomics on one element at the event address. The payload holds the operand
+ *    (for compare-and-swap, the expected value followed by the new value) and the
+ *    response payload holds the old value. Compare-and-swap responses have F_SUCCESS
+ *    set only if the swap happened.
+ *  - Reductions over the event's 'size' bytes starting at the event address, a whole
+ *    number of elements. There is no payload; the response payload holds the result.
+ *
+ * The op code is makeOpCode(op, type), i.e., (type << 4) | op.
+ * An operation's bytes must all map to this memory controller and be contiguous in it, i.e.,
+ * a reduction over interleaved memory may not cross an interleave boundary.
+ *
+ * Timing: each operation is issued to the backend as ordinary requests covering the
+ * bytes it reads and then the bytes it writes, so any timing backend charges it per
+ * request_width burst. Without a backing store, operations are timed and results are 0.
+ */
+class NearMemCustomCmdMemHandler : public CustomCmdMemHandler {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(NearMemCustomCmdMemHandler, "memHierarchy", "nearMemCustomCmdHandler", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Custom command handler for near-memory atomics (fetch-add, compare-and-swap, min, max) and reductions (sum, min, max)", "SST::MemHierarchy::CustomCmdMemHandler")
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"shootdown",       "(bool) Ask the memory controller to invalidate cached copies of every line an operation touches before executing it. Only coherent memory controllers do shootdowns; otherwise operate on data that is not cached.", "false"},
+            {"cache_line_size", "(uint) Line size used to list the lines an operation touches for shootdowns", "64"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"atomic_ops",      "Number of atomic operations executed",     "count",    1},
+            {"reduce_ops",      "Number of reductions executed",            "count",    1},
+            {"reduce_bytes",    "Number of bytes read by reductions",       "bytes",    1} )
+
+/* Begin class defintion */
+    enum class Op : uint32_t { FetchAdd = 0, CompareSwap = 1, FetchMin = 2, FetchMax = 3, ReduceSum = 4, ReduceMin = 5, ReduceMax = 6 };
+    enum class Type : uint32_t { U32 = 0, U64 = 1, I32 = 2, I64 = 3, F32 = 4, F64 = 5 };
+
+    static uint32_t makeOpCode(Op op, Type type) { return ((uint32_t)type << 4) | (uint32_t)op; }
+
+    NearMemCustomCmdMemHandler(Component * comp, Params &params);
+
+    ~NearMemCustomCmdMemHandler() {}
+
+    CustomCmdMemHandler::MemEventInfo receive(MemEventBase* ev) override;
+
+    CustomCmdInfo* ready(MemEventBase* ev) override;
+
+    MemEventBase* finish(MemEventBase *ev, uint32_t flags) override;
+
+private:
+    /* A decoded operation */
+    struct Operation {
+        Op op;
+        Type type;
+        uint32_t width;     // Element size in bytes
+        uint64_t bytes;     // Bytes read
+        bool reduce;
+        Addr local;         // Local address of the first byte
+    };
+
+    Operation decode(CustomCmdEvent * ev);
+    Addr localRange(CustomCmdEvent * ev, uint64_t bytes);
+
+    template<typename T> void execute(const Operation &op, Addr addr, CustomCmdEvent * ev, std::vector<uint8_t> &result, bool &success);
+    template<typename T> T reduce(Op op, Addr addr, uint64_t count);
+
+    bool shootdown_;
+    uint64_t lineSize_;
+    std::vector<uint64_t> buffer_;  // Reduction staging, 8-byte aligned for any element type
+
+    Statistic<uint64_t>* statAtomicOps;
+    Statistic<uint64_t>* statReduceOps;
+    Statistic<uint64_t>* statReduceBytes;
+};    // class NearMemCustomCmdMemHandler
+}     // namespace MemHierarchy
+}     // namespace SST
+
+#endif
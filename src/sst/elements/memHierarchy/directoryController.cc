@@ -16,9 +16,11 @@
 #include <sst_config.h>
 #include "directoryController.h"
 
+#include <algorithm>
 
 #include <sst/core/params.h>
 #include <sst/core/simulation.h>
+#include <sst/core/stringize.h>
 
 #include "memNIC.h"
 
@@ -42,6 +44,7 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     Component(id) {
     int debugLevel = params.find<int>("debug_level", 0);
     cacheLineSize = params.find<uint32_t>("cache_line_size", 64);
+    timingOnly = params.find<bool>("timing_only", false);
     
     dbg.init("", debugLevel, 0, (Output::output_location_t)params.find<int>("debug", 0));
     if (debugLevel < 0 || debugLevel > 10)     dbg.fatal(CALL_INFO, -1, "Debugging level must be between 0 and 10. \n");
@@ -77,6 +80,30 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     
     entryCacheMaxSize = params.find<size_t>("entry_cache_size", 32768);
     entryCacheSize = 0;
+
+    std::string entryCachePolicy = params.find<std::string>("entry_cache_policy", "lru");
+    to_lower(entryCachePolicy);
+    if (entryCachePolicy == "lru") {
+        entryCacheClock = false;
+    } else if (entryCachePolicy == "clock") {
+        entryCacheClock = true;
+    } else {
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): entry_cache_policy - must be 'lru' or 'clock'. You specified '%s'\n", getName().c_str(), entryCachePolicy.c_str());
+    }
+
+    entryCacheAssoc = params.find<uint32_t>("entry_cache_associativity", 16);
+    entryCacheSets = 0;
+    if (entryCacheClock && entryCacheMaxSize > 0) {
+        if (entryCacheAssoc == 0 || entryCacheAssoc > entryCacheMaxSize) entryCacheAssoc = entryCacheMaxSize;
+        if (entryCacheMaxSize % entryCacheAssoc != 0) 
+            dbg.fatal(CALL_INFO, -1, "Invalid param(%s): entry_cache_associativity - must evenly divide entry_cache_size (%zu). You specified '%" PRIu32 "'\n", 
+                    getName().c_str(), entryCacheMaxSize, entryCacheAssoc);
+        entryCacheSets = entryCacheMaxSize / entryCacheAssoc;
+        entryCacheSlots.resize(entryCacheMaxSize, nullptr);
+        entryCacheTags.resize(entryCacheMaxSize, 0);
+        entryCacheRef.resize(entryCacheMaxSize, 0);
+        entryCacheHand.resize(entryCacheSets, 0);
+    }
     std::string net_bw = params.find<std::string>("network_bw", "80GiB/s");
 
     // These are technically nic params and we're borrowing them
@@ -129,6 +156,20 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
                 getName().c_str(), ilStep.c_str());
     }
 
+    /* Snapshots */
+    snapshotSave = params.find<std::string>("snapshot_save", "");
+    snapshotLoad = params.find<std::string>("snapshot_load", "");
+    std::string snapshotTime = params.find<std::string>("snapshot_save_time", "");
+    snapshotLink = nullptr;
+    snapshotSaved = false;
+    if (!snapshotTime.empty()) {
+        if (!UnitAlgebra(snapshotTime).hasUnits("s"))
+            dbg.fatal(CALL_INFO, -1, "Invalid param(%s): snapshot_save_time - must have units of time (s). Ex: '1ms'. SI units are ok. You specified %s\n", getName().c_str(), snapshotTime.c_str());
+        if (snapshotSave.empty())
+            dbg.fatal(CALL_INFO, -1, "Invalid param(%s): snapshot_save_time - snapshot_save must also be set to the file to write the snapshot to\n", getName().c_str());
+        snapshotLink = configureSelfLink("Snapshot", snapshotTime, new Event::Handler<DirectoryController>(this, &DirectoryController::handleSnapshotEvent));
+    }
+
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
     mshrLatency     = params.find<uint64_t>("mshr_latency_cycles", 0);
@@ -229,16 +270,17 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     stat_MSHROccupancy              = registerStatistic<uint64_t>("MSHR_occupancy");
     stat_NoncacheReceived           = registerStatistic<uint64_t>("requests_received_noncacheable");
     stat_CustomReceived             = registerStatistic<uint64_t>("requests_received_custom");
+    stat_WarmupReceived             = registerStatistic<uint64_t>("requests_received_warmup");
+    stat_WarmupGrants               = registerStatistic<uint64_t>("warmup_grants");
 
 }
 
 
 
 DirectoryController::~DirectoryController(){
-    for(std::unordered_map<Addr, DirEntry*>::iterator i = directory.begin(); i != directory.end() ; ++i){
-        delete i->second;
-    }
     directory.clear();
+    freeEntries.clear();
+    entryPool.clear();
     
     while(workQueue.size()){
         MemEvent *front = workQueue.front();
@@ -274,6 +316,7 @@ void DirectoryController::handlePacket(SST::Event *event){
     }
     
     MemEvent *ev = static_cast<MemEvent*>(event);
+    if (timingOnly) ev->setDataless();
     if (ev->getCmd() == Command::GetSResp || ev->getCmd() == Command::GetXResp || ev->getCmd() == Command::FlushLineResp 
             || ev->getCmd() == Command::ForceInv || ev->getCmd() == Command::FetchInv || ev->getCmd() == Command::AckPut) {
         handleMemoryResponse(event);
@@ -473,6 +516,11 @@ void DirectoryController::processPacket(MemEvent * ev, bool replay) {
                 getName().c_str(), ev->getBaseAddr(), CommandString[(int)ev->getCmd()], ev->getSrc().c_str(), getCurrentSimTimeNano());
     }
 
+    if (ev->queryFlag(MemEvent::F_WARMUP)) {
+        handleWarmup(ev);
+        return;
+    }
+
     Command cmd = ev->getCmd();
     switch (cmd) {
         case Command::GetS:
@@ -522,7 +570,7 @@ void DirectoryController::processPacket(MemEvent * ev, bool replay) {
 
 void DirectoryController::handleNoncacheableRequest(MemEventBase * ev) {
     if (!(ev->queryFlag(MemEventBase::F_NORESPONSE))) {
-        noncacheMemReqs[ev->getID()] = ev->getSrc();
+        noncacheMemReqs[ev->getID()] = ev->getSrcId();
     }
     stat_NoncacheReceived->addData(1);
 
@@ -602,6 +650,35 @@ void DirectoryController::handleGetS(MemEvent * ev, bool replay) {
 }
 
 
+/** 
+ * Functional warmup request from a last-level cache that has reserved a line for it. 
+ * Record the cache as a sharer if the entry is idle and I or S, and tell it whether it may keep the line. 
+ * Memory is not accessed and no latency is modeled.
+ */
+void DirectoryController::handleWarmup(MemEvent * ev) {
+    stat_WarmupReceived->addData(1);
+
+    DirEntry * entry = getDirEntry(ev->getBaseAddr());
+    State state = entry->getState();
+    bool grant = entry->isCached() && !mshr->isHit(ev->getBaseAddr()) && (state == I || state == S);
+
+    if (grant) {
+        entry->setState(S);
+        entry->addSharer(node_name_to_id(ev->getSrc()));
+        stat_WarmupGrants->addData(1);
+    }
+
+    MemEvent * respEv = ev->makeResponse();
+    respEv->setSuccess(grant);
+    sendEventToCaches(respEv, timestamp);
+
+    if (is_debug_event(ev)) dbg.debug(_L4_, "Warmup request for 0x%" PRIx64 " from %s %s\n", ev->getBaseAddr(), ev->getSrc().c_str(), grant ? "granted" : "refused");
+
+    if (grant) updateCache(entry);
+    delete ev;
+}
+
+
 /** GetX */
 void DirectoryController::handleGetX(MemEvent * ev, bool replay) {
     /* Locate directory entry and allocate if needed */
@@ -1104,7 +1181,7 @@ void DirectoryController::handleFetchResp(MemEvent * ev, bool keepEvent) {
             dbg.fatal(CALL_INFO, -1, "%s, Error: Directory received %s but state is %s. Addr = 0x%" PRIx64 ", Src = %s. Time = %" PRIu64 "ns, %" PRIu64 " cycles\n",
                     getName().c_str(), CommandString[(int)ev->getCmd()], StateString[state], ev->getBaseAddr(), ev->getSrc().c_str(), getCurrentSimTimeNano(), timestamp);
     }   
-    respEv->setPayload(ev->getPayload());
+    respEv->copyPayload(ev);
     profileResponseSent(respEv);
     if (reqEv->getCmd() == Command::FetchInv || reqEv->getCmd() == Command::ForceInv)
         memMsgQueue.insert(std::make_pair(timestamp + mshrLatency, respEv));
@@ -1144,7 +1221,7 @@ void DirectoryController::handleFetchXResp(MemEvent * ev, bool keepEvent) {
     MemEvent * respEv = reqEv->makeResponse(); 
     entry->addSharer(node_id(reqEv->getSrc()));
     
-    respEv->setPayload(ev->getPayload());
+    respEv->copyPayload(ev);
     profileResponseSent(respEv);
     sendEventToCaches(respEv, timestamp + mshrLatency);
     
@@ -1313,6 +1390,7 @@ void DirectoryController::handleNACK(MemEvent * ev) {
 /* Memory response handler - calls handler for each event from memory */
 void DirectoryController::handleMemoryResponse(SST::Event *event){
     MemEvent *ev = static_cast<MemEvent*>(event);
+    if (timingOnly) ev->setDataless();
     
     if (is_debug_event(ev)) {
         dbg.debug(_L3_, "\n%" PRIu64 " (%s) Received: %s\n",
@@ -1402,7 +1480,7 @@ void DirectoryController::handleDataResponse(MemEvent * ev) {
     }
 
     respEv->setSize(cacheLineSize);
-    respEv->setPayload(ev->getPayload());
+    respEv->copyPayload(ev);
     respEv->setMemFlags(ev->getMemFlags());
     profileResponseSent(respEv);
     sendEventToCaches(respEv, timestamp + mshrLatency);
@@ -1476,13 +1554,11 @@ void DirectoryController::handleDirEntryMemoryResponse(MemEvent * ev) {
 
 
 void DirectoryController::issueInvalidates(MemEvent * ev, DirEntry * entry, Command cmd) {
-    uint32_t rqst_id = node_id(ev->getSrc());
-    for (uint32_t i = 0; i < numTargets; i++) {
+    int rqst_id = node_id(ev->getSrc());
+    for (int i = entry->nextSharer(0); i >= 0; i = entry->nextSharer(i + 1)) {
         if (i == rqst_id) continue;
-        if (entry->isSharer(i)) {
-            sendInvalidate(i, ev, entry, cmd);
-            entry->incrementWaitingAcks();
-        }
+        sendInvalidate(i, ev, entry, cmd);
+        entry->incrementWaitingAcks();
     }
     entry->lastRequest = DirEntry::NO_LAST_REQUEST;
     
@@ -1585,10 +1661,18 @@ void DirectoryController::printStatus(Output &out){
 
 
 DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr baseAddr){
+    /* Cached entries live only in the CLOCK array, so most lookups are a probe of one set's tags */
+    if (entryCacheSets != 0) {
+        uint32_t setStart = entryCacheSet(baseAddr) * entryCacheAssoc;
+        for (uint32_t way = setStart; way < setStart + entryCacheAssoc; way++) {
+            if (entryCacheTags[way] == baseAddr && entryCacheSlots[way] != nullptr) return entryCacheSlots[way];
+        }
+    }
+
     std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(baseAddr);
     DirEntry *entry;
     if (directory.end() == i) {
-        entry = new DirEntry(baseAddr, numTargets, &dbg);
+        entry = allocateDirEntry(baseAddr);
         entry->cacheIter = entryCache.end();
         directory[baseAddr] = entry;
         entry->setCached(true);   // TODO fix this so new entries go to memory if we're caching, little bit o cheatin here
@@ -1674,9 +1758,28 @@ uint32_t DirectoryController::node_name_to_id(const std::string &name){
     return id;
 }
 
+DirectoryController::DirEntry* DirectoryController::allocateDirEntry(Addr baseAddr) {
+    if (freeEntries.empty()) {
+        entryPool.emplace_back(baseAddr, numTargets, &dbg);
+        return &entryPool.back();
+    }
+    DirEntry * entry = freeEntries.back();
+    freeEntries.pop_back();
+    entry->init(baseAddr, numTargets, &dbg);
+    return entry;
+}
+
+
+void DirectoryController::releaseDirEntry(DirEntry * entry) {
+    freeEntries.push_back(entry);
+}
+
+
 void DirectoryController::updateCache(DirEntry *entry){
     if(0 == entryCacheMaxSize){
         sendEntryToMemory(entry);
+    } else if (entryCacheClock) {
+        updateClockCache(entry);
     } else {
         /* Find if we're in the cache */
         if(entry->cacheIter != entryCache.end()){
@@ -1690,7 +1793,7 @@ void DirectoryController::updateCache(DirEntry *entry){
             if (is_debug_addr(entry->getBaseAddr())) dbg.debug(_L10_, "Entry for 0x%" PRIx64 " has no references - purging\n", entry->getBaseAddr());
             
             directory.erase(entry->getBaseAddr());
-            delete entry;
+            releaseDirEntry(entry);
             return;
         } else {
             entryCache.push_front(entry);
@@ -1716,6 +1819,91 @@ void DirectoryController::updateCache(DirEntry *entry){
 
 
 
+/* 
+ * Entry cache as a set-associative array with CLOCK replacement
+ * Each slot has a reference bit that is set on access. To find a victim the set's hand sweeps the ways,
+ * clearing reference bits, until it finds an unreferenced entry that is not in the MSHR. If every way 
+ * is busy the new entry bypasses the cache (it is written to memory, as if the cache were size 0) and
+ * insertion is retried on its next access.
+ * The array is the primary store for cached entries; 'directory' only holds entries that are in memory
+ * (or new and not yet placed), so an entry moves between the two as it is cached and evicted.
+ */
+void DirectoryController::updateClockCache(DirEntry *entry) {
+    if (entry->getState() == I) {
+        if (entry->cacheSlot >= 0) {
+            entryCacheSlots[entry->cacheSlot] = nullptr;
+            --entryCacheSize;
+        } else {
+            directory.erase(entry->getBaseAddr());
+        }
+        if (is_debug_addr(entry->getBaseAddr())) dbg.debug(_L10_, "Entry for 0x%" PRIx64 " has no references - purging\n", entry->getBaseAddr());
+
+        releaseDirEntry(entry);
+        return;
+    }
+
+    if (entry->cacheSlot >= 0) {
+        entryCacheRef[entry->cacheSlot] = 1;
+        return;
+    }
+
+    uint32_t set = entryCacheSet(entry->getBaseAddr());
+    uint32_t setStart = set * entryCacheAssoc;
+    int slot = -1;
+
+    /* Use an empty way if there is one */
+    for (uint32_t way = 0; way < entryCacheAssoc; way++) {
+        if (entryCacheSlots[setStart + way] == nullptr) {
+            slot = setStart + way;
+            break;
+        }
+    }
+
+    /* Otherwise sweep the hand - two passes clears every reference bit once */
+    for (uint32_t step = 0; slot < 0 && step < 2 * entryCacheAssoc; step++) {
+        uint32_t candidate = setStart + entryCacheHand[set];
+        entryCacheHand[set] = (entryCacheHand[set] + 1) % entryCacheAssoc;
+
+        if (entryCacheRef[candidate]) {
+            entryCacheRef[candidate] = 0;
+            continue;
+        }
+        DirEntry * oldEntry = entryCacheSlots[candidate];
+        if (mshr->isHit(oldEntry->getBaseAddr())) continue;
+        
+        if (is_debug_addr(oldEntry->getBaseAddr())) dbg.debug(_L10_, "entryCache set %" PRIu32 " full.  Evicting entry for 0x%" PRIx64 "\n", set, oldEntry->getBaseAddr());
+
+        oldEntry->cacheSlot = -1;
+        oldEntry->setCached(false);
+        directory[oldEntry->getBaseAddr()] = oldEntry;
+        sendEntryToMemory(oldEntry);
+        --entryCacheSize;
+        slot = candidate;
+    }
+
+    if (slot < 0) {
+        if (is_debug_addr(entry->getBaseAddr())) dbg.debug(_L10_, "entryCache set %" PRIu32 " busy.  Entry for 0x%" PRIx64 " bypasses cache\n", set, entry->getBaseAddr());
+        entry->setCached(false);
+        sendEntryToMemory(entry);
+        return;
+    }
+
+    directory.erase(entry->getBaseAddr());
+    entryCacheSlots[slot] = entry;
+    entryCacheTags[slot] = entry->getBaseAddr();
+    entryCacheRef[slot] = 1;
+    entry->cacheSlot = slot;
+    ++entryCacheSize;
+}
+
+
+uint32_t DirectoryController::entryCacheSet(Addr baseAddr) {
+    uint64_t line = baseAddr / cacheLineSize;
+    return ((line * 0x9E3779B97F4A7C15ULL) >> 32) % entryCacheSets; // Scramble so interleaved directories use every set
+}
+
+
+
 void DirectoryController::sendEntryToMemory(DirEntry *entry){
     Addr entryAddr = 0; // Always use local address 0 for directory entries
     MemEvent *me   = new MemEvent(this, entryAddr, entryAddr, Command::PutE, cacheLineSize); // MemController discards PutE's without writeback so this is safe
@@ -1733,13 +1921,12 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry){
 MemEvent::id_type DirectoryController::writebackData(MemEvent *data_event, Command wbCmd) {
     MemEvent *ev       = new MemEvent(this, data_event->getBaseAddr(), data_event->getBaseAddr(), wbCmd, cacheLineSize);
 
-    if(data_event->getPayload().size() != cacheLineSize) {
+    if(data_event->getPayloadSize() != cacheLineSize) {
 	dbg.fatal(CALL_INFO, -1, "%s, Error: Writing back data request but payload does not match cache line size of %uB. Addr = 0x%" PRIx64 ", Cmd = %s, Src = %s, Size = %zu. Time = %" PRIu64 "ns\n",
-                getName().c_str(), cacheLineSize, ev->getBaseAddr(), CommandString[(int)ev->getCmd()], ev->getSrc().c_str(), ev->getPayload().size(), getCurrentSimTimeNano());
+                getName().c_str(), cacheLineSize, ev->getBaseAddr(), CommandString[(int)ev->getCmd()], ev->getSrc().c_str(), data_event->getPayloadSize(), getCurrentSimTimeNano());
     }
 
-    ev->setSize(data_event->getPayload().size());
-    ev->setPayload(data_event->getPayload());
+    ev->copyPayload(data_event);
     ev->setDst(memoryName);
     profileRequestSent(ev);
     
@@ -1925,6 +2112,7 @@ void DirectoryController::init(unsigned int phase) {
 
 
 void DirectoryController::finish(void){
+    if (!snapshotSave.empty() && !snapshotSaved) saveSnapshot();
     network->finish();
 }
 
@@ -1938,5 +2126,119 @@ void DirectoryController::setup(void){
     if(0 == numTargets) dbg.fatal(CALL_INFO,-1,"%s, Error: Did not find any caches during init\n",getName().c_str());
 
     entrySize = (numTargets+1)/8 +1;
+
+    if (!snapshotLoad.empty()) loadSnapshot();
+    if (snapshotLink) snapshotLink->send(1, NULL);
+}
+
+
+
+void DirectoryController::handleSnapshotEvent(SST::Event * event) {
+    saveSnapshot();
+}
+
+
+
+/*
+ * Snapshot layout: the names sharer/owner ids refer to, then one record per stable entry. Entries are
+ * ordered so that restoring them in order rebuilds the LRU entry cache: uncached entries first, then
+ * cached entries from least to most recently used. Entries with requests in the MSHR are skipped.
+ */
+void DirectoryController::saveSnapshot() {
+    std::vector<DirEntry*> entries;
+    uint64_t busy = 0;
+    for (std::unordered_map<Addr,DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
+        if (entryCacheClock || it->second->cacheIter == entryCache.end()) entries.push_back(it->second);
+    }
+    // Uncached entries in address order so the same contents always give the same file. Cached entries
+    // follow in the order load should re-insert them, least recently used first
+    std::sort(entries.begin(), entries.end(), [](DirEntry * a, DirEntry * b) { return a->getBaseAddr() < b->getBaseAddr(); });
+    if (entryCacheClock) {
+        for (std::vector<DirEntry*>::iterator it = entryCacheSlots.begin(); it != entryCacheSlots.end(); it++)
+            if (*it != nullptr) entries.push_back(*it);
+    } else {
+        for (std::list<DirEntry*>::reverse_iterator it = entryCache.rbegin(); it != entryCache.rend(); it++)
+            entries.push_back(*it);
+    }
+
+    SnapshotWriter snapshot;
+    if (!snapshot.open(snapshotSave))
+        dbg.fatal(CALL_INFO, -1, "%s, Error: unable to open snapshot file '%s' for writing\n", getName().c_str(), snapshotSave.c_str());
+
+    snapshot.beginSection(SnapshotSection::Directory, getName());
+    snapshot.write((uint32_t)nodeid_to_name.size());
+    for (uint32_t id = 0; id < nodeid_to_name.size(); id++)
+        snapshot.writeString(nodeid_to_name[id]);
+
+    for (std::vector<DirEntry*>::iterator it = entries.begin(); it != entries.end(); it++) {
+        DirEntry * entry = *it;
+        State state = entry->getState();
+        if ((state != S && state != M) || mshr->isHit(entry->getBaseAddr())) {
+            if (state != I) busy++;
+            continue;
+        }
+        snapshot.write(entry->getBaseAddr());
+        snapshot.write((uint8_t)state);
+        snapshot.write((uint8_t)entry->isCached());
+        snapshot.write((int32_t)entry->getOwner());
+        snapshot.write(entry->getSharerCount());
+        for (int id = entry->nextSharer(0); id >= 0; id = entry->nextSharer(id + 1))
+            snapshot.write((uint32_t)id);
+    }
+    snapshot.endSection();
+
+    if (!snapshot.close())
+        dbg.fatal(CALL_INFO, -1, "%s, Error: failed writing snapshot file '%s'\n", getName().c_str(), snapshotSave.c_str());
+    snapshotSaved = true;
+
+    if (busy != 0) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.output("%s, Warning: %" PRIu64 " directory entries had requests in progress when the snapshot was written at %" PRIu64 "ns and were not saved.\n",
+                getName().c_str(), busy, getCurrentSimTimeNano());
+    }
+}
+
+
+
+/* Sharer and owner names are mapped onto this run's node ids, so they must be connected to this directory */
+void DirectoryController::loadSnapshot() {
+    SnapshotReader snapshot;
+    SnapshotCursor cursor;
+    if (!snapshot.open(snapshotLoad))
+        dbg.fatal(CALL_INFO, -1, "%s, Error: unable to load snapshot '%s': %s\n", getName().c_str(), snapshotLoad.c_str(), snapshot.error().c_str());
+    if (!snapshot.find(SnapshotSection::Directory, getName(), cursor))
+        dbg.fatal(CALL_INFO, -1, "%s, Error: snapshot '%s' has no directory entries\n", getName().c_str(), snapshotLoad.c_str());
+
+    std::vector<uint32_t> ids(cursor.read<uint32_t>());
+    for (uint32_t i = 0; i < ids.size(); i++)
+        ids[i] = node_name_to_id(cursor.readString());
+
+    while (cursor.good() && !cursor.atEnd()) {
+        Addr addr = cursor.read<Addr>();
+        State state = (State)cursor.read<uint8_t>();
+        bool cached = cursor.read<uint8_t>();
+        int32_t owner = cursor.read<int32_t>();
+        uint32_t sharerCount = cursor.read<uint32_t>();
+        if ((state != S && state != M) || owner >= (int32_t)ids.size() || sharerCount > ids.size()) 
+            dbg.fatal(CALL_INFO, -1, "%s, Error: snapshot '%s' is corrupt, bad entry for 0x%" PRIx64 "\n", getName().c_str(), snapshotLoad.c_str(), addr);
+
+        DirEntry * entry = getDirEntry(addr);
+        entry->setState(state);
+        if (owner >= 0) entry->setOwner(ids[owner]);
+        for (uint32_t i = 0; i < sharerCount; i++) {
+            uint32_t id = cursor.read<uint32_t>();
+            if (id >= ids.size()) 
+                dbg.fatal(CALL_INFO, -1, "%s, Error: snapshot '%s' is corrupt, bad sharer for 0x%" PRIx64 "\n", getName().c_str(), snapshotLoad.c_str(), addr);
+            entry->addSharer(ids[id]);
+        }
+
+        if (cached) {
+            updateCache(entry);
+        } else {
+            entry->setCached(false);
+        }
+    }
+    if (!cursor.good() || !cursor.atEnd())
+        dbg.fatal(CALL_INFO, -1, "%s, Error: snapshot '%s' is truncated or corrupt\n", getName().c_str(), snapshotLoad.c_str());
 }
 
@@ -22,9 +22,11 @@
 #ifndef _MEMHIERARCHY_DIRCONTROLLER_H_
 #define _MEMHIERARCHY_DIRCONTROLLER_H_
 
+#include <deque>
 #include <map>
 #include <set>
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 #include <sst/core/event.h>
@@ -36,6 +38,7 @@
 #include "memEvent.h"
 #include "util.h"
 #include "mshr.h"
+#include "snapshot.h"
 
 using namespace std;
 
@@ -52,10 +55,13 @@ public:
     SST_ELI_DOCUMENT_PARAMS( 
             {"clock",                   "Clock rate of controller.", "1GHz"},
             {"entry_cache_size",        "Size (in # of entries) the controller will cache.", "0"},
+            {"entry_cache_policy",      "Replacement policy for the entry cache. 'lru': exact LRU over a linked list. 'clock': preallocated set-associative array with CLOCK replacement, for directories tracking very large numbers of lines.", "lru"},
+            {"entry_cache_associativity", "For entry_cache_policy=clock, number of ways per set in the entry cache. Must evenly divide entry_cache_size. 0 means fully associative.", "16"},
             {"debug",                   "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
             {"debug_level",             "Debugging level: 0 to 10", "0"},
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},
             {"cache_line_size",         "Size of a cache line [aka cache block] in bytes.", "64"},
+            {"timing_only",             "Model timing only: events are made dataless on arrival so payload sizes are modeled but no payload bytes are stored or copied.", "false"},
             {"coherence_protocol",      "Coherence protocol.  Supported --MESI, MSI--", "MESI"},
             {"mshr_num_entries",        "Number of MSHRs. Set to -1 for almost unlimited number.", "-1"},
             {"net_memory_name",         "For directories connected to a memory over the network: name of the memory this directory owns", ""},
@@ -67,6 +73,9 @@ public:
             {"addr_range_end",          "Highest address handled by this directory.", "uint64_t-1"},
             {"interleave_size",         "Size of interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
             {"interleave_step",         "Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
+            {"snapshot_save",           "Write the directory's stable entries (state, sharers, owner, whether cached) to this file. Use a separate file for each component.", ""},
+            {"snapshot_save_time",      "Simulated time at which to write the snapshot, e.g., '1ms'. Entries with requests in progress are not saved. If not set, the snapshot is written at the end of simulation.", ""},
+            {"snapshot_load",           "Restore the directory's entries from a snapshot file at setup.", ""},
             /* Old parameters - deprecated or moved */
             {"direct_mem_link",         "DEPRECATED. Now auto-detected by configure. Specifies whether directory has a direct connection to memory (1) or is connected via a network (0)","1"}, // Remove SST 8.0
             {"network_num_vc",          "DEPRECATED. Number of virtual channels (VCs) on the on-chip network. memHierarchy only uses one VC.", "1"}, // Remove SST 9.0
@@ -93,6 +102,8 @@ public:
             {"requests_received_PutM",          "Number of PutM (dirty exclusive replacement) requests received",       "requests",     1},
             {"requests_received_noncacheable",  "Number of noncacheable requests that were received and forwarded",     "requests",     1},
             {"requests_received_custom",        "Number of custom requests that were received and forwarded",           "requests",     1},
+            {"requests_received_warmup",        "Number of functional warmup requests received (see memHierarchy.Cache warmup_requests)", "requests", 1},
+            {"warmup_grants",                   "Number of functional warmup requests for which the requesting cache was recorded as a sharer", "requests", 1},
             {"responses_received_NACK",         "Number of NACK responses received",                                    "responses",    1},
             {"responses_received_FetchResp",    "Number of FetchResp responses received (response to FetchInv/Fetch)",  "responses",    1},
             {"responses_received_FetchXResp",   "Number of FetchXResp responses received (response to FetchXInv) ",     "responses",    1},
@@ -123,6 +134,7 @@ private:
     uint32_t    numTargets;
     uint32_t    targetCount;
     uint32_t    cacheLineSize;
+    bool        timingOnly;     // Make events dataless on arrival
 
     /* Range of addresses supported by this directory */
     Addr        addrRangeStart;
@@ -140,7 +152,16 @@ private:
     /* Directory cache */
     size_t      entryCacheMaxSize;
     size_t      entryCacheSize;
+    bool        entryCacheClock;        // Use the set-associative CLOCK entry cache instead of the LRU list
+    uint32_t    entryCacheAssoc;        // Ways per set in the CLOCK entry cache
+    uint32_t    entryCacheSets;         // Number of sets in the CLOCK entry cache
     
+    /* Snapshots */
+    std::string snapshotSave;       // Snapshot file to write, empty if none
+    std::string snapshotLoad;       // Snapshot file to restore at setup, empty if none
+    Link*       snapshotLink;       // Self link that fires at snapshot_save_time
+    bool        snapshotSaved;
+
     /* Timestamp & latencies */
     uint64_t    timestamp;
     uint64_t    accessLatency;
@@ -173,6 +194,8 @@ private:
     Statistic<uint64_t> * stat_PutSRespReceived;
     Statistic<uint64_t> * stat_NoncacheReceived;
     Statistic<uint64_t> * stat_CustomReceived;
+    Statistic<uint64_t> * stat_WarmupReceived;
+    Statistic<uint64_t> * stat_WarmupGrants;
     // Sent events - to mem
     Statistic<uint64_t> * stat_dataReads;
     Statistic<uint64_t> * stat_dataWrites;
@@ -188,16 +211,20 @@ private:
     Statistic<uint64_t> * stat_MSHROccupancy;
 
     /* Directory structures */
-    std::list<DirEntry*>                    entryCache;
-    std::unordered_map<Addr,DirEntry*>      directory;
+    std::list<DirEntry*>                    entryCache;         // LRU order for entry_cache_policy=lru
+    std::vector<DirEntry*>                  entryCacheSlots;    // Set-associative array for entry_cache_policy=clock
+    std::vector<Addr>                       entryCacheTags;     // Address of each slot's entry, probed without touching the entries
+    std::vector<uint8_t>                    entryCacheRef;      // CLOCK reference bit for each slot
+    std::vector<uint32_t>                   entryCacheHand;     // CLOCK hand for each set
+    std::unordered_map<Addr,DirEntry*>      directory;          // With entry_cache_policy=clock, only entries that are not in entryCacheSlots
     std::map<std::string,uint32_t>          node_lookup;
     std::vector<std::string>                nodeid_to_name;
     
     /* Queue of packets to work on */
     std::list<MemEvent*>                    workQueue;
-    std::map<MemEvent::id_type, Addr>       memReqs;
-    std::map<MemEvent::id_type, Addr>       dirEntryMiss;
-    std::map<MemEvent::id_type, std::string> noncacheMemReqs;
+    std::unordered_map<MemEvent::id_type, Addr, memEventIdHash>        memReqs;
+    std::unordered_map<MemEvent::id_type, Addr, memEventIdHash>        dirEntryMiss;
+    std::unordered_map<MemEvent::id_type, EndpointId, memEventIdHash>  noncacheMemReqs;
 
     /* Network connections */
     MemLink*    memLink;
@@ -209,10 +236,26 @@ private:
     
     /** Find directory entry by base address */
     DirEntry* getDirEntry(Addr target);
+
+    /** Take a DirEntry from the pool, or return one to it */
+    DirEntry* allocateDirEntry(Addr baseAddr);
+    void releaseDirEntry(DirEntry * entry);
 	
     /** Handle incoming GetS request */
     void handleGetS(MemEvent * ev, bool replay);
     
+    /** Handle incoming functional warmup request */
+    void handleWarmup(MemEvent * ev);
+
+    /** Write stable directory entries to 'snapshot_save' */
+    void saveSnapshot();
+
+    /** Restore directory entries from 'snapshot_load' */
+    void loadSnapshot();
+
+    /** Self-event handler for 'snapshot_save_time' */
+    void handleSnapshotEvent(SST::Event * event);
+    
     /** Handle incoming GetX/GetSX request */
     void handleGetX(MemEvent * ev, bool replay);
 
@@ -295,6 +338,12 @@ private:
         of entries is done to get performance stimation */
     void updateCache(DirEntry *entry);
 
+    /** updateCache() for entry_cache_policy=clock */
+    void updateClockCache(DirEntry *entry);
+
+    /** Set in the CLOCK entry cache that an address maps to */
+    uint32_t entryCacheSet(Addr baseAddr);
+
     /** Profile request and delete it */
     void postRequestProcessing(MemEvent * ev, DirEntry * entry, bool stable);
 
@@ -343,18 +392,27 @@ private:
         Addr                baseAddr;       // block address
         State               state;          // state
         MemEvent::id_type   lastRequest;    // ID of message we're wanting a response to  - used to track whether a NACK needs to be retried
-        std::list<DirEntry*>::iterator cacheIter;
-	std::vector<bool>   sharers;        // set of sharers for block
+        std::list<DirEntry*>::iterator cacheIter;   // Position in entryCache (lru)
+        int                 cacheSlot;      // Index in entryCacheSlots (clock), -1 if not present
+        uint64_t            sharers;        // Bitmask of sharers with id < 64
+        std::vector<uint64_t> sharersExt;   // Bitmask of sharers with id >= 64, only sized if there are that many targets
+        uint32_t            sharerCount;    // Number of bits set in sharers/sharersExt
         int                 owner;          // owner of block
         Output * dbg;
 	
         DirEntry(Addr bsAddr, uint32_t bitlength, Output * d){
+            init(bsAddr, bitlength, d);
+        }
+
+        /* (Re)initialize, used when an entry is recycled from the pool */
+        void init(Addr bsAddr, uint32_t bitlength, Output * d) {
+            sharersExt.assign(bitlength > 64 ? (bitlength - 1) / 64 : 0, 0);
             clearEntry();
             baseAddr     = bsAddr;
-            sharers.resize(bitlength);
             dbg          = d;
             state        = I;
             cached       = false;
+            cacheSlot    = -1;
         }
 
         void clearEntry(){
@@ -383,31 +441,48 @@ private:
         }
         
         uint32_t getSharerCount(void) {
-            uint32_t count = 0;
-            for (uint32_t i = 0; i < sharers.size(); i++) {
-                if (sharers[i]) count++;
-            }
-            return count;
+            return sharerCount;
         }
 
         void clearSharers(void){
-            for (uint32_t i = 0; i < sharers.size(); i++)
-                sharers[i] = false;
+            sharers = 0;
+            for (uint32_t i = 0; i < sharersExt.size(); i++)
+                sharersExt[i] = 0;
+            sharerCount = 0;
         }
         
         void addSharer(int id){
-            sharers[id]= true;
+            uint64_t &word = (id < 64) ? sharers : sharersExt[(id >> 6) - 1];
+            uint64_t bit = (uint64_t)1 << (id & 63);
+            if (!(word & bit)) sharerCount++;
+            word |= bit;
         }
         
         bool isSharer(int id) {
-            return sharers[id];
+            if (id < 64) return (sharers >> id) & 1;
+            return (sharersExt[(id >> 6) - 1] >> (id & 63)) & 1;
         }
 
         void removeSharer(int id){
-            if (!sharers[id]) {
+            if (!isSharer(id)) {
                 dbg->fatal(CALL_INFO,-1,"Removing a sharer which does not exist\n");
             }
-            sharers[id]= false;
+            if (id < 64) sharers &= ~((uint64_t)1 << id);
+            else sharersExt[(id >> 6) - 1] &= ~((uint64_t)1 << (id & 63));
+            sharerCount--;
+        }
+
+        /* Return the lowest sharer id >= id, or -1 if there is none */
+        int nextSharer(int id) {
+            uint32_t word = id >> 6;
+            while (word <= sharersExt.size()) {
+                uint64_t bits = (word == 0) ? sharers : sharersExt[word - 1];
+                bits &= ~(uint64_t)0 << (id & 63);
+                if (bits) return (word << 6) + __builtin_ctzll(bits);
+                word++;
+                id = word << 6;
+            }
+            return -1;
         }
         
         int getOwner(void) {
@@ -443,6 +518,10 @@ private:
         }
     };
 
+    /* DirEntry storage - declared after DirEntry since deque needs a complete type */
+    std::deque<DirEntry>    entryPool;      // Backing store for DirEntry objects, never shrinks
+    std::vector<DirEntry*>  freeEntries;    // Entries in entryPool available for reuse
+
 public:
     DirectoryController(ComponentId_t id, Params &params);
     ~DirectoryController();
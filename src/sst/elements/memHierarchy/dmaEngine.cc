@@ -183,7 +183,7 @@ void DMAEngine::processPacket(Request *req, MemEventBase *ev)
         req->loadKeys.erase(ev->getResponseToID());
         MemEvent *storeEV = new MemEvent(this, (req->getDst() + offset), (req->getDst() + offset), GetX);
         storeEV->setFlag(MemEvent::F_NONCACHEABLE);
-        storeEV->setPayload(ev->getPayload());
+        storeEV->setPayload(ev->getSharedPayload());
         storeEV->setDst(networkLink->findTargetDestination(req->getDst() + offset));
         req->storeKeys.insert(storeEV->getID());
         networkLink->send(storeEV);
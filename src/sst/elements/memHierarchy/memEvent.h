@@ -23,6 +23,8 @@
 
 #include "util.h"
 #include "memEventBase.h"
+#include "memEventPool.h"
+#include "sharedPayload.h"
 #include "memTypes.h"
 
 namespace SST { namespace MemHierarchy {
@@ -41,32 +43,58 @@ using namespace std;
 class MemEvent : public MemEventBase  {
 public:
     
-    /** Creates a new MemEvent - Generic */
-    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd) : MemEventBase(src->getName(), cmd) {
+    /** Creates a new MemEvent - Generic
+     *  'src' is the sender's interned ID and 'initTime' the current time in ns */
+    MemEvent(EndpointId src, SimTime_t initTime, Addr addr, Addr baseAddr, Command cmd) : MemEventBase(src, cmd) {
         initialize();
         addr_ = addr;
         baseAddr_ = baseAddr;
-        initTime_ = src->getCurrentSimTimeNano();
+        initTime_ = initTime;
     }
 
     /** MemEvent constructor - Reads */
-    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd, uint32_t size) : MemEventBase(src->getName(), cmd) {
+    MemEvent(EndpointId src, SimTime_t initTime, Addr addr, Addr baseAddr, Command cmd, uint32_t size) : MemEventBase(src, cmd) {
         initialize();
         addr_ = addr;
         baseAddr_ = baseAddr;
-        initTime_ = src->getCurrentSimTimeNano();
+        initTime_ = initTime;
         size_ = size;
     }
 
     /** MemEvent constructor - Writes */
-    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd, std::vector<uint8_t>& data) : MemEventBase(src->getName(), cmd) {
+    MemEvent(EndpointId src, SimTime_t initTime, Addr addr, Addr baseAddr, Command cmd, std::vector<uint8_t>& data) : MemEventBase(src, cmd) {
         initialize();
         addr_ = addr;
         baseAddr_ = baseAddr;
-        initTime_ = src->getCurrentSimTimeNano();
+        initTime_ = initTime;
         setPayload(data); // Also sets size_ field
     }
 
+    /** MemEvent constructor - Writes, sharing data with another event or a cache line */
+    MemEvent(EndpointId src, SimTime_t initTime, Addr addr, Addr baseAddr, Command cmd, const SharedPayload& data) : MemEventBase(src, cmd) {
+        initialize();
+        addr_ = addr;
+        baseAddr_ = baseAddr;
+        initTime_ = initTime;
+        setPayload(data); // Also sets size_ field
+    }
+
+    /** Creates a new MemEvent from component 'src' - Generic */
+    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd) : 
+        MemEvent(EndpointNames::idOf(src), src->getCurrentSimTimeNano(), addr, baseAddr, cmd) { }
+
+    /** MemEvent constructor - Reads */
+    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd, uint32_t size) : 
+        MemEvent(EndpointNames::idOf(src), src->getCurrentSimTimeNano(), addr, baseAddr, cmd, size) { }
+
+    /** MemEvent constructor - Writes */
+    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd, std::vector<uint8_t>& data) : 
+        MemEvent(EndpointNames::idOf(src), src->getCurrentSimTimeNano(), addr, baseAddr, cmd, data) { }
+
+    /** MemEvent constructor - Writes, sharing data with another event or a cache line */
+    MemEvent(const Component *src, Addr addr, Addr baseAddr, Command cmd, const SharedPayload& data) : 
+        MemEvent(EndpointNames::idOf(src), src->getCurrentSimTimeNano(), addr, baseAddr, cmd, data) { }
+
     /** Create a new MemEvent instance, pre-configured to act as a NACK response */
     MemEvent* makeNACKResponse(MemEvent* NACKedEvent, SimTime_t timeInNano) {
         MemEvent *me      = new MemEvent(*this);
@@ -115,6 +143,8 @@ public:
         blocked_            = false;
         initTime_           = 0;
         payload_.clear();
+        dataless_           = false;
+        datalessSize_       = 0;
         dirty_              = false;
 	instPtr_	    = 0;
 	vAddr_		    = 0;
@@ -179,19 +209,54 @@ public:
     bool fromHighNetNACK()  { return !CommandCPUSide[(int)cmd_];}
     bool fromLowNetNACK()   { return CommandCPUSide[(int)cmd_];}
 
-    /** @return  the data payload. */
+    /** @return  the data payload, writable. Always empty for a dataless event.
+     * Takes a private copy if the bytes are shared; use getSharedPayload() to read or forward them.
+     */
     dataVec& getPayload(void) {
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
+        if ( !dataless_ && payload_.size() < size_ )  payload_.mut().resize(size_);
+        return payload_.mut();
+    }
+
+    /** @return  the data payload without copying it. Always empty for a dataless event */
+    const SharedPayload& getSharedPayload(void) {
+        if ( !dataless_ && payload_.size() < size_ )  payload_.mut().resize(size_);
         return payload_;
     }
-    
 
     /** Sets the data payload and payload size.
      * @param[in] data  Vector from which to copy data
      */
-    void setPayload(std::vector<uint8_t>& data) {
+    void setPayload(const std::vector<uint8_t>& data) {
+        setSize(data.size());
+        if (dataless_) {
+            datalessSize_ = data.size();
+            return;
+        }
+        payload_.assign(data);
+    }
+
+    /** Sets the data payload and payload size.
+     * @param[in] data  Vector to take the data from
+     */
+    void setPayload(std::vector<uint8_t>&& data) {
+        setSize(data.size());
+        if (dataless_) {
+            datalessSize_ = data.size();
+            return;
+        }
+        payload_.assign(std::move(data));
+    }
+
+    /** Sets the data payload and payload size.
+     * @param[in] data  Payload to share, no bytes are copied
+     */
+    void setPayload(const SharedPayload& data) {
         setSize(data.size());
+        if (dataless_) {
+            datalessSize_ = data.size();
+            return;
+        }
         payload_ = data;
     }
     
@@ -199,23 +264,53 @@ public:
      * @param[in] size  How many bytes to copy from data
      * @param[in] data  Data array to set as payload
      */
-    void setPayload(uint32_t size, uint8_t* data) {
+    void setPayload(uint32_t size, const uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
+        if (dataless_) {
+            datalessSize_ = size;
+            return;
         }
+        if (size == 0) payload_.clear();
+        else payload_.assign(data, size);
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
-        payload_.clear();
-        payload_.resize(size, 0);
+        if (dataless_) {
+            datalessSize_ = size;
+            return;
+        }
+        payload_.assign(size, 0);
+    }
+
+    /** Sets the payload to src's payload, which may be dataless. The bytes are shared, not copied */
+    void copyPayload(MemEvent* src) {
+        if (src->dataless_) {
+            setDataless();
+            setSize(src->datalessSize_);
+            datalessSize_ = src->datalessSize_;
+        } else {
+            setPayload(src->getSharedPayload());
+        }
     }
 
     size_t getPayloadSize() override {
-        return payload_.size();
+        return dataless_ ? datalessSize_ : payload_.size();
+    }
+
+    /** Timing-only events keep their payload size, which is what link and network
+     * bandwidth is modeled on, but never store or copy payload bytes. Any payload
+     * already present is released. Events created from a dataless event inherit this.
+     */
+    void setDataless() {
+        if (dataless_) return;
+        dataless_ = true;
+        datalessSize_ = payload_.size();
+        payload_.clear();
     }
+    
+    /** Returns true if this event carries a payload size but no payload */
+    bool isDataless() const { return dataless_; }
 
     /** Sets that this is a prefetch command */
     void setPrefetchFlag(bool prefetch) { prefetch_ = prefetch;}
@@ -240,6 +335,10 @@ public:
         return new MemEvent(*this);
     }
 
+    /** MemEvents are allocated from a per-thread pool, see memEventPool.h */
+    static void* operator new(size_t size) { return MemEventPool<MemEvent>::allocate(size); }
+    static void operator delete(void* ptr, size_t size) { MemEventPool<MemEvent>::release(ptr, size); }
+
     virtual std::string getVerboseString() override {
         std::ostringstream str;
         str << std::hex << " Addr: 0x" << addr_ << " BaseAddr: 0x" << baseAddr_;
@@ -271,7 +370,9 @@ private:
     bool            addrGlobal_;        // Whether address is a local or global address 
     MemEvent*       NACKedEvent_;       // For a NACK, pointer to the NACKed event
     int             retries_;           // For NACKed events, how many times a retry has been sent
-    dataVec         payload_;           // Data
+    SharedPayload   payload_;           // Data, shared with the event this was copied from and any cache lines it filled
+    bool            dataless_;          // Timing-only: payload_ is always empty and datalessSize_ is the modeled payload size
+    uint32_t        datalessSize_;      // Payload size of a dataless event
     bool            prefetch_;          // Whether this request came from a prefetcher
     bool            blocked_;           // Whether this request blocked for another pending request (for profiling) TODO move to mshrs
     SimTime_t       initTime_;          // Timestamp when event was created, for detecting timeouts TODO move to mshrs
@@ -291,7 +392,12 @@ public:
         ser & addrGlobal_;
         ser & NACKedEvent_;
         ser & retries_;
-        ser & payload_;
+        dataVec payload;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) payload = payload_.get();
+        ser & payload;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) payload_.assign(std::move(payload));
+        ser & dataless_;
+        ser & datalessSize_;
         ser & prefetch_;
         ser & blocked_;
         ser & initTime_;
@@ -21,6 +21,7 @@
 
 #include "util.h"
 #include "memTypes.h"
+#include "memEventPool.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -41,10 +42,18 @@ public:
     static const uint32_t F_LLSC            = 0x00000100;
     static const uint32_t F_SUCCESS         = 0x00001000;
     static const uint32_t F_NORESPONSE      = 0x00010000;
+    static const uint32_t F_WARMUP          = 0x00100000;     // Functional warmup: update cache/directory state only, no timing
 
 
     /** Creates a new MemEventBase */
     MemEventBase(std::string src, Command cmd) : SST::Event() {
+        setDefaults();
+        cmd_ = cmd;
+        src_ = EndpointNames::intern(src);
+    }
+
+    /** Creates a new MemEventBase from an already-interned source */
+    MemEventBase(EndpointId src, Command cmd) : SST::Event() {
         setDefaults();
         cmd_ = cmd;
         src_ = src;
@@ -53,9 +62,9 @@ public:
     virtual void setDefaults() {
         eventID_        = generateUniqueId();  // Defined in SST::Event
         responseToID_   = NO_ID;
-        dst_            = NONE;
-        src_            = NONE;
-        rqstr_          = NONE;
+        dst_            = NO_ENDPOINT;
+        src_            = NO_ENDPOINT;
+        rqstr_          = NO_ENDPOINT;
         cmd_            = Command::NULLCMD;
         flags_          = 0;
         memFlags_       = 0;
@@ -89,19 +98,31 @@ public:
     void setCmd(Command newcmd) { cmd_ = newcmd; }
     
     /** @return the source string - who sent this MemEvent */
-    const std::string& getSrc(void) const { return src_; }
+    const std::string& getSrc(void) const { return EndpointNames::name(src_); }
+    /** @return the source ID - who sent this MemEvent */
+    EndpointId getSrcId(void) const { return src_; }
     /** Sets the source string - who sent this MemEvent */
-    void setSrc(const std::string& src) { src_ = src; }
+    void setSrc(const std::string& src) { src_ = EndpointNames::intern(src); }
+    /** Sets the source ID - who sent this MemEvent */
+    void setSrc(EndpointId src) { src_ = src; }
     
     /** @return the destination string - who receives this MemEvent */
-    const std::string& getDst(void) const { return dst_; }
+    const std::string& getDst(void) const { return EndpointNames::name(dst_); }
+    /** @return the destination ID - who receives this MemEvent */
+    EndpointId getDstId(void) const { return dst_; }
     /** Sets the destination string - who received this MemEvent */
-    void setDst(const std::string& dst) { dst_ = dst; }
+    void setDst(const std::string& dst) { dst_ = EndpointNames::intern(dst); }
+    /** Sets the destination ID - who receives this MemEvent */
+    void setDst(EndpointId dst) { dst_ = dst; }
     
     /** @return the requestor string - whose original request caused this MemEvent */
-    const std::string& getRqstr(void) const { return rqstr_; }
+    const std::string& getRqstr(void) const { return EndpointNames::name(rqstr_); }
+    /** @return the requestor ID - whose original request caused this MemEvent */
+    EndpointId getRqstrId(void) const { return rqstr_; }
     /** Sets the requestor string - whose original request caused this MemEvent */
-    void setRqstr(const std::string& rqstr) { rqstr_ = rqstr; }
+    void setRqstr(const std::string& rqstr) { rqstr_ = EndpointNames::intern(rqstr); }
+    /** Sets the requestor ID - whose original request caused this MemEvent */
+    void setRqstr(EndpointId rqstr) { rqstr_ = rqstr; }
 
     /** @returns the state of all flags */
     uint32_t getFlags(void) const { return flags_; }
@@ -153,6 +174,11 @@ public:
             str += "F_NORESPONSE"; 
             addComma = true;
         }
+        if (flags_ & F_WARMUP) { 
+            if (addComma) str += ", ";
+            str += "F_WARMUP"; 
+            addComma = true;
+        }
         str += "]";
         return str;
     }
@@ -170,7 +196,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream str;
         str << " Flags: " << getFlagString() << " MemFlags: 0x" << std::hex << memFlags_;
-        return idstring.str() + " Cmd: " + cmdStr + " Src: " + src_ + " Dst: " + dst_ + " Rqstr: " + rqstr_ + str.str();
+        return idstring.str() + " Cmd: " + cmdStr + " Src: " + getSrc() + " Dst: " + getDst() + " Rqstr: " + getRqstr() + str.str();
     }
 
     /** Get brief print of the event */
@@ -181,7 +207,7 @@ public:
         if (BasicCommandClassArr[(int)cmd_] == BasicCommandClass::Response) {
             idstring << " RespID: <" << responseToID_.first << "," << responseToID_.second << ">";
         }
-        return idstring.str() + " Cmd: " + cmdStr + " Src: " + src_ + " Dst: " + dst_;
+        return idstring.str() + " Cmd: " + cmdStr + " Src: " + getSrc() + " Dst: " + getDst();
     }
 
     virtual bool doDebug(std::set<Addr> &addr) {
@@ -203,9 +229,9 @@ public:
 protected:
     id_type         eventID_;           // Unique ID for this event
     id_type         responseToID_;      // For responses, holds the ID to which this event matches
-    string          src_;               // Source ID
-    string          dst_;               // Destination ID
-    string          rqstr_;             // Cache that originated this request
+    EndpointId      src_;               // Source ID
+    EndpointId      dst_;               // Destination ID
+    EndpointId      rqstr_;             // Cache that originated this request
     Command         cmd_;               // Command
     uint32_t        flags_;
     uint32_t        memFlags_;
@@ -217,9 +243,21 @@ public:
         Event::serialize_order(ser);
         ser & eventID_;
         ser & responseToID_;
-        ser & src_;
-        ser & dst_;
-        ser & rqstr_;
+        // IDs are only meaningful within a process so send the names and re-intern on the other side
+        std::string src, dst, rqstr;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) {
+            src = getSrc();
+            dst = getDst();
+            rqstr = getRqstr();
+        }
+        ser & src;
+        ser & dst;
+        ser & rqstr;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            src_ = EndpointNames::intern(src);
+            dst_ = EndpointNames::intern(dst);
+            rqstr_ = EndpointNames::intern(rqstr);
+        }
         ser & cmd_;
         ser & flags_;
         ser & memFlags_;
@@ -234,6 +272,13 @@ struct memEventCmp {
     }
 };
 
+/* Hash for event IDs, for unordered containers keyed by MemEventBase::id_type */
+struct memEventIdHash {
+    size_t operator() (const MemEventBase::id_type &id) const {
+        return std::hash<uint64_t>()(id.first * 0x9E3779B97F4A7C15ULL ^ (uint64_t)(uint32_t)id.second);
+    }
+};
+
 /* 
  * Init event type
  */
@@ -252,6 +297,10 @@ public:
 
     InitCommand getInitCmd() { return initCmd_; }
 
+    /** Allocated from a per-thread pool, see memEventPool.h */
+    static void* operator new(size_t size) { return MemEventPool<MemEventInit>::allocate(size); }
+    static void operator delete(void* ptr, size_t size) { MemEventPool<MemEventInit>::release(ptr, size); }
+
     std::vector<uint8_t>& getPayload() { return payload_; }
     Addr getAddr() { return addr_; }
     void setAddr(Addr addr) { addr_ = addr; }
@@ -0,0 +1,179 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_MEMEVENTPOOL_H
+#define MEMHIERARCHY_MEMEVENTPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ *  Slab allocator for fixed-size event objects
+ *
+ *  Each thread keeps its own free list so allocation and release on the same thread never lock.
+ *  Memory is carved from slabs of SLAB_BLOCKS objects. Every block records the pool that carved
+ *  it, and a block freed on a different thread goes back to that pool through the pool's remote
+ *  free stack (lock-free push). The owner takes the whole stack when its free list runs dry,
+ *  before carving a new slab, so events that are created on one thread and retired on another
+ *  do not make either thread's pool grow without bound. Only requests for exactly sizeof(T) are
+ *  pooled so that derived classes which inherit T's operator new fall through to the global
+ *  allocator.
+ *
+ *  Usage: in T,
+ *      static void* operator new(size_t size) { return MemEventPool<T>::allocate(size); }
+ *      static void operator delete(void* ptr, size_t size) { MemEventPool<T>::release(ptr, size); }
+ */
+template<typename T>
+class MemEventPool {
+public:
+    /* Process-wide counters, summed over all threads */
+    struct Stats {
+        uint64_t blocks;        // Blocks carved from slabs (pool capacity)
+        uint64_t allocs;        // Allocations served from the pool
+        uint64_t outstanding;   // Blocks currently allocated
+    };
+
+    static void* allocate(size_t size) {
+        if (size != sizeof(T)) return ::operator new(size);
+
+        ThreadPool &pool = local();
+        if (pool.freeList == nullptr) pool.refill();
+        Block * block = pool.freeList;
+        pool.freeList = block->next;
+        block->owner = &pool;
+        bump(pool.counters.allocs);
+        return block->storage;
+    }
+
+    static void release(void * ptr, size_t size) {
+        if (ptr == nullptr) return;
+        if (size != sizeof(T)) {
+            ::operator delete(ptr);
+            return;
+        }
+        ThreadPool &pool = local();
+        Block * block = reinterpret_cast<Block*>(static_cast<unsigned char*>(ptr) - offsetof(Block, storage));
+        ThreadPool * owner = block->owner;
+        if (owner == &pool) {
+            block->next = pool.freeList;
+            pool.freeList = block;
+        } else {
+            block->next = owner->remoteFree.load(std::memory_order_relaxed);
+            while (!owner->remoteFree.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) { }
+        }
+        bump(pool.counters.frees);
+    }
+
+    static Stats getStats() {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        uint64_t frees = 0;
+        Stats stats = {0, 0, 0};
+        for (typename std::vector<ThreadPool*>::iterator it = reg.pools.begin(); it != reg.pools.end(); it++) {
+            stats.blocks += (*it)->counters.blocks.load(std::memory_order_relaxed);
+            stats.allocs += (*it)->counters.allocs.load(std::memory_order_relaxed);
+            frees += (*it)->counters.frees.load(std::memory_order_relaxed);
+        }
+        stats.outstanding = stats.allocs - frees;
+        return stats;
+    }
+
+    /** True for exactly one caller per process. The stats are process-wide, so only the component
+     *  that claims them should record them */
+    static bool claimStats() {
+        static std::atomic<bool> claimed(false);
+        return !claimed.exchange(true);
+    }
+
+private:
+    static const size_t SLAB_BLOCKS = 256;
+
+    struct ThreadPool;
+
+    /* 'next' links free blocks; 'owner' is only read while the block is allocated */
+    struct Block {
+        union {
+            Block * next;
+            ThreadPool * owner;
+        };
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /* Only the owning thread writes these; getStats() may read them from any thread */
+    struct Counters {
+        std::atomic<uint64_t> blocks;
+        std::atomic<uint64_t> allocs;
+        std::atomic<uint64_t> frees;
+        Counters() : blocks(0), allocs(0), frees(0) { }
+    };
+
+    /* Pools and slabs outlive the threads that created them, since their blocks may still be in use */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<Block*> slabs;
+        std::vector<ThreadPool*> pools;
+    };
+
+    struct ThreadPool {
+        Block * freeList;
+        std::atomic<Block*> remoteFree;     // Blocks freed by other threads
+        Counters counters;
+
+        ThreadPool() : freeList(nullptr), remoteFree(nullptr) {
+            Registry &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.pools.push_back(this);
+        }
+
+        void refill() {
+            freeList = remoteFree.exchange(nullptr, std::memory_order_acquire);
+            if (freeList != nullptr) return;
+
+            Block * slab = static_cast<Block*>(::operator new(SLAB_BLOCKS * sizeof(Block)));
+            for (size_t i = 0; i < SLAB_BLOCKS - 1; i++)
+                slab[i].next = &slab[i+1];
+            slab[SLAB_BLOCKS - 1].next = nullptr;
+            freeList = slab;
+            counters.blocks.store(counters.blocks.load(std::memory_order_relaxed) + SLAB_BLOCKS, std::memory_order_relaxed);
+
+            Registry &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.slabs.push_back(slab);
+        }
+    };
+
+    static void bump(std::atomic<uint64_t> &counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static ThreadPool& local() {
+        static thread_local ThreadPool * pool = new ThreadPool();
+        return *pool;
+    }
+
+    static Registry& registry() {
+        static Registry reg;
+        return reg;
+    }
+};
+
+}}
+
+#endif /* MEMHIERARCHY_MEMEVENTPOOL_H */
@@ -158,6 +158,12 @@ MemEventBase* MemHierarchyInterface::createCustomEvent(SimpleMem::Request * req)
     if(req->flags & SimpleMem::Request::F_NONCACHEABLE)
         cme->setFlag(MemEvent::F_NONCACHEABLE);
     
+    /* Operands, if any. The request size may differ from the operand size (e.g., a reduction over a range) */
+    if (!req->data.empty()) {
+        cme->setPayload(req->data);
+        cme->setSize(req->size);
+    }
+
     cme->setVirtualAddress(req->getVirtualAddress());
     cme->setInstructionPointer(req->getInstructionPointer());
 
@@ -203,8 +209,8 @@ void MemHierarchyInterface::updateRequest(SimpleMem::Request* req, MemEvent *me)
     switch (me->getCmd()) {
         case Command::GetSResp:
             req->cmd   = SimpleMem::Request::ReadResp;
-            req->data  = me->getPayload();
-            req->size  = me->getPayload().size();
+            req->data  = me->getSharedPayload().get();
+            req->size  = req->data.size();
             break;
         case Command::GetXResp:
             req->cmd   = SimpleMem::Request::WriteResp;
@@ -228,6 +234,11 @@ void MemHierarchyInterface::updateRequest(SimpleMem::Request* req, MemEvent *me)
 void MemHierarchyInterface::updateCustomRequest(SimpleMem::Request* req, MemEventBase *ev) const{
     req->cmd = SimpleMem::Request::CustomCmd;
     req->memFlags = ev->getMemFlags();
+
+    /* Results, if the handler returned any */
+    CustomCmdEvent * cme = dynamic_cast<CustomCmdEvent*>(ev);
+    if (cme && cme->getPayloadSize() != 0)
+        req->data = cme->getPayload();
 }
 
 bool MemHierarchyInterface::initialize(const std::string &linkName, HandlerBase *handler){
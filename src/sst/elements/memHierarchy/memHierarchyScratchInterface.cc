@@ -191,7 +191,7 @@ void MemHierarchyScratchInterface::updateRequest(SimpleMem::Request* req, MemEve
             break;
         case Command::GetSResp:
             req->cmd   = SimpleMem::Request::ReadResp;
-            req->data = static_cast<MemEvent*>(me)->getPayload();
+            req->data = static_cast<MemEvent*>(me)->getSharedPayload().get();
             req->size  = req->data.size();
             break;
         case Command::GetXResp:
@@ -56,8 +56,8 @@ void MemLink::init(unsigned int phase) {
                 epInfo.addr = 0;
                 epInfo.id = 0;
                 epInfo.region = mEvRegion->getRegion();
-                sourceEndpointInfo.insert(epInfo);
-                destEndpointInfo.insert(epInfo);
+                addSource(epInfo);
+                addDest(epInfo);
 
                 if (mEvRegion->getSetRegion() && acceptRegion) {
                     dbg.debug(_L10_, "\tUpdating local region\n");
@@ -54,6 +54,8 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS( { MEMLINK_ELI_PARAMS }  )
 
+    SST_ELI_DOCUMENT_STATISTICS( MEMLINKBASE_ELI_STATS )
+
 /* Begin class definition */
     class MemEventLinkInit : public MemEventBase {
         public:
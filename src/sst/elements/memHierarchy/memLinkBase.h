@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
+#include <algorithm>
 
 #include <sst/core/event.h>
 #include <sst/core/output.h>
@@ -51,10 +52,13 @@ public:
     { "interleave_size",    "(string) Set by parent component. Size of interleaved chunks.", "0B"},\
     { "interleave_step",    "(string) Set by parent component. Distance between interleaved chunks.", "0B"}
 
+#define MEMLINKBASE_ELI_STATS { "route_lookup_probes", "Number of destination regions checked to route one address", "count", 5 }
+
 
     // Struct identifying an endpoint
     struct EndpointInfo {
         std::string name;
+        EndpointId nameId;  // Interned name, filled in when the endpoint is added to a link
         uint64_t addr;
         uint32_t id;
         MemRegion region;
@@ -106,11 +110,16 @@ public:
         info.region.interleaveSize = UnitAlgebra(ilSize).getRoundedValue();
         info.region.interleaveStep = UnitAlgebra(ilStep).getRoundedValue();
         info.name = getName();
+        info.nameId = EndpointNames::intern(info.name);
         info.addr = 0;
         info.id = 0;
 
         // Check whether we should accept a region push by someone else
         acceptRegion = params.find<bool>("accept_region", false);
+
+        routeDirty = true;
+        routeLinear = true;
+        stat_routeProbes = registerStatistic<uint64_t>("route_lookup_probes");
     }
     
     /* Destructor */
@@ -141,15 +150,44 @@ public:
      * Extra functions for MemLink derivatives 
      */
     virtual bool clock() { return true; } // No clock
-    virtual uint64_t lookupNetworkAddress(const std::string &dst) const { return 0; } // No network address
+    virtual uint64_t lookupNetworkAddress(EndpointId dst) const { return 0; } // No network address
 
     // Link call back for incoming events
     void recvNotify(SST::Event * ev) { (*recvHandler)(ev); }
 
     /* Functions for managing communication according to address */
-    virtual std::string findTargetDestination(Addr addr) {
+    virtual EndpointId findTargetDestination(Addr addr) {
+        if (routeDirty) buildRouteTable();
+
+        uint64_t probes = 0;
+        if (!routeLinear) {
+            if (!routeSlotIndex.empty() && addr >= routeAnchor) {
+                uint64_t slot = ((addr - routeAnchor) / routeGranule) % (routeSlotIndex.size() - 1);
+                for (uint32_t i = routeSlotIndex[slot]; i < routeSlotIndex[slot + 1]; i++) {
+                    probes++;
+                    if (routeCandidates[i]->region.contains(addr)) {
+                        stat_routeProbes->addData(probes);
+                        return routeCandidates[i]->nameId;
+                    }
+                }
+            }
+            std::vector<RouteRange>::const_iterator range = std::upper_bound(routeRanges.begin(), routeRanges.end(), addr, RouteRange::before);
+            if (range != routeRanges.begin()) {
+                range--;
+                probes++;
+                if (addr < range->end) {
+                    stat_routeProbes->addData(probes);
+                    return range->endpoint->nameId;
+                }
+            }
+        }
+
         for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
-            if (it->region.contains(addr)) return it->name;
+            probes++;
+            if (it->region.contains(addr)) {
+                stat_routeProbes->addData(probes);
+                return it->nameId;
+            }
         }
 
         /* Build error string */
@@ -160,7 +198,7 @@ public:
             error << it->name << " " << it->region.toString() << endl;
         }
         dbg.fatal(CALL_INFO, -1, "%s", error.str().c_str());
-        return "";
+        return NO_ENDPOINT;
     }
 
     virtual bool isRequestAddressValid(Addr addr) { return info.region.contains(addr); }
@@ -169,11 +207,25 @@ public:
     std::set<EndpointInfo> * getSources() { return &sourceEndpointInfo; }
     std::set<EndpointInfo> * getDests() { return &destEndpointInfo; }
     
-    void setSources(std::set<EndpointInfo>& srcs) { sourceEndpointInfo = srcs; }
-    void setDests(std::set<EndpointInfo>& dsts) { destEndpointInfo = dsts; }
+    void setSources(std::set<EndpointInfo>& srcs) { 
+        sourceEndpointInfo.clear();
+        for (std::set<EndpointInfo>::iterator it = srcs.begin(); it != srcs.end(); it++) addSource(*it);
+    }
+    void setDests(std::set<EndpointInfo>& dsts) { 
+        destEndpointInfo.clear();
+        routeDirty = true;
+        for (std::set<EndpointInfo>::iterator it = dsts.begin(); it != dsts.end(); it++) addDest(*it);
+    }
     
-    void addSource(EndpointInfo info) { sourceEndpointInfo.insert(info); }
-    void addDest(EndpointInfo info) { destEndpointInfo.insert(info); }
+    void addSource(EndpointInfo info) { 
+        info.nameId = EndpointNames::intern(info.name);
+        sourceEndpointInfo.insert(info); 
+    }
+    void addDest(EndpointInfo info) { 
+        info.nameId = EndpointNames::intern(info.name);
+        destEndpointInfo.insert(info); 
+        routeDirty = true;
+    }
     
     virtual bool isDest(std::string str) { return true; } // Anything we get on this link is valid for a dest 
     virtual bool isSource(std::string str) { return true; } // Anything we get on this link is valid for a source
@@ -201,6 +253,109 @@ protected:
     std::set<EndpointInfo> sourceEndpointInfo;  // endpoint info for each source network endpoint
     std::set<EndpointInfo> destEndpointInfo;    // endpoint info for each destination network endpoint
     std::queue<MemEventInit*> initReceiveQ;     // queue for messages received during init
+
+private:
+
+    /*
+     * Routing table for findTargetDestination, rebuilt on the first lookup after the destinations change
+     *
+     * Destinations with contiguous regions are kept sorted by start address and found by binary search.
+     * Interleaved destinations are folded into one table covering a single interleave period: the
+     * period is split into granules (the gcd of all interleave sizes, steps and start offsets) and each
+     * granule lists, in destEndpointInfo order, the destinations whose interleave pattern covers it.
+     * A lookup is then one division and usually one region check instead of a scan of every
+     * destination. If regions overlap or the period would need too many granules, lookups fall back
+     * to the linear scan.
+     */
+    static const uint64_t MAX_ROUTE_SLOTS = 1 << 16;
+
+    struct RouteRange {
+        Addr start;
+        Addr end;
+        const EndpointInfo * endpoint;
+        static bool before(Addr addr, const RouteRange &range) { return addr < range.start; }
+        bool operator<(const RouteRange &o) const { return start < o.start; }
+    };
+
+    bool routeDirty;
+    bool routeLinear;
+    Addr routeAnchor;                                   // Lowest start address of the interleaved destinations
+    uint64_t routeGranule;
+    std::vector<uint32_t> routeSlotIndex;               // Granule i's candidates are routeCandidates[routeSlotIndex[i], routeSlotIndex[i+1])
+    std::vector<const EndpointInfo*> routeCandidates;
+    std::vector<RouteRange> routeRanges;                // Non-interleaved destinations, sorted by start
+    Statistic<uint64_t> * stat_routeProbes;
+
+    static uint64_t gcd(uint64_t a, uint64_t b) {
+        while (b != 0) {
+            uint64_t t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    void buildRouteTable() {
+        routeDirty = false;
+        routeLinear = true;
+        routeSlotIndex.clear();
+        routeCandidates.clear();
+        routeRanges.clear();
+
+        std::vector<const EndpointInfo*> interleaved;
+        for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
+            const MemRegion &region = it->region;
+            if (region.start >= region.end) continue;
+            if (region.interleaveSize == 0 || region.interleaveSize >= region.interleaveStep) {
+                RouteRange range = { region.start, region.end, &(*it) };
+                routeRanges.push_back(range);
+            } else {
+                interleaved.push_back(&(*it));
+            }
+        }
+
+        // Overlapping regions depend on scan order, leave those to the linear scan
+        std::sort(routeRanges.begin(), routeRanges.end());
+        for (size_t i = 1; i < routeRanges.size(); i++) {
+            if (routeRanges[i].start < routeRanges[i-1].end) return;
+        }
+        for (size_t i = 0; i < interleaved.size(); i++) {
+            for (size_t j = 0; j < routeRanges.size(); j++) {
+                if (interleaved[i]->region.start < routeRanges[j].end && routeRanges[j].start < interleaved[i]->region.end) return;
+            }
+        }
+
+        if (!interleaved.empty()) {
+            routeAnchor = interleaved[0]->region.start;
+            for (size_t i = 1; i < interleaved.size(); i++) routeAnchor = std::min(routeAnchor, interleaved[i]->region.start);
+
+            uint64_t granule = 0;
+            uint64_t period = 1;
+            for (size_t i = 0; i < interleaved.size(); i++) {
+                const MemRegion &region = interleaved[i]->region;
+                granule = gcd(granule, gcd(region.interleaveSize, gcd(region.interleaveStep, region.start - routeAnchor)));
+                period = period / gcd(period, region.interleaveStep) * region.interleaveStep;
+                if (period / granule > MAX_ROUTE_SLOTS) return;
+            }
+            routeGranule = granule;
+            uint64_t slots = period / granule;
+
+            routeSlotIndex.reserve(slots + 1);
+            for (uint64_t slot = 0; slot < slots; slot++) {
+                routeSlotIndex.push_back(routeCandidates.size());
+                Addr addr = routeAnchor + slot * granule;
+                for (size_t i = 0; i < interleaved.size(); i++) {
+                    const MemRegion &region = interleaved[i]->region;
+                    uint64_t offset = (addr - routeAnchor) % region.interleaveStep;
+                    uint64_t startOffset = (region.start - routeAnchor) % region.interleaveStep;
+                    offset = (offset + region.interleaveStep - startOffset) % region.interleaveStep;
+                    if (offset < region.interleaveSize) routeCandidates.push_back(interleaved[i]);
+                }
+            }
+            routeSlotIndex.push_back(routeCandidates.size());
+        }
+        routeLinear = false;
+    }
 };
 
 } //namespace memHierarchy
@@ -130,16 +130,16 @@ void MemNIC::init(unsigned int phase) {
         InitMemRtrEvent * imre = dynamic_cast<InitMemRtrEvent*>(payload);
         if (imre) {
             // Record name->address map for all other endpoints
-            networkAddressMap.insert(std::make_pair(imre->info.name, imre->info.addr));
+            setNetworkAddress(EndpointNames::intern(imre->info.name), imre->info.addr);
             
             dbg.debug(_L10_, "%s (memNIC) received imre. Name: %s, Addr: %" PRIu64 ", ID: %" PRIu32 ", start: %" PRIu64 ", end: %" PRIu64 ", size: %" PRIu64 ", step: %" PRIu64 "\n",
                     getName().c_str(), imre->info.name.c_str(), imre->info.addr, imre->info.id, imre->info.region.start, imre->info.region.end, imre->info.region.interleaveSize, imre->info.region.interleaveStep);
 
             if (sourceIDs.find(imre->info.id) != sourceIDs.end()) {
-                sourceEndpointInfo.insert(imre->info);
+                addSource(imre->info);
                 dbg.debug(_L10_, "\tAdding to sourceEndpointInfo. %zu sources found\n", sourceEndpointInfo.size());
             } else if (destIDs.find(imre->info.id) != destIDs.end()) {
-                destEndpointInfo.insert(imre->info);
+                addDest(imre->info);
                 dbg.debug(_L10_, "\tAdding to destEndpointInfo. %zu destinations found\n", destEndpointInfo.size());
             }
             delete imre;
@@ -156,7 +156,7 @@ void MemNIC::init(unsigned int phase) {
              *      src is a src/dst?
              */
             if (ev->getInitCmd() == MemEventInit::InitCommand::Region) {
-                if (ev->getDst() == getName()) {
+                if (ev->getDstId() == info.nameId) {
                     MemEventInitRegion * rEv = static_cast<MemEventInitRegion*>(ev);
                     if (rEv->getSetRegion() && acceptRegion) {
                         info.region = rEv->getRegion();
@@ -167,7 +167,7 @@ void MemNIC::init(unsigned int phase) {
                 delete mre;
             } else if (
                     (ev->getCmd() == Command::NULLCMD && (isSource(mre->event->getSrc()) || isDest(mre->event->getSrc()))) 
-                    || ev->getDst() == getName()) {
+                    || ev->getDstId() == info.nameId) {
                 dbg.debug(_L10_, "\tInserting in initQueue\n");
                 initQueue.push(mre);
             }
@@ -253,7 +253,7 @@ void MemNIC::send(MemEventBase *ev) {
     SimpleNetwork::Request *req = new SimpleNetwork::Request();
     MemRtrEvent * mre = new MemRtrEvent(ev);
     req->src = info.addr;
-    req->dest = lookupNetworkAddress(ev->getDst());
+    req->dest = lookupNetworkAddress(ev->getDstId());
     req->size_in_bits = getSizeInBits(ev);
     req->vn = 0;
     
@@ -270,13 +270,12 @@ void MemNIC::send(MemEventBase *ev) {
 /** Helper functions **/
 
 
-/* Translate destination string to network address */
-uint64_t MemNIC::lookupNetworkAddress(const std::string & dst) const {
-    std::unordered_map<std::string,uint64_t>::const_iterator it = networkAddressMap.find(dst);
-    if (it == networkAddressMap.end()) {
-        dbg.fatal(CALL_INFO, -1, "%s (MemNIC), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), dst.c_str());
+/* Translate destination ID to network address */
+uint64_t MemNIC::lookupNetworkAddress(EndpointId dst) const {
+    if (dst >= networkAddressMap.size() || networkAddressMap[dst] == NO_NETWORK_ADDR) {
+        dbg.fatal(CALL_INFO, -1, "%s (MemNIC), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), EndpointNames::name(dst).c_str());
     }
-    return it->second;
+    return networkAddressMap[dst];
 }
 
 
@@ -302,14 +301,15 @@ MemEventBase* MemNIC::recv() {
             return ev;
         } else { /* InitMemRtrEvent - someone updated their info */
             InitMemRtrEvent *imre = static_cast<InitMemRtrEvent*>(mre);
-            if (networkAddressMap.find(imre->info.name) == networkAddressMap.end()) {
+            EndpointId id = EndpointNames::intern(imre->info.name);
+            if (id >= networkAddressMap.size() || networkAddressMap[id] == NO_NETWORK_ADDR) {
                 dbg.fatal(CALL_INFO, -1, "%s (MemNIC), received information about previously unknown endpoint. This case is not handled. Endpoint name: %s\n",
                         getName().c_str(), imre->info.name.c_str());
             }
             if (sourceIDs.find(imre->info.id) != sourceIDs.end()) {
-                sourceEndpointInfo.insert(imre->info);
+                addSource(imre->info);
             } else if (destIDs.find(imre->info.id) != destIDs.end()) {
-                destEndpointInfo.insert(imre->info);
+                addDest(imre->info);
             }
             delete imre;
         }
@@ -63,6 +63,8 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS( MEMNIC_ELI_PARAMS )
 
+    SST_ELI_DOCUMENT_STATISTICS( MEMLINKBASE_ELI_STATS )
+
 /* Begin class definition */    
     /* Constructor */
     MemNIC(Component * comp, Params &params);
@@ -80,7 +82,7 @@ public:
 
     /* Helper functions */
     size_t getSizeInBits(MemEventBase * ev);
-    uint64_t lookupNetworkAddress(const std::string &dst) const;
+    uint64_t lookupNetworkAddress(EndpointId dst) const;
 
     /* Initialization and finish */
     void init(unsigned int phase);
@@ -162,7 +164,13 @@ private:
     SST::Interfaces::SimpleNetwork *link_control;
 
     // Data structures
-    std::unordered_map<std::string,uint64_t> networkAddressMap;         // Map of name -> address for each network endpoint
+    std::vector<uint64_t> networkAddressMap;    // Network address of each endpoint, indexed by name ID. NO_NETWORK_ADDR if unknown
+    static const uint64_t NO_NETWORK_ADDR = (uint64_t) -1;
+
+    void setNetworkAddress(EndpointId id, uint64_t addr) {
+        if (id >= networkAddressMap.size()) networkAddressMap.resize(id + 1, (uint64_t)NO_NETWORK_ADDR);
+        networkAddressMap[id] = addr;
+    }
 
     // Event queues
     std::queue<MemRtrEvent*> initQueue; // Queue for received init events
@@ -18,6 +18,13 @@
 
 #include <sst/core/sst_types.h>
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include <sst/core/elibase.h>   // For ElementInfoStatistic
 
 #include "util.h"
@@ -208,6 +215,98 @@ static State NextState[] __attribute__((unused)) = {
 
 static const std::string NONE = "None";
 
+
+/******************************************************************************************
+ *  Endpoint names
+ *  Events identify their source, destination and requestor by a small integer ID
+ *  rather than by component name. Names are interned once into a process-wide table
+ *  and IDs can be compared, hashed, and copied for free on the event path.
+ *  ID 0 is always NONE.
+ *
+ *  Lookups from ID to name do not lock; the name storage is allocated in fixed-size
+ *  chunks that never move once published. Interning a new name takes a lock and is
+ *  expected to happen mostly during construction and init; components that create
+ *  events should keep their own ID (or use idOf()) rather than intern their name per event.
+ *  IDs are local to a process and must not be sent across ranks - serialize names instead.
+ ******************************************************************************************/
+
+typedef uint32_t EndpointId;
+static const EndpointId NO_ENDPOINT = 0;
+
+class EndpointNames {
+public:
+    /* Return the ID for 'name', adding it to the table if it is not already there */
+    static EndpointId intern(const std::string &name) {
+        Table &t = table();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        std::unordered_map<std::string,EndpointId>::iterator it = t.ids.find(name);
+        if (it != t.ids.end()) return it->second;
+
+        EndpointId id = t.count.load(std::memory_order_relaxed);
+        size_t chunk = id >> CHUNK_BITS;
+        if (chunk >= MAX_CHUNKS) {
+            fprintf(stderr, "memHierarchy: too many endpoint names (%u), cannot add '%s'\n", id, name.c_str());
+            abort();
+        }
+        std::string * names = t.chunks[chunk].load(std::memory_order_relaxed);
+        if (names == nullptr) {
+            names = new std::string[CHUNK_SIZE];
+            t.chunks[chunk].store(names, std::memory_order_release);
+        }
+        names[id & (CHUNK_SIZE - 1)] = name;
+        t.ids.insert(std::make_pair(name, id));
+        t.count.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    /* Return the ID for 'owner->getName()'. Cached per thread by the owner's address, so repeated
+     * lookups for the same component neither hash its name nor take the table lock */
+    template<typename T>
+    static EndpointId idOf(const T * owner) {
+        static thread_local std::unordered_map<const T*,EndpointId> cache;
+        typename std::unordered_map<const T*,EndpointId>::iterator it = cache.find(owner);
+        if (it != cache.end()) return it->second;
+        EndpointId id = intern(owner->getName());
+        cache.insert(std::make_pair(owner, id));
+        return id;
+    }
+
+    /* Return the name for an ID previously returned by intern() */
+    static const std::string& name(EndpointId id) {
+        return table().chunks[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+    }
+
+    /* Number of names interned so far */
+    static size_t size() { return table().count.load(std::memory_order_acquire); }
+
+private:
+    static const unsigned CHUNK_BITS = 10;
+    static const size_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static const size_t MAX_CHUNKS = 1024;
+
+    struct Table {
+        std::mutex mutex;
+        std::unordered_map<std::string,EndpointId> ids;
+        std::atomic<std::string*> chunks[MAX_CHUNKS];
+        std::atomic<EndpointId> count;
+
+        Table() : count(1) {
+            for (size_t i = 0; i < MAX_CHUNKS; i++)
+                chunks[i].store(nullptr, std::memory_order_relaxed);
+            std::string * names = new std::string[CHUNK_SIZE];
+            names[NO_ENDPOINT] = NONE;
+            ids.insert(std::make_pair(NONE, NO_ENDPOINT));
+            chunks[0].store(names, std::memory_order_release);
+        }
+    };
+
+    /* Single table shared by every library that includes this header */
+    static Table& table() {
+        static Table t;
+        return t;
+    }
+};
+
 }}
 
 
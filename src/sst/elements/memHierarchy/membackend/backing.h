@@ -16,29 +16,113 @@
 #ifndef __SST_MEMH_BACKEND_BACKING
 #define __SST_MEMH_BACKEND_BACKING
 
+#include <algorithm>
 #include <fcntl.h>
 #include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <vector>
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/snapshot.h"
 
 namespace SST {
 namespace MemHierarchy {
 namespace Backend {
 
+/*
+ * Backing stores hold functional memory contents. The span accessors are the
+ * primitives; the vector overloads are conveniences that forward to them.
+ *
+ * Snapshots hold the store's non-zero extents: a table of extent addresses
+ * followed by the extents' data, aligned to SNAPSHOT_ALIGN in the file so a
+ * store can map them from the snapshot instead of copying.
+ */
 class Backing {
 public:
     Backing( ) { }
-    ~Backing() { }
+    virtual ~Backing() { }
 
     virtual void set( Addr addr, uint8_t value ) = 0;
-    virtual void set( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void set( Addr addr, size_t size, const uint8_t* data ) = 0;
 
     virtual uint8_t get( Addr addr) = 0;
-    virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void get( Addr addr, size_t size, uint8_t* data ) = 0;
+
+    void set( Addr addr, size_t size, const std::vector<uint8_t>& data ) {
+        set(addr, size, data.data());
+    }
+
+    void get( Addr addr, size_t size, std::vector<uint8_t>& data ) {
+        get(addr, size, data.data());
+    }
+
+    virtual void save( SnapshotWriter& out ) = 0;
+
+    /* Returns false if the snapshot is truncated */
+    bool load( const SnapshotReader& in, SnapshotCursor& cursor ) {
+        uint64_t extentSize = cursor.read<uint64_t>();
+        uint64_t count = cursor.read<uint64_t>();
+        if (count > cursor.remaining() / sizeof(Addr)) return false;
+        const uint8_t* addrs = cursor.skip(count * sizeof(Addr));
+        cursor.align(SNAPSHOT_ALIGN);
+
+        /* Restore runs of adjacent extents at once; their data is adjacent in the file too */
+        uint64_t i = 0;
+        while (i < count && cursor.good()) {
+            Addr start = extentAddr(addrs, i);
+            uint64_t run = 1;
+            while (i + run < count && extentAddr(addrs, i + run) == start + run * extentSize) run++;
+            uint64_t fileOffset = cursor.fileOffset();
+            const uint8_t* data = cursor.skip(run * extentSize);
+            if (data) restore(in.fd(), fileOffset, start, run * extentSize, data);
+            i += run;
+        }
+        return cursor.good();
+    }
+
+protected:
+    static const uint64_t SNAPSHOT_ALIGN = 4096;
+
+    static bool isZero( const uint8_t* data, size_t size ) {
+        return data[0] == 0 && memcmp(data, data + 1, size - 1) == 0;
+    }
+
+    /* extents: (address, data) of each extent to save, in address order */
+    static void saveExtents( SnapshotWriter& out, uint64_t extentSize, const std::vector<std::pair<Addr, const uint8_t*> >& extents ) {
+        out.write(extentSize);
+        out.write((uint64_t)extents.size());
+        for (size_t i = 0; i < extents.size(); i++)
+            out.write(extents[i].first);
+        out.align(SNAPSHOT_ALIGN);
+        for (size_t i = 0; i < extents.size(); i++)
+            out.write(extents[i].second, extentSize);
+    }
+
+    /* Restore 'size' bytes at 'addr' whose data is also at 'fileOffset' in the snapshot file 'fd' */
+    virtual void restore( int fd, uint64_t fileOffset, Addr addr, size_t size, const uint8_t* data ) {
+        set(addr, size, data);
+    }
+
+private:
+    static Addr extentAddr( const uint8_t* addrs, uint64_t i ) {
+        Addr addr;
+        memcpy(&addr, addrs + i * sizeof(Addr), sizeof(Addr));
+        return addr;
+    }
 };
 
 class BackingMMAP : public Backing {
 public:
-    BackingMMAP(std::string memoryFile, size_t size, size_t offset = 0) : Backing(), m_fd(-1), m_size(size), m_offset(offset) {
+    using Backing::set;
+    using Backing::get;
+
+    /*
+     * hugePages: for anonymous stores, try a MAP_HUGETLB mapping first (requires
+     * preallocated huge pages) and otherwise ask for transparent huge pages with
+     * madvise. File-backed stores only get the madvise hint.
+     */
+    BackingMMAP(std::string memoryFile, size_t size, size_t offset = 0, bool hugePages = false) :
+        Backing(), m_buffer((uint8_t*)MAP_FAILED), m_fd(-1), m_size(size), m_mapSize(size), m_offset(offset), m_hugeTLB(false) {
         int flags = MAP_PRIVATE;
         if ( ! memoryFile.empty() ) {
             m_fd = open(memoryFile.c_str(), O_RDWR);
@@ -48,15 +132,31 @@ public:
         } else {
             flags  |= MAP_ANON;
         }
-        m_buffer = (uint8_t*)mmap(NULL, size, PROT_READ|PROT_WRITE, flags, m_fd, 0);
+#ifdef MAP_HUGETLB
+        if ( hugePages && m_fd == -1 ) {
+            m_mapSize = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+            m_buffer = (uint8_t*)mmap(NULL, m_mapSize, PROT_READ|PROT_WRITE, flags | MAP_HUGETLB, m_fd, 0);
+            if ( m_buffer == MAP_FAILED )
+                m_mapSize = size;
+            else
+                m_hugeTLB = true;
+        }
+#endif
+        if ( m_buffer == MAP_FAILED )
+            m_buffer = (uint8_t*)mmap(NULL, m_mapSize, PROT_READ|PROT_WRITE, flags, m_fd, 0);
 
         if ( m_buffer == MAP_FAILED) {
             throw 2;
         }
+#ifdef MADV_HUGEPAGE
+        if ( hugePages ) {
+            madvise( m_buffer, m_mapSize, MADV_HUGEPAGE ); // Advisory only, ignore failure
+        }
+#endif
     }
 
     ~BackingMMAP() {
-        munmap( m_buffer, m_size );
+        munmap( m_buffer, m_mapSize );
         if ( -1 != m_fd ) {
             close( m_fd );
         }
@@ -66,107 +166,214 @@ public:
         m_buffer[addr - m_offset ] = value;
     }
 
-    void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++) 
-            m_buffer[addr + i] = data[i];
+    void set( Addr addr, size_t size, const uint8_t* data ) {
+        memcpy(m_buffer + (addr - m_offset), data, size);
     }
 
     uint8_t get( Addr addr ) {
         return m_buffer[addr - m_offset];
     }
 
-    void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+    void get( Addr addr, size_t size, uint8_t* data ) {
+        memcpy(data, m_buffer + (addr - m_offset), size);
+    }
+
+    /* Saves the store's non-zero pages. Reading untouched pages of an anonymous store does not allocate them.
+     * A partial last page is saved whole; the mapping always extends to a page boundary */
+    void save( SnapshotWriter& out ) {
+        std::vector<std::pair<Addr, const uint8_t*> > extents;
+        for (size_t offset = 0; offset < m_size; offset += SNAPSHOT_ALIGN) {
+            size_t bytes = std::min((size_t)SNAPSHOT_ALIGN, m_size - offset);
+            if (!isZero(m_buffer + offset, bytes))
+                extents.push_back(std::make_pair(m_offset + offset, m_buffer + offset));
+        }
+        saveExtents(out, SNAPSHOT_ALIGN, extents);
+    }
+
+protected:
+    /* Whole pages are mapped copy-on-write from the snapshot, so restoring costs page faults on first
+     * touch rather than a copy of the whole image. Anything else, or a failed mapping, is copied */
+    void restore( int fd, uint64_t fileOffset, Addr addr, size_t size, const uint8_t* data ) {
+        if (addr < m_offset || addr - m_offset >= m_size) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMMAP: Error - snapshot data at 0x%" PRIx64 " is outside this memory\n", addr);
+        }
+        size = std::min(size, m_size - (addr - m_offset));
+        uint8_t* target = m_buffer + (addr - m_offset);
+        size_t page = sysconf(_SC_PAGESIZE);
+        if (!m_hugeTLB && fd >= 0 && fileOffset % page == 0 && (addr - m_offset) % page == 0 && size % page == 0) {
+            if (mmap(target, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, fd, fileOffset) != MAP_FAILED)
+                return;
+            /* A failed MAP_FIXED may have unmapped the range */
+            if (mmap(target, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_FIXED, -1, 0) == MAP_FAILED) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "BackingMMAP: Error - unable to restore snapshot data at 0x%" PRIx64 "\n", addr);
+            }
+        }
+        memcpy(target, data, size);
     }
 
 private:
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
     uint8_t* m_buffer;
     int m_fd;
-    int m_size;
+    size_t m_size;
+    size_t m_mapSize;
     size_t m_offset;
+    bool m_hugeTLB;     // Mapped with MAP_HUGETLB, so snapshot pages cannot be mapped over it
 };
 
+/*
+ * Allocates the store lazily in units of 'size' bytes. Units are found through a
+ * radix tree (like a page table) of NODE_SLOTS-wide nodes whose height grows with
+ * the highest unit touched, so small memories need a single level. The most
+ * recently used unit is cached to skip the walk for sequential accesses.
+ */
 class BackingMalloc : public Backing {
 public:
-    BackingMalloc(size_t size) {
+    using Backing::set;
+    using Backing::get;
+
+    BackingMalloc(size_t size) : m_root(nullptr), m_height(0), m_lastUnit(0), m_lastData(nullptr) {
         m_allocUnit = size;
         /* Alloc unit needs to be pwr-2 */
         if (!isPowerOfTwo(m_allocUnit)) {
             Output out("", 1, 0, Output::STDOUT);
-            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - size must be a power of two. Got: %u\n", size);
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - size must be a power of two. Got: %zu\n", size);
         }
         m_shift = log2Of(m_allocUnit);
     }
 
+    ~BackingMalloc() {
+        freeNode(m_root, m_height);
+    }
+
     void set( Addr addr, uint8_t value ) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        m_buffer[bAddr][offset] = value;
+        Addr offset = addr & (m_allocUnit - 1);
+        lookup(addr >> m_shift)[offset] = value;
     }
 
-    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+    void set( Addr addr, size_t size, const uint8_t* data ) {
         /* Account for size exceeding alloc unit size */
         Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-        
-        allocIfNeeded(bAddr);
-
-        while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
-            offset++;
-            dataOffset++;
-
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
-        }
-    }        
+        Addr offset = addr & (m_allocUnit - 1);
 
-    void get (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-        
-        allocIfNeeded(bAddr);
-        
-        while (dataOffset != size) {
-            data[dataOffset] = m_buffer[bAddr][offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
+        while (size != 0) {
+            size_t bytes = std::min(size, (size_t)(m_allocUnit - offset));
+            memcpy(lookup(bAddr) + offset, data, bytes);
+            data += bytes;
+            size -= bytes;
+            offset = 0;
+            bAddr++;
         }
     }
 
     uint8_t get( Addr addr ) {
+        Addr offset = addr & (m_allocUnit - 1);
+        return lookup(addr >> m_shift)[offset];
+    }
+
+    void get( Addr addr, size_t size, uint8_t* data ) {
         Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        return m_buffer[bAddr][offset];
+        Addr offset = addr & (m_allocUnit - 1);
+
+        while (size != 0) {
+            size_t bytes = std::min(size, (size_t)(m_allocUnit - offset));
+            memcpy(data, lookup(bAddr) + offset, bytes);
+            data += bytes;
+            size -= bytes;
+            offset = 0;
+            bAddr++;
+        }
+    }
+
+    /* Saves every allocated unit that is not all zeros */
+    void save( SnapshotWriter& out ) {
+        std::vector<std::pair<Addr, const uint8_t*> > extents;
+        collect(m_root, m_height, 0, extents);
+        saveExtents(out, m_allocUnit, extents);
     }
 
 private:
-    void allocIfNeeded(Addr bAddr) {
-        if (m_buffer.find(bAddr) == m_buffer.end()) {
-            uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
-            if (!data) {
+    static const unsigned NODE_BITS = 9;
+    static const unsigned NODE_SLOTS = 1 << NODE_BITS;
+
+    struct Node {
+        void* slot[NODE_SLOTS];
+    };
+
+    /* Return the storage for allocation unit 'bAddr', allocating it and any missing tree levels */
+    uint8_t* lookup(Addr bAddr) {
+        if (m_lastData && bAddr == m_lastUnit)
+            return m_lastData;
+
+        while (m_height == 0 || (m_height * NODE_BITS < 64 && (bAddr >> (m_height * NODE_BITS)) != 0)) {
+            Node* root = allocNode();
+            root->slot[0] = m_root;
+            m_root = root;
+            m_height++;
+        }
+
+        Node* node = m_root;
+        for (unsigned level = m_height - 1; level > 0; level--) {
+            void* &next = node->slot[(bAddr >> (level * NODE_BITS)) & (NODE_SLOTS - 1)];
+            if (next == nullptr)
+                next = allocNode();
+            node = static_cast<Node*>(next);
+        }
+
+        void* &leaf = node->slot[bAddr & (NODE_SLOTS - 1)];
+        if (leaf == nullptr) {
+            leaf = calloc(m_allocUnit, sizeof(uint8_t));
+            if (!leaf) {
                 Output out("", 1, 0, Output::STDOUT);
                 out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
             }
-            m_buffer[bAddr] = data;
         }
+        m_lastUnit = bAddr;
+        m_lastData = static_cast<uint8_t*>(leaf);
+        return m_lastData;
+    }
+
+    Node* allocNode() {
+        Node* node = static_cast<Node*>(calloc(1, sizeof(Node)));
+        if (!node) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
+        }
+        return node;
+    }
+
+    void collect(Node* node, unsigned height, Addr prefix, std::vector<std::pair<Addr, const uint8_t*> >& extents) {
+        if (node == nullptr) return;
+        for (unsigned i = 0; i < NODE_SLOTS; i++) {
+            if (node->slot[i] == nullptr) continue;
+            Addr bAddr = (prefix << NODE_BITS) | i;
+            if (height > 1) {
+                collect(static_cast<Node*>(node->slot[i]), height - 1, bAddr, extents);
+            } else if (!isZero(static_cast<uint8_t*>(node->slot[i]), m_allocUnit)) {
+                extents.push_back(std::make_pair(bAddr << m_shift, static_cast<const uint8_t*>(node->slot[i])));
+            }
+        }
+    }
+
+    void freeNode(Node* node, unsigned height) {
+        if (node == nullptr) return;
+        for (unsigned i = 0; i < NODE_SLOTS; i++) {
+            if (height > 1)
+                freeNode(static_cast<Node*>(node->slot[i]), height - 1);
+            else
+                free(node->slot[i]);
+        }
+        free(node);
     }
 
-    std::unordered_map<Addr,uint8_t*> m_buffer;
-    unsigned int m_allocUnit;
+    Node* m_root;
+    unsigned m_height;
+    Addr m_lastUnit;
+    uint8_t* m_lastData;
+    size_t m_allocUnit;
     unsigned int m_shift;
 };
 
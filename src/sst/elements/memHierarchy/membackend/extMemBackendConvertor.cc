@@ -47,6 +47,15 @@ bool ExtMemBackendConvertor::issue( BaseReq *req ) {
     if( req->isCustCmd() ){
       // issue custom request
       CustomReq * mreq = static_cast<CustomReq*>(req);
+      if( mreq->hasFootprint() ){
+        // time as ordinary requests
+        return static_cast<ExtMemBackend*>(m_backend)->issueRequest( mreq->id(),
+                                                                     mreq->addr(),
+                                                                     mreq->isWrite(),
+                                                                     NULLVEC,
+                                                                     mreq->getInfo()->getFlags(),
+                                                                     m_backendRequestWidth );
+      }
       CustomOpCodeCmdInfo *info = static_cast<CustomOpCodeCmdInfo*>(mreq->getInfo());
       return static_cast<ExtMemBackend*>(m_backend)->issueCustomRequest( mreq->id(),
                                                                          info->getAddr(),
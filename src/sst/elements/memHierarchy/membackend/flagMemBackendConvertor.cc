@@ -45,6 +45,8 @@ bool FlagMemBackendConvertor::issue( BaseReq *breq ) {
         return static_cast<FlagMemBackend*>(m_backend)->issueRequest( req->id(), req->addr(), req->isWrite(), event->getFlags(), m_backendRequestWidth );
     } else {
         CustomReq * req = static_cast<CustomReq*>(breq);
+        if (req->hasFootprint())
+            return static_cast<FlagMemBackend*>(m_backend)->issueRequest( req->id(), req->addr(), req->isWrite(), req->getInfo()->getFlags(), m_backendRequestWidth );
         return static_cast<FlagMemBackend*>(m_backend)->issueCustomRequest(req->id(), req->getInfo());
     }
 }
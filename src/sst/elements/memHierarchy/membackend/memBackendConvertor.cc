@@ -91,7 +91,7 @@ void MemBackendConvertor::handleCustomEvent( CustomCmdInfo * info) {
     uint32_t id = genReqId();
     CustomReq* req = new CustomReq( info, id );
     m_requestQueue.push_back( req );
-    m_pendingRequests[id] = req;
+    m_pendingRequests.insert(id, req);
 }
 
 bool MemBackendConvertor::clock(Cycle_t cycle) {
@@ -120,6 +120,8 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
 
         if ( req->issueDone() ) {
             Debug(_L10_, "Completed issue of request\n");
+            if (req->isMemEv())
+                dequeueMemReq(static_cast<MemReq*>(req));
             m_requestQueue.pop_front();
         }
     }
@@ -147,11 +149,19 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
  * cycle = current cycle
  */
 void MemBackendConvertor::turnClockOn(Cycle_t cycle) {
+    syncCycle(cycle);
+    m_clockOn = true;
+}
+
+/*
+ * Bring the cycle count and per-cycle statistics up to 'cycle'
+ * without turning the clock on
+ */
+void MemBackendConvertor::syncCycle(Cycle_t cycle) {
     Cycle_t cyclesOff = cycle - m_cycleCount;
     for (Cycle_t i = 0; i < cyclesOff; i++)
         stat_outstandingReqs->addData( m_pendingRequests.size() );
     m_cycleCount = cycle;
-    m_clockOn = true;
 }
 
 /*
@@ -163,21 +173,25 @@ void MemBackendConvertor::turnClockOff() {
 
 void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
 
-    /* If clock is not on, turn it back on */
+    /* If clock is not on, turn it back on. In event-driven mode, just catch up the cycle count if nothing needs to tick */
     if (!m_clockOn) {
-        Cycle_t cycle = static_cast<MemController*>(parent)->turnClockOn();
-        turnClockOn(cycle);
+        MemController * memCtrl = static_cast<MemController*>(parent);
+        if (memCtrl->responseNeedsClock()) {
+            Cycle_t cycle = memCtrl->turnClockOn();
+            turnClockOn(cycle);
+        } else {
+            syncCycle(memCtrl->getCurrentCycle());
+        }
     }
 
     uint32_t id = BaseReq::getBaseId(reqId);
     MemEvent* resp = NULL;
 
-    if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+    BaseReq* req = m_pendingRequests.find( id );
+    if ( req == nullptr ) {
         m_dbg.fatal(CALL_INFO, -1, "memory request not found; id=%" PRId32 "\n", id);
     }
 
-    BaseReq* req = m_pendingRequests[id];
-
     req->decrement( );
 
     if ( req->isDone() ) {
@@ -204,18 +218,13 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
 
             // TODO clock responses
             // Check for flushes that are waiting on this event to finish
-            if (m_dependentRequests.find(event) != m_dependentRequests.end()) {
-                std::set<MemEvent*, memEventCmp> flushes = m_dependentRequests.find(event)->second;
-
-                for (std::set<MemEvent*, memEventCmp>::iterator it = flushes.begin(); it != flushes.end(); it++) {
-                    (m_waitingFlushes.find(*it)->second).erase(event);
-                    if ((m_waitingFlushes.find(*it)->second).empty()) {
-                        MemEvent * flush = *it;
-                        sendResponse(flush->getID(), (flush->getFlags() | MemEvent::F_SUCCESS));
-                        m_waitingFlushes.erase(flush);
-                    }
+            std::vector<WaitingFlush*> &flushes = static_cast<MemReq*>(req)->getWaitingFlushes();
+            for (std::vector<WaitingFlush*>::iterator it = flushes.begin(); it != flushes.end(); it++) {
+                if (--(*it)->pending == 0) {
+                    MemEvent * flush = (*it)->flush;
+                    sendResponse(flush->getID(), (flush->getFlags() | MemEvent::F_SUCCESS));
+                    delete *it;
                 }
-                m_dependentRequests.erase(event);
             }
             delete req;
         }
@@ -20,6 +20,9 @@
 #include <sst/core/subcomponent.h>
 #include <sst/core/event.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
 
@@ -86,18 +89,49 @@ class MemBackendConvertor : public SubComponent {
         ReqType m_type;
     };
 
+    /* Custom commands with a footprint (CustomCmdInfo::setFootprint) issue as a sequence of ordinary
+     * backend requests, reads then writes, and complete when all of them have; others issue as
+     * a single custom request */
     class CustomReq : public BaseReq {
     public:
         CustomReq(CustomCmdInfo * info, uint32_t reqId) : BaseReq(reqId, BaseReq::ReqType::CUSTOM), 
-            m_info(info) { }
+            m_info(info), m_offset(0), m_numReq(0) { }
         ~CustomReq() { }
 
         CustomCmdInfo* getInfo() { return m_info; }
         const std::string getRqstr() override { return m_info->getRqstr(); }
+
+        bool hasFootprint() { return m_info->hasFootprint(); }
+        uint64_t id()       { return ((uint64_t)m_reqId << 32) | (uint32_t)m_offset; }
+        bool isWrite()      { return m_offset >= m_info->getReadBytes(); }
+        Addr addr()         { return m_info->getFootprintAddr() + (isWrite() ? m_offset - m_info->getReadBytes() : m_offset); }
+
+        void increment( uint32_t bytes ) {
+            if (!hasFootprint()) return;
+            // Don't let a burst straddle the reads and the writes
+            uint64_t readBytes = m_info->getReadBytes();
+            m_offset = (m_offset < readBytes && m_offset + bytes > readBytes) ? readBytes : m_offset + bytes;
+            ++m_numReq;
+        }
+        void decrement( ) { if (m_numReq) --m_numReq; }
+
+        bool issueDone() {
+            return m_offset >= m_info->getReadBytes() + m_info->getWriteBytes();
+        }
+        bool isDone() {
+            return issueDone() && 0 == m_numReq;
+        }
     private:
         CustomCmdInfo * m_info;
-        uint32_t m_CustCmd;
+        uint64_t m_offset;
+        uint32_t m_numReq;
+
+    };
 
+    /* A flush waiting for 'pending' earlier requests to the same line to complete */
+    struct WaitingFlush {
+        MemEvent* flush;
+        uint32_t pending;
     };
 
     class MemReq : public BaseReq {
@@ -122,6 +156,10 @@ class MemBackendConvertor : public SubComponent {
             ++m_numReq;
         }
         void decrement( ) { --m_numReq; }
+
+        void addWaitingFlush( WaitingFlush* flush ) { m_waitingFlushes.push_back(flush); }
+        std::vector<WaitingFlush*>& getWaitingFlushes() { return m_waitingFlushes; }
+
         bool issueDone() {
             return m_offset >= m_event->getSize();
         }
@@ -140,6 +178,62 @@ class MemBackendConvertor : public SubComponent {
         MemEvent*   m_event;
         uint32_t    m_offset;
         uint32_t    m_numReq;
+        std::vector<WaitingFlush*> m_waitingFlushes;
+    };
+
+    /*
+     * Outstanding requests indexed by request id. Ids are handed out in increasing order,
+     * so the live ids always fall in [head, tail) and map directly onto a power-of-two ring.
+     * The ring doubles if the oldest outstanding request falls a full ring behind the newest.
+     */
+    class PendingRequests {
+      public:
+        PendingRequests() : m_slots(64, nullptr), m_head(1), m_tail(1), m_count(0) { }
+
+        BaseReq* find( uint32_t id ) {
+            if (id - m_head >= m_tail - m_head) return nullptr;
+            return m_slots[id & (m_slots.size() - 1)];
+        }
+
+        void insert( uint32_t id, BaseReq* req ) {
+            if (m_count == 0) m_head = m_tail = id;
+            while (id - m_head >= m_slots.size()) grow();
+            m_slots[id & (m_slots.size() - 1)] = req;
+            if (id - m_head >= m_tail - m_head) m_tail = id + 1;
+            m_count++;
+        }
+
+        void erase( uint32_t id ) {
+            m_slots[id & (m_slots.size() - 1)] = nullptr;
+            m_count--;
+            while (m_head != m_tail && m_slots[m_head & (m_slots.size() - 1)] == nullptr)
+                m_head++;
+        }
+
+        size_t size() { return m_count; }
+
+        /* Delete every outstanding request; used on teardown */
+        void clear() {
+            for (uint32_t id = m_head; id != m_tail; id++) {
+                delete m_slots[id & (m_slots.size() - 1)];
+                m_slots[id & (m_slots.size() - 1)] = nullptr;
+            }
+            m_head = m_tail;
+            m_count = 0;
+        }
+
+      private:
+        void grow() {
+            std::vector<BaseReq*> slots(m_slots.size() * 2, nullptr);
+            for (uint32_t id = m_head; id != m_tail; id++)
+                slots[id & (slots.size() - 1)] = m_slots[id & (m_slots.size() - 1)];
+            m_slots.swap(slots);
+        }
+
+        std::vector<BaseReq*> m_slots;
+        uint32_t m_head;    // Oldest outstanding id
+        uint32_t m_tail;    // One past the newest id
+        size_t m_count;
     };
 
   public:
@@ -152,6 +246,7 @@ class MemBackendConvertor : public SubComponent {
     virtual bool clock( Cycle_t cycle );
     virtual void turnClockOff();
     virtual void turnClockOn(Cycle_t cycle);
+    void syncCycle(Cycle_t cycle);
     virtual void handleMemEvent(  MemEvent* );
     virtual void handleCustomEvent( CustomCmdInfo* );
     virtual uint32_t getRequestWidth();
@@ -159,11 +254,12 @@ class MemBackendConvertor : public SubComponent {
 
     virtual const std::string getRequestor( ReqId reqId ) { 
         uint32_t id = BaseReq::getBaseId(reqId);
-        if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+        BaseReq* req = m_pendingRequests.find( id );
+        if ( req == nullptr ) {
             m_dbg.fatal(CALL_INFO, -1, "memory request not found\n");
         }
 
-        return m_pendingRequests[id]->getRqstr();
+        return req->getRqstr();
     }
 
     // generates a MemReq for the target custom command
@@ -176,10 +272,7 @@ class MemBackendConvertor : public SubComponent {
             m_requestQueue.pop_front();
         }
 
-        PendingRequests::iterator iter = m_pendingRequests.begin();
-        for ( ; iter != m_pendingRequests.end(); ++ iter ) {
-            delete iter->second;
-        }
+        m_pendingRequests.clear();
     }
 
     void doResponse( ReqId reqId, uint32_t flags = 0 );
@@ -198,37 +291,33 @@ class MemBackendConvertor : public SubComponent {
 
     bool setupMemReq( MemEvent* ev ) {
         if ( Command::FlushLine == ev->getCmd() || Command::FlushLineInv == ev->getCmd() ) {
-            // TODO optimize if this becomes a problem, it is slow
-            std::set<MemEvent*, memEventCmp> dependsOn;
-            for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end(); it++) {
-                if (!(*it)->isMemEv())
-                    continue;
-                MemReq * mr = static_cast<MemReq*>(*it);
-                if (mr->baseAddr() == ev->getBaseAddr()) {
-                    MemEvent * req = mr->getMemEvent();
-                    dependsOn.insert(req);
-                    if (m_dependentRequests.find(req) == m_dependentRequests.end()) {
-                        std::set<MemEvent*, memEventCmp> flushSet;
-                        flushSet.insert(ev);
-                        m_dependentRequests.insert(std::make_pair(req, flushSet));
-                    } else {
-                        (m_dependentRequests.find(req)->second).insert(ev);
-                    }
-                }
-            }
+            // A flush waits for requests to its line that are still queued for issue
+            std::unordered_map<Addr, std::vector<MemReq*> >::iterator it = m_queuedByAddr.find(ev->getBaseAddr());
+            if (it == m_queuedByAddr.end()) return false;
 
-            if (dependsOn.empty()) return false;
-            m_waitingFlushes.insert(std::make_pair(ev, dependsOn));
+            WaitingFlush * flush = new WaitingFlush{ev, (uint32_t)it->second.size()};
+            for (std::vector<MemReq*>::iterator reqIt = it->second.begin(); reqIt != it->second.end(); reqIt++)
+                (*reqIt)->addWaitingFlush(flush);
             return true; 
         }
 
         uint32_t id = genReqId();
         MemReq* req = new MemReq( ev, id );
         m_requestQueue.push_back( req );
-        m_pendingRequests[id] = req;
+        m_pendingRequests.insert(id, req);
+        m_queuedByAddr[req->baseAddr()].push_back(req);
         return true;
     }
 
+    /* Remove a request from the per-line index once it has been fully issued */
+    void dequeueMemReq( MemReq* req ) {
+        std::unordered_map<Addr, std::vector<MemReq*> >::iterator it = m_queuedByAddr.find(req->baseAddr());
+        std::vector<MemReq*> &reqs = it->second;
+        reqs.erase(std::find(reqs.begin(), reqs.end(), req));
+        if (reqs.empty())
+            m_queuedByAddr.erase(it);
+    }
+
     inline void doClockStat( ) {
         stat_totalCycles->addData(1);        
     }
@@ -281,14 +370,11 @@ class MemBackendConvertor : public SubComponent {
 
     uint32_t    m_reqId;
 
-    typedef std::map<uint32_t,BaseReq*>    PendingRequests;
-
     std::deque<BaseReq*>     m_requestQueue;
     PendingRequests         m_pendingRequests;
     uint32_t                m_frontendRequestWidth;
 
-    std::map<MemEvent*, std::set<MemEvent*, memEventCmp> > m_waitingFlushes; // Set of request events for each flush
-    std::map<MemEvent*, std::set<MemEvent*, memEventCmp> > m_dependentRequests; // Reverse map, set of flushes for each request ID, for faster lookup
+    std::unordered_map<Addr, std::vector<MemReq*> > m_queuedByAddr; // Requests not yet fully issued, by base address, in arrival order
 
     Statistic<uint64_t>* stat_GetSLatency;
     Statistic<uint64_t>* stat_GetSXLatency;
@@ -28,7 +28,8 @@
 using namespace SST;
 using namespace SST::MemHierarchy;
 
-pagedMultiMemory::pagedMultiMemory(Component *comp, Params &params) : DRAMSimMemory(comp, params), pagesInFast(0), lastMin(0) {
+pagedMultiMemory::pagedMultiMemory(Component *comp, Params &params) : DRAMSimMemory(comp, params), quantum(0), migrationsThisQuantum(0),
+    quantumAccesses(0), quantumFastHits(0), pagesInFast(0), lastMin(0) {
     dbg.init("@R:pagedMultiMemory::@p():@l " + comp->getName() + ": ", 0, 0, 
              (Output::output_location_t)params.find<int>("debug", 0));
     dbg.output(CALL_INFO, "making pagedMultiMemory controller\n");
@@ -63,6 +64,8 @@ pagedMultiMemory::pagedMultiMemory(Component *comp, Params &params) : DRAMSimMem
         replaceStrat = BiLRU;
     } else if (stratStr == "SCLRU") {
         replaceStrat = SCLRU;
+    } else if (stratStr == "SketchLFU") {
+        replaceStrat = SketchLFU;
     } else {
         dbg.fatal(CALL_INFO, -1, "Invalid page replacement Strategy (page_replace_strategy)\n");
     }
@@ -93,6 +96,20 @@ pagedMultiMemory::pagedMultiMemory(Component *comp, Params &params) : DRAMSimMem
       }
     }
 
+    if (replaceStrat == SketchLFU) {
+        uint32_t sketchWidth = params.find<uint32_t>("sketch_width", 65536);
+        uint32_t sketchDepth = params.find<uint32_t>("sketch_depth", 4);
+        if (!isPowerOfTwo(sketchWidth) || sketchWidth < 2 || sketchDepth == 0) {
+            dbg.fatal(CALL_INFO, -1, "Invalid param: sketch_width must be a power of 2 (>1) and sketch_depth at least 1. You specified %" PRIu32 " and %" PRIu32 "\n", 
+                    sketchWidth, sketchDepth);
+        }
+        sketch.init(sketchWidth, sketchDepth);
+        lfuBuckets.resize(256);
+        migrationBatch = params.find<unsigned int>("migration_batch", 4);
+        maxMigrationsPerQuantum = params.find<unsigned int>("max_migrations_per_quantum", 0);
+        migrationQueueSize = params.find<unsigned int>("migration_queue_size", 1024);
+    }
+
     dramBackpressure = params.find<bool>("dramBackpressure", 1);    
 
     threshold = params.find<unsigned int>("threshold", 4);    
@@ -117,6 +134,9 @@ pagedMultiMemory::pagedMultiMemory(Component *comp, Params &params) : DRAMSimMem
     tPages = registerStatistic<uint64_t>("t_pages","1");
     cantSwapOut = registerStatistic<uint64_t>("cant_swap","1");
     swapDelays = registerStatistic<uint64_t>("swap_delays","1");
+    migrationBytes = registerStatistic<uint64_t>("migration_bytes","1");
+    fastHitRate = registerStatistic<uint64_t>("fast_hit_rate","1");
+    migrationsDeferred = registerStatistic<uint64_t>("migrations_deferred","1");
 
     if (modelSwaps) {
         // use our own callbacks
@@ -362,11 +382,135 @@ void pagedMultiMemory::do_LFU( Addr addr, pageInfo &page, bool &inFast, bool &sw
     }
 }
 
+/*
+ * SketchLFU: record a touch and return the page's state if it is tracked (in fast
+ * memory or migrating). Untracked pages that are hot enough are queued for migration.
+ */
+pageInfo* pagedMultiMemory::sketchAccess( uint64_t pageAddr, bool &inFast ) {
+    uint32_t touches = sketch.touch(pageAddr);
+
+    auto it = pageMap.find(pageAddr);
+    if (it != pageMap.end()) {
+        pageInfo &page = it->second;
+        inFast = page.inFast;
+        if (page.inFast) {
+            ageFastPage(page);
+            if (page.touched + 1 < lfuBuckets.size()) {
+                pageInfo::pageList_t &from = lfuBuckets[page.touched];
+                page.touched++;
+                lfuBuckets[page.touched].splice(lfuBuckets[page.touched].end(), from, page.listEntry);
+            }
+        }
+        return &page;
+    }
+
+    inFast = 0;
+    if (maxFastPages > 0 && touches > threshold && promoteSet.size() < migrationQueueSize && promoteSet.insert(pageAddr).second) {
+        promoteQ.push_back(pageAddr);
+    }
+    return NULL;
+}
+
+/* Catch a fast page's count up with the bucket halving done each quantum */
+void pagedMultiMemory::ageFastPage( pageInfo &page ) {
+    uint64_t quanta = quantum - page.agedQuantum;
+    if (quanta != 0) {
+        page.touched = quanta >= 32 ? 0 : page.touched >> quanta;
+        page.agedQuantum = quantum;
+    }
+}
+
+void pagedMultiMemory::bucketPage( pageInfo &page ) {
+    pageInfo::pageList_t &bucket = lfuBuckets[page.touched];
+    bucket.push_back(&page);
+    page.listEntry = std::prev(bucket.end());
+}
+
+/* Least frequently used fast page with fewer than 'touches' touches that is not mid-swap; removed from its bucket */
+pageInfo* pagedMultiMemory::findLFUVictim( uint touches ) {
+    for (uint b = 0; b < touches && b < lfuBuckets.size(); b++) {
+        for (auto it = lfuBuckets[b].begin(); it != lfuBuckets[b].end(); ++it) {
+            if ((*it)->swapDir == pageInfo::NONE) {
+                pageInfo *victim = *it;
+                lfuBuckets[b].erase(it);
+                return victim;
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * SketchLFU: start up to migration_batch queued promotions, subject to DRAM
+ * backpressure and the per-quantum migration budget
+ */
+void pagedMultiMemory::sketchMigrate() {
+    uint started = 0;
+    while (!promoteQ.empty() && started < migrationBatch) {
+        if (dramBackpressure && dramQ.size() >= 4) break;
+        if (maxMigrationsPerQuantum != 0 && migrationsThisQuantum >= maxMigrationsPerQuantum) break;
+
+        uint64_t pageAddr = promoteQ.front();
+        promoteQ.pop_front();
+        promoteSet.erase(pageAddr);
+
+        // May have cooled off or started moving since it was queued
+        uint touches = sketch.estimate(pageAddr);
+        if (touches <= threshold || pageMap.find(pageAddr) != pageMap.end()) continue;
+
+        if (pagesInFast >= maxFastPages) {
+            pageInfo *victim = findLFUVictim(touches);
+            if (!victim) {
+                cantSwapOut->addData(1);
+                continue;
+            }
+            victim->inFast = 0;
+            victim->listEntry = pageInfo::pageList_t::iterator();
+            pagesInFast--;
+            moveToSlow(victim);
+            fastSwaps->addData(1);
+        }
+
+        pageInfo &page = pageMap[pageAddr];
+        page.pageAddr = pageAddr;
+        page.inFast = 1;
+        page.touched = touches;
+        page.agedQuantum = quantum;
+        bucketPage(page);
+        pagesInFast++;
+        moveToFast(page);
+
+        migrationsThisQuantum++;
+        started++;
+    }
+}
+
 bool pagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned numBytes ){
     uint64_t pageAddr = addr >> pageShift;
     bool inFast = 0;
     bool swapping = 0;
     SimTime_t extraDelay = 0;
+
+    if (replaceStrat == SketchLFU) {
+        pageInfo *tracked = sketchAccess(pageAddr, inFast);
+        Req* req = new Req(id,addr,isWrite,numBytes );
+
+        fastAccesses->addData(1);
+        quantumAccesses++;
+        if (tracked && pageIsSwapping(*tracked)) {
+            // put in queue to be issued when swap completes
+            swapDelays->addData(1);
+            waitingReqs[pageAddr].push_back(req);
+        } else if (inFast) {
+            fastHits->addData(1);
+            quantumFastHits++;
+            self_link->send(1, new MemCtrlEvent(req));
+        } else {
+            queueRequest(req);
+        }
+        return true;
+    }
+
     auto &page = pageMap[pageAddr];
 
     page.record(addr, isWrite, getRequestor(id), collectStats, pageAddr, replaceStrat == LFU8);
@@ -388,6 +532,7 @@ bool pagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
 
     if (modelSwaps) {
         fastAccesses->addData(1);
+        quantumAccesses++;
         if (pageIsSwapping(page)) {
             // put in queue to be issued when swap completes
             swapDelays->addData(1);
@@ -395,6 +540,7 @@ bool pagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
         } else {
             if (inFast) {
                 fastHits->addData(1);
+                quantumFastHits++;
                 // issue to fast
                 self_link->send(1, new MemCtrlEvent(req));
             } else {
@@ -417,8 +563,10 @@ bool pagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
         }
         
         fastAccesses->addData(1);
+        quantumAccesses++;
         if (inFast) {
             fastHits->addData(1);
+            quantumFastHits++;
             if (extraDelay > 0) {
                 self_link->send(extraDelay, 
                                 Simulation::getSimulation()->getTimeLord()->getNano(), 
@@ -446,6 +594,8 @@ bool pagedMultiMemory::clock(Cycle_t cycle){
             break;
         }
     }
+
+    if (replaceStrat == SketchLFU) sketchMigrate();
     return false;
 }
 
@@ -516,6 +666,24 @@ void pagedMultiMemory::handleSelfEvent(SST::Event *event){
 
 bool pagedMultiMemory::quantaClock(SST::Cycle_t _cycle) {
     if (collectStats) printAccStats();
+
+    if (quantumAccesses != 0) {
+        fastHitRate->addData(quantumFastHits * 100 / quantumAccesses);
+    }
+    quantumAccesses = 0;
+    quantumFastHits = 0;
+
+    if (replaceStrat == SketchLFU) {
+        // Halve all counts: the sketch directly, fast pages by merging buckets (each page catches up lazily)
+        sketch.age();
+        for (size_t b = 1; b < lfuBuckets.size(); b++) {
+            lfuBuckets[b / 2].splice(lfuBuckets[b / 2].end(), lfuBuckets[b]);
+        }
+        quantum++;
+        migrationsDeferred->addData(promoteQ.size());
+        migrationsThisQuantum = 0;
+        return false;
+    }
     
     lastMin = 0;
 
@@ -535,6 +703,7 @@ void pagedMultiMemory::moveToFast(pageInfo &page) {
     // mark page as swapping
     page.swapDir = pageInfo::StoF;
     page.swapsOut = numTransfers;   
+    migrationBytes->addData(numTransfers * 64);
 
     dbg.debug(_L10_, "moveToFast(%p addr:%p) sO:%d\n", &page, (void*)(addr), 
               page.swapsOut);
@@ -561,6 +730,7 @@ void pagedMultiMemory::moveToSlow(pageInfo *page) {
     // mark page as swapping
     page->swapDir = pageInfo::FtoS;
     page->swapsOut = numTransfers;
+    migrationBytes->addData(numTransfers * 64);
 
     // issue reads to fast mem
     for (int i = 0; i < numTransfers; ++i) {
@@ -641,7 +811,13 @@ void pagedMultiMemory::swapDone(pageInfo *page, const uint64_t addr) {
     waitingReqs.erase(pageAddr);
 
     // mark page as ready
+    bool evicted = page->swapDir == pageInfo::FtoS && !page->inFast;
     page->swapDir = pageInfo::NONE;
+
+    // SketchLFU only tracks pages in fast memory or on the move
+    if (replaceStrat == SketchLFU && evicted) {
+        pageMap.erase(pageAddr);
+    }
 }
 
 
@@ -18,6 +18,7 @@
 #define _H_SST_MEMH_PAGEDMULTI_BACKEND
 
 #include <queue>
+#include <unordered_set>
 #include "membackend/dramSimBackend.h"
 #include "sst/core/rng/sstrng.h"
 
@@ -52,6 +53,7 @@ struct pageInfo {
     typedef enum {NONE, FtoS, StoF} swapDir_t;
     swapDir_t swapDir;
     int swapsOut;
+    uint64_t agedQuantum; // quantum 'touched' was last aged to (used in SketchLFU)
 
     // stats
     typedef enum {LT_NEG_ONE, NEG_ONE, ZERO, ONE, GT_ONE, LAST_CASE} AcCases;
@@ -138,13 +140,63 @@ struct pageInfo {
     }
 
     pageInfo() : pageAddr(0), touched(0), inFast(0), lastTouch(0), lastRef(0), scanLeng(0),
-                 pageDelay(0), swapDir(NONE), swapsOut(0) {
+                 pageDelay(0), swapDir(NONE), swapsOut(0), agedQuantum(0) {
         for (int i = 0; i < LAST_CASE; ++i) {
             accPat[i] = 0;
         }
     }
 };
 
+/*
+ * Count-min sketch of page touches. Estimates never undercount; conservative
+ * update (only raising the counters that hold the minimum) keeps the
+ * overcount from hash collisions small. Counters saturate at 255 and are
+ * halved each quantum, so the estimate tracks recent touches per quantum.
+ */
+struct hotnessSketch {
+    hotnessSketch() : width(0), shift(0) { }
+
+    void init(uint32_t w, uint32_t depth) {
+        width = w;
+        shift = 64 - log2Of(w);
+        counters.assign(depth, std::vector<uint8_t>(w, 0));
+    }
+
+    uint32_t touch(uint64_t key) {
+        uint32_t est = estimate(key);
+        if (est == 255) return est;
+        for (size_t i = 0; i < counters.size(); i++) {
+            uint8_t &c = counters[i][index(key, i)];
+            if (c == est) c++;
+        }
+        return est + 1;
+    }
+
+    uint32_t estimate(uint64_t key) {
+        uint32_t est = 255;
+        for (size_t i = 0; i < counters.size(); i++)
+            est = std::min(est, (uint32_t)counters[i][index(key, i)]);
+        return est;
+    }
+
+    void age() {
+        for (size_t i = 0; i < counters.size(); i++)
+            for (uint32_t j = 0; j < width; j++)
+                counters[i][j] >>= 1;
+    }
+
+private:
+    /* Multiply-shift hashing with a distinct odd multiplier per row */
+    uint32_t index(uint64_t key, size_t row) {
+        uint64_t mult = 0x9E3779B97F4A7C15ULL + 0x632BE59BD9B4E019ULL * (2 * row);
+        return ((key + 1) * (mult | 1)) >> shift;
+    }
+
+    uint32_t width;
+    uint32_t shift;
+    std::vector<std::vector<uint8_t> > counters;
+};
+
 class pagedMultiMemory : public DRAMSimMemory {
 public:
 /* Element Library Info */
@@ -160,12 +212,17 @@ public:
             {"scan_threshold",      "scan Threshold (for SC strategies)", "4"},
             {"seed",                "RNG Seed", "1447"},
             {"page_add_strategy",   "Page Addition Strategy", "T"},
-            {"page_replace_strategy",      "Page Replacement Strategy", "FIFO"},
+            {"page_replace_strategy",      "Page Replacement Strategy: FIFO, LRU, BiLRU, SCLRU, LFU, LFU8, or SketchLFU. SketchLFU tracks hotness in a count-min sketch, keeps per-page state only for pages in fast memory or migrating, and migrates in rate-limited batches. It ignores page_add_strategy and collect_stats.", "FIFO"},
             {"access_time",         "Constant time memory access for \"fast\" memory", "35ns"},
             {"max_fast_pages",      "Number of \"fast\" (constant time) pages", "256"},
             {"page_shift",          "Size of page (2^x bytes)", "12"},
             {"quantum",             "time period for when page access counts is shifted", "5ms"},
-            {"accStatsPrefix",      "File name for acces pattern statistics",""} )
+            {"accStatsPrefix",      "File name for acces pattern statistics",""},
+            {"sketch_width",        "SketchLFU: counters per sketch row. Must be a power of 2.", "65536"},
+            {"sketch_depth",        "SketchLFU: number of sketch rows (hash functions)", "4"},
+            {"migration_batch",     "SketchLFU: maximum page migrations started per memory cycle", "4"},
+            {"max_migrations_per_quantum", "SketchLFU: maximum page migrations started per quantum. 0 is unlimited.", "0"},
+            {"migration_queue_size", "SketchLFU: maximum hot pages waiting to be migrated; further candidates are dropped until they are touched again", "1024"} )
 
     SST_ELI_DOCUMENT_STATISTICS(
             {"fast_hits", "Number of accesses that 'hit' a fast page", "count", 1},
@@ -173,7 +230,10 @@ public:
             {"fast_acc", "Number of total accesses to the memory backend", "count", 1},
             {"t_pages", "Number of total pages", "count", 1},
             {"cant_swap", "Number of times a page could not be swapped in because no victim page could be found because all candidates were swapping", "count", 1},
-            {"swap_delays", "Number of an access is delayed because the page is swapping", "count", 1} )
+            {"swap_delays", "Number of an access is delayed because the page is swapping", "count", 1},
+            {"migration_bytes", "Bytes moved between 'fast' and 'slow' memory by page swaps", "bytes", 1},
+            {"fast_hit_rate", "Percentage of accesses that hit a fast page, sampled each quantum", "percent", 1},
+            {"migrations_deferred", "Hot pages still queued for migration at the end of each quantum", "count", 1} )
 
 /* Begin class definition */
     pagedMultiMemory(Component *comp, Params &params);
@@ -222,6 +282,7 @@ private:
                   LRU, // LRU replacement
                   BiLRU, // bimodal LRU
                   SCLRU, // scan aware
+                  SketchLFU, // count-min sketch hotness, bucketed LFU replacement, batched migration
                   LAST_STRAT} pageReplaceStrat_t;
     pageReplaceStrat_t replaceStrat; 
 
@@ -230,6 +291,25 @@ private:
     bool checkAdd(pageInfo &page);
     void do_FIFO_LRU( pageInfo &page, bool &inFast, bool &swapping);
     void do_LFU( Addr, pageInfo &page, bool &inFast, bool &swapping);
+
+    // SketchLFU state
+    hotnessSketch sketch;
+    std::vector<pageInfo::pageList_t> lfuBuckets; // fast pages by (aged) touch count
+    uint64_t quantum;                       // quanta elapsed, for lazy aging of fast pages
+    std::deque<uint64_t> promoteQ;          // hot slow pages waiting to migrate, in order found
+    std::unordered_set<uint64_t> promoteSet; // members of promoteQ
+    uint migrationBatch;
+    uint maxMigrationsPerQuantum;
+    uint migrationsThisQuantum;
+    uint migrationQueueSize;
+    uint64_t quantumAccesses;
+    uint64_t quantumFastHits;
+
+    pageInfo* sketchAccess( uint64_t pageAddr, bool &inFast );
+    void sketchMigrate();
+    void ageFastPage( pageInfo &page );
+    void bucketPage( pageInfo &page );
+    pageInfo* findLFUVictim( uint touches );
     
     void printAccStats();
     queue<Req *> dramQ;
@@ -302,6 +382,9 @@ public:
     Statistic<uint64_t> *tPages;
     Statistic<uint64_t> *cantSwapOut;
     Statistic<uint64_t> *swapDelays;
+    Statistic<uint64_t> *migrationBytes;
+    Statistic<uint64_t> *fastHitRate;
+    Statistic<uint64_t> *migrationsDeferred;
 };
 
 }
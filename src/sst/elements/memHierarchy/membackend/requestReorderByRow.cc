@@ -65,9 +65,8 @@ RequestReorderRow::RequestReorderRow(Component *comp, Params &params) : SimpleMe
     bankMask = banks - 1;
     rowOffset = log2Of(rowSize.getRoundedValue());
     lineOffset = log2Of(requestSize.getRoundedValue());
+    requestQueue.resize(banks);
     for (unsigned int i = 0; i < banks; i++) {
-        std::list<Req >* bankList = new std::list<Req>;
-        requestQueue.push_back(bankList);
         lastRow.push_back(-1);  // No last request to this bank
         reorderCount.push_back(maxReqsPerRow);  // No requests reordered to this row
     }
@@ -80,7 +79,7 @@ bool RequestReorderRow::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
 #endif
     int bank = (addr >> lineOffset) & bankMask;
     
-    requestQueue[bank]->push_back(Req(id,addr,isWrite,numBytes));
+    requestQueue[bank].push(addr >> rowOffset, Req(id,addr,isWrite,numBytes));
     return true;
 }
 
@@ -97,44 +96,35 @@ bool RequestReorderRow::clock(Cycle_t cycle) {
         // For current bank
         unsigned int bank = nextBank;
         for (unsigned int i = 0; i < banks; i++) {
-            if (requestQueue[bank]->empty()) {
+            RowBucketQueue<Req> &bankQueue = requestQueue[bank];
+            if (bankQueue.empty()) {
                 bank = (bank + 1) % banks;
                 continue;
             }
 
             // Decide whether to try to re-order a request to this bank or issue a new row
             bool reorderIssued = false;
-            if (reorderCount[bank] != maxReqsPerRow) {
-                std::list<Req>* bankList = requestQueue[bank];
-                for (std::list<Req>::iterator it = bankList->begin(); it != bankList->end(); it++) {
-                    unsigned int row = (*it).addr >> rowOffset;
-                    
-                    if (row == lastRow[bank]) {
-                        // Attempt issue, if we're blocked, this bank is busy & move to next bank
-                        bool issued = backend->issueRequest((*it).id,(*it).addr,(*it).isWrite,(*it).numBytes);
-                        reorderIssued = true;
-                        if (issued) {
-                            reqsIssuedThisCycle++;
-                            nextBank = (bank + 1) % banks;
-                            reorderCount[bank]++;
-                            bankList->erase(it);
-                            break; 
-                        } else {
-                            break;
-                        }
-                    }
+            if (reorderCount[bank] != maxReqsPerRow && bankQueue.hasRow(lastRow[bank])) {
+                // Attempt issue of the oldest request to the open row, if we're blocked, this bank is busy & move to next bank
+                Req& req = bankQueue.oldestInRow(lastRow[bank]);
+                reorderIssued = true;
+                if (backend->issueRequest(req.id, req.addr, req.isWrite, req.numBytes)) {
+                    reqsIssuedThisCycle++;
+                    nextBank = (bank + 1) % banks;
+                    reorderCount[bank]++;
+                    bankQueue.popRow(lastRow[bank]);
                 }
             }
             
             if (!reorderIssued) {
                 // Try to issue oldest request
-				Req& req = *requestQueue[bank]->begin();
+                Req& req = bankQueue.oldest();
                 if (backend->issueRequest( req.id, req.addr, req.isWrite, req.numBytes ) ) {
                     reqsIssuedThisCycle++;
                     nextBank = (bank + 1) % banks;
                     reorderCount[bank] = 1;
-                    lastRow[bank] = req.addr >> rowOffset;
-                    requestQueue[bank]->erase(requestQueue[bank]->begin());
+                    lastRow[bank] = bankQueue.oldestRow();
+                    bankQueue.popOldest();
                 }
             }
 
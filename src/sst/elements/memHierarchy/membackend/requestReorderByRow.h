@@ -18,7 +18,7 @@
 #define _H_SST_MEMH_REQUEST_REORDER_ROW_BACKEND
 
 #include "membackend/memBackend.h"
-#include <list>
+#include "membackend/rowBucketQueue.h"
 #include <vector>
 
 namespace SST {
@@ -70,9 +70,9 @@ private:
     unsigned int rowOffset;     // Offset for determining request row
     unsigned int lineOffset;    // Offset for determining line (needed for finding bank)
     int reqsPerCycle;           // Number of requests to issue per cycle (max) -> memCtrl limits how many we accept
-    std::vector< std::list<Req>* > requestQueue;
+    std::vector< RowBucketQueue<Req> > requestQueue;   // Per bank, indexed by row
     std::vector<unsigned int> reorderCount;
-    std::vector<unsigned int> lastRow;
+    std::vector<RowBucketQueue<Req>::Row> lastRow;
 
 };
 
@@ -0,0 +1,93 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MEMH_ROW_BUCKET_QUEUE
+#define _H_SST_MEMH_ROW_BUCKET_QUEUE
+
+#include <deque>
+#include <unordered_map>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Request queue for one bank, indexed both by age and by row, for FR-FCFS style schedulers.
+ *
+ * Entries live in an age-ordered ring addressed by a sequence number; each row has a bucket
+ * of sequence numbers in arrival order. Since requests arrive in age order, the oldest entry
+ * is always the head of the ring and the oldest request to a row is always the head of that
+ * row's bucket, so finding and removing either is O(1) amortized regardless of queue depth.
+ * Removing from the middle of the ring only clears the slot; the head skips cleared slots.
+ */
+template<typename T>
+class RowBucketQueue {
+public:
+    typedef uint64_t Row;
+
+    RowBucketQueue() : m_headSeq(0), m_count(0) { }
+
+    bool empty() { return m_count == 0; }
+    size_t size() { return m_count; }
+
+    void push( Row row, const T& item ) {
+        m_buckets[row].push_back(m_headSeq + m_entries.size());
+        m_entries.push_back(Entry(row, item));
+        m_count++;
+    }
+
+    /* Oldest request overall */
+    T& oldest() { return m_entries.front().item; }
+    Row oldestRow() { return m_entries.front().row; }
+
+    void popOldest() {
+        popRow(m_entries.front().row);
+    }
+
+    /* Oldest request to 'row' */
+    bool hasRow( Row row ) { return m_buckets.find(row) != m_buckets.end(); }
+    T& oldestInRow( Row row ) { return m_entries[m_buckets.find(row)->second.front() - m_headSeq].item; }
+
+    void popRow( Row row ) {
+        typename std::unordered_map<Row, std::deque<uint64_t> >::iterator bucket = m_buckets.find(row);
+        m_entries[bucket->second.front() - m_headSeq].live = false;
+        bucket->second.pop_front();
+        if (bucket->second.empty())
+            m_buckets.erase(bucket);
+        m_count--;
+
+        while (!m_entries.empty() && !m_entries.front().live) {
+            m_entries.pop_front();
+            m_headSeq++;
+        }
+    }
+
+private:
+    struct Entry {
+        Entry( Row row, const T& item ) : row(row), item(item), live(true) { }
+        Row row;
+        T item;
+        bool live;
+    };
+
+    std::deque<Entry> m_entries;    // Age order; m_entries[i] has sequence number m_headSeq + i
+    std::unordered_map<Row, std::deque<uint64_t> > m_buckets;
+    uint64_t m_headSeq;
+    size_t m_count;
+};
+
+}
+}
+
+#endif
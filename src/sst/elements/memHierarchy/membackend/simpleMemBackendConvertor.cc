@@ -36,6 +36,8 @@ bool SimpleMemBackendConvertor::issue( BaseReq* req ) {
         return static_cast<SimpleMemBackend*>(m_backend)->issueRequest( mreq->id(), mreq->addr(), mreq->isWrite(), m_backendRequestWidth );
     } else {
         CustomReq * creq = static_cast<CustomReq*>(req);
+        if (creq->hasFootprint())
+            return static_cast<SimpleMemBackend*>(m_backend)->issueRequest( creq->id(), creq->addr(), creq->isWrite(), m_backendRequestWidth );
         return static_cast<SimpleMemBackend*>(m_backend)->issueCustomRequest( creq->id(), creq->getInfo() );
     }
 }
@@ -14,6 +14,9 @@
 #include <sst/core/timeLord.h>
 #include "membackend/timingDRAMBackend.h"
 
+/* Polls a channel thread makes for its next cycle before it goes to sleep */
+#define TIMINGDRAM_WORKER_SPIN 1000
+
 using namespace SST;
 using namespace SST::MemHierarchy;
 
@@ -22,7 +25,8 @@ bool TimingDRAM::Channel::m_printConfig = true;
 bool TimingDRAM::Rank::m_printConfig = true;
 bool TimingDRAM::Bank::m_printConfig = true;
 
-TimingDRAM::TimingDRAM(Component *comp, Params &params) : SimpleMemBackend(comp, params), m_cycle(0) {
+TimingDRAM::TimingDRAM(Component *comp, Params &params) : SimpleMemBackend(comp, params), m_cycle(0),
+    m_workersDone(0), m_stopWorkers(false) {
 
     int id = params.find<int>("id", -1);
     assert( id != -1 );
@@ -47,8 +51,13 @@ TimingDRAM::TimingDRAM(Component *comp, Params &params) : SimpleMemBackend(comp,
 
     int numChannels = params.find<int>("channels", 1);
 
+    m_numThreads = params.find<unsigned>("channel_threads", 1);
+    if ( m_numThreads == 0 ) m_numThreads = 1;
+    if ( m_numThreads > (unsigned) numChannels ) m_numThreads = numChannels;
+
     if ( m_printConfig ) {
         output->verbose(CALL_INFO, 1, DBG_MASK, "number of channels: %d\n",numChannels);
+        output->verbose(CALL_INFO, 1, DBG_MASK, "channel threads:    %u\n",m_numThreads);
         output->verbose(CALL_INFO, 1, DBG_MASK, "address mapper:     %s\n",addrMapper.c_str());
         m_printConfig = false;
     }
@@ -59,6 +68,23 @@ TimingDRAM::TimingDRAM(Component *comp, Params &params) : SimpleMemBackend(comp,
     for ( unsigned i=0; i < numChannels; i++ ) {
         m_channels.push_back( Channel( comp, this, tmpParams, id, i, output, m_mapper ) );
     }
+
+    for ( unsigned i = 1; i < m_numThreads; i++ ) {
+        m_workers.emplace_back();
+        m_workers.back().thread = std::thread( &TimingDRAM::workerLoop, this, i, &m_workers.back() );
+    }
+}
+
+TimingDRAM::~TimingDRAM()
+{
+    m_stopWorkers.store( true );
+    for ( unsigned i = 0; i < m_workers.size(); i++ ) {
+        {
+            std::lock_guard<std::mutex> guard( m_workers[i].lock );
+            m_workers[i].wake.notify_one();
+        }
+        m_workers[i].thread.join();
+    }
 }
 
 bool TimingDRAM::issueRequest( ReqId id, Addr addr, bool isWrite, unsigned numBytes )
@@ -78,19 +104,84 @@ bool TimingDRAM::issueRequest( ReqId id, Addr addr, bool isWrite, unsigned numBy
 bool TimingDRAM::clock(Cycle_t cycle)
 {
     output->verbose(CALL_INFO, 5, DBG_MASK, "cycle %llu\n",m_cycle);
+
+    // Channels only interact through responses, so advance them (in parallel if configured),
+    // then send responses in channel order exactly as a serial pass would
+    if ( m_numThreads > 1 ) {
+        m_workersDone.store( 0, std::memory_order_relaxed );
+        unsigned started = 0;
+        for ( unsigned i = 1; i < m_numThreads; i++ ) {
+            if ( ! threadHasWork( i ) ) continue;
+            Worker &worker = m_workers[i - 1];
+            // Pairs with the worker setting 'sleeping' before it rechecks 'tick', so either
+            // the worker sees this cycle or we see that it needs waking
+            worker.tick.fetch_add( 1 );
+            if ( worker.sleeping.load() ) {
+                std::lock_guard<std::mutex> guard( worker.lock );
+                worker.wake.notify_one();
+            }
+            started++;
+        }
+        clockChannels( 0 );
+        for ( unsigned spin = 0; m_workersDone.load( std::memory_order_acquire ) != started; spin++ ) {
+            if ( spin > TIMINGDRAM_WORKER_SPIN ) std::this_thread::yield();
+        }
+    } else {
+        clockChannels( 0 );
+    }
+
     for ( unsigned i = 0; i < m_channels.size(); i++ ) {
-        m_channels[i].clock(m_cycle);
+        m_channels[i].sendResponse();
     }
     ++m_cycle;
     return false;
 }
 
+/* Advance this thread's share of channels by one cycle. Idle channels are skipped, clocking them is a no-op */
+void TimingDRAM::clockChannels( unsigned thread )
+{
+    for ( unsigned i = thread; i < m_channels.size(); i += m_numThreads ) {
+        if ( m_channels[i].hasWork() ) m_channels[i].clock(m_cycle);
+    }
+}
+
+bool TimingDRAM::threadHasWork( unsigned thread )
+{
+    for ( unsigned i = thread; i < m_channels.size(); i += m_numThreads ) {
+        if ( m_channels[i].hasWork() ) return true;
+    }
+    return false;
+}
+
+void TimingDRAM::workerLoop( unsigned thread, Worker* worker )
+{
+    uint64_t gen = 0;
+    while ( true ) {
+        unsigned spin = 0;
+        while ( worker->tick.load( std::memory_order_acquire ) == gen ) {
+            if ( m_stopWorkers.load( std::memory_order_acquire ) ) return;
+            if ( ++spin > TIMINGDRAM_WORKER_SPIN ) {
+                std::unique_lock<std::mutex> guard( worker->lock );
+                worker->sleeping.store( true );
+                while ( worker->tick.load() == gen && ! m_stopWorkers.load() ) {
+                    worker->wake.wait( guard );
+                }
+                worker->sleeping.store( false );
+                spin = 0;
+            }
+        }
+        gen++;
+        clockChannels( thread );
+        m_workersDone.fetch_add( 1, std::memory_order_release );
+    }
+}
+
 //==================================================================================
 // Channel 
 //==================================================================================
 
 TimingDRAM::Channel::Channel( Component* comp, TimingDRAM* mem, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    m_mem(mem), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0)
+    m_mem(mem), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0), m_issueSeq(0)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Channel:@p():@l:mc=" << mc << ":chan=" << myNum << ": "; 
@@ -119,26 +210,38 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
 {
     m_output->verbosePrefix(prefix(),CALL_INFO, 5, DBG_MASK, "cycle %llu\n",cycle);
 
-    std::list<Cmd*>::iterator iter = m_issuedCmds.begin();
+    // Retire in completion order, then issue order among commands finishing together
+    while ( ! m_issuedCmds.empty() && m_issuedCmds.top().cmd->isDone(cycle) ) {
+        Cmd* cmd = m_issuedCmds.top().cmd;
 
-    while ( iter != m_issuedCmds.end() ) {
-        if ( (*iter)->isDone(cycle) ) {
-            Cmd* cmd = (*iter);
+        m_output->verbosePrefix(prefix(),CALL_INFO, 2, DBG_MASK, "cycle=%llu retire %s for rank=%d bank=%d row=%d\n",
+                cycle, cmd->getName().c_str(), cmd->getRank(), cmd->getBank(), cmd->getRow());
 
-            m_output->verbosePrefix(prefix(),CALL_INFO, 2, DBG_MASK, "cycle=%llu retire %s for rank=%d bank=%d row=%d\n",
+        if (cmd->getTrans() != nullptr) {
+            m_retiredTrans.push(cmd->getTrans());
+        }
+
+        delete cmd;
+        m_issuedCmds.pop();
+    }
+
+    Cmd* cmd = popCmd( cycle, m_dataBusAvailCycle );
+    if ( cmd ) {
+        m_output->verbosePrefix(prefix(),CALL_INFO, 2, DBG_MASK, "cycle=%llu issue %s for rank=%d bank=%d row=%d\n",
                     cycle, cmd->getName().c_str(), cmd->getRank(), cmd->getBank(), cmd->getRow());
 
-            if (cmd->getTrans() != nullptr) {
-                m_retiredTrans.push(cmd->getTrans());
-            }
+        m_dataBusAvailCycle = cmd->issue();  
 
-            delete (*iter);
-            iter = m_issuedCmds.erase(iter); 
-        } else {
-            ++iter;
-        }
+        m_issuedCmds.push(IssuedCmd(cmd, m_issueSeq++));
     }
- 
+}
+
+/*
+ * Send at most one retired transaction's response per cycle. Split from clock()
+ * because it calls back into the memory controller and must run on the simulation thread.
+ */
+void TimingDRAM::Channel::sendResponse()
+{
     if ( ! m_retiredTrans.empty() ) {
         m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK, "send response: reqId=%llu bank=%d addr=%#llx, createTime=%" PRIu64 "\n", m_retiredTrans.front()->id, m_retiredTrans.front()->bank, m_retiredTrans.front()->addr, m_retiredTrans.front()->createTime);
 
@@ -148,16 +251,6 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
         m_retiredTrans.pop();
         m_pendingCount--;
     }
-
-    Cmd* cmd = popCmd( cycle, m_dataBusAvailCycle );
-    if ( cmd ) {
-        m_output->verbosePrefix(prefix(),CALL_INFO, 2, DBG_MASK, "cycle=%llu issue %s for rank=%d bank=%d row=%d\n",
-                    cycle, cmd->getName().c_str(), cmd->getRank(), cmd->getBank(), cmd->getRow());
-
-        m_dataBusAvailCycle = cmd->issue();  
-
-        m_issuedCmds.push_back(cmd);
-    }
 }
 
 TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle )
@@ -295,7 +388,7 @@ void TimingDRAM::Bank::update( SimTime_t current )
         return;
     }
 
-    Transaction* trans = m_transQ->pop(m_row);
+    Transaction* trans = m_transQ->pop(m_row, current);
 
     if ( ! trans ) {
         return;
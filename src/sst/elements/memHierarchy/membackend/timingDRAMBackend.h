@@ -13,7 +13,12 @@
 #ifndef _H_SST_MEMH_TIMING_DRAM_BACKEND
 #define _H_SST_MEMH_TIMING_DRAM_BACKEND
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <queue>
+#include <thread>
 
 #include "membackend/simpleMemBackend.h"
 #include "membackend/timingAddrMapper.h"
@@ -38,6 +43,7 @@ public:
             {"dbg_mask", "Mask on dbg_level", "-1"},
             {"addrMapper", "Address map subcomponent", "memHierarchy.simpleAddrMapper"},
             {"channels", "Number of channels", "1"},
+            {"channel_threads", "Number of host threads that advance channels each cycle. 1 advances them serially on the simulation thread. Results do not depend on this, but channel debug output may interleave.", "1"},
             {"channel.numRanks", "Number of ranks per channel", "1"},
             {"channel.transaction_Q_size", "Size of transaction queue", "32"},
             {"channel.rank.numBanks", "Number of banks per rank", "8"},
@@ -94,6 +100,9 @@ private:
         unsigned getRank() { return m_rank; }
         unsigned getBank() { return m_bank; }
 
+        /* No open row and no queued commands, so a cycle with no new transactions changes nothing */
+        bool isIdle() { return m_row == (unsigned) -1 && m_cmdQ.empty(); }
+
       private:
         void update( SimTime_t );
         const char* prefix() { return m_pre.c_str(); }
@@ -189,6 +198,8 @@ private:
             return ret;
         }
 
+        SimTime_t getFiniTime() { return m_finiTime; }
+
         bool isDone( SimTime_t now ) { 
 
             m_bank->verbose(__LINE__,__FUNCTION__,"%lu %lu\n",now,m_finiTime);
@@ -226,6 +237,13 @@ private:
         
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
 
+        bool isIdle() {
+            for ( unsigned i = 0; i < m_banks.size(); i++ ) {
+                if ( ! m_banks[i].isIdle() ) return false;
+            }
+            return true;
+        }
+
         void pushTrans( Transaction* trans ) {
             unsigned bank = m_mapper->getBank( trans->addr);
             
@@ -273,6 +291,16 @@ private:
         }
 
         void clock(SimTime_t );
+        void sendResponse();
+
+        /* Whether clocking this channel can do anything: transactions outstanding, commands in flight, or rows to close */
+        bool hasWork() {
+            if ( m_pendingCount != 0 || ! m_issuedCmds.empty() ) return true;
+            for ( unsigned i = 0; i < m_ranks.size(); i++ ) {
+                if ( ! m_ranks[i].isIdle() ) return true;
+            }
+            return false;
+        }
 
       private:
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
@@ -289,7 +317,19 @@ private:
         unsigned            m_maxPendingTrans;
         unsigned            m_pendingCount;
 
-        std::list<Cmd*>     m_issuedCmds;
+        /* Issued commands, earliest finish first */
+        struct IssuedCmd {
+            IssuedCmd( Cmd* cmd, uint64_t seq ) : cmd(cmd), finiTime(cmd->getFiniTime()), seq(seq) { }
+            bool operator>( const IssuedCmd& rhs ) const {
+                return finiTime != rhs.finiTime ? finiTime > rhs.finiTime : seq > rhs.seq;
+            }
+            Cmd* cmd;
+            SimTime_t finiTime;
+            uint64_t seq;
+        };
+
+        std::priority_queue<IssuedCmd, std::vector<IssuedCmd>, std::greater<IssuedCmd> > m_issuedCmds;
+        uint64_t            m_issueSeq;
         std::queue<Transaction*> m_retiredTrans;
     };
 
@@ -305,13 +345,35 @@ public:
     }
     virtual bool clock(Cycle_t cycle);
     virtual void finish() {}
+    ~TimingDRAM();
 
 private:
+    struct Worker;
+    void workerLoop( unsigned thread, Worker* worker );
+    void clockChannels( unsigned thread );
+    bool threadHasWork( unsigned thread );
 
     std::vector<Channel> m_channels;
     AddrMapper* m_mapper;
     SimTime_t   m_cycle;
 
+    /* Channel worker pool; thread 0 is the simulation thread.
+     * A worker spins briefly waiting for its next cycle and then sleeps on its condition variable.
+     * Only workers that have a channel with work are started on a cycle */
+    struct Worker {
+        Worker() : tick(0), sleeping(false) { }
+        std::thread                 thread;
+        std::atomic<uint64_t>       tick;       // Bumped to start this worker on a cycle
+        std::atomic<bool>           sleeping;
+        std::mutex                  lock;
+        std::condition_variable     wake;
+    };
+
+    unsigned                    m_numThreads;
+    std::deque<Worker>          m_workers;      // m_workers[i] runs thread i + 1
+    std::atomic<unsigned>       m_workersDone;  // Workers finished with the current cycle
+    std::atomic<bool>           m_stopWorkers;
+
 };
 
 }
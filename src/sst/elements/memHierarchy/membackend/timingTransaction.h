@@ -15,6 +15,8 @@
 
 #include <sst/core/subcomponent.h>
 
+#include "membackend/rowBucketQueue.h"
+
 namespace SST {
 namespace MemHierarchy {
 namespace TimingDRAM_NS {
@@ -62,6 +64,11 @@ class TransactionQ : public SST::SubComponent {
         return trans;
     }
 
+    /* Called by the bank each cycle; queues that track age override this */
+    virtual Transaction* pop( unsigned row, SimTime_t cycle ) {
+        return pop( row );
+    }
+
   protected:
     std::list<Transaction*> m_transQ;
 };
@@ -126,6 +133,55 @@ class ReorderTransactionQ : public TransactionQ {
     unsigned  windowCycles;
 };
 
+class FRFCFSTransactionQ : public TransactionQ {
+
+  public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(FRFCFSTransactionQ, "memHierarchy", "frfcfsTransactionQ", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "first-ready FCFS transaction queue: row hits first, oldest first otherwise", "SST::MemHierarchy::TransactionQ")
+
+    SST_ELI_DOCUMENT_PARAMS( {"starvation_cycles", "Serve the oldest transaction once it has waited this many cycles, even if younger ones hit the open row. 0 disables.", "1000" } )
+
+/* Begin class definition */
+    FRFCFSTransactionQ( Component* owner, Params& params ) : TransactionQ( owner, params ) {
+        m_starvationCycles = params.find<SimTime_t>("starvation_cycles", 1000);
+    }
+
+    virtual void push( Transaction* trans ) {
+        m_queue.push( trans->row, trans );
+    }
+
+    virtual Transaction* pop( unsigned row ) {
+        return select( row, false );
+    }
+
+    virtual Transaction* pop( unsigned row, SimTime_t cycle ) {
+        bool starved = !m_queue.empty() && m_starvationCycles != 0 && 
+            cycle >= m_queue.oldest()->createTime + m_starvationCycles;
+        return select( row, starved );
+    }
+
+  private:
+    Transaction* select( unsigned row, bool starved ) {
+        if ( m_queue.empty() ) {
+            return NULL;
+        }
+
+        Transaction* trans;
+        if ( ! starved && m_queue.hasRow( row ) ) {
+            trans = m_queue.oldestInRow( row );
+            m_queue.popRow( row );
+        } else {
+            trans = m_queue.oldest();
+            m_queue.popOldest();
+        }
+        return trans;
+    }
+
+    RowBucketQueue<Transaction*> m_queue;
+    SimTime_t m_starvationCycles;
+};
+
 }
 }
 }
@@ -161,6 +161,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     // Set up backing store if needed
     std::string backingType = params.find<std::string>("backing", "mmap", found); /* Default to using an mmap backing store, fall back on malloc */
     backing_ = nullptr;
+    timingOnly_ = params.find<bool>("timing_only", false);
     if (!found) {
         bool oldBackVal = params.find<bool>("do_not_back", false, found);
         if (found) {
@@ -174,6 +175,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
+
+    if (timingOnly_) backingType = "none";
         
     std::string size = params.find<std::string>("backing_size_unit", "1MiB");
     UnitAlgebra size_ua(size);
@@ -195,8 +198,9 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if ( 0 == memoryFile.compare( NO_STRING_DEFINED ) ) {
             memoryFile.clear();
         }
+        bool hugePages = params.find<bool>("backing_huge_pages", false);
         try { 
-            backing_ = new Backend::BackingMMAP( memoryFile, memBackendConvertor_->getMemSize() );
+            backing_ = new Backend::BackingMMAP( memoryFile, memBackendConvertor_->getMemSize(), 0, hugePages );
         }
         catch ( int e) {
             if (e == 1) 
@@ -211,10 +215,38 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         backing_ = new Backend::BackingMalloc(sizeBytes);
     }
 
+    /* Snapshots of the backing store */
+    snapshotSave_ = params.find<std::string>("snapshot_save", "");
+    snapshotLoad_ = params.find<std::string>("snapshot_load", "");
+    std::string snapshotTime = params.find<std::string>("snapshot_save_time", "");
+    snapshotLink_ = nullptr;
+    snapshotSaved_ = false;
+    if ((!snapshotSave_.empty() || !snapshotLoad_.empty()) && !backing_) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: snapshot_save/snapshot_load. Snapshots require a backing store but 'backing' is 'none' or 'timing_only' is set.\n", getName().c_str());
+    }
+    if (!snapshotTime.empty()) {
+        if (!UnitAlgebra(snapshotTime).hasUnits("s"))
+            out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: snapshot_save_time. Must have units of time (s). SI ok. You specified: %s\n", getName().c_str(), snapshotTime.c_str());
+        if (snapshotSave_.empty())
+            out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: snapshot_save_time. snapshot_save must also be set to the file to write the snapshot to.\n", getName().c_str());
+        snapshotLink_ = configureSelfLink("Snapshot", snapshotTime, new Event::Handler<MemController>(this, &MemController::handleSnapshotEvent));
+    }
+
     /* Clock Handler */
     clockHandler_ = new Clock::Handler<MemController>(this, &MemController::clock);
-    clockTimeBase_ = registerClock(memBackendConvertor_->getClockFreq(), clockHandler_);
-    clockOn_ = true;
+    eventDriven_ = params.find<bool>("event_driven", false);
+    if (eventDriven_) {
+        /* Ticks are self-events aligned to clock edges, scheduled only while there is work */
+        clockTimeBase_ = getTimeConverter(memBackendConvertor_->getClockFreq());
+        tickTimeBase_ = getTimeConverter("1ps");
+        tickLink_ = configureSelfLink("EventDrivenTick", "1ps", new Event::Handler<MemController>(this, &MemController::handleTick));
+        tickCycle_ = 0;
+        memBackendConvertor_->turnClockOff();
+        clockOn_ = false;
+    } else {
+        clockTimeBase_ = registerClock(memBackendConvertor_->getClockFreq(), clockHandler_);
+        clockOn_ = true;
+    }
 
     registerTimeBase("1 ns", true);
 
@@ -225,6 +257,9 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
             customCommandHandler_ = dynamic_cast<CustomCmdMemHandler*>(loadSubComponent(customHandlerName, this, params));
         }
     }
+    if (customCommandHandler_)
+        customCommandHandler_->setBacking(backing_, memSize_, [this](Addr addr) { return translateToLocal(addr); },
+                [this](Addr addr) { return isRequestAddressValid(addr); });
 }
 
 void MemController::handleEvent(SST::Event* event) {
@@ -247,6 +282,7 @@ void MemController::handleEvent(SST::Event* event) {
     }
 
     MemEvent * ev = static_cast<MemEvent*>(meb);
+    if (timingOnly_) ev->setDataless();
 
     if (ev->isAddrGlobal()) {
         ev->setBaseAddr(translateToLocal(ev->getBaseAddr()));
@@ -271,7 +307,8 @@ void MemController::handleEvent(SST::Event* event) {
             {
                 MemEvent* put = NULL;
                 if ( ev->getPayloadSize() != 0 ) {
-                    put = new MemEvent(this, ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload() );
+                    put = new MemEvent(this, ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM);
+                    put->copyPayload(ev);
                     put->setFlag(MemEvent::F_NORESPONSE);
                     outstandingEvents_.insert(std::make_pair(put->getID(), put));
                     notifyListeners(ev);
@@ -312,12 +349,36 @@ bool MemController::clock(Cycle_t cycle) {
 }
 
 Cycle_t MemController::turnClockOn() {
+    if (eventDriven_) {
+        /* Schedule a tick on the next clock edge, the cycle reregisterClock() would have returned */
+        Cycle_t cycle = getCurrentCycle() + 1;
+        scheduleTick(cycle);
+        tickCycle_ = cycle - 1;
+        clockOn_ = true;
+        return tickCycle_;
+    }
     Cycle_t cycle = reregisterClock(clockTimeBase_, clockHandler_);
     cycle--;
     clockOn_ = true;
     return cycle;
 }
 
+/* Event-driven mode: run one clock cycle and schedule the next tick unless clock() says we can stop */
+void MemController::handleTick(SST::Event* event) {
+    tickCycle_++;
+    if (!clock(tickCycle_))
+        scheduleTick(tickCycle_ + 1);
+}
+
+/* Event-driven mode: send a tick that arrives exactly on the edge of 'cycle'.
+ * The delay is computed from the edge's absolute time rather than accumulated, and the tick link's
+ * own 1ps latency is taken off, so ticks stay on the same edges a registered clock would fire on */
+void MemController::scheduleTick(Cycle_t cycle) {
+    SimTime_t now = Simulation::getSimulation()->getCurrentSimCycle();
+    SimTime_t delay = tickTimeBase_->convertFromCoreTime(clockTimeBase_->convertToCoreTime(cycle) - now);
+    tickLink_->send(delay - 1, NULL);
+}
+
 void MemController::handleCustomEvent(MemEventBase * ev) {
     if (!customCommandHandler_) 
         dbg.fatal(CALL_INFO, -1, "%s, Error: Received custom event but no handler loaded. Ev = %s. Time = %" PRIu64 "ns\n",
@@ -362,7 +423,7 @@ void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
     bool noncacheable  = ev->queryFlag(MemEvent::F_NONCACHEABLE);
     
     /* Write data. Here instead of receive to try to match backing access order to backend execute order */
-    if (backing_ && (ev->getCmd() == Command::PutM || (ev->getCmd() == Command::GetX && noncacheable)))
+    if (backing_ && !ev->isDataless() && (ev->getCmd() == Command::PutM || (ev->getCmd() == Command::GetX && noncacheable)))
         writeData(ev);
 
     if (ev->queryFlag(MemEvent::F_NORESPONSE)) {
@@ -409,16 +470,49 @@ void MemController::setup(void) {
     memBackendConvertor_->setup();
     link_->setup();
 
+    /* Overwrites anything written during init */
+    if (!snapshotLoad_.empty()) {
+        SnapshotReader snapshot;
+        SnapshotCursor cursor;
+        if (!snapshot.open(snapshotLoad_))
+            dbg.fatal(CALL_INFO, -1, "%s, Error - unable to load snapshot '%s': %s\n", getName().c_str(), snapshotLoad_.c_str(), snapshot.error().c_str());
+        if (!snapshot.find(SnapshotSection::Backing, getName(), cursor))
+            dbg.fatal(CALL_INFO, -1, "%s, Error - snapshot '%s' has no memory contents\n", getName().c_str(), snapshotLoad_.c_str());
+        if (!backing_->load(snapshot, cursor))
+            dbg.fatal(CALL_INFO, -1, "%s, Error - snapshot '%s' is truncated or corrupt\n", getName().c_str(), snapshotLoad_.c_str());
+    }
+    if (snapshotLink_) snapshotLink_->send(1, NULL);
+}
+
+
+void MemController::handleSnapshotEvent(SST::Event* event) {
+    saveSnapshot();
+}
+
+
+void MemController::saveSnapshot() {
+    SnapshotWriter snapshot;
+    if (!snapshot.open(snapshotSave_))
+        dbg.fatal(CALL_INFO, -1, "%s, Error - unable to open snapshot file '%s' for writing\n", getName().c_str(), snapshotSave_.c_str());
+    snapshot.beginSection(SnapshotSection::Backing, getName());
+    backing_->save(snapshot);
+    snapshot.endSection();
+    if (!snapshot.close())
+        dbg.fatal(CALL_INFO, -1, "%s, Error - failed writing snapshot file '%s'\n", getName().c_str(), snapshotSave_.c_str());
+    snapshotSaved_ = true;
 }
 
 
 void MemController::finish(void) {
-    if (!clockOn_) {
+    if (!clockOn_ && eventDriven_) {
+        memBackendConvertor_->syncCycle(getCurrentCycle());
+    } else if (!clockOn_) {
         Cycle_t cycle = turnClockOn();
         memBackendConvertor_->turnClockOn(cycle);
     }
     memBackendConvertor_->finish();
     link_->finish();
+    if (!snapshotSave_.empty() && !snapshotSaved_) saveSnapshot();
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -429,7 +523,7 @@ void MemController::writeData(MemEvent* event) {
     if (event->getCmd() == Command::PutM) { /* Write request to memory */
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
             
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->getSharedPayload().get());
         
         return;
     }
@@ -437,7 +531,7 @@ void MemController::writeData(MemEvent* event) {
     if (noncacheable && event->getCmd() == Command::GetX) {
         if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
         
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->getSharedPayload().get());
         
         return;
     }
@@ -449,14 +543,20 @@ void MemController::readData(MemEvent* event) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
     Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
 
-    vector<uint8_t> payload;
-    payload.resize(event->getSize(), 0);
+    /* Dataless responses carry the size of the data read but not the data */
+    if (event->isDataless()) {
+        event->setZeroPayload(event->getSize());
+        return;
+    }
 
     if (!backing_) return;
 
+    vector<uint8_t> payload;
+    payload.resize(event->getSize(), 0);
+
     backing_->get(localAddr, event->getSize(), payload);
     
-    event->setPayload(payload);
+    event->setPayload(std::move(payload));
 }
 
 
@@ -41,6 +41,7 @@ public:
 
 #define MEMCONTROLLER_ELI_PARAMS {"backend.mem_size",    "(string) Size of physical memory. NEW REQUIREMENT: must include units in 'B' (SI ok). Simple fix: add 'MiB' to old value.", NULL},\
             {"clock",               "(string) Clock frequency of controller", NULL},\
+            {"event_driven",        "(bool) Replace the controller clock with self-events scheduled only while requests are queued for issue. Idle controllers cost nothing and backend responses do not wake the controller. Intended for unclocked backends (e.g., simpleMem) on a direct link.", "false"},\
             {"backendConvertor",    "(string) Backend convertor to load", "memHierarchy.simpleMembackendConvertor"},\
             {"backend",             "(string) Backend memory model to use for timing.  Defaults to simpleMem", "memHierarchy.simpleMem"},\
             {"max_requests_per_cycle",  "(int) Maximum number of requests to accept per cycle. 0 or negative is unlimited. Default is 1 for simpleMem backend, unlimited otherwise.", "1"},\
@@ -51,8 +52,13 @@ public:
             {"listenercount",       "(uint) Counts the number of listeners attached to this controller, these are modules for tracing or components like prefetchers", "0"},\
             {"listener%(listenercount)d", "(string) Loads a listener module into the controller", ""},\
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "malloc"},\
+            {"timing_only",         "(bool) Model timing only: no backing store and events are made dataless on arrival. Responses carry their payload size but no payload bytes. Overrides 'backing'.", "false"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing_huge_pages",  "(bool) For 'mmap' backing stores, back the store with huge pages (MAP_HUGETLB if available, otherwise transparent huge pages via madvise)", "false"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"snapshot_save",       "(string) Write the backing store's non-zero contents to this file. Use a separate file for each component.", ""},\
+            {"snapshot_save_time",  "(string) Simulated time at which to write the snapshot, e.g., '1ms'. If not set, the snapshot is written at the end of simulation.", ""},\
+            {"snapshot_load",       "(string) Restore the backing store from a snapshot file at setup, after memory initialization. 'mmap' stores map whole pages of the snapshot copy-on-write instead of copying them.", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
@@ -97,6 +103,10 @@ public:
     virtual void handleMemResponse( SST::Event::id_type id, uint32_t flags );
     
     SST::Cycle_t turnClockOn();
+
+    /* Event-driven mode: the current controller cycle, and whether a backend response needs the controller to tick */
+    SST::Cycle_t getCurrentCycle() { return getCurrentSimTime(clockTimeBase_); }
+    virtual bool responseNeedsClock() { return !eventDriven_ || clockLink_; }
     
     /* For updating memory values. CustomMemoryCommand should call this */
     void writeData( MemEvent* );
@@ -121,12 +131,18 @@ protected:
     virtual void processInitEvent( MemEventInit* );
 
     virtual bool clock( SST::Cycle_t );
+    void handleTick( SST::Event* );
+    void scheduleTick( SST::Cycle_t cycle );
+
+    void saveSnapshot();
+    void handleSnapshotEvent( SST::Event* );
 
     Output dbg;
     std::set<Addr> DEBUG_ADDR;
 
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_; 
+    bool                    timingOnly_;    // Make events dataless on arrival, never back memory
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy 
     bool clockLink_;            // Flag - should we call clock() on this link or not
@@ -148,9 +164,19 @@ protected:
     
     Clock::Handler<MemController>* clockHandler_;
     TimeConverter* clockTimeBase_;
+
+    bool eventDriven_;          // Tick with self-events instead of a registered clock
+    Link* tickLink_;            // Event-driven mode: self link carrying ticks, in picoseconds
+    TimeConverter* tickTimeBase_;
+    Cycle_t tickCycle_;         // Event-driven mode: cycle of the last tick
     
     CustomCmdMemHandler * customCommandHandler_;
 
+    std::string snapshotSave_;  // Snapshot file to write, empty if none
+    std::string snapshotLoad_;  // Snapshot file to restore at setup, empty if none
+    Link* snapshotLink_;        // Self link that fires at snapshot_save_time
+    bool snapshotSaved_;
+
 private:
     
     std::map<SST::Event::id_type, MemEventBase*> outstandingEvents_; // For sending responses. Expect backend to respond to ALL requests so that we know the execution order
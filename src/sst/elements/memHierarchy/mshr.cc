@@ -61,6 +61,114 @@ MSHR::MSHR(Output* debug, int maxSize, string cacheName, std::set<Addr> debugAdd
     d2_->init("", 10, 0, (Output::output_location_t)1);
 
     DEBUG_ADDR = debugAddr;
+
+    // Size the table so that it is at most half full when every MSHR is in use
+    unsigned int initialEntries = (maxSize_ > MSHR_MAX_INITIAL_ENTRIES) ? MSHR_MAX_INITIAL_ENTRIES : maxSize_;
+    unsigned int log2Slots = 4;
+    while ((1u << log2Slots) < 2 * initialEntries) log2Slots++;
+    mshrSlot empty = {0, -1};
+    slots_.assign(1u << log2Slots, empty);
+    slotShift_ = 64 - log2Slots;
+    numEntries_ = 0;
+    
+    entryPool_.resize(initialEntries);
+    freeEntries_.reserve(initialEntries);
+    for (int i = initialEntries - 1; i >= 0; i--) {
+        entryPool_[i].acksNeeded = 0;
+        freeEntries_.push_back(i);
+    }
+}
+
+
+/* Table management */
+mshrEntry* MSHR::findEntry(Addr baseAddr) {
+    uint64_t mask = slots_.size() - 1;
+    for (uint64_t i = slotIndex(baseAddr); ; i = (i + 1) & mask) {
+        if (slots_[i].entry < 0) return nullptr;
+        if (slots_[i].addr == baseAddr) return &entryPool_[slots_[i].entry];
+    }
+}
+
+mshrEntry* MSHR::findOrCreateEntry(Addr baseAddr) {
+    uint64_t mask = slots_.size() - 1;
+    uint64_t i = slotIndex(baseAddr);
+    for ( ; slots_[i].entry >= 0; i = (i + 1) & mask) {
+        if (slots_[i].addr == baseAddr) return &entryPool_[slots_[i].entry];
+    }
+    
+    if (freeEntries_.empty()) {
+        entryPool_.resize(entryPool_.size() + 1);
+        freeEntries_.push_back(entryPool_.size() - 1);
+    }
+    int index = freeEntries_.back();
+    freeEntries_.pop_back();
+    
+    mshrEntry * entry = &entryPool_[index];
+    entry->acksNeeded = 0;
+    entry->mshrQueue.clear();
+    entry->dataBuffer.clear();
+
+    slots_[i].addr = baseAddr;
+    slots_[i].entry = index;
+    numEntries_++;
+    
+    if (2 * numEntries_ > slots_.size()) growTable();
+    return entry;
+}
+
+/* Remove an address from the table using backward-shift deletion so no tombstones are needed */
+void MSHR::eraseEntry(Addr baseAddr) {
+    uint64_t mask = slots_.size() - 1;
+    uint64_t i = slotIndex(baseAddr);
+    while (slots_[i].addr != baseAddr || slots_[i].entry < 0) {
+        if (slots_[i].entry < 0) return;
+        i = (i + 1) & mask;
+    }
+    
+    // Recycle the entry, keeping its storage
+    int index = slots_[i].entry;
+    entryPool_[index].mshrQueue.clear();
+    entryPool_[index].dataBuffer.clear();
+    freeEntries_.push_back(index);
+    numEntries_--;
+
+    uint64_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (slots_[j].entry < 0) break;
+        uint64_t home = slotIndex(slots_[j].addr);
+        // Move slot j into the hole at i if its home position is not in (i, j]
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            slots_[i] = slots_[j];
+            i = j;
+        }
+    }
+    slots_[i].entry = -1;
+}
+
+void MSHR::eraseIfEmpty(Addr baseAddr, mshrEntry* entry) {
+    if ((entry->acksNeeded == 0) && entry->dataBuffer.empty() && entry->mshrQueue.empty()) {
+        if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR erasing 0x%" PRIx64 "\n", baseAddr);
+        
+        eraseEntry(baseAddr);
+    }
+}
+
+void MSHR::growTable() {
+    vector<mshrSlot> oldSlots;
+    oldSlots.swap(slots_);
+    
+    mshrSlot empty = {0, -1};
+    slots_.assign(oldSlots.size() * 2, empty);
+    slotShift_--;
+    
+    uint64_t mask = slots_.size() - 1;
+    for (vector<mshrSlot>::iterator it = oldSlots.begin(); it != oldSlots.end(); it++) {
+        if (it->entry < 0) continue;
+        uint64_t i = slotIndex(it->addr);
+        while (slots_[i].entry >= 0) i = (i + 1) & mask;
+        slots_[i] = *it;
+    }
 }
 
 
@@ -79,115 +187,111 @@ bool MSHR::isFull() {
 }
 
 int MSHR::getAcksNeeded(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) return 0;
-    return (it->second).acksNeeded;
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) return 0;
+    return entry->acksNeeded;
 }
 
 
 void MSHR::setAcksNeeded(Addr baseAddr, int acksNeeded, MemEvent * event) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) {
         if (is_debug_addr(baseAddr)) d_->debug(_L6_, "\tCreating new MSHR holder for acks\n");
         
-        mshrEntry entry;
-        entry.acksNeeded = acksNeeded;
-        entry.dataBuffer.clear();
+        entry = findOrCreateEntry(baseAddr);
+        entry->acksNeeded = acksNeeded;
         if (event != nullptr)
-            entry.mshrQueue.push_back(mshrType(event));
-        map_[baseAddr] = entry;
+            entry->mshrQueue.push_back(mshrType(event));
         return;
     }
-    (it->second).acksNeeded = acksNeeded;
+    entry->acksNeeded = acksNeeded;
 }
 
 void MSHR::incrementAcksNeeded(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
-        mshrEntry entry;
-        entry.acksNeeded = 1;
-        map_[baseAddr] = entry;
-    } else {
-        (it->second).acksNeeded++;
-    }
+    findOrCreateEntry(baseAddr)->acksNeeded++;
 }
 
 void MSHR::decrementAcksNeeded(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) return;
-    (it->second).acksNeeded--;
-    if (((it->second).acksNeeded == 0) && (it->second).dataBuffer.empty() && (it->second).mshrQueue.empty()) {
-        if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR erasing 0x%" PRIx64 "\n", baseAddr);
-        
-        map_.erase(it);
-    }
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) return;
+    entry->acksNeeded--;
+    eraseIfEmpty(baseAddr, entry);
 }
 
-void MSHR::setDataBuffer(Addr baseAddr, vector<uint8_t>& data) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: No pending request for response event. Addr = 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
-    (it->second).dataBuffer = data;
+void MSHR::setDataBuffer(Addr baseAddr, const SharedPayload& data) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: No pending request for response event. Addr = 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
+    entry->dataBuffer = data;
 }
 
-vector<uint8_t> * MSHR::getDataBuffer(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) return NULL;
-    return &((it->second).dataBuffer);
+/* Dataless (timing-only) events have no bytes to buffer, so share a zero line of the modeled size so that
+ * events later built from the buffer still carry the right payload size. Only a change in size allocates */
+void MSHR::setDataBuffer(Addr baseAddr, MemEvent* event) {
+    if (!event->isDataless()) {
+        setDataBuffer(baseAddr, event->getSharedPayload());
+        return;
+    }
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: No pending request for response event. Addr = 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
+    if (zeroLine_.size() != event->getPayloadSize()) zeroLine_.assign(event->getPayloadSize(), 0);
+    entry->dataBuffer = zeroLine_;
+}
+
+const SharedPayload * MSHR::getDataBuffer(Addr baseAddr) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) return NULL;
+    return &(entry->dataBuffer);
 }
 
 void MSHR::clearDataBuffer(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it != map_.end()) (it->second).dataBuffer.clear();
-    if (((it->second).acksNeeded == 0) && (it->second).dataBuffer.empty() && (it->second).mshrQueue.empty()) {
-        if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR erasing 0x%" PRIx64 "\n", baseAddr);
-        
-        map_.erase(it);
-    }
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) return;
+    entry->dataBuffer.clear();
+    eraseIfEmpty(baseAddr, entry);
 }
 
 bool MSHR::isDataBufferValid(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it != map_.end()) (it->second).dataBuffer.clear();
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry != nullptr) entry->dataBuffer.clear();
     return false;
 }
 
 bool MSHR::exists(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) return false;
-    vector<mshrType> * queue = &((it->second).mshrQueue);
-    vector<mshrType>::iterator frontEntry = queue->begin();
-    if (frontEntry == queue->end()) return false;
-    return (frontEntry->elem.isEvent());
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr || entry->mshrQueue.empty()) return false;
+    return (entry->mshrQueue.front().elem.isEvent());
 }
 
-bool MSHR::isHit(Addr baseAddr) { return (map_.find(baseAddr) != map_.end()) && (map_.find(baseAddr)->second.mshrQueue.size() > 0); }
+bool MSHR::isHit(Addr baseAddr) { 
+    mshrEntry * entry = findEntry(baseAddr);
+    return (entry != nullptr) && (entry->mshrQueue.size() > 0); 
+}
 
 bool MSHR::pendingWriteback(Addr baseAddr) {
     mshrType entry = mshrType(baseAddr);
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) return false;
+    mshrEntry * mshrEnt = findEntry(baseAddr);
+    if (mshrEnt == nullptr) return false;
 
-    vector<mshrType>& res = (it->second).mshrQueue;
+    vector<mshrType>& res = mshrEnt->mshrQueue;
     vector<mshrType>::iterator itv = std::find_if(res.begin(), res.end(), MSHREntryCompare(&entry));
     return (itv != res.end());
 }
 
 const vector<mshrType> MSHR::lookup(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) {
         d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: mshr did not find entry with address 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
     }
-    vector<mshrType> res = (it->second).mshrQueue;
-    return res;
+    return entry->mshrQueue;
 }
 
 
 MemEvent* MSHR::lookupFront(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) {
         d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: mshr did not find entry with address 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
     }
-    vector<mshrType> queue = (it->second).mshrQueue;
+    vector<mshrType>& queue = entry->mshrQueue;
     if (queue.front().elem.isAddr()) {
         d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: front entry in mshr is not of type MemEvent. Addr = 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
     }
@@ -214,7 +318,7 @@ bool MSHR::insert(Addr baseAddr, MemEvent* event) {
     
     if (is_debug_addr(baseAddr)) {
         d_->debug(_L9_, "\tMSHR: Event Inserted. Key addr = %" PRIx64 ", event Addr = %" PRIx64 ", Cmd = %s, MSHR Size = %u, Entry Size = %zu\n", 
-                baseAddr, event->getAddr(), CommandString[(int)event->getCmd()], size_, map_[baseAddr].mshrQueue.size());
+                baseAddr, event->getAddr(), CommandString[(int)event->getCmd()], size_, findEntry(baseAddr)->mshrQueue.size());
     }
 
     return true;
@@ -238,16 +342,8 @@ bool MSHR::insertWriteback(Addr keyAddr) {
     
     mshrType mshrElement = mshrType(keyAddr);
 
-    mshrTable::iterator it = map_.find(keyAddr);
-    if (it == map_.end()) {
-        mshrEntry newEntry;
-        newEntry.acksNeeded = 0;
-        newEntry.dataBuffer.clear();
-        map_[keyAddr] = newEntry;
-    }
-
-    vector<mshrType>::iterator itv = map_[keyAddr].mshrQueue.begin();
-    map_[keyAddr].mshrQueue.insert(itv, mshrElement);
+    vector<mshrType>& queue = findOrCreateEntry(keyAddr)->mshrQueue;
+    queue.insert(queue.begin(), mshrElement);
     //printTable();
     
     return true;
@@ -259,7 +355,7 @@ bool MSHR::insertInv(Addr baseAddr, MemEvent* event, bool inProgress) {
     if (LIKELY(ret)) {
         if (is_debug_addr(baseAddr)) {
             d_->debug(_L9_, "\tMSHR: Event Inserted. Key addr = %" PRIx64 ", event Addr = %" PRIx64 ", Cmd = %s, MSHR Size = %u, Entry Size = %zu\n", 
-                    baseAddr, event->getAddr(), CommandString[(int)event->getCmd()], size_, map_[baseAddr].mshrQueue.size());
+                    baseAddr, event->getAddr(), CommandString[(int)event->getCmd()], size_, findEntry(baseAddr)->mshrQueue.size());
         }
     } else if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR Full.  Event could not be inserted.\n");
     
@@ -268,16 +364,9 @@ bool MSHR::insertInv(Addr baseAddr, MemEvent* event, bool inProgress) {
 
 bool MSHR::insertAll(Addr baseAddr, vector<mshrType>& events) {
     if (events.empty()) return false;
-    mshrTable::iterator it = map_.find(baseAddr);
     
-    if (it != map_.end()) (it->second).mshrQueue.insert((it->second).mshrQueue.end(), events.begin(), events.end());
-    else {
-        mshrEntry entry;
-        entry.mshrQueue = events;
-        entry.acksNeeded = 0;
-        entry.dataBuffer.clear();
-        map_[baseAddr] = entry;
-    }
+    vector<mshrType>& queue = findOrCreateEntry(baseAddr)->mshrQueue;
+    queue.insert(queue.end(), events.begin(), events.end());
     
     int trueSize = 0;
     int prefetches = 0;
@@ -298,14 +387,7 @@ bool MSHR::insertAll(Addr baseAddr, vector<mshrType>& events) {
 
 /* Private insertion methods called by public inserts */
 bool MSHR::insert(Addr baseAddr, mshrType entry) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
-        mshrEntry entry;
-        entry.acksNeeded = 0;
-        entry.dataBuffer.clear();
-        map_[baseAddr] = entry;
-    }
-    map_[baseAddr].mshrQueue.push_back(entry);
+    findOrCreateEntry(baseAddr)->mshrQueue.push_back(entry);
     //printTable();
     
     return true;
@@ -314,9 +396,10 @@ bool MSHR::insert(Addr baseAddr, mshrType entry) {
 bool MSHR::insertInv(Addr baseAddr, mshrType entry, bool inProgress) {
     if (size_ >= maxSize_) return false;
     
-    vector<mshrType>::iterator it = map_[baseAddr].mshrQueue.begin();
-    if (inProgress && map_[baseAddr].mshrQueue.size() > 0) it++;
-    map_[baseAddr].mshrQueue.insert(it, entry);
+    vector<mshrType>& queue = findOrCreateEntry(baseAddr)->mshrQueue;
+    vector<mshrType>::iterator it = queue.begin();
+    if (inProgress && queue.size() > 0) it++;
+    queue.insert(it, entry);
     if (entry.elem.isEvent()) size_++;
     //printTable();
     return true;
@@ -330,8 +413,10 @@ bool MSHR::insertInv(Addr baseAddr, mshrType entry, bool inProgress) {
 
 MemEvent* MSHR::getOldestRequest() const {
     MemEvent *ev = NULL;
-    for ( mshrTable::const_iterator it = map_.begin() ; it != map_.end() ; ++it ) {
-        for ( vector<mshrType>::const_iterator jt = (it->second).mshrQueue.begin() ; jt != (it->second).mshrQueue.end() ; jt++ ) {
+    for (vector<mshrSlot>::const_iterator it = slots_.begin(); it != slots_.end(); ++it) {
+        if (it->entry < 0) continue;
+        const vector<mshrType>& queue = entryPool_[it->entry].mshrQueue;
+        for ( vector<mshrType>::const_iterator jt = queue.begin() ; jt != queue.end() ; jt++ ) {
             if ( jt->elem.isEvent() ) {
                 MemEvent *me = (jt->elem).getEvent();
                 if ( !ev || ( me->getInitializationTime() < ev->getInitializationTime() ) ) {
@@ -345,27 +430,23 @@ MemEvent* MSHR::getOldestRequest() const {
 }
 
 vector<mshrType>* MSHR::getAll(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) {
         d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: mshr did not find entry with address 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
     }
-    return &((it->second).mshrQueue); 
+    return &(entry->mshrQueue); 
 }
 
 
 vector<mshrType> MSHR::removeAll(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) {
         d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: mshr did not find entry with address 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
     }
-    vector<mshrType> res = (it->second).mshrQueue;
-    if ((it->second).acksNeeded == 0 && (it->second).dataBuffer.empty()) {
-        if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR erasing 0x%" PRIx64 "\n", baseAddr);
-        
-        map_.erase(it);
-    } else {
-        (it->second).mshrQueue.clear();
-    }
+    vector<mshrType> res = entry->mshrQueue;
+    entry->mshrQueue.clear();
+    eraseIfEmpty(baseAddr, entry);
+    
     int trueSize = 0;
     int prefetches = 0;
     for (vector<mshrType>::iterator it = res.begin(); it != res.end(); it++) {
@@ -385,27 +466,17 @@ vector<mshrType> MSHR::removeAll(Addr baseAddr) {
 }
 
 MemEvent* MSHR::removeFront(Addr baseAddr) {
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) {
+    mshrEntry * entry = findEntry(baseAddr);
+    if (entry == nullptr) {
         d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: mshr did not find entry with address 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
     }
-    //if (it->second.empty()) {
-    //  d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: no front entry to remove in mshr for addr = 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
-    //}
-    //
-    // if (it->second.front().elem.isAddr()) {
-    //     d2_->fatal(CALL_INFO,-1, "%s (MSHR), Error: front entry in mshr is not of type MemEvent. Addr = 0x%" PRIx64 "\n", ownerName_.c_str(), baseAddr);
-    // }
     
-    MemEvent* ret = ((it->second).mshrQueue.front().elem).getEvent();
+    MemEvent* ret = (entry->mshrQueue.front().elem).getEvent();
     
     if (ret->isPrefetch()) prefetchCount_--;
     
-    (it->second).mshrQueue.erase(it->second.mshrQueue.begin());
-    if (((it->second).acksNeeded == 0) && (it->second).dataBuffer.empty() && (it->second).mshrQueue.empty()) {
-        if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR erasing 0x%" PRIx64 "\n", baseAddr);
-        map_.erase(it);
-    }
+    entry->mshrQueue.erase(entry->mshrQueue.begin());
+    eraseIfEmpty(baseAddr, entry);
     
     size_--;
     
@@ -435,23 +506,18 @@ void MSHR::removeElement(Addr baseAddr, Addr pointer) {
 }
 
 bool MSHR::removeElement(Addr baseAddr, mshrType entry) {
-
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) return false;    
+    mshrEntry * mshrEnt = findEntry(baseAddr);
+    if (mshrEnt == nullptr) return false;    
    
-    if (is_debug_addr(baseAddr)) d_->debug(_L9_,"\tMSHR Entry size = %zu\n", it->second.mshrQueue.size());
+    if (is_debug_addr(baseAddr)) d_->debug(_L9_,"\tMSHR Entry size = %zu\n", mshrEnt->mshrQueue.size());
     
-    vector<mshrType>& res = (it->second).mshrQueue;
+    vector<mshrType>& res = mshrEnt->mshrQueue;
     vector<mshrType>::iterator itv = std::find_if(res.begin(), res.end(), MSHREntryCompare(&entry));
     
     if (itv == res.end()) return false;
     res.erase(std::remove_if(res.begin(), res.end(), MSHREntryCompare(&entry)), res.end());
 
-    if (((it->second).acksNeeded == 0) && (it->second).dataBuffer.empty() && (it->second).mshrQueue.empty()) {
-        if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR erasing 0x%" PRIx64 "\n", baseAddr);
-        
-        map_.erase(it);
-    }
+    eraseIfEmpty(baseAddr, mshrEnt);
     
     if (is_debug_addr(baseAddr)) d_->debug(_L9_, "\tMSHR Removed Event\n");
     //printTable();
@@ -467,12 +533,12 @@ void MSHR::removeWriteback(Addr baseAddr) {
 bool MSHR::elementIsHit(Addr baseAddr, MemEvent *event) {
     mshrType entry = mshrType(event);
 
-    mshrTable::iterator it = map_.find(baseAddr);
-    if (it == map_.end()) return false;    
+    mshrEntry * mshrEnt = findEntry(baseAddr);
+    if (mshrEnt == nullptr) return false;    
     
-    if (is_debug_addr(baseAddr)) d_->debug(_L9_,"\tMSHR Entry size = %zu\n", it->second.mshrQueue.size());
+    if (is_debug_addr(baseAddr)) d_->debug(_L9_,"\tMSHR Entry size = %zu\n", mshrEnt->mshrQueue.size());
     
-    vector<mshrType>& res = (it->second).mshrQueue;
+    vector<mshrType>& res = mshrEnt->mshrQueue;
     vector<mshrType>::iterator itv = std::find_if (res.begin(), res.end(), MSHREntryCompare(&entry));
     
     if (itv == res.end()) return false;
@@ -481,9 +547,10 @@ bool MSHR::elementIsHit(Addr baseAddr, MemEvent *event) {
 
 
 void MSHR::printTable() {
-    for (mshrTable::iterator it = map_.begin(); it != map_.end(); it++) {
-        vector<mshrType> entries = (it->second).mshrQueue;
-        d_->debug(_L9_, "\tMSHR: Addr = 0x%" PRIx64 "\n", (it->first));
+    for (vector<mshrSlot>::iterator it = slots_.begin(); it != slots_.end(); it++) {
+        if (it->entry < 0) continue;
+        vector<mshrType>& entries = entryPool_[it->entry].mshrQueue;
+        d_->debug(_L9_, "\tMSHR: Addr = 0x%" PRIx64 "\n", it->addr);
         for (vector<mshrType>::iterator it2 = entries.begin(); it2 != entries.end(); it2++) {
             if (it2->elem.isAddr()) {
                 Addr ptr = (it2->elem).getAddr();
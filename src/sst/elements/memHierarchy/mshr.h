@@ -17,6 +17,7 @@
 #define _MSHR_H_
 
 #include <map>
+#include <deque>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -68,15 +69,27 @@ struct mshrType {
 struct mshrEntry {
     vector<mshrType> mshrQueue; // Events and pointers to events for this address
     uint32_t        acksNeeded; // Acks needed for request at top of queue. Here instead of at cacheline for non-inclusive caches
-    vector<uint8_t> dataBuffer;   // Temporary holding place for response data during replay of request events (for non-inclusive caches)
+    SharedPayload dataBuffer;     // Temporary holding place for response data during replay of request events (for non-inclusive caches)
 };
 
-typedef map<Addr, mshrEntry >   mshrTable;
+/* Index slot for the MSHR's open-addressed table. Points into the entry pool, entry < 0 means the slot is empty */
+struct mshrSlot {
+    Addr    addr;
+    int     entry;
+};
 
 #define HUGE_MSHR 100000
+#define MSHR_MAX_INITIAL_ENTRIES 4096   // Cap on preallocated entries/slots when mshr_num_entries is very large (e.g., HUGE_MSHR)
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
+ *  Entries are located through an open-addressed (linear probing) table keyed by address. 
+ *  The entries themselves live in a pool that is sized from the number of MSHRs and recycled 
+ *  without releasing their queue/buffer storage, so steady-state operation does not allocate. 
+ *  Pooled entries never move, so pointers returned by getAll() and getDataBuffer() remain valid
+ *  until that address's entry is removed.
+ *  Pointer, writeback, and ack-only entries do not count against the MSHR size, so the table
+ *  grows if they exceed the preallocated capacity.
  */
 class MSHR {
 public:
@@ -112,8 +125,9 @@ public:
     void setAcksNeeded(Addr baseAddr, int acksNeeded, MemEvent * event = nullptr);
     void incrementAcksNeeded(Addr baseAddr);
     void decrementAcksNeeded(Addr baseAddr);
-    vector<uint8_t> * getDataBuffer(Addr baseAddr);
-    void setDataBuffer(Addr baseAddr, vector<uint8_t>& data);
+    const SharedPayload * getDataBuffer(Addr baseAddr);
+    void setDataBuffer(Addr baseAddr, const SharedPayload& data);
+    void setDataBuffer(Addr baseAddr, MemEvent* event);
     void clearDataBuffer(Addr baseAddr);
     bool isDataBufferValid(Addr baseAddr);
 
@@ -132,7 +146,21 @@ public:
     void printTable();
 
 private:
-    mshrTable map_;
+    /* Table management */
+    mshrEntry* findEntry(Addr baseAddr);
+    mshrEntry* findOrCreateEntry(Addr baseAddr);
+    void eraseEntry(Addr baseAddr);
+    void eraseIfEmpty(Addr baseAddr, mshrEntry* entry);
+    void growTable();
+    inline uint64_t slotIndex(Addr baseAddr) const { return (baseAddr * 0x9E3779B97F4A7C15ULL) >> slotShift_; }
+
+    vector<mshrSlot>    slots_;         // Open-addressed index, size is a power of 2
+    unsigned int        slotShift_;     // 64 - log2(slots_.size())
+    unsigned int        numEntries_;    // Number of occupied slots
+    std::deque<mshrEntry> entryPool_;   // Entry storage, deque so that growing it does not move existing entries
+    vector<int>         freeEntries_;   // Unused entries in entryPool_
+    SharedPayload       zeroLine_;      // Shared stand-in data buffer for dataless responses
+
     Output* d_;
     Output* d2_;
     int size_;
@@ -16,6 +16,8 @@
 #include <sst_config.h>
 #include "multithreadL1Shim.h"
 
+#include <algorithm>
+
 #include <sst/core/params.h>
 #include <sst/core/simulation.h>
 #include <sst/core/interfaces/stringEvent.h>
@@ -65,12 +67,30 @@ MultiThreadL1::MultiThreadL1(ComponentId_t id, Params &params) : Component(id) {
     /* Setup throughput limiting */
     requestsPerCycle = params.find<uint64_t>("requests_per_cycle", 0);
     responsesPerCycle = params.find<uint64_t>("responses_per_cycle", 0);
+    requestHeadSeq = 0;
+
+    /* Setup coalescing */
+    coalesce = params.find<bool>("coalesce", false);
+    uint64_t lineSize = params.find<uint64_t>("line_size", 64);
+    if (!isPowerOfTwo(lineSize)) 
+        output.fatal(CALL_INFO, -1, "%s, Invalid param: line_size - must be a power of 2. You specified %" PRIu64 "\n", getName().c_str(), lineSize);
+    lineMask = ~(lineSize - 1);
+
+    /* Setup statistics */
+    for (unsigned int i = 0; i < threadLinks.size(); i++)
+        statQueueDelay.push_back(registerStatistic<uint64_t>("queue_delay", std::to_string(i)));
+    statRequestsCoalesced = registerStatistic<uint64_t>("requests_coalesced");
+    statRequestsForwarded = registerStatistic<uint64_t>("requests_forwarded");
 }
 
 MultiThreadL1::~MultiThreadL1() {
-    while (requestQueue.size()) {
-        delete requestQueue.front();
-        requestQueue.pop();
+    for (std::deque<std::vector<Request> >::iterator it = requestQueue.begin(); it != requestQueue.end(); it++) {
+        for (std::vector<Request>::iterator rt = it->begin(); rt != it->end(); rt++)
+            delete rt->event;
+    }
+    for (std::map<Event::id_type, std::vector<Request> >::iterator it = coalescedRequests.begin(); it != coalescedRequests.end(); it++) {
+        for (std::vector<Request>::iterator rt = it->second.begin(); rt != it->second.end(); rt++)
+            delete rt->event;
     }
     while (responseQueue.size()) {
         delete responseQueue.front();
@@ -82,12 +102,39 @@ void MultiThreadL1::handleRequest(SST::Event * ev, unsigned int threadid) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
     if (!clockOn) enableClock();
     threadRequestMap.insert(std::make_pair(event->getID(), threadid));
-    requestQueue.push(event);
+
+    Request request = { event, threadid, timestamp };
+    
+    if (coalesce) {
+        Addr line = event->getRoutingAddress() & lineMask;
+        std::unordered_map<Addr, uint64_t>::iterator group = openGroups.find(line);
+        if (isCoalescable(event)) {
+            if (group != openGroups.end()) {
+                requestQueue[group->second - requestHeadSeq].push_back(request);
+                statRequestsCoalesced->addData(1);
+                return;
+            }
+            openGroups[line] = requestHeadSeq + requestQueue.size();
+        } else if (group != openGroups.end()) {
+            openGroups.erase(group);    // Later reads must not be reordered ahead of this request
+        }
+    }
+    requestQueue.push_back(std::vector<Request>(1, request));
 }
 
 void MultiThreadL1::handleResponse(SST::Event * ev) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
     if (!clockOn) enableClock();
+    
+    if (!coalescedRequests.empty()) {
+        std::map<Event::id_type, std::vector<Request> >::iterator group = coalescedRequests.find(event->getResponseToID());
+        if (group != coalescedRequests.end()) {
+            splitResponse(static_cast<MemEvent*>(event), group->second);
+            coalescedRequests.erase(group);
+            delete event;
+            return;
+        }
+    }
     responseQueue.push(event);
 }
 
@@ -98,8 +145,15 @@ bool MultiThreadL1::tick(SST::Cycle_t cycle) {
     
     /* Drain request queue */
     while (!requestQueue.empty() && sendcount > 0) {
-        cacheLink->send(requestQueue.front());
-        requestQueue.pop();
+        std::vector<Request> &group = requestQueue.front();
+        if (coalesce) {
+            std::unordered_map<Addr, uint64_t>::iterator open = openGroups.find(group.front().event->getRoutingAddress() & lineMask);
+            if (open != openGroups.end() && open->second == requestHeadSeq)
+                openGroups.erase(open);
+        }
+        forwardRequests(group);
+        requestQueue.pop_front();
+        requestHeadSeq++;
         sendcount--;
     }
 
@@ -125,6 +179,67 @@ bool MultiThreadL1::tick(SST::Cycle_t cycle) {
     return false;
 }
 
+bool MultiThreadL1::isCoalescable(MemEventBase * event) {
+    if (event->getCmd() != Command::GetS) return false;
+    if (event->queryFlag(MemEventBase::F_LOCKED | MemEventBase::F_NONCACHEABLE | MemEventBase::F_LLSC)) return false;
+    MemEvent * read = static_cast<MemEvent*>(event);
+    if (read->getSize() == 0) return false;
+    return (read->getAddr() & lineMask) == ((read->getAddr() + read->getSize() - 1) & lineMask);
+}
+
+void MultiThreadL1::forwardRequests(std::vector<Request> &group) {
+    for (std::vector<Request>::iterator it = group.begin(); it != group.end(); it++)
+        statQueueDelay[it->thread]->addData(timestamp - it->arrival);
+    statRequestsForwarded->addData(1);
+
+    if (group.size() == 1) {
+        cacheLink->send(group.front().event);
+        return;
+    }
+
+    /* Read the bytes covering every request in the group */
+    MemEvent * first = static_cast<MemEvent*>(group.front().event);
+    Addr start = first->getAddr();
+    Addr end = start + first->getSize();
+    for (std::vector<Request>::iterator it = group.begin() + 1; it != group.end(); it++) {
+        MemEvent * read = static_cast<MemEvent*>(it->event);
+        start = std::min(start, read->getAddr());
+        end = std::max(end, read->getAddr() + read->getSize());
+    }
+
+    MemEvent * request = new MemEvent(this, start, first->getBaseAddr(), Command::GetS, end - start);
+    request->setRqstr(first->getRqstrId());
+    request->setMemFlags(first->getMemFlags());
+    request->setVirtualAddress(first->getVirtualAddress() - first->getAddr() + start);
+    request->setInstructionPointer(first->getInstructionPointer());
+    
+    if (DEBUG_ADDR.empty() || request->doDebug(DEBUG_ADDR))
+        debug.debug(_L5_, "%s, Coalesced %zu reads into %s\n", getName().c_str(), group.size(), request->getBriefString().c_str());
+
+    coalescedRequests.insert(std::make_pair(request->getID(), group));
+    cacheLink->send(request);
+}
+
+void MultiThreadL1::splitResponse(MemEvent * response, std::vector<Request> &group) {
+    for (std::vector<Request>::iterator it = group.begin(); it != group.end(); it++) {
+        MemEvent * request = static_cast<MemEvent*>(it->event);
+        MemEvent * split = request->makeResponse();
+        Addr offset = request->getAddr() - response->getAddr();
+        
+        if (response->isDataless()) {
+            split->setDataless();
+            split->setPayload(request->getSize(), nullptr);
+        } else if (offset == 0 && request->getSize() == response->getSize()) {
+            split->setPayload(response->getSharedPayload());
+        } else {
+            split->setPayload(request->getSize(), response->getSharedPayload().data() + offset);
+        }
+        
+        responseQueue.push(split);
+        delete request;
+    }
+}
+
 inline void MultiThreadL1::enableClock() {
     clockOn = true;
     timestamp = reregisterClock(clock, clockHandler);
@@ -16,8 +16,11 @@
 #ifndef _MEMHIERARCHY_MULTITHREADL1_H_
 #define _MEMHIERARCHY_MULTITHREADL1_H_
 
+#include <deque>
 #include <map>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -28,6 +31,7 @@
 #include <sst/core/output.h>
 
 #include "memEventBase.h"
+#include "memEvent.h"
 #include "util.h"
 
 using namespace std;
@@ -44,6 +48,8 @@ public:
             {"clock",               "(string) Clock frequency or period with units (Hz or s; SI units OK).", NULL},
             {"requests_per_cycle",  "(uint) Number of requests to forward to L1 each cycle (for all threads combined). 0 indicates unlimited", "0"},
             {"responses_per_cycle", "(uint) Number of responses to forward to threads each cycle (for all threads combined). 0 indicates unlimited", "0"},
+            {"coalesce",            "(bool) Merge reads to the same cache line from different threads while they wait for a request slot and forward them to the L1 as one request. Each thread still receives its own response.", "false"},
+            {"line_size",           "(uint) Cache line size in bytes, used to find same-line requests when coalescing. Must be a power of 2.", "64"},
             {"debug",               "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",         "(uint) Debug verbosity level. Between 0 and 10", "0"},
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""} )
@@ -52,6 +58,11 @@ public:
           {"cache", "Link to L1 cache", {"memHierarchy.MemEventBase"} },
           {"thread%(port)d", "Links to threads/cores", {"memHierarchy.MemEventBase"} } )
 
+    SST_ELI_DOCUMENT_STATISTICS(
+          {"queue_delay",           "Cycles each request waited for a request slot, per thread (subid: thread index). Use a histogram statistic for a distribution.", "cycles", 1},
+          {"requests_coalesced",    "Number of requests merged into an earlier request to the same line", "count", 1},
+          {"requests_forwarded",    "Number of requests sent to the L1, counting each coalesced group once", "count", 1} )
+
 /* Begin class definition */
     /** Constructor & destructor */
     MultiThreadL1(ComponentId_t id, Params &params);
@@ -93,10 +104,40 @@ private:
     /** Throughput control */
     uint64_t requestsPerCycle;
     uint64_t responsesPerCycle;
-    std::queue<MemEventBase*> requestQueue;
     std::queue<MemEventBase*> responseQueue;
-    
+
+    /** Requests waiting for a request slot. Each entry is a group of one or more requests that are sent as
+     *  a single request. While a group waits, later reads to its line join it unless another request to the
+     *  line arrived in between. Groups are addressed by sequence number: group 'seq' is requestQueue[seq - requestHeadSeq]. */
+    struct Request {
+        MemEventBase*   event;
+        unsigned int    thread;
+        uint64_t        arrival;
+    };
+    std::deque<std::vector<Request> > requestQueue;
+    uint64_t requestHeadSeq;
+    std::unordered_map<Addr, uint64_t> openGroups;      // Line -> group still accepting reads
+
+    /** Coalescing */
+    bool coalesce;
+    Addr lineMask;
+    std::map<Event::id_type, std::vector<Request> > coalescedRequests;  // Forwarded request ID -> requests it stands for
+
+    /** Statistics */
+    vector<Statistic<uint64_t>*> statQueueDelay;
+    Statistic<uint64_t>* statRequestsCoalesced;
+    Statistic<uint64_t>* statRequestsForwarded;
+
     inline void enableClock();
+
+    /** Whether a request can be merged with other reads to its line */
+    bool isCoalescable(MemEventBase * event);
+
+    /** Send a group of requests to the L1 */
+    void forwardRequests(std::vector<Request> &group);
+
+    /** Split the response to a coalesced request into a response for each request it stands for */
+    void splitResponse(MemEvent * response, std::vector<Request> &group);
 };
 
 }
@@ -0,0 +1,159 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_PREFETCHISSUEQUEUE_H
+#define MEMHIERARCHY_PREFETCHISSUEQUEUE_H
+
+#include <deque>
+#include <unordered_set>
+
+#include "memEvent.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ *  Prefetch issue queue and feedback tracker for a cache
+ *
+ *  Prefetches from the cache's listener wait here, deduplicated by line address, until the
+ *  cache has a spare request slot and MSHR room to issue them. When the queue is full the
+ *  oldest prefetch is dropped since it is the least likely to still be timely.
+ *
+ *  Issued prefetch lines are remembered until a demand request touches them (useful; late
+ *  if the prefetch miss was still outstanding) or they are evicted untouched (unused). The
+ *  counts feed a feedback-directed throttle (Srinath et al., HPCA'07): at the end of each
+ *  interval, accuracy and lateness move the throttle level up or down, and the level scales
+ *  how many prefetch misses may be outstanding at once. Cache pollution is not tracked, so
+ *  the throttle acts on accuracy and lateness only.
+ */
+class PrefetchIssueQueue {
+public:
+    static const int MIN_LEVEL = 1;
+    static const int MAX_LEVEL = 5;
+
+    PrefetchIssueQueue() : depth_(0), trackLimit_(0), interval_(0), throttle_(false), level_(3),
+        intervalIssued_(0), intervalUseful_(0), intervalLate_(0), issued_(0.0), useful_(0.0), late_(0.0) { }
+
+    ~PrefetchIssueQueue() {
+        for (std::deque<MemEvent*>::iterator it = queue_.begin(); it != queue_.end(); it++)
+            delete *it;
+    }
+
+    /* depth: queue entries (0 disables queueing), trackLimit: max lines tracked for feedback,
+     * interval: issued prefetches per throttle interval (0 disables throttling) */
+    void configure(size_t depth, size_t trackLimit, uint64_t interval) {
+        depth_ = depth;
+        trackLimit_ = trackLimit;
+        interval_ = interval;
+        throttle_ = interval > 0;
+    }
+
+    bool enabled() const { return depth_ > 0; }
+    bool empty() const { return queue_.empty(); }
+    size_t size() const { return queue_.size(); }
+    int level() const { return level_; }
+
+    /** Whether a prefetch to this line is already waiting */
+    bool queued(Addr baseAddr) const { return queuedAddrs_.find(baseAddr) != queuedAddrs_.end(); }
+
+    /** Queue a prefetch. Returns the prefetch displaced to make room, if any */
+    MemEvent* push(MemEvent* event) {
+        MemEvent* dropped = nullptr;
+        if (queue_.size() >= depth_) {
+            dropped = queue_.front();
+            queuedAddrs_.erase(dropped->getBaseAddr());
+            queue_.pop_front();
+        }
+        queue_.push_back(event);
+        queuedAddrs_.insert(event->getBaseAddr());
+        return dropped;
+    }
+
+    MemEvent* front() const { return queue_.front(); }
+
+    void pop() {
+        queuedAddrs_.erase(queue_.front()->getBaseAddr());
+        queue_.pop_front();
+    }
+
+    /** Max outstanding prefetches allowed by the throttle, given the configured maximum */
+    int scaleOutstanding(int maxOutstanding) const {
+        if (!throttle_) return maxOutstanding;
+        int allowed = (maxOutstanding * level_) / MAX_LEVEL;
+        return allowed > 0 ? allowed : 1;
+    }
+
+    /* Feedback */
+    void issued(Addr baseAddr) {
+        if (tracked_.size() < trackLimit_) tracked_.insert(baseAddr);
+        intervalIssued_++;
+        if (throttle_ && intervalIssued_ >= interval_) adjust();
+    }
+
+    /** A demand request touched this line. Returns whether it was an issued prefetch */
+    bool demand(Addr baseAddr, bool outstanding) {
+        if (tracked_.empty() || tracked_.erase(baseAddr) == 0) return false;
+        intervalUseful_++;
+        if (outstanding) intervalLate_++;
+        return true;
+    }
+
+    /** This line was evicted. Returns whether it was an issued prefetch never used */
+    bool evicted(Addr baseAddr) {
+        return !tracked_.empty() && tracked_.erase(baseAddr) != 0;
+    }
+
+private:
+    /* FDP thresholds */
+    static constexpr double ACCURACY_LOW = 0.40;
+    static constexpr double LATENESS = 0.01;
+
+    void adjust() {
+        // Weigh this interval equally with all history
+        issued_ = (issued_ + intervalIssued_) / 2;
+        useful_ = (useful_ + intervalUseful_) / 2;
+        late_ = (late_ + intervalLate_) / 2;
+        intervalIssued_ = intervalUseful_ = intervalLate_ = 0;
+
+        double accuracy = issued_ > 0 ? useful_ / issued_ : 0.0;
+        bool late = useful_ > 0 && late_ / useful_ > LATENESS;
+
+        if (accuracy >= ACCURACY_LOW) {
+            if (late && level_ < MAX_LEVEL) level_++;
+        } else if (level_ > MIN_LEVEL) {
+            level_--;
+        }
+    }
+
+    std::deque<MemEvent*>       queue_;
+    std::unordered_set<Addr>    queuedAddrs_;
+    std::unordered_set<Addr>    tracked_;       // Issued prefetch lines not yet used or evicted
+
+    size_t      depth_;
+    size_t      trackLimit_;
+    uint64_t    interval_;
+    bool        throttle_;
+    int         level_;
+
+    uint64_t    intervalIssued_;
+    uint64_t    intervalUseful_;
+    uint64_t    intervalLate_;
+    double      issued_;
+    double      useful_;
+    double      late_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_PREFETCHISSUEQUEUE_H */
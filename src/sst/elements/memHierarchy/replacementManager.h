@@ -23,8 +23,10 @@
 #define	REPLACEMENT_MGR_H
 
 #include "memEvent.h"
+#include "snapshot.h"
 #include "sst/core/rng/marsaglia.h"
 #include <stdlib.h>     /* srand, rand */
+#include <string.h>     /* memset */
 #include <time.h>       /* time */
 
 using namespace std;
@@ -35,11 +37,79 @@ namespace MemHierarchy {
 class ReplacementMgr{
     public:
         typedef unsigned int uint;
+
+        /* Per-line coherence flags, kept by the cache array next to its states */
+        static const uint8_t HAS_SHARERS    = 0x1;
+        static const uint8_t OWNED          = 0x2;
+
         virtual void update(uint id) = 0;
         virtual uint getBestCandidate() = 0;
-        virtual uint findBestCandidate(uint setBegin, State * state, uint * sharers, bool * owned, bool sharersAware) = 0;
+        /* state and coherence point at the metadata for the set's ways, in way order */
+        virtual uint findBestCandidate(uint setBegin, const State * state, const uint8_t * coherence, bool sharersAware) = 0;
         virtual void replaced(uint id) = 0;
+        /* Called when id is filled with baseAddr, after replaced(id) and before update(id).
+         * Only needed by policies that predict reuse from the address (e.g., SHiP) */
+        virtual void inserted(uint id, Addr baseAddr) { }
         virtual ~ReplacementMgr(){}
+
+        /* Snapshot the policy's state. load() returns false if the snapshot was taken with a different
+         * policy or array geometry */
+        void save(SnapshotWriter &out) {
+            out.writeString(policyName());
+            saveState(out);
+        }
+
+        bool load(SnapshotCursor &in) {
+            if (in.readString() != policyName()) return false;
+            return loadState(in) && in.good();
+        }
+
+    protected:
+        virtual const char * policyName() = 0;
+        /* Policies without per-line state (e.g., random) only record their name */
+        virtual void saveState(SnapshotWriter &out) { }
+        virtual bool loadState(SnapshotCursor &in) { return true; }
+
+        /* Helpers for policies that keep one array entry per line */
+        template<typename T>
+        static void saveArray(SnapshotWriter &out, const T * array, uint64_t count) {
+            out.write(count);
+            out.write(array, count * sizeof(T));
+        }
+
+        template<typename T>
+        static bool loadArray(SnapshotCursor &in, T * array, uint64_t count) {
+            if (in.read<uint64_t>() != count) return false;
+            const uint8_t * src = in.skip(count * sizeof(T));
+            if (!src) return false;
+            memcpy(array, src, count * sizeof(T));
+            return true;
+        }
+
+        /* Return the first way with the smallest key, where a way's key packs (valid, has sharers, owned, timestamp)
+         * from most to least significant bit, so invalid ways come first and timestamp breaks ties. If invert is set,
+         * larger timestamps rank lower. The reduction and the search for the minimum are separate branch-free
+         * loops over the set's contiguous metadata so the compiler can vectorize them. */
+        static uint minRankedWay(const State * state, const uint8_t * coherence, const uint64_t * timestamp, bool sharersAware, uint numWays, bool invert) {
+            const uint64_t TS_MASK = ((uint64_t)1 << 61) - 1;
+            uint64_t cohMask = sharersAware ? 3 : 0;
+            uint64_t tsFlip = invert ? TS_MASK : 0;
+            uint64_t minKey = ~(uint64_t)0;
+            for (uint i = 0; i < numWays; i++) {
+                uint64_t key = rankKey(state[i], coherence[i] & cohMask, timestamp[i] ^ tsFlip, TS_MASK);
+                minKey = key < minKey ? key : minKey;
+            }
+            uint way = 0;
+            while (rankKey(state[way], coherence[way] & cohMask, timestamp[way] ^ tsFlip, TS_MASK) != minKey) way++;
+            return way;
+        }
+
+    private:
+        static inline uint64_t rankKey(State state, uint64_t coh, uint64_t timestamp, uint64_t tsMask) {
+            uint64_t valid = (state != I);
+            uint64_t key = ((uint64_t)1 << 63) | ((coh & HAS_SHARERS) << 62) | ((coh & OWNED) << 60) | (timestamp & tsMask);
+            return key & (0 - valid);
+        }
 };
 
 /* ------------------------------------------------------------------------------------------
@@ -53,32 +123,6 @@ private:
     uint        numLines;
     uint        numWays;
 
-    struct Rank {
-        uint64_t   timestamp;
-        uint       sharers;
-        bool       owned;
-        State      state;
-
-        void reset() {
-            state       = I;
-            sharers     = 0;
-            timestamp   = 0;
-            owned       = false;
-        }
-
-        inline bool lessThan(const Rank& other) const {
-            if(state == I) return true;
-            //if(!CacheArray::CacheLine::inTransition(state) && CacheArray::CacheLine::inTransition(other.state)) return true;
-            else{
-                if (sharers == 0 && other.sharers > 0) return true;
-                else if (sharers > 0 && other.sharers == 0) return false;
-                else if (!owned && other.owned) return true;
-                else if (owned && !other.owned) return false;
-                else return timestamp < other.timestamp;
-            }
-        }
-    };
-
 public:
     LRUReplacementMgr(Output* _dbg, uint _numLines, uint _numWays, bool _sharersAware) : timestamp(1), bestCandidate(-1), numLines(_numLines), numWays(_numWays)  {
         array = (uint64_t*) calloc(numLines, sizeof(uint64_t));
@@ -90,22 +134,9 @@ public:
 
     void update(uint id) { array[id] = timestamp++; }
     
-    uint findBestCandidate(uint setBegin, State * state, uint * sharers, bool * owned, bool sharersAware) {
-        uint setEnd = setBegin + numWays;
-        bestCandidate = setBegin;
-        Rank bestRank = {array[setBegin], (sharersAware)? sharers[0] : 0, (sharersAware)? owned[0] : false, state[0]};
-        if (state[0] == I) return (uint)bestCandidate;
-        setBegin++;
-        int i = 1;
-        for (uint id = setBegin; id < setEnd; id++) {
-            Rank candRank = {array[id], (sharersAware)? sharers[i] : 0, (sharersAware)? owned[i] : false, state[i]};
-            if (candRank.lessThan(bestRank)) {
-                bestRank = candRank;
-                bestCandidate = id;
-                if (state[i] == I) return (uint)bestCandidate;
-            }
-            i++;
-        }
+    /* Victim is the first way with the smallest (valid, has sharers, owned, timestamp) key */
+    uint findBestCandidate(uint setBegin, const State * state, const uint8_t * coherence, bool sharersAware) {
+        bestCandidate = setBegin + minRankedWay(state, coherence, &array[setBegin], sharersAware, numWays, false);
         return (uint)bestCandidate;
     }
 
@@ -115,6 +146,20 @@ public:
         array[id] = 0;
     }
 
+protected:
+    const char * policyName() { return "lru"; }
+
+    void saveState(SnapshotWriter &out) {
+        out.write(timestamp);
+        saveArray(out, array, numLines);
+    }
+
+    bool loadState(SnapshotCursor &in) {
+        uint64_t ts = in.read<uint64_t>();
+        if (!loadArray(in, array, numLines)) return false;
+        timestamp = ts;
+        return true;
+    }
 };
 
 /* ------------------------------------------------------------------------------------------
@@ -185,16 +230,16 @@ class LFUReplacementMgr : public ReplacementMgr {
             timestamp += 1000;
         }
         
-        uint findBestCandidate(uint setBegin, State * state, uint * sharers, bool * owned, bool sharersAware) {
+        uint findBestCandidate(uint setBegin, const State * state, const uint8_t * coherence, bool sharersAware) {
             uint setEnd = setBegin + numWays;
             bestCandidate = setBegin;
-            Rank bestRank = {array[setBegin], (sharersAware)? sharers[0] : 0, (sharersAware)? owned[0] : false, state[0] };
+            Rank bestRank = {array[setBegin], (sharersAware)? (uint)(coherence[0] & HAS_SHARERS) : 0, (sharersAware)? (bool)(coherence[0] & OWNED) : false, state[0] };
             if (state[0] == I) return (uint)bestCandidate; 
         
             setBegin++;
             int i = 1;
             for (uint id = setBegin; id < setEnd; id++) {
-                Rank candRank = {array[id], (sharersAware)? sharers[i] : 0, (sharersAware)? owned[i] : false, state[i]};
+                Rank candRank = {array[id], (sharersAware)? (uint)(coherence[i] & HAS_SHARERS) : 0, (sharersAware)? (bool)(coherence[i] & OWNED) : false, state[i]};
                 if (candRank.lessThan(bestRank, timestamp)) {
                     bestRank = candRank;
                     bestCandidate = id;
@@ -210,7 +255,21 @@ class LFUReplacementMgr : public ReplacementMgr {
         void replaced(uint id) {
             array[id].acc = 0;
         }
-    
+
+    protected:
+        const char * policyName() { return "lfu"; }
+
+        void saveState(SnapshotWriter &out) {
+            out.write(timestamp);
+            saveArray(out, array, numLines);
+        }
+
+        bool loadState(SnapshotCursor &in) {
+            uint64_t ts = in.read<uint64_t>();
+            if (!loadArray(in, array, numLines)) return false;
+            timestamp = ts;
+            return true;
+        }
 };
 
 
@@ -226,31 +285,6 @@ private:
     uint        numLines;
     uint        numWays;
 
-    struct Rank {
-        uint64_t  timestamp;
-        uint      sharers;
-        bool      owned;
-        State     state;
-
-        void reset() {
-            state       = I;
-            sharers     = 0;
-            owned       = false;
-            timestamp   = 0;
-        }
-
-        inline bool biggerThan(const Rank& other) const {
-            if(state == I) return true;
-            else{
-                if (sharers == 0 && other.sharers > 0) return true;
-                else if (sharers > 0 && other.sharers == 0) return false;
-                else if (owned && !other.owned) return false;
-                else if (!owned && other.owned) return true;
-                else return timestamp > other.timestamp;
-            }
-        }
-    };
-
 public:
     MRUReplacementMgr(Output* _dbg, uint _numLines, uint _numWays, bool _sharersAware) : timestamp(1), bestCandidate(-1), numLines(_numLines), numWays(_numWays)  {
         array = (uint64_t*) calloc(numLines, sizeof(uint64_t));
@@ -260,23 +294,9 @@ public:
 
     void update(uint id) { array[id] = timestamp++; }
 
-    uint findBestCandidate(uint setBegin, State * state, uint * sharers, bool * owned, bool sharersAware) {
-        uint setEnd = setBegin + numWays;
-        bestCandidate = setBegin;
-        Rank bestRank = {array[setBegin], (sharersAware)? sharers[0] : 0, (sharersAware)? owned[0] : false, state[0] };
-        if (state[0] == I) return (uint)bestCandidate; 
-        
-        setBegin++;
-        int i = 1;
-        for (uint id = setBegin; id < setEnd; id++) {
-            Rank candRank = {array[id], (sharersAware)? sharers[i]: 0, (sharersAware)? owned[i] : false, state[i]};
-            if (candRank.biggerThan(bestRank)) {
-                bestRank = candRank;
-                bestCandidate = id;
-                if (state[i] == I) return (uint)bestCandidate;
-            }
-            i++;
-        }
+    /* Victim is the first way with the smallest (valid, has sharers, owned, -timestamp) key */
+    uint findBestCandidate(uint setBegin, const State * state, const uint8_t * coherence, bool sharersAware) {
+        bestCandidate = setBegin + minRankedWay(state, coherence, &array[setBegin], sharersAware, numWays, true);
         return (uint)bestCandidate;
     }
 
@@ -287,6 +307,20 @@ public:
         array[id] = 0;
     }
 
+protected:
+    const char * policyName() { return "mru"; }
+
+    void saveState(SnapshotWriter &out) {
+        out.write(timestamp);
+        saveArray(out, array, numLines);
+    }
+
+    bool loadState(SnapshotCursor &in) {
+        uint64_t ts = in.read<uint64_t>();
+        if (!loadArray(in, array, numLines)) return false;
+        timestamp = ts;
+        return true;
+    }
 };
 
 
@@ -310,7 +344,7 @@ public:
     void update(uint id){}
        
     // Return a empty slot if one exists, otherwise return a random candidate
-    uint findBestCandidate(uint setBegin, State * state, uint * sharers, bool * owned, bool sharersAware) {
+    uint findBestCandidate(uint setBegin, const State * state, const uint8_t * coherence, bool sharersAware) {
         for (uint i = 0; i < numWays; i++) {
             if (state[i] == I) {
                 bestCandidate = setBegin + i;
@@ -326,6 +360,9 @@ public:
     }
 
     void replaced(uint id) { }
+
+protected:
+    const char * policyName() { return "random"; }
 };
 
 /* ------------------------------------------------------------------------------------------
@@ -352,7 +389,7 @@ public:
     }
 
     // Return an empty slot if one exists, otherwise return any slot that is not the most-recently used in the set
-    uint findBestCandidate(uint setBegin, State * state, uint * sharers, bool * owned, bool sharersAware) {
+    uint findBestCandidate(uint setBegin, const State * state, const uint8_t * coherence, bool sharersAware) {
         for (uint i = 0; i < numWays; i++) {
             if (state[i] == I) {
                 bestCandidate = setBegin + i;
@@ -371,6 +408,201 @@ public:
 
     void replaced(uint id) {}
 
+protected:
+    const char * policyName() { return "nmru"; }
+
+    void saveState(SnapshotWriter &out) { saveArray(out, array, numLines/numWays); }
+    bool loadState(SnapshotCursor &in) { return loadArray(in, array, numLines/numWays); }
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Re-reference interval prediction (RRIP): static (SRRIP), bimodal (BRRIP) and set-dueling
+ *  dynamic (DRRIP), after Jaleel et al., ISCA 2010.
+ *  Each line holds a 2-bit re-reference prediction value (RRPV) in one byte of metadata. Hits
+ *  promote to RRPV 0, fills insert at long (MAX_RRPV-1) or distant (MAX_RRPV), and the victim
+ *  is the line with the largest RRPV. Rather than repeatedly aging the set until some line
+ *  reaches MAX_RRPV, the victim search is a single pass after which the set is aged by the
+ *  difference, so findBestCandidate is O(ways).
+ * ------------------------------------------------------------------------------------------*/
+class RRIPReplacementMgr : public ReplacementMgr {
+public:
+    enum class Policy { SRRIP, BRRIP, DRRIP };
+
+protected:
+    static const uint8_t MAX_RRPV       = 3;
+    static const uint8_t RRPV_MASK      = 0x03;
+    static const uint8_t FILLED         = 0x04;     // Line was filled since the last replaced()
+    static const uint8_t REUSED         = 0x08;     // Line has hit since it was filled
+    static const uint   BRRIP_THROTTLE  = 32;       // BRRIP inserts at long instead of distant once every BRRIP_THROTTLE fills
+    static const uint   PSEL_MAX        = 1023;     // 10-bit DRRIP policy selector
+    static const uint   DUEL_PERIOD     = 64;       // DRRIP: one SRRIP and one BRRIP leader set out of every DUEL_PERIOD sets
+
+    int32_t     bestCandidate;
+    uint8_t*    meta;           // Per line: RRPV | FILLED | REUSED
+    uint        numLines;
+    uint        numWays;
+    uint        duelPeriod;
+    Policy      policy;
+    uint        psel;           // DRRIP: above PSEL_MAX/2, SRRIP leaders miss more and followers use BRRIP
+    uint        brripFills;
+
+    uint8_t bimodalRRPV() {
+        return (++brripFills % BRRIP_THROTTLE == 0) ? MAX_RRPV - 1 : MAX_RRPV;
+    }
+
+    /* RRPV for a line that was just filled */
+    virtual uint8_t insertionRRPV(uint id) {
+        if (policy == Policy::SRRIP) return MAX_RRPV - 1;
+        if (policy == Policy::BRRIP) return bimodalRRPV();
+
+        uint leader = (id / numWays) % duelPeriod;
+        if (leader == 0) {
+            if (psel < PSEL_MAX) psel++;
+            return MAX_RRPV - 1;
+        }
+        if (leader == duelPeriod - 1) {
+            if (psel > 0) psel--;
+            return bimodalRRPV();
+        }
+        return (psel > PSEL_MAX / 2) ? bimodalRRPV() : MAX_RRPV - 1;
+    }
+
+    virtual void hit(uint id) { }
+
+    const char * policyName() {
+        if (policy == Policy::SRRIP) return "srrip";
+        if (policy == Policy::BRRIP) return "brrip";
+        return "drrip";
+    }
+
+    void saveState(SnapshotWriter &out) {
+        out.write((uint32_t)psel);
+        out.write((uint32_t)brripFills);
+        saveArray(out, meta, numLines);
+    }
+
+    bool loadState(SnapshotCursor &in) {
+        uint32_t savedPsel = in.read<uint32_t>();
+        uint32_t savedFills = in.read<uint32_t>();
+        if (!loadArray(in, meta, numLines)) return false;
+        psel = savedPsel;
+        brripFills = savedFills;
+        return true;
+    }
+
+public:
+    RRIPReplacementMgr(Output* _dbg, uint _numLines, uint _numWays, Policy _policy) : bestCandidate(-1), numLines(_numLines), numWays(_numWays), 
+            policy(_policy), psel(PSEL_MAX / 2), brripFills(0) {
+        meta = (uint8_t*) malloc(numLines);
+        memset(meta, MAX_RRPV, numLines);
+        uint numSets = numLines / numWays;
+        duelPeriod = (numSets < DUEL_PERIOD) ? numSets : DUEL_PERIOD;
+    }
+
+    virtual ~RRIPReplacementMgr() { free(meta); }
+
+    void update(uint id) {
+        uint8_t m = meta[id];
+        if (m & FILLED) {
+            meta[id] = (m & ~RRPV_MASK) | REUSED;
+            hit(id);
+        } else {
+            meta[id] = FILLED | insertionRRPV(id);
+        }
+    }
+
+    /* Rank each way by (invalid, no sharers, not owned, RRPV) packed into one key and take the largest,
+     * so the loop only compares integers. Ties go to the lowest way. */
+    uint findBestCandidate(uint setBegin, const State * state, const uint8_t * coherence, bool sharersAware) {
+        const uint INVALID = 0x10;
+        uint cohMask = sharersAware ? 0x0C : 0;
+        uint bestKey = 0;
+        bestCandidate = setBegin;
+        for (uint i = 0; i < numWays; i++) {
+            uint coh = ((uint)(~coherence[i] & HAS_SHARERS) << 3) | ((uint)(~coherence[i] & OWNED) << 1);
+            uint key = ((uint)(state[i] == I) << 4) | (coh & cohMask) | (meta[setBegin + i] & RRPV_MASK);
+            bool better = key > bestKey;
+            bestKey = better ? key : bestKey;
+            bestCandidate = better ? (int32_t)(setBegin + i) : bestCandidate;
+        }
+
+        /* Age the set so that the victim is at MAX_RRPV */
+        uint8_t age = MAX_RRPV - (bestKey & RRPV_MASK);
+        if (age != 0 && !(bestKey & INVALID)) {
+            for (uint id = setBegin; id < setBegin + numWays; id++) {
+                uint8_t rrpv = (meta[id] & RRPV_MASK) + age;
+                meta[id] = (meta[id] & ~RRPV_MASK) | (rrpv > MAX_RRPV ? MAX_RRPV : rrpv);
+            }
+        }
+        return (uint)bestCandidate;
+    }
+
+    uint getBestCandidate() { return (uint)bestCandidate; }
+
+    virtual void replaced(uint id) {
+        meta[id] = MAX_RRPV;
+    }
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Signature-based hit prediction (SHiP) on top of SRRIP, after Wu et al., MICRO 2011.
+ *  Replacement managers see addresses but not the requesting instruction, so the signature is
+ *  the memory region of the line (SHiP-Mem). A table of saturating counters learns whether
+ *  lines from a region are re-referenced; lines from regions that are not get inserted at
+ *  distant RRPV so they are evicted first.
+ * ------------------------------------------------------------------------------------------*/
+class SHiPReplacementMgr : public RRIPReplacementMgr {
+private:
+    static const uint   SHCT_BITS       = 14;
+    static const uint   SHCT_SIZE       = 1 << SHCT_BITS;
+    static const uint8_t SHCT_MAX       = 7;        // 3-bit counters
+    static const uint   REGION_SHIFT    = 14;       // Signature granularity: 16KiB regions
+
+    uint8_t*    shct;           // Signature history counter table
+    uint16_t*   signature;      // Per line: SHCT index of the line's region
+
+    uint8_t insertionRRPV(uint id) {
+        return shct[signature[id]] == 0 ? MAX_RRPV : MAX_RRPV - 1;
+    }
+
+    void hit(uint id) {
+        if (shct[signature[id]] < SHCT_MAX) shct[signature[id]]++;
+    }
+
+    const char * policyName() { return "ship"; }
+
+    void saveState(SnapshotWriter &out) {
+        RRIPReplacementMgr::saveState(out);
+        saveArray(out, shct, SHCT_SIZE);
+        saveArray(out, signature, numLines);
+    }
+
+    bool loadState(SnapshotCursor &in) {
+        return RRIPReplacementMgr::loadState(in) && loadArray(in, shct, SHCT_SIZE) && loadArray(in, signature, numLines);
+    }
+
+public:
+    SHiPReplacementMgr(Output* _dbg, uint _numLines, uint _numWays) : RRIPReplacementMgr(_dbg, _numLines, _numWays, Policy::SRRIP) {
+        shct = (uint8_t*) malloc(SHCT_SIZE);
+        memset(shct, 1, SHCT_SIZE);
+        signature = (uint16_t*) calloc(numLines, sizeof(uint16_t));
+    }
+
+    ~SHiPReplacementMgr() {
+        free(shct);
+        free(signature);
+    }
+
+    void inserted(uint id, Addr baseAddr) {
+        Addr region = baseAddr >> REGION_SHIFT;
+        signature[id] = (region ^ (region >> SHCT_BITS) ^ (region >> (2 * SHCT_BITS))) & (SHCT_SIZE - 1);
+    }
+
+    /* A line leaving without having been re-referenced trains its region towards distant insertion */
+    void replaced(uint id) {
+        if ((meta[id] & (FILLED | REUSED)) == FILLED && shct[signature[id]] > 0) shct[signature[id]]--;
+        RRIPReplacementMgr::replaced(id);
+    }
 };
 
 
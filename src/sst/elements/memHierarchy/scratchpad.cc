@@ -157,8 +157,9 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
         if ( 0 == memoryFile.compare( "" ) ) {
             memoryFile.clear();
         }
+        bool hugePages = params.find<bool>("backing_huge_pages", false);
         try { 
-            backing_ = new Backend::BackingMMAP( memoryFile, scratch_->getMemSize() );
+            backing_ = new Backend::BackingMMAP( memoryFile, scratch_->getMemSize(), 0, hugePages );
         }
         catch ( int e) {
             if (e == 1) 
@@ -527,8 +528,7 @@ void Scratchpad::handleScratchRead(MemEvent * ev) {
     outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
 
     if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        std::vector<uint8_t> data = doScratchRead(read);
-        response->setPayload(data);
+        response->setPayload(doScratchRead(read));
         mshr_.insert(std::make_pair(ev->getBaseAddr(), std::list<MSHREntry>(1,MSHREntry(ev->getID(), Command::GetS, true, false))));
         if (caching_ && !ev->queryFlag(MemEvent::F_NONCACHEABLE)) {
             cacheStatus_.at(ev->getBaseAddr()/scratchLineSize_) = true;
@@ -570,7 +570,7 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
             return;
             // TODO handle corner cases where Get only writes partial line
         } else if (outstandingEventList_.find(entry->id)->second.request->getCmd() == Command::Put) {
-            if (ev->getPayload().empty()) {
+            if (ev->getSharedPayload().empty()) {
                 handleAckInv(ev);
             } else {
                 handleFetchResp(ev);
@@ -595,7 +595,7 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
     MemEvent * response = nullptr;
     response = ev->makeResponse();
 
-    MemEvent * write = new MemEvent(this, ev->getAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload());
+    MemEvent * write = new MemEvent(this, ev->getAddr(), ev->getBaseAddr(), Command::PutM, ev->getSharedPayload());
     write->setRqstr(ev->getRqstr());
     write->setVirtualAddress(ev->getVirtualAddress());
     write->setInstructionPointer(ev->getInstructionPointer());
@@ -875,7 +875,7 @@ void Scratchpad::handleFetchResp(MemEventBase * event) {
 
     // Send a write to scratch if the line was dirty since we forcefully invalidated
     if (response->getDirty()) {
-        MemEvent * write = new MemEvent(this, response->getAddr(), baseAddr, Command::PutM, response->getPayload());
+        MemEvent * write = new MemEvent(this, response->getAddr(), baseAddr, Command::PutM, response->getSharedPayload());
         write->setRqstr(put->getRqstr());
         write->setVirtualAddress(put->getSrcVirtualAddress());
         write->setInstructionPointer(put->getInstructionPointer());
@@ -983,7 +983,7 @@ void Scratchpad::handleRemoteWrite(MemEvent * event) {
     stat_RemoteWriteReceived->addData(1);
 
     event->setBaseAddr((event->getAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
-    MemEvent * request = new MemEvent(this, event->getAddr() - remoteAddrOffset_, event->getBaseAddr(), Command::GetX, event->getPayload());
+    MemEvent * request = new MemEvent(this, event->getAddr() - remoteAddrOffset_, event->getBaseAddr(), Command::GetX, event->getSharedPayload());
     request->setFlag(MemEvent::F_NORESPONSE);
     request->setFlag(MemEvent::F_NONCACHEABLE);
     request->setRqstr(event->getRqstr());
@@ -1068,7 +1068,7 @@ void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_typ
 void Scratchpad::handleRemoteReadResponse(MemEvent * response, SST::Event::id_type requestID) {
     // Update response with payload and finish request
     MemEvent * fwdResponse = static_cast<MemEvent*>(outstandingEventList_.find(requestID)->second.response);
-    fwdResponse->setPayload(response->getPayload());
+    fwdResponse->setPayload(response->getSharedPayload());
     
     finishRequest(requestID);
 
@@ -1088,8 +1088,7 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
             dbg.debug(_L5_, "\tProcessing MSHR entry. %s\n", entry->getString().c_str());
 
         if (entry->cmd == Command::GetS) {
-            std::vector<uint8_t> readData = doScratchRead(entry->scratch);
-            static_cast<MemEvent*>(outstandingEventList_.find(entry->id)->second.response)->setPayload(readData);
+            static_cast<MemEvent*>(outstandingEventList_.find(entry->id)->second.response)->setPayload(doScratchRead(entry->scratch));
             
             if (is_debug_addr(baseAddr))
                 dbg.debug(_L5_, "\t\tUpdated. %s\n", entry->getString().c_str());
@@ -1164,7 +1163,7 @@ void Scratchpad::doScratchWrite(MemEvent * event) {
     stat_ScratchWriteIssued->addData(1);
 
     if (backing_) {
-        backing_->set(event->getAddr(), event->getSize(), event->getPayload());
+        backing_->set(event->getAddr(), event->getSize(), event->getSharedPayload().get());
     }
 
     dbg.debug(_L4_, "\tSending request to scratch: %s\n", event->getBriefString().c_str());
@@ -0,0 +1,105 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SHAREDPAYLOAD_H
+#define MEMHIERARCHY_SHAREDPAYLOAD_H
+
+#include <cstring>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ *  Reference-counted, copy-on-write data buffer
+ *
+ *  Copying a SharedPayload shares the bytes instead of copying them, so a line of data can
+ *  move between events and cache lines at every level of the hierarchy without being
+ *  duplicated. Readers see an immutable vector; any write first takes a private copy if
+ *  another holder still references the bytes. Holders may live on different threads: the
+ *  reference count is atomic and shared bytes are never written in place.
+ */
+class SharedPayload {
+public:
+    typedef std::vector<uint8_t> dataVec;
+    typedef dataVec::const_iterator const_iterator;
+
+    SharedPayload() { }
+    explicit SharedPayload(const dataVec &data) { assign(data); }
+
+    /* Read access - never copies */
+    const dataVec& get() const { return buf_ ? *buf_ : empty_(); }
+    size_t size() const { return buf_ ? buf_->size() : 0; }
+    bool empty() const { return size() == 0; }
+    const uint8_t* data() const { return get().data(); }
+    const uint8_t& operator[](size_t i) const { return get()[i]; }
+    const uint8_t& at(size_t i) const { return get().at(i); }
+    const_iterator begin() const { return get().begin(); }
+    const_iterator end() const { return get().end(); }
+
+    /** Whether another holder references the same bytes */
+    bool isShared() const { return buf_ && buf_.use_count() > 1; }
+
+    /* Write access - reuses the buffer when this is the only holder */
+    void assign(const dataVec &data) {
+        if (writable()) *buf_ = data;
+        else buf_ = std::make_shared<dataVec>(data);
+    }
+
+    void assign(dataVec &&data) {
+        buf_ = std::make_shared<dataVec>(std::move(data));
+    }
+
+    void assign(const uint8_t * data, size_t size) {
+        if (writable()) buf_->assign(data, data + size);
+        else buf_ = std::make_shared<dataVec>(data, data + size);
+    }
+
+    void assign(size_t size, uint8_t value) {
+        if (writable()) buf_->assign(size, value);
+        else buf_ = std::make_shared<dataVec>(size, value);
+    }
+
+    /** Overwrite 'data.size()' bytes starting at 'offset'; the buffer must already be large enough */
+    void write(const dataVec &data, size_t offset) {
+        if (data.empty()) return;
+        std::memcpy(mut().data() + offset, data.data(), data.size());
+    }
+
+    /** Private, writable copy of the bytes */
+    dataVec& mut() {
+        if (!buf_) buf_ = std::make_shared<dataVec>();
+        else if (buf_.use_count() > 1) buf_ = std::make_shared<dataVec>(*buf_);
+        return *buf_;
+    }
+
+    /** Drop this holder's reference */
+    void clear() { buf_.reset(); }
+
+private:
+    std::shared_ptr<dataVec> buf_;
+
+    bool writable() const { return buf_ && buf_.use_count() == 1; }
+
+    static const dataVec& empty_() {
+        static const dataVec none;
+        return none;
+    }
+};
+
+}}
+
+#endif /* MEMHIERARCHY_SHAREDPAYLOAD_H */
@@ -0,0 +1,277 @@
+// Copyright 2009-2017 Sandia Corporation. Under the terms
+// of Contract DE-NA0003525 with Sandia Corporation, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2017, Sandia Corporation
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SNAPSHOT_H
+#define MEMHIERARCHY_SNAPSHOT_H
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ *  Binary snapshot of warmed memory system state
+ *
+ *  A snapshot file is a header followed by sections. Each section has a type, the name of the
+ *  component it belongs to and a payload whose layout is up to the structure that wrote it
+ *  (cache array, replacement manager, directory, backing store). Values are written in host
+ *  byte order; a snapshot is only meant to be read by the same build on the same kind of host.
+ *
+ *  The reader maps the whole file read-only and hands out cursors over section payloads, so
+ *  large payloads (line data, memory images) can be copied or mapped straight from the page
+ *  cache without an intermediate buffer. Payload data that writers align to the page size
+ *  with SnapshotWriter::align() can be mapped copy-on-write into a backing store.
+ */
+enum class SnapshotSection : uint32_t {
+    CacheArray  = 1,
+    Replacement = 2,
+    Directory   = 3,
+    Backing     = 4,
+};
+
+/** Cursor over one section's payload. Reads past the end return zeros and mark the cursor bad */
+class SnapshotCursor {
+public:
+    SnapshotCursor() : base_(nullptr), pos_(0), end_(0), good_(true) { }
+    SnapshotCursor(const uint8_t * base, uint64_t pos, uint64_t end) : base_(base), pos_(pos), end_(end), good_(true) { }
+
+    bool good() const { return good_; }
+    bool atEnd() const { return pos_ >= end_; }
+    uint64_t remaining() const { return pos_ < end_ ? end_ - pos_ : 0; }
+
+    /** Offset of the next byte in the snapshot file */
+    uint64_t fileOffset() const { return pos_; }
+
+    template<typename T>
+    T read() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    void read(void * data, size_t size) {
+        const uint8_t * src = skip(size);
+        if (src) memcpy(data, src, size);
+        else memset(data, 0, size);
+    }
+
+    std::string readString() {
+        uint32_t size = read<uint32_t>();
+        const uint8_t * src = skip(size);
+        return src ? std::string((const char*)src, size) : std::string();
+    }
+
+    /** Pointer to the next 'size' bytes in the mapped file, or nullptr if the section is too short */
+    const uint8_t * skip(size_t size) {
+        if (!good_ || size > remaining()) {
+            good_ = false;
+            return nullptr;
+        }
+        const uint8_t * ptr = base_ + pos_;
+        pos_ += size;
+        return ptr;
+    }
+
+    /** Skip the padding SnapshotWriter::align() wrote */
+    void align(uint64_t alignment) {
+        uint64_t pad = (alignment - (pos_ % alignment)) % alignment;
+        skip(pad);
+    }
+
+private:
+    const uint8_t * base_;
+    uint64_t pos_;
+    uint64_t end_;
+    bool good_;
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader() : fd_(-1), base_((const uint8_t*)MAP_FAILED), size_(0) { }
+    ~SnapshotReader() { close(); }
+
+    /** Map 'path' and index its sections. On failure, returns false and error() says why */
+    bool open(const std::string &path) {
+        close();
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return fail("unable to open file");
+        struct stat st;
+        if (fstat(fd_, &st) != 0) return fail("unable to stat file");
+        size_ = st.st_size;
+        if (size_ < HEADER_SIZE) return fail("file is too short to be a snapshot");
+        base_ = (const uint8_t*)mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (base_ == MAP_FAILED) return fail("unable to map file");
+
+        if (memcmp(base_, magic(), MAGIC_SIZE) != 0) return fail("not a memHierarchy snapshot");
+        uint32_t version;
+        memcpy(&version, base_ + MAGIC_SIZE, sizeof(version));
+        if (version != VERSION) return fail("unsupported snapshot version");
+
+        uint64_t pos = HEADER_SIZE;
+        while (pos < size_) {
+            SnapshotCursor header(base_, pos, size_);
+            uint32_t type = header.read<uint32_t>();
+            std::string name = header.readString();
+            uint64_t length = header.read<uint64_t>();
+            if (!header.good() || length > size_ - header.fileOffset()) return fail("truncated section");
+            sections_[std::make_pair(type, name)] = std::make_pair(header.fileOffset(), length);
+            pos = header.fileOffset() + length;
+        }
+        return true;
+    }
+
+    void close() {
+        if (base_ != MAP_FAILED) munmap((void*)base_, size_);
+        if (fd_ >= 0) ::close(fd_);
+        base_ = (const uint8_t*)MAP_FAILED;
+        fd_ = -1;
+        sections_.clear();
+    }
+
+    const std::string& error() const { return error_; }
+
+    /** File descriptor of the snapshot, for mapping payload pages directly */
+    int fd() const { return fd_; }
+
+    /** Find a section by type and component name. If there is no section with that name but exactly one
+     *  of that type, it is used so a snapshot can be restored into a renamed component */
+    bool find(SnapshotSection type, const std::string &name, SnapshotCursor &cursor) const {
+        SectionMap::const_iterator it = sections_.find(std::make_pair((uint32_t)type, name));
+        if (it == sections_.end()) {
+            SectionMap::const_iterator only = sections_.end();
+            for (SectionMap::const_iterator jt = sections_.begin(); jt != sections_.end(); jt++) {
+                if (jt->first.first != (uint32_t)type) continue;
+                if (only != sections_.end()) return false;
+                only = jt;
+            }
+            it = only;
+        }
+        if (it == sections_.end()) return false;
+        cursor = SnapshotCursor(base_, it->second.first, it->second.first + it->second.second);
+        return true;
+    }
+
+private:
+    friend class SnapshotWriter;
+    static const uint64_t HEADER_SIZE = 16;
+    static const size_t MAGIC_SIZE = 8;
+    static const uint32_t VERSION = 1;
+
+    typedef std::map<std::pair<uint32_t, std::string>, std::pair<uint64_t, uint64_t> > SectionMap;
+
+    static const char * magic() { return "MHSNAP\0"; }   // MAGIC_SIZE bytes with the terminator
+
+    bool fail(const char * why) {
+        error_ = why;
+        close();
+        return false;
+    }
+
+    int fd_;
+    const uint8_t * base_;
+    uint64_t size_;
+    SectionMap sections_;   // (type, name) -> (payload offset, payload length)
+    std::string error_;
+};
+
+/*
+ *  The snapshot is written to a temporary file that replaces 'path' on close(), so a snapshot being
+ *  read (or mapped into a backing store) is never truncated underneath its reader.
+ */
+class SnapshotWriter {
+public:
+    SnapshotWriter() : file_(nullptr), lengthPos_(0), ok_(false) { }
+    ~SnapshotWriter() { close(); }
+
+    bool open(const std::string &path) {
+        path_ = path;
+        file_ = fopen((path_ + ".tmp").c_str(), "wb");
+        if (!file_) return false;
+        ok_ = true;
+        uint32_t version = SnapshotReader::VERSION;
+        uint32_t reserved = 0;
+        write(SnapshotReader::magic(), SnapshotReader::MAGIC_SIZE);
+        write(version);
+        write(reserved);
+        return ok_;
+    }
+
+    /** Flush and close the file. Returns whether every write succeeded */
+    bool close() {
+        if (!file_) return ok_;
+        if (fclose(file_) != 0) ok_ = false;
+        file_ = nullptr;
+        std::string tmp = path_ + ".tmp";
+        if (ok_ && rename(tmp.c_str(), path_.c_str()) != 0) ok_ = false;
+        if (!ok_) remove(tmp.c_str());
+        return ok_;
+    }
+
+    void beginSection(SnapshotSection type, const std::string &name) {
+        write((uint32_t)type);
+        writeString(name);
+        lengthPos_ = ftell(file_);
+        write((uint64_t)0);
+    }
+
+    /** Patch the length of the section begun last */
+    void endSection() {
+        long end = ftell(file_);
+        uint64_t length = end - (lengthPos_ + sizeof(uint64_t));
+        if (fseek(file_, lengthPos_, SEEK_SET) != 0) ok_ = false;
+        write(length);
+        if (fseek(file_, end, SEEK_SET) != 0) ok_ = false;
+    }
+
+    template<typename T>
+    void write(const T &value) { write(&value, sizeof(T)); }
+
+    void write(const void * data, size_t size) {
+        if (ok_ && size && fwrite(data, 1, size, file_) != size) ok_ = false;
+    }
+
+    void writeString(const std::string &str) {
+        write((uint32_t)str.size());
+        write(str.data(), str.size());
+    }
+
+    /** Pad with zeros so the next byte written is at a multiple of 'alignment' in the file */
+    void align(uint64_t alignment) {
+        static const uint8_t zeros[4096] = { 0 };
+        uint64_t pad = (alignment - ((uint64_t)ftell(file_) % alignment)) % alignment;
+        while (pad) {
+            size_t bytes = pad < sizeof(zeros) ? pad : sizeof(zeros);
+            write(zeros, bytes);
+            pad -= bytes;
+        }
+    }
+
+private:
+    std::string path_;
+    FILE * file_;
+    long lengthPos_;
+    bool ok_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_SNAPSHOT_H */
@@ -15,6 +15,9 @@
 
 #include <sst_config.h>
 #include "testcpu/trivialCPU.h"
+#include "customcmd/nearMemCustomCmdHandler.h"
+
+#include <cstring>
 
 #include <sst/core/params.h>
 #include <sst/core/simulation.h>
@@ -62,6 +65,13 @@ trivialCPU::trivialCPU(ComponentId_t id, Params& params) :
     noncacheableRangeStart = params.find<uint64_t>("noncacheableRangeStart", 0);
     noncacheableRangeEnd = params.find<uint64_t>("noncacheableRangeEnd", 0);
     
+    do_nearmem = params.find<bool>("do_nearmem", 0);
+    nearmemAddr = params.find<uint64_t>("nearmemAddr", 0);
+    if (do_nearmem && (nearmemAddr % lineSize) + 16 > lineSize) {
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: nearmemAddr - the counter and the word after it must fit in one line\n", getName().c_str());
+    }
+    nearmemAdds = nearmemAddSum = nearmemOps = nearmemErrors = 0;
+
     maxReqsPerIssue = params.find<uint32_t>("reqsPerIssue", 1);
     if (maxReqsPerIssue < 1) {
         out.fatal(CALL_INFO, -1, "TrivialCPU cannot issue less than one request at a time...fix your input deck\n");
@@ -109,6 +119,22 @@ void trivialCPU::handleEvent(Interfaces::SimpleMem::Request *req)
     } else {
         SimTime_t et = getCurrentSimTime() - i->second;
         requests.erase(i);
+
+        std::map<uint64_t, uint32_t>::iterator op = nearmemRequests.find(req->id);
+        if ( nearmemRequests.end() != op ) {
+            uint64_t value = 0;
+            if ( req->data.size() >= sizeof(value) ) memcpy(&value, req->data.data(), sizeof(value));
+            else nearmemErrors++;
+            typedef NearMemCustomCmdMemHandler Handler;
+            if ( op->second == Handler::makeOpCode(Handler::Op::FetchAdd, Handler::Type::U64) ) {
+                nearmemAddSum += value;
+            } else if ( op->second == Handler::makeOpCode(Handler::Op::CompareSwap, Handler::Type::U64) ) {
+                if ( value != 0 ) nearmemErrors++;
+            } else if ( value > nearmemAdds ) {
+                nearmemErrors++;    // A sum over the counter's line can't exceed the fetch-adds issued so far
+            }
+            nearmemRequests.erase(op);
+        }
         if (verbose) {
             out.output("%s: Received Request with command %d (addr 0x%" PRIx64 ") [Time: %" PRIu64 "] [%zu outstanding requests]\n",
                     getName().c_str(), req->cmd, req->addr, et, requests.size());
@@ -157,6 +183,9 @@ bool trivialCPU::clockTic( Cycle_t )
                     addr = ((addr % (maxAddr - noncacheableRangeEnd)>>2) << 2) + noncacheableRangeStart;
                     addr = addr - (addr % lineSize);
                     cmdString = "FlushLine";
+                } else if (do_nearmem && 4 <= instNum && instNum <= 6) {
+                    cmd = Interfaces::SimpleMem::Request::CustomCmd;
+                    addr = nearmemAddr;
                 } else if (do_flush && 3 == instNum) {
                     cmd = Interfaces::SimpleMem::Request::FlushLineInv;
                     size = lineSize;
@@ -167,7 +196,13 @@ bool trivialCPU::clockTic( Cycle_t )
                     addr = ((addr % maxAddr)>>2) << 2;
                 }
 
-                Interfaces::SimpleMem::Request *req = new Interfaces::SimpleMem::Request(cmd, addr, 4 /*4 bytes*/);
+                Interfaces::SimpleMem::Request *req;
+                if ( cmd == Interfaces::SimpleMem::Request::CustomCmd ) {
+                    req = makeNearMemRequest(instNum);
+                    cmdString = "NearMemOp";
+                } else {
+                    req = new Interfaces::SimpleMem::Request(cmd, addr, 4 /*4 bytes*/);
+                }
 		if ( cmd == Interfaces::SimpleMem::Request::Write ) {
 		    req->data.resize(4);
                     req->data[0] = (addr >> 24) & 0xff;
@@ -209,3 +244,36 @@ bool trivialCPU::clockTic( Cycle_t )
 }
 
 
+/* Near-memory op on this CPU's counter line: a fetch-add of 1, a compare-and-swap of 0 with 0 on the next word, or a sum over the line */
+Interfaces::SimpleMem::Request* trivialCPU::makeNearMemRequest(uint32_t instNum)
+{
+    typedef NearMemCustomCmdMemHandler Handler;
+    Interfaces::SimpleMem::Request *req;
+    Interfaces::SimpleMem::Request::dataVec operands;
+    uint64_t value;
+    uint32_t opcode;
+
+    switch (instNum) {
+        case 4:
+            opcode = Handler::makeOpCode(Handler::Op::FetchAdd, Handler::Type::U64);
+            value = 1;
+            operands.resize(sizeof(value));
+            memcpy(operands.data(), &value, sizeof(value));
+            req = new Interfaces::SimpleMem::Request(nearmemAddr, sizeof(value), operands, opcode);
+            nearmemAdds++;
+            break;
+        case 5:
+            opcode = Handler::makeOpCode(Handler::Op::CompareSwap, Handler::Type::U64);
+            operands.resize(2 * sizeof(uint64_t), 0);
+            req = new Interfaces::SimpleMem::Request(nearmemAddr + sizeof(uint64_t), sizeof(uint64_t), operands, opcode);
+            break;
+        default:
+            opcode = Handler::makeOpCode(Handler::Op::ReduceSum, Handler::Type::U64);
+            req = new Interfaces::SimpleMem::Request(nearmemAddr - (nearmemAddr % lineSize), lineSize, opcode);
+            break;
+    }
+    req->flags |= Interfaces::SimpleMem::Request::F_NONCACHEABLE;
+    nearmemRequests[req->id] = opcode;
+    nearmemOps++;
+    return req;
+}
@@ -57,6 +57,9 @@ public:
             {"do_flush",                "(bool) Enable flushes", "0"},
             {"noncacheableRangeStart",  "(uint) Beginning of range of addresses that are noncacheable.", "0x0"},
             {"noncacheableRangeEnd",    "(uint) End of range of addresses that are noncacheable.", "0x0"},
+            {"do_nearmem",              "(bool) Also issue near-memory ops for memHierarchy.nearMemCustomCmdHandler: fetch-adds of 1 to a 64-bit counter at nearmemAddr, compare-and-swaps on the word after it (which stays 0), and sums over the counter's line. "
+                                        "Results are checked at the end of simulation. nearmemAddr should be at or past memSize so loads and stores never touch its line, and distinct for each CPU.", "0"},
+            {"nearmemAddr",             "(uint) Address of the counter used by near-memory ops", "0"},
             {"addressoffset",           "(uint) Apply an offset to a calculated address to check for non-alignment issues", "0"} )
 
     SST_ELI_DOCUMENT_PORTS( {"mem_link", "Connection to cache", { "memHierarchy.MemEventBase" } } )
@@ -71,6 +74,13 @@ public:
     		getName().c_str(), num_reads_issued, num_reads_returned, clock_ticks);
     	if ( noncacheableReads || noncacheableWrites )
 	    out.output("\t%zu Noncacheable Reads\n\t%zu Noncacheable Writes\n", noncacheableReads, noncacheableWrites);
+        if ( do_nearmem ) {
+            out.output("\t%" PRIu64 " Near-memory ops (%" PRIu64 " fetch-adds)\n", nearmemOps, nearmemAdds);
+            // Every fetch-add returns a distinct old value of the counter, so together they return 0..n-1
+            if ( nearmemErrors || nearmemAddSum != nearmemAdds * (nearmemAdds - 1) / 2 )
+                out.fatal(CALL_INFO, -1, "%s: near-memory ops returned wrong results (%" PRIu64 " errors, fetch-add sum %" PRIu64 ")\n",
+                        getName().c_str(), nearmemErrors, nearmemAddSum);
+        }
 
     	//out.output("Number of Pending Requests per Cycle (Binned by 2 Requests)\n");
     	//for(uint64_t i = requestsPendingCycle->getBinStart(); i < requestsPendingCycle->getBinEnd(); i += requestsPendingCycle->getBinWidth()) {
@@ -86,6 +96,7 @@ private:
     void init(unsigned int phase);
 
     void handleEvent( Interfaces::SimpleMem::Request *ev );
+    Interfaces::SimpleMem::Request* makeNearMemRequest( uint32_t instNum );
     virtual bool clockTic( SST::Cycle_t );
 
     Output out;
@@ -102,6 +113,10 @@ private:
     uint64_t noncacheableRangeStart, noncacheableRangeEnd;
     uint64_t clock_ticks;
     size_t noncacheableReads, noncacheableWrites;
+    bool do_nearmem;
+    uint64_t nearmemAddr;
+    std::map<uint64_t, uint32_t> nearmemRequests;  // Outstanding near-memory op ids -> op code
+    uint64_t nearmemAdds, nearmemAddSum, nearmemOps, nearmemErrors;
     Statistic<uint64_t>* requestsPendingCycle;
 
     std::map<uint64_t, SimTime_t> requests;
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+
+import re
+import sys;
+
+# Check the functional warmup statistics in the output of testWarmup.py.
+# Each L1 must handle exactly its warmup_requests in warmup mode, and the L2 and directory must actually
+# install and grant lines; otherwise warmup did nothing and the run is just a cold one.
+# Prints each failed check and exits with 1 if there are any.
+
+statPattern = re.compile('\A ([^ ]+) : [^:]+ : Sum\.u64 = (\d+);')
+
+def readSums(path):
+    sums = dict()
+    with open(path) as f:
+        for line in f:
+            statMap = statPattern.match(line.rstrip())
+            if statMap:
+                sums[statMap.group(1)] = int(statMap.group(2))
+    return sums
+
+if len(sys.argv) != 2:
+    sys.stderr.write("Usage: %s <output>\n" % sys.argv[0])
+    sys.exit(2)
+
+sums = readSums(sys.argv[1])
+
+failures = 0
+def check(name, ok, expected):
+    global failures
+    value = sums.get(name)
+    if value is None or not ok(value):
+        print("%s: %s, expected %s" % (name, "(missing)" if value is None else value, expected))
+        failures = failures + 1
+
+for cpu in range(2):
+    check("l1cache%d.Warmup_requests" % cpu, lambda v: v == 1000, "1000")
+check("l2cache.Warmup_installs", lambda v: v > 0, "more than 0")
+check("dirctrl.warmup_grants", lambda v: v > 0, "more than 0")
+
+if failures:
+    print("%d warmup checks failed" % failures)
+    sys.exit(1)
+print("Warmup statistics OK")
@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+
+import re
+import sys;
+
+# Compare the statistics and simulated time in two SST outputs, e.g., the same test run two ways that must not differ.
+# Prints each difference and exits with 1 if there are any.
+
+statPattern = re.compile('\A ([^ ]+) : [^:]+ : (.*)\Z')
+timePattern = re.compile('\ASimulation is complete, simulated time: (.*)\Z')
+
+def readStats(path):
+    stats = dict()
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip()
+            statMap = statPattern.match(line)
+            if statMap:
+                stats[statMap.group(1)] = statMap.group(2)
+            else:
+                timeMap = timePattern.match(line)
+                if timeMap:
+                    stats["simulated time"] = timeMap.group(1)
+    return stats
+
+if len(sys.argv) != 3:
+    sys.stderr.write("Usage: %s <output> <output>\n" % sys.argv[0])
+    sys.exit(2)
+
+first = readStats(sys.argv[1])
+second = readStats(sys.argv[2])
+
+if not first:
+    sys.stderr.write("No statistics found in %s\n" % sys.argv[1])
+    sys.exit(1)
+
+differences = 0
+for name in sorted(set(first.keys()) | set(second.keys())):
+    a = first.get(name, "(missing)")
+    b = second.get(name, "(missing)")
+    if a != b:
+        print("%s:\n  %s: %s\n  %s: %s" % (name, sys.argv[1], a, sys.argv[2], b))
+        differences = differences + 1
+
+if differences:
+    print("%d statistics differ" % differences)
+    sys.exit(1)
+print("Statistics match")
@@ -30,6 +30,7 @@ declare -a bk_arr=( testBackendChaining.py
                     testBackendSimpleDRAM-2.py
                     testBackendTimingDRAM.py
                     testBackendVaultSim.py
+                    testNearMemOps.py
                     )
 declare -a ca_arr=(testDistributedCaches.py
                     testFlushes-2.py
@@ -82,4 +83,44 @@ do
     fi
 done
 
+# Event-driven and clocked memory controllers must produce the same statistics
+echo "Running testEventDriven.py (event-driven vs. clocked)"
+if timeout 60 sst testEventDriven.py > log_event && timeout 60 sst testEventDriven.py --model-options="clocked" > log_clocked && python compareStats.py log_event log_clocked > log; then
+    echo "  Complete"
+else
+    echo "  FAILED"
+    cp log fail_testEventDriven.py.log
+fi
+
+# Functional warmup must actually warm the L2 and directory
+echo "Running testWarmup.py (warmup statistics)"
+if timeout 60 sst testWarmup.py > log_warmup && python checkWarmup.py log_warmup > log; then
+    echo "  Complete"
+else
+    echo "  FAILED"
+    cat log_warmup >> log
+    cp log fail_testWarmup.py.log
+fi
 
+# Restoring snapshots and saving them again must reproduce them exactly
+echo "Running testSnapshot.py (save, load and save again)"
+rm -f snapshot-*.bin
+if timeout 60 sst testSnapshot.py > log && timeout 60 sst testSnapshot.py --model-options="load" >> log &&
+   timeout 60 sst testSnapshot.py --model-options="midrun" > midrun.log && timeout 60 sst testSnapshot.py --model-options="midrun load" >> midrun.log; then
+    cat midrun.log >> log
+    failed=0
+    # The mid-run snapshot must catch lines in transition, or it tests nothing the end-of-run one doesn't
+    grep -q "were in transition when the snapshot was written" midrun.log || failed=1
+    for f in snapshot-*.reload.bin; do
+        cmp ${f%.reload.bin}.bin $f >> log 2>&1 || failed=1
+    done
+else
+    failed=1
+fi
+if [ $failed -eq 0 ]; then
+    echo "  Complete"
+else
+    echo "  FAILED"
+    cp log fail_testSnapshot.py.log
+fi
+rm -f snapshot-*.bin midrun.log
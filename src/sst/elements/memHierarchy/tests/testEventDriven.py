@@ -0,0 +1,84 @@
+# Automatically generated SST Python input
+import sst
+import sys
+
+# Testing
+# MemController "event_driven" mode
+# Sparse traffic from four CPUs so the memory controller is often idle
+# An event-driven controller must produce exactly the same statistics as a clocked one:
+#   sst testEventDriven.py > event.out
+#   sst testEventDriven.py --model-options="clocked" > clocked.out
+#   python compareStats.py event.out clocked.out
+
+eventDriven = "clocked" not in sys.argv[1:]
+
+cores = 4
+
+# Define the simulation components
+comp_bus = sst.Component("bus", "memHierarchy.Bus")
+comp_bus.addParams({
+      "bus_frequency" : "2Ghz"
+})
+
+for x in range(cores):
+    comp_cpu = sst.Component("cpu" + str(x), "memHierarchy.trivialCPU")
+    comp_cpu.addParams({
+          "commFreq" : "200",
+          "rngseed" : str(101 + 200 * x),
+          "do_write" : "1",
+          "num_loadstore" : "1000",
+          "memSize" : "0x100000",
+    })
+    comp_l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    comp_l1cache.addParams({
+          "access_latency_cycles" : "2",
+          "cache_frequency" : "2Ghz",
+          "replacement_policy" : "lru",
+          "coherence_protocol" : "MESI",
+          "associativity" : "4",
+          "cache_line_size" : "64",
+          "cache_size" : "2 KB",
+          "L1" : "1",
+          "debug" : "0"
+    })
+
+    link_cpu_l1cache = sst.Link("link_cpu_l1cache_" + str(x))
+    link_cpu_l1cache.connect( (comp_cpu, "mem_link", "500ps"), (comp_l1cache, "high_network_0", "500ps") )
+    link_l1cache_bus = sst.Link("link_l1cache_bus_" + str(x))
+    link_l1cache_bus.connect( (comp_l1cache, "low_network_0", "1000ps"), (comp_bus, "high_network_" + str(x), "1000ps") )
+
+comp_l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+comp_l2cache.addParams({
+      "access_latency_cycles" : "6",
+      "cache_frequency" : "2Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "8",
+      "cache_line_size" : "64",
+      "cache_size" : "16 KB",
+      "debug" : "0"
+})
+comp_memory = sst.Component("memory", "memHierarchy.MemController")
+comp_memory.addParams({
+      "clock" : "700MHz",   # Not a divisor of the cache clock, so ticks must land on the controller's own edges
+      "event_driven" : "1" if eventDriven else "0",
+      "max_requests_per_cycle" : "1",
+      "backing" : "malloc",
+      "backend.mem_size" : "512MiB",
+      "backend" : "memHierarchy.simpleMem",
+      "backend.access_time" : "70 ns",
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+sst.enableAllStatisticsForComponentType("memHierarchy.Cache")
+sst.enableAllStatisticsForComponentType("memHierarchy.MemController")
+
+
+# Define the simulation links
+link_bus_l2cache = sst.Link("link_bus_l2cache")
+link_bus_l2cache.connect( (comp_bus, "low_network_0", "1000ps"), (comp_l2cache, "high_network_0", "1000ps") )
+link_l2cache_mem = sst.Link("link_l2cache_mem")
+link_l2cache_mem.connect( (comp_l2cache, "low_network_0", "1000ps"), (comp_memory, "direct_link", "1000ps") )
+# End of generated output.
@@ -0,0 +1,81 @@
+# Automatically generated SST Python input
+import sst
+
+# Testing
+# Near-memory atomics and reductions (memHierarchy.nearMemCustomCmdHandler)
+# Each CPU mixes fetch-adds, compare-and-swaps and line sums on its own counter in with random loads/stores
+# The counters are past the CPUs' memSize, so loads/stores never touch them
+# trivialCPU checks the results at the end of simulation and fails if any are wrong
+
+cores = 2
+
+# Define the simulation components
+comp_bus = sst.Component("bus", "memHierarchy.Bus")
+comp_bus.addParams({
+      "bus_frequency" : "2Ghz"
+})
+
+for x in range(cores):
+    comp_cpu = sst.Component("cpu" + str(x), "memHierarchy.trivialCPU")
+    comp_cpu.addParams({
+          "commFreq" : "10",
+          "rngseed" : str(101 + 200 * x),
+          "do_write" : "1",
+          "do_nearmem" : "1",
+          "nearmemAddr" : 0x100000 + 64 * x,
+          "num_loadstore" : "2000",
+          "memSize" : "0x100000",
+    })
+    comp_l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    comp_l1cache.addParams({
+          "access_latency_cycles" : "2",
+          "cache_frequency" : "2Ghz",
+          "replacement_policy" : "lru",
+          "coherence_protocol" : "MESI",
+          "associativity" : "4",
+          "cache_line_size" : "64",
+          "cache_size" : "4 KB",
+          "L1" : "1",
+          "debug" : "0"
+    })
+
+    link_cpu_l1cache = sst.Link("link_cpu_l1cache_" + str(x))
+    link_cpu_l1cache.connect( (comp_cpu, "mem_link", "500ps"), (comp_l1cache, "high_network_0", "500ps") )
+    link_l1cache_bus = sst.Link("link_l1cache_bus_" + str(x))
+    link_l1cache_bus.connect( (comp_l1cache, "low_network_0", "1000ps"), (comp_bus, "high_network_" + str(x), "1000ps") )
+
+comp_l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+comp_l2cache.addParams({
+      "access_latency_cycles" : "6",
+      "cache_frequency" : "2Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "8",
+      "cache_line_size" : "64",
+      "cache_size" : "32 KB",
+      "debug" : "0"
+})
+comp_memory = sst.Component("memory", "memHierarchy.MemController")
+comp_memory.addParams({
+      "clock" : "1GHz",
+      "backing" : "malloc",
+      "backend.mem_size" : "512MiB",
+      "backend" : "memHierarchy.simpleMem",
+      "backend.access_time" : "100 ns",
+      "customCmdHandler" : "memHierarchy.nearMemCustomCmdHandler",
+      "cache_line_size" : "64",
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+sst.enableAllStatisticsForComponentType("memHierarchy.Cache")
+sst.enableAllStatisticsForComponentType("memHierarchy.MemController")
+
+
+# Define the simulation links
+link_bus_l2cache = sst.Link("link_bus_l2cache")
+link_bus_l2cache.connect( (comp_bus, "low_network_0", "1000ps"), (comp_l2cache, "high_network_0", "1000ps") )
+link_l2cache_mem = sst.Link("link_l2cache_mem")
+link_l2cache_mem.connect( (comp_l2cache, "low_network_0", "1000ps"), (comp_memory, "direct_link", "1000ps") )
+# End of generated output.
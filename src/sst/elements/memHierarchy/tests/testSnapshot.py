@@ -0,0 +1,123 @@
+# Automatically generated SST Python input
+import sst
+import sys
+
+# Testing
+# Snapshot save/load round trip for caches, a directory and a memory controller
+#   sst testSnapshot.py                              Run traffic and save snapshot-<component>.bin at the end
+#   sst testSnapshot.py --model-options="load"       Restore those snapshots, run no traffic, and save snapshot-<component>.reload.bin
+# Adding "midrun" to either run saves snapshot-<component>.midrun.bin at 20us instead, while requests are still in flight,
+# and loads from those files. Lines and entries in transition are saved as invalid, so the caches warn about them.
+# Restoring and saving again must reproduce each file exactly:
+#   for f in snapshot-*.reload.bin; do cmp $f ${f%.reload.bin}.bin; done
+
+load = "load" in sys.argv[1:]
+midrun = "midrun" in sys.argv[1:]
+
+def snapshot(component, params):
+    prefix = "snapshot-" + component + (".midrun" if midrun else "")
+    if load:
+        params["snapshot_load"] = prefix + ".bin"
+        params["snapshot_save"] = prefix + ".reload.bin"
+    else:
+        params["snapshot_save"] = prefix + ".bin"
+        if midrun:
+            params["snapshot_save_time"] = "20us"
+    return params
+
+cores = 2
+
+# Define the simulation components
+comp_bus = sst.Component("bus", "memHierarchy.Bus")
+comp_bus.addParams({
+      "bus_frequency" : "2Ghz"
+})
+
+for x in range(cores):
+    comp_cpu = sst.Component("cpu" + str(x), "memHierarchy.trivialCPU")
+    comp_cpu.addParams({
+          "commFreq" : "50",
+          "rngseed" : str(101 + 200 * x),
+          "do_write" : "1",
+          "num_loadstore" : "0" if load else "2000",
+          "memSize" : "0x10000",
+    })
+    comp_l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    comp_l1cache.addParams(snapshot("l1cache" + str(x), {
+          "access_latency_cycles" : "2",
+          "cache_frequency" : "2Ghz",
+          "replacement_policy" : "lru",
+          "coherence_protocol" : "MESI",
+          "associativity" : "4",
+          "cache_line_size" : "64",
+          "cache_size" : "2 KB",
+          "L1" : "1",
+          "debug" : "0"
+    }))
+
+    link_cpu_l1cache = sst.Link("link_cpu_l1cache_" + str(x))
+    link_cpu_l1cache.connect( (comp_cpu, "mem_link", "500ps"), (comp_l1cache, "high_network_0", "500ps") )
+    link_l1cache_bus = sst.Link("link_l1cache_bus_" + str(x))
+    link_l1cache_bus.connect( (comp_l1cache, "low_network_0", "1000ps"), (comp_bus, "high_network_" + str(x), "1000ps") )
+
+comp_l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+comp_l2cache.addParams(snapshot("l2cache", {
+      "access_latency_cycles" : "10",
+      "cache_frequency" : "2Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "8",
+      "cache_line_size" : "64",
+      "cache_size" : "16 KB",
+      "debug" : "0",
+      "memNIC.network_address" : "1",
+      "memNIC.network_bw" : "25GB/s",
+}))
+comp_chiprtr = sst.Component("chiprtr", "merlin.hr_router")
+comp_chiprtr.addParams({
+      "xbar_bw" : "1GB/s",
+      "link_bw" : "1GB/s",
+      "input_buf_size" : "1KB",
+      "num_ports" : "2",
+      "flit_size" : "72B",
+      "output_buf_size" : "1KB",
+      "id" : "0",
+      "topology" : "merlin.singlerouter"
+})
+comp_dirctrl = sst.Component("dirctrl", "memHierarchy.DirectoryController")
+comp_dirctrl.addParams(snapshot("dirctrl", {
+      "coherence_protocol" : "MESI",
+      "debug" : "0",
+      "memNIC.network_address" : "0",
+      "entry_cache_size" : "128",   # Smaller than the L2, so some entries are saved uncached
+      "memNIC.network_bw" : "25GB/s",
+      "memNIC.addr_range_end" : "0x1F000000",
+      "memNIC.addr_range_start" : "0x0"
+}))
+comp_memory = sst.Component("memory", "memHierarchy.MemController")
+comp_memory.addParams(snapshot("memory", {
+      "clock" : "1GHz",
+      "backing" : "malloc",
+      "backend.mem_size" : "512MiB",
+      "backend" : "memHierarchy.simpleMem",
+      "backend.access_time" : "100 ns",
+}))
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+sst.enableAllStatisticsForComponentType("memHierarchy.Cache")
+sst.enableAllStatisticsForComponentType("memHierarchy.MemController")
+sst.enableAllStatisticsForComponentType("memHierarchy.DirectoryController")
+
+
+# Define the simulation links
+link_bus_l2cache = sst.Link("link_bus_l2cache")
+link_bus_l2cache.connect( (comp_bus, "low_network_0", "1000ps"), (comp_l2cache, "high_network_0", "1000ps") )
+link_cache_net_0 = sst.Link("link_cache_net_0")
+link_cache_net_0.connect( (comp_l2cache, "directory", "1000ps"), (comp_chiprtr, "port1", "1000ps") )
+link_dir_net_0 = sst.Link("link_dir_net_0")
+link_dir_net_0.connect( (comp_chiprtr, "port0", "1000ps"), (comp_dirctrl, "network", "1000ps") )
+link_dir_mem_link = sst.Link("link_dir_mem_link")
+link_dir_mem_link.connect( (comp_dirctrl, "memory", "1000ps"), (comp_memory, "direct_link", "1000ps") )
+# End of generated output.
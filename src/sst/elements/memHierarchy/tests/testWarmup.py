@@ -0,0 +1,108 @@
+# Automatically generated SST Python input
+import sst
+
+# Testing
+# Functional warmup (warmup_requests) through a shared L2 and a directory
+# Each L1 handles its CPU's first 1000 requests in warmup mode, then switches to detailed timing
+# Warm requests install lines in the L2 and register the L2 with the directory, so after the switch
+# the L2 should hit where a cold one would miss
+# checkWarmup.py checks the stats: l1cache*.Warmup_requests = 1000, l2cache.Warmup_installs and dirctrl.warmup_grants above 0
+#   sst testWarmup.py > warmup.out && python checkWarmup.py warmup.out
+
+cores = 2
+
+# Define the simulation components
+comp_bus = sst.Component("bus", "memHierarchy.Bus")
+comp_bus.addParams({
+      "bus_frequency" : "2Ghz"
+})
+
+for x in range(cores):
+    comp_cpu = sst.Component("cpu" + str(x), "memHierarchy.trivialCPU")
+    comp_cpu.addParams({
+          "commFreq" : "50",
+          "rngseed" : str(101 + 200 * x),
+          "do_write" : "1",
+          "num_loadstore" : "3000",
+          "memSize" : "0x4000",   # Fits in the L2, so a warmed L2 mostly hits
+    })
+    comp_l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    comp_l1cache.addParams({
+          "access_latency_cycles" : "2",
+          "cache_frequency" : "2Ghz",
+          "replacement_policy" : "lru",
+          "coherence_protocol" : "MESI",
+          "associativity" : "4",
+          "cache_line_size" : "64",
+          "cache_size" : "2 KB",
+          "L1" : "1",
+          "warmup_requests" : "1000",
+          "debug" : "0"
+    })
+
+    link_cpu_l1cache = sst.Link("link_cpu_l1cache_" + str(x))
+    link_cpu_l1cache.connect( (comp_cpu, "mem_link", "500ps"), (comp_l1cache, "high_network_0", "500ps") )
+    link_l1cache_bus = sst.Link("link_l1cache_bus_" + str(x))
+    link_l1cache_bus.connect( (comp_l1cache, "low_network_0", "1000ps"), (comp_bus, "high_network_" + str(x), "1000ps") )
+
+comp_l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+comp_l2cache.addParams({
+      "access_latency_cycles" : "10",
+      "cache_frequency" : "2Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "8",
+      "cache_line_size" : "64",
+      "cache_size" : "32 KB",
+      "debug" : "0",
+      "memNIC.network_address" : "1",
+      "memNIC.network_bw" : "25GB/s",
+})
+comp_chiprtr = sst.Component("chiprtr", "merlin.hr_router")
+comp_chiprtr.addParams({
+      "xbar_bw" : "1GB/s",
+      "link_bw" : "1GB/s",
+      "input_buf_size" : "1KB",
+      "num_ports" : "2",
+      "flit_size" : "72B",
+      "output_buf_size" : "1KB",
+      "id" : "0",
+      "topology" : "merlin.singlerouter"
+})
+comp_dirctrl = sst.Component("dirctrl", "memHierarchy.DirectoryController")
+comp_dirctrl.addParams({
+      "coherence_protocol" : "MESI",
+      "debug" : "0",
+      "memNIC.network_address" : "0",
+      "entry_cache_size" : "1024",
+      "memNIC.network_bw" : "25GB/s",
+      "memNIC.addr_range_end" : "0x1F000000",
+      "memNIC.addr_range_start" : "0x0"
+})
+comp_memory = sst.Component("memory", "memHierarchy.MemController")
+comp_memory.addParams({
+      "clock" : "1GHz",
+      "backing" : "none",
+      "backend.mem_size" : "512MiB",
+      "backend" : "memHierarchy.simpleMem",
+      "backend.access_time" : "100 ns",
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+sst.enableAllStatisticsForComponentType("memHierarchy.Cache")
+sst.enableAllStatisticsForComponentType("memHierarchy.MemController")
+sst.enableAllStatisticsForComponentType("memHierarchy.DirectoryController")
+
+
+# Define the simulation links
+link_bus_l2cache = sst.Link("link_bus_l2cache")
+link_bus_l2cache.connect( (comp_bus, "low_network_0", "1000ps"), (comp_l2cache, "high_network_0", "1000ps") )
+link_cache_net_0 = sst.Link("link_cache_net_0")
+link_cache_net_0.connect( (comp_l2cache, "directory", "1000ps"), (comp_chiprtr, "port1", "1000ps") )
+link_dir_net_0 = sst.Link("link_dir_net_0")
+link_dir_net_0.connect( (comp_chiprtr, "port0", "1000ps"), (comp_dirctrl, "network", "1000ps") )
+link_dir_mem_link = sst.Link("link_dir_mem_link")
+link_dir_mem_link.connect( (comp_dirctrl, "memory", "1000ps"), (comp_memory, "direct_link", "1000ps") )
+# End of generated output.